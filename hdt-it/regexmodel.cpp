@@ -8,15 +8,23 @@ class QFont;
 
 #include "../hdt-lib/src/dictionary/LiteralDictionary.hpp"
 
-RegexModel::RegexModel(HDTController *manager) : hdtController(manager), numResults(0), results(NULL)
+// Matches located each time that the view needs more rows.
+#define REGEX_FETCH_SIZE 100
+
+RegexModel::RegexModel(HDTController *manager) : hdtController(manager), iterator(NULL)
 {
 }
 
 RegexModel::~RegexModel()
 {
-    if(results!=NULL) {
-        free(results);
-    }
+    delete iterator;
+}
+
+void RegexModel::clearResults()
+{
+    delete iterator;
+    iterator = NULL;
+    results.clear();
 }
 
 void RegexModel::setQuery(QString query)
@@ -27,19 +35,34 @@ void RegexModel::setQuery(QString query)
             QMessageBox::warning(NULL, tr("ERROR"), tr("This HDT does not support substring search"));
             return;
         }
-        if(query.length()==0) {
-            numResults = 0;
-        } else {
+        clearResults();
+        if(query.length()!=0) {
             QByteArray arr = query.toUtf8();
-            numResults = dict->substringToId((uchar *)arr.data(), arr.size(), &results);
+            iterator = dict->substringToIds((uchar *)arr.data(), arr.size());
         }
         emit layoutChanged();
     }
 }
 
+bool RegexModel::canFetchMore(const QModelIndex &parent) const
+{
+    return iterator!=NULL && iterator->hasNext();
+}
+
+void RegexModel::fetchMore(const QModelIndex &parent)
+{
+    std::vector<unsigned int> more;
+    while(iterator->hasNext() && more.size()<REGEX_FETCH_SIZE) {
+        more.push_back(iterator->next());
+    }
+    beginInsertRows(QModelIndex(), results.size(), results.size()+more.size()-1);
+    results.insert(results.end(), more.begin(), more.end());
+    endInsertRows();
+}
+
 int RegexModel::rowCount(const QModelIndex &parent) const
 {
-    return (int)numResults;
+    return (int)results.size();
 }
 
 int RegexModel::columnCount(const QModelIndex &parent) const
@@ -49,7 +72,7 @@ int RegexModel::columnCount(const QModelIndex &parent) const
 
 QVariant RegexModel::data(const QModelIndex &index, int role) const
 {
-    if(results==NULL) {
+    if(index.row()>=(int)results.size()) {
         return QVariant();
     }
 
@@ -122,11 +145,7 @@ QVariant RegexModel::headerData(int section, Qt::Orientation orientation, int ro
 
 void RegexModel::updateDatasetChanged()
 {
-    if(results==NULL) {
-        free(results);
-    }
-    numResults = 0;
-    results=NULL;
+    clearResults();
 
     emit layoutChanged();
 }
@@ -2,19 +2,26 @@
 #define REGEXMODEL_HPP
 
 #include <QAbstractTableModel>
+#include <vector>
 
 #include "hdtcontroller.hpp"
 
 class HDTController;
 
+namespace hdt {
+class IteratorUInt;
+}
+
 class RegexModel : public QAbstractTableModel
 {
     Q_OBJECT
 
 private:
     HDTController *hdtController;
-    uint32_t numResults;
-    uint32_t *results;
+    hdt::IteratorUInt *iterator;
+    std::vector<unsigned int> results;
+
+    void clearResults();
 
 public:
     explicit RegexModel(HDTController *manager);
@@ -26,6 +33,8 @@ public:
     int columnCount(const QModelIndex &parent = QModelIndex()) const;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
     QVariant headerData(int section, Qt::Orientation orientation, int role) const;
+    bool canFetchMore(const QModelIndex &parent) const;
+    void fetchMore(const QModelIndex &parent);
 
     void updateDatasetChanged();
 signals:
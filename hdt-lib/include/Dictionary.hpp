@@ -33,6 +33,7 @@
 #define HDT_DICTIONARY_
 
 #include <string>
+#include <vector>
 #include <iostream>
 
 #include <HDTListener.hpp>
@@ -63,6 +64,55 @@ public:
     */
     virtual std::string idToString(unsigned int id, TripleComponentRole role)=0;
 
+    /**
+    * Fetch the string associated to the specified ID as the triple role into a buffer
+    * owned by the caller, followed by '\0', without allocating memory.
+    * @param id ID to be fetched
+    * @param role Triple Role (Subject, Predicate, Object) to be fetched.
+    * @param buffer Memory where the string is written.
+    * @param capacity Size of the buffer in bytes.
+    * @return The length of the string, or 0 if the ID does not exist. If it is capacity or
+    * more the string was not written, and the call must be repeated with a bigger buffer.
+    */
+    virtual size_t extract(unsigned int id, TripleComponentRole role, char *buffer, size_t capacity) {
+    	std::string str = idToString(id, role);
+    	if(str.length()<capacity) {
+    		str.copy(buffer, str.length());
+    		buffer[str.length()] = '\0';
+    	}
+    	return str.length();
+    }
+
+    /**
+    * Fetch the string associated to the specified ID as the triple role into out,
+    * reusing the memory that out already has.
+    * @return The length of the string, or 0 if the ID does not exist.
+    */
+    size_t extractString(unsigned int id, TripleComponentRole role, std::string &out) {
+    	out.resize(out.capacity()>15 ? out.capacity() : 15);
+    	size_t len = extract(id, role, &out[0], out.size()+1);
+    	if(len>out.size()) {
+    		out.resize(len);
+    		len = extract(id, role, &out[0], out.size()+1);
+    	}
+    	out.resize(len);
+    	return len;
+    }
+
+    /**
+    * Fetch the strings associated to several IDs of the same triple role, in the same
+    * order. IDs in increasing order let the dictionary decode each block only once.
+    * @param ids IDs to be fetched
+    * @param role Triple Role (Subject, Predicate, Object) to be fetched.
+    * @param out Resized to the number of IDs, reusing its strings.
+    */
+    virtual void extractMany(const std::vector<unsigned int> &ids, TripleComponentRole role, std::vector<std::string> &out) {
+    	out.resize(ids.size());
+    	for(size_t i=0;i<ids.size();i++) {
+    		extractString(ids[i], role, out[i]);
+    	}
+    }
+
     /**
     * Fetch the ID assigned to the supplied string as the triple role.
     * If the ID does not exist, it throws an exception.
@@ -72,6 +122,35 @@ public:
     */
     virtual unsigned int stringToId(std::string &str, TripleComponentRole role)=0;
 
+    /**
+    * Fetch the IDs assigned to several strings as the triple role, in the same order.
+    * Strings that do not exist get the ID 0. The strings are looked up in the given
+    * order; dictionaries may continue the search of a string from the previous one,
+    * so sorted strings can be resolved faster.
+    * @param strs Strings to be converted.
+    * @param role Triple Role (Subject, Predicate, Object) to be fetched.
+    * @param ids Resized to the number of strings.
+    */
+    virtual void stringToIds(std::vector<std::string> &strs, TripleComponentRole role, std::vector<unsigned int> &ids) {
+    	ids.resize(strs.size());
+    	for(size_t i=0;i<strs.size();i++) {
+    		ids[i] = stringToId(strs[i], role);
+    	}
+    }
+
+    /**
+    * Fetch the IDs of the strings of the triple role that start with a prefix, without
+    * decoding them. The sections are sorted, so the IDs are contiguous in each section
+    * and they are returned as one range [begin, end) per section, in global IDs and in
+    * increasing order. Empty ranges are not added.
+    * @param prefix Prefix of the strings, an empty one matches all the role.
+    * @param role Triple Role (Subject, Predicate, Object) to be fetched.
+    * @param ranges Receives the ranges, it is cleared first.
+    */
+    virtual void prefixRange(const std::string &prefix, TripleComponentRole role, std::vector<std::pair<unsigned int, unsigned int> > &ranges) {
+    	throw "prefixRange not implemented";
+    }
+
     /**
     * Convert a TripleString object to a TripleID, using the dictionary to perform the conversion.
     * If any of the components do not exist in the dictionary, it throws an exception.
@@ -91,12 +170,10 @@ public:
     * @return resultant TripleSTring
     */
     void tripleIDtoTripleString(TripleID &tripleID, TripleString &ts) {
-    	string s = idToString(tripleID.getSubject(), SUBJECT);
-    	string p = idToString(tripleID.getPredicate(), PREDICATE);
-    	string o = idToString(tripleID.getObject(), OBJECT);
-    	ts.setSubject(s);
-    	ts.setPredicate(p);
-    	ts.setObject(o);
+    	// Decoded in place, so reusing ts does not allocate.
+    	extractString(tripleID.getSubject(), SUBJECT, ts.getSubject());
+    	extractString(tripleID.getPredicate(), PREDICATE, ts.getPredicate());
+    	extractString(tripleID.getObject(), OBJECT, ts.getObject());
     }
 
     /** Number of total elements of the dictionary
@@ -110,6 +110,15 @@ public:
     IteratorTripleString *search(TripleString &pattern) {
         return search(pattern.getSubject().c_str(), pattern.getPredicate().c_str(), pattern.getObject().c_str());
     }
+
+	/**
+	 * Search the triples that match the specified pattern, skipping the first offset
+	 * results and returning at most limit of them (0 for no limit). When the pattern
+	 * allows it, the offset is reached directly without walking the previous results.
+	 */
+	IteratorTripleString *search(const char *subject, const char *predicate, const char *object, unsigned int offset, unsigned int limit) {
+		return new LimitIteratorTripleString(search(subject, predicate, object), offset, limit);
+	}
 };
 
 
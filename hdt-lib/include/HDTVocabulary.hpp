@@ -114,6 +114,10 @@ namespace HDTVocabulary {
 
 	// Index types
 	const std::string INDEX_TYPE_FOQ = HDT_BASE+"indexFoQ>";
+	const std::string INDEX_TYPE_LITERAL_RANGE = HDT_BASE+"indexLiteralRange>";
+	const std::string INDEX_TYPE_LITERAL_TAG = HDT_BASE+"indexLiteralTag>";
+	const std::string INDEX_TYPE_HASH = HDT_BASE+"indexHash>";
+	const std::string INDEX_TYPE_BLOOM = HDT_BASE+"indexBloom>";
 
 	// Sequences
 	const std::string SEQ_TYPE_INT32 = HDT_SEQ_BASE+"Int32>";
@@ -122,9 +126,13 @@ namespace HDTVocabulary {
 	const std::string SEQ_TYPE_LOG2 = HDT_SEQ_BASE+"Log2>";
 	const std::string SEQ_TYPE_HUFFMAN = HDT_SEQ_BASE+"Huffman>";
 	const std::string SEQ_TYPE_WAVELET = HDT_SEQ_BASE+"Wavelet>";
+	const std::string SEQ_TYPE_WAVELET_MATRIX = HDT_SEQ_BASE+"WaveletMatrix>";
+	const std::string SEQ_TYPE_ELIAS_FANO = HDT_SEQ_BASE+"EliasFano>";
+	const std::string SEQ_TYPE_DAC = HDT_SEQ_BASE+"DAC>";
 
 	// Bitmaps
 	const std::string BITMAP_TYPE_PLAIN = HDT_BITMAP_BASE+"Plain>";
+	const std::string BITMAP_TYPE_RANK9 = HDT_BITMAP_BASE+"Rank9>";
 
 	// Misc
 	const std::string ORIGINAL_SIZE = HDT_BASE+"originalSize>";
@@ -131,11 +131,32 @@ public:
 	virtual ResultEstimationType numResultEstimation() {
 		return UNKNOWN;
 	}
+	/**
+	 * Tells whether goTo() can jump to a position without walking the
+	 * previous results.
+	 */
 	virtual bool canGoTo() {
 		return false;
 	}
+	/**
+	 * Move the iterator so that next() returns the result number pos (starting at 0).
+	 * Throws if pos is beyond the last result.
+	 */
 	virtual void goTo(unsigned int pos) {
 	}
+	/**
+	 * Tells whether findNextOccurrence() can skip ahead on the given
+	 * component (1 Subject, 2 Predicate, 3 Object).
+	 */
+	virtual bool canFindNextOccurrence(unsigned char component) {
+		return false;
+	}
+	/**
+	 * Skip forward so that next() returns the first remaining triple whose
+	 * component (1 Subject, 2 Predicate, 3 Object) is greater or equal than value.
+	 * The component must be sorted in this iterator, see canFindNextOccurrence().
+	 * @return false if there are no such triples left.
+	 */
 	virtual bool findNextOccurrence(unsigned int value, unsigned char component) {
 		return false;
 	}
@@ -168,6 +189,57 @@ public:
 	virtual void goToStart() {
 
 	}
+	virtual bool canGoTo() {
+		return false;
+	}
+	virtual void goTo(unsigned int pos) {
+	}
+};
+
+/**
+ * Returns up to limit triples of another iterator after skipping the first offset ones.
+ * The offset is reached with goTo() if the iterator supports it, otherwise walking it.
+ * A limit of 0 returns all the remaining triples.
+ */
+class LimitIteratorTripleString : public IteratorTripleString {
+private:
+	IteratorTripleString *iterator;
+	unsigned int offset, limit, count;
+	bool exhausted;
+
+public:
+	LimitIteratorTripleString(IteratorTripleString *iterator, unsigned int offset, unsigned int limit) :
+		iterator(iterator), offset(offset), limit(limit) {
+		goToStart();
+	}
+	virtual ~LimitIteratorTripleString() {
+		delete iterator;
+	}
+
+	bool hasNext() {
+		return !exhausted && (limit==0 || count<limit) && iterator->hasNext();
+	}
+	TripleString *next() {
+		count++;
+		return iterator->next();
+	}
+	void goToStart() {
+		count = 0;
+		exhausted = false;
+		if(offset>0 && iterator->canGoTo()) {
+			try {
+				iterator->goTo(offset);
+			} catch (const char *e) {
+				// Offset beyond the last triple
+				exhausted = true;
+			}
+		} else {
+			iterator->goToStart();
+			for(unsigned int i=0; i<offset && iterator->hasNext(); i++) {
+				iterator->next();
+			}
+		}
+	}
 };
 
 }
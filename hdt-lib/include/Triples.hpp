@@ -71,6 +71,21 @@ public:
 		return search(all);
 	}
 
+	/**
+	 * Draws k distinct triples matching the pattern uniformly at random (all of them
+	 * if there are less than k). The same seed always returns the same sample.
+	 *
+	 * If the iterator of the pattern knows the exact number of results and supports
+	 * goTo(), only the chosen positions are visited. Otherwise the results are
+	 * enumerated once with reservoir sampling and returned in no particular order.
+	 *
+	 * @param pattern
+	 * @param k Number of triples to draw.
+	 * @param seed
+	 * @return The sampled triples.
+	 */
+	virtual std::vector<TripleID> sample(TripleID &pattern, unsigned int k, unsigned int seed);
+
 	/**
 	 * Calculates the cost to retrieve a specific pattern
 	 *
@@ -44,6 +44,7 @@ SOURCES += \
     ../src/hdt/BasicModifiableHDT.hpp \
     ../src/util/StopWatch.cpp \
     ../src/util/propertyutil.cpp \
+    ../src/triples/Triples.cpp \
     ../src/triples/TriplesList.cpp \
     ../src/triples/TriplesComparator.cpp \
     ../src/triples/TripleOrderConvert.cpp \
@@ -62,14 +63,21 @@ SOURCES += \
     ../src/libdcs/CSD_PFC.cpp \
     ../src/libdcs/CSD_HTFC.cpp \
     ../src/libdcs/CSD_FMIndex.cpp \
+    ../src/libdcs/CSD_RePairDAC.cpp \
     ../src/libdcs/CSD_Cache2.cpp \
     ../src/libdcs/CSD_Cache.cpp \
+    ../src/libdcs/CSD_BlockCache.cpp \
+    ../src/libdcs/BloomFilter.cpp \
+    ../src/libdcs/MPHIndex.cpp \
     ../src/libdcs/fmindex/SuffixArray.cpp \
+    ../src/libdcs/fmindex/SAIS.cpp \
     ../src/libdcs/fmindex/SSA.cpp \
     ../src/dictionary/PlainDictionary.cpp \
     ../src/dictionary/FourSectionDictionary.cpp \
     ../src/dictionary/KyotoDictionary.cpp \
     ../src/dictionary/LiteralDictionary.cpp \
+    ../src/dictionary/LiteralRangeIndex.cpp \
+    ../src/dictionary/LiteralTagIndex.cpp \
     ../src/rdf/RDFParserNtriples.cpp \
     ../src/rdf/RDFParser.cpp \
     ../src/rdf/RDFSerializerNTriples.cpp \
@@ -87,6 +95,8 @@ SOURCES += \
     ../src/sparql/SortBinding.cpp \
     ../src/sequence/WaveletSequence.cpp \
     ../src/sequence/LogSequence2.cpp \
+    ../src/sequence/EliasFanoSequence.cpp \
+    ../src/sequence/DACSequence.cpp \
     ../src/sequence/LogSequence.cpp \
     ../src/sequence/IntSequence.cpp \
     ../src/sequence/HuffmanSequence.cpp \
@@ -96,6 +106,8 @@ SOURCES += \
     ../src/hdt/BasicModifiableHDT.cpp \
     ../src/sparql/QueryProcessor.cpp \
     ../src/bitsequence/BitSequence375.cpp \
+    ../src/bitsequence/BitSequenceRank9.cpp \
+    ../src/bitsequence/BitSeq.cpp \
     ../src/util/crc32.cpp \
     ../src/util/crc16.cpp \
     ../src/util/crc8.cpp \
@@ -127,6 +139,8 @@ HEADERS += \
     ../src/dictionary/KyotoDictionary.hpp \
     ../src/dictionary/FourSectionDictionary.hpp \
     ../src/dictionary/LiteralDictionary.hpp \
+    ../src/dictionary/LiteralRangeIndex.hpp \
+    ../src/dictionary/LiteralTagIndex.hpp \
     ../src/triples/TriplesList.hpp \
     ../src/triples/TriplesComparator.hpp \
     ../src/triples/TripleOrderConvert.hpp \
@@ -135,6 +149,7 @@ HEADERS += \
     ../src/triples/PlainTriples.hpp \
     ../src/triples/CompactTriples.hpp \
     ../src/triples/BitmapTriples.hpp \
+    ../src/triples/BitmapTriplesScanIterator.hpp \
     ../src/triples/TriplesKyoto.hpp \
     ../src/huffman/Huffman.h \
     ../src/huffman/huff.h \
@@ -144,9 +159,15 @@ HEADERS += \
     ../src/libdcs/CSD_PFC.h \
     ../src/libdcs/CSD_HTFC.h \
     ../src/libdcs/CSD_FMIndex.h \
+    ../src/libdcs/CSD_RePairDAC.h \
     ../src/libdcs/CSD_Cache2.h \
     ../src/libdcs/CSD_Cache.h \
+    ../src/libdcs/CSD_BlockCache.h \
+    ../src/libdcs/BloomFilter.h \
+    ../src/libdcs/MurmurHash.h \
+    ../src/libdcs/MPHIndex.h \
     ../src/libdcs/fmindex/SuffixArray.h \
+    ../src/libdcs/fmindex/SAIS.h \
     ../src/libdcs/fmindex/SSA.h \
     ../src/rdf/RDFParserNtriples.hpp \
     ../src/rdf/RDFSerializerNTriples.hpp \
@@ -162,9 +183,13 @@ HEADERS += \
     ../src/sparql/CachedBinding.hpp \
     ../src/sparql/BaseJoinBinding.hpp \
     ../src/sparql/VarFilterBinding.hpp \
+    ../src/sparql/VarRangeFilterBinding.hpp \
+    ../src/sparql/VarTagFilterBinding.hpp \
     ../src/sparql/SortBinding.hpp \
     ../src/sequence/WaveletSequence.hpp \
     ../src/sequence/LogSequence2.hpp \
+    ../src/sequence/EliasFanoSequence.hpp \
+    ../src/sequence/DACSequence.hpp \
     ../src/sequence/LogSequence.hpp \
     ../src/sequence/IntSequence.hpp \
     ../src/sequence/HuffmanSequence.hpp \
@@ -178,6 +203,7 @@ HEADERS += \
     ../src/util/propertyutil.h \
     ../src/util/Histogram.h \
     ../src/bitsequence/BitSequence375.h \
+    ../src/bitsequence/BitSequenceRank9.h \
     ../src/bitsequence/BitSeq.h \
     ../src/util/crc32.h \
     ../src/util/crc16.h \
@@ -0,0 +1,55 @@
+/* BitSeq.cpp
+ *
+ * Factory of bitmaps by type.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <HDTVocabulary.hpp>
+
+#include "BitSeq.h"
+#include "BitSequence375.h"
+#include "BitSequenceRank9.h"
+
+namespace hdt
+{
+
+BitSeq *BitSeq::getBitmap(std::string type)
+{
+	if(type==HDTVocabulary::BITMAP_TYPE_RANK9) {
+		return new BitSequenceRank9();
+	}
+	return new BitSequence375();
+}
+
+BitSeq *BitSeq::getBitmap(unsigned char type)
+{
+	if(type==BITMAP_TYPE_RANK9) {
+		return new BitSequenceRank9();
+	}
+	return new BitSequence375();
+}
+
+BitSeq *BitSeq::load(istream & in)
+{
+	unsigned char type = (unsigned char)in.peek();
+	if(type==BITMAP_TYPE_RANK9) {
+		return BitSequenceRank9::load(in);
+	}
+	return BitSequence375::load(in);
+}
+
+}
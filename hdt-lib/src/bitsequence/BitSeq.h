@@ -31,6 +31,12 @@ using namespace std;
 namespace hdt
 {
 
+/** Type byte at the start of each serialized bitmap. */
+enum BitmapType {
+	BITMAP_TYPE_PLAIN=1,
+	BITMAP_TYPE_RANK9,
+};
+
 class BitSeq
 {
 
@@ -84,9 +90,21 @@ public:
 	/** Load the data structure from a memory region */
     virtual size_t load(const unsigned char *ptr, const unsigned char*maxPtr, ProgressListener *listener=NULL)=0;
 
+	/** Sets the i-th bit, growing the bitmap if needed */
+	virtual void set(const size_t i, bool val)=0;
+
+	/** Appends a bit at the end of the bitmap */
+	virtual void append(bool bit)=0;
+
 	/** Reads a bitmap determining the type */
 	static BitSeq * load(istream & fp);
 
+	/** Creates an empty bitmap given its HDTVocabulary type, BitSequence375 by default */
+	static BitSeq *getBitmap(std::string type);
+
+	/** Creates an empty bitmap given the type byte of its serialized form */
+	static BitSeq *getBitmap(unsigned char type);
+
 };
 
 };
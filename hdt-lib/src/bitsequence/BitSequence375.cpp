@@ -36,20 +36,20 @@ namespace hdt
 {
 
 
-BitSequence375::BitSequence375(): numbits(0), numones(0), numwords(0), indexReady(false), isMapped(false)
+BitSequence375::BitSequence375(): numbits(0), numones(0), numwords(0), selectSampling(DEFAULT_SELECT_SAMPLING), indexReady(false), isMapped(false)
 {
     data.resize(1); //Ensure valid pointer.
     array = &data[0];
 }
 
-BitSequence375::BitSequence375(uint64_t capacity): numbits(0), numones(0), indexReady(false), isMapped(false)
+BitSequence375::BitSequence375(uint64_t capacity): numbits(0), numones(0), selectSampling(DEFAULT_SELECT_SAMPLING), indexReady(false), isMapped(false)
 {
     numwords = numWords(numbits);
     data.resize(numwords>0?numwords:1);
     array = &data[0];
 }
 
-BitSequence375::BitSequence375(uint32_t *bitarray, uint64_t n) : numbits(n), indexReady(false), isMapped(false)
+BitSequence375::BitSequence375(uint32_t *bitarray, uint64_t n) : numbits(n), selectSampling(DEFAULT_SELECT_SAMPLING), indexReady(false), isMapped(false)
 {
     numwords = numWords(numbits);
     data.resize(numwords>0?numwords:1);
@@ -103,15 +103,64 @@ void BitSequence375::buildIndex()
 		}
 
 		blocks[blockIndex] = blockPop;
-		blockPop += popcount32(array[blockIndex]);
+		uint32_t word = array[blockIndex];
+		if(blockIndex==numwords-1 && (numbits & 0x1F)) {
+			// Mapped bitmaps are followed by the CRC, ignore the bits after the end.
+			word &= (1u << (numbits & 0x1F)) - 1;
+		}
+		blockPop += popcount32(word);
 		blockIndex++;
 	}
 
 	numones = superBlockPop+blockPop;
 
+	buildSelectSamples();
+
 	indexReady=true;
 }
 
+void BitSequence375::buildSelectSamples()
+{
+	selectSamples1.clear();
+	selectSamples0.clear();
+	if(selectSampling==0) {
+		return;
+	}
+
+	uint32_t numsuper = superblocks.size();
+	uint64_t numzeros = numbits-numones;
+
+	// For each sample, the last superblock with less than k*selectSampling+1 ones before it.
+	uint32_t sb=0;
+	for(uint64_t target=1; target<=numones; target+=selectSampling) {
+		while(sb+1<numsuper && superblocks[sb+1]<target) {
+			sb++;
+		}
+		selectSamples1.push_back(sb);
+	}
+
+	sb=0;
+	for(uint64_t target=1; target<=numzeros; target+=selectSampling) {
+		while(sb+1<numsuper && ((sb+1)*256-superblocks[sb+1])<target) {
+			sb++;
+		}
+		selectSamples0.push_back(sb);
+	}
+}
+
+void BitSequence375::setSelectSampling(uint32_t rate)
+{
+	selectSampling = rate;
+	if(indexReady) {
+		buildSelectSamples();
+	}
+}
+
+uint32_t BitSequence375::getSelectSampling() const
+{
+	return selectSampling;
+}
+
 size_t BitSequence375::rank0(const size_t i) const
 {
 	return i+1-rank1(i);
@@ -167,11 +216,6 @@ void BitSequence375::append(bool bit) {
 	this->set(numbits, bit);
 }
 
-bool BitSequence375::access(const size_t i) const
-{
-	return array[i/WORDSIZE] & (1u << (i & 0x1F));
-}
-
 void BitSequence375::save(ostream & out) const
 {
 	CRC8 crch;
@@ -179,7 +223,7 @@ void BitSequence375::save(ostream & out) const
 	unsigned char arr[9];
 
 	// Write type
-	unsigned char type=TYPE_BITMAP_PLAIN;
+	unsigned char type=BITMAP_TYPE_PLAIN;
 	crch.writeData(out, &type, sizeof(type));
 
 	// Write NumBits
@@ -204,7 +248,7 @@ size_t BitSequence375::load(const unsigned char *ptr, const unsigned char *maxPt
 
     // Check type
 	CHECKPTR(&ptr[count], maxPtr, 1);
-    if(ptr[count++]!=TYPE_BITMAP_PLAIN) {
+    if(ptr[count++]!=BITMAP_TYPE_PLAIN) {
         throw "Trying to read a BitSequence375 but the type does not match";
     }
 
@@ -249,7 +293,7 @@ BitSequence375 * BitSequence375::load(istream & in)
 	// Read Type
 	unsigned char type;
 	in.read((char*)&type, sizeof(type));
-	if(type!=TYPE_BITMAP_PLAIN) {    // throw exception
+	if(type!=BITMAP_TYPE_PLAIN) {    // throw exception
         throw "Trying to read a BitmapPlain but the type does not match";
 	}
 	crch.update(&type, sizeof(type));
@@ -290,7 +334,8 @@ BitSequence375 * BitSequence375::load(istream & in)
 
 size_t BitSequence375::getSizeBytes() const
 {
-	return (this->numwords*sizeof(uint32_t)) + (sizeof(uint32_t)*superblocks.size()) + (sizeof(unsigned char)*blocks.size()) + (sizeof(BitSeq));
+	return (this->numwords*sizeof(uint32_t)) + (sizeof(uint32_t)*superblocks.size()) + (sizeof(unsigned char)*blocks.size())
+			+ (sizeof(uint32_t)*(selectSamples1.size()+selectSamples0.size())) + (sizeof(BitSeq));
 }
 
 size_t BitSequence375::selectPrev1(const size_t start) const
@@ -332,13 +377,7 @@ size_t BitSequence375::select1(const size_t x) const
 		return numbits;
 	}
 
-	uint32_t superBlockIndex = binsearch((uint32_t *)&superblocks[0],superblocks.size(),x);
-
-	// If there is a run of many zeros, two correlative superblocks may have the same value,
-	// We need to position at the first of them.
-	while(superBlockIndex>0 && (superblocks[superBlockIndex]>=x)) {
-		superBlockIndex--;
-	}
+	uint32_t superBlockIndex = select1Superblock(x);
 
 	uint32_t countdown = x-superblocks[superBlockIndex];
 	uint32_t blockIdx = superBlockIndex * BLOCKS_PER_SUPER;
@@ -368,16 +407,49 @@ size_t BitSequence375::select1(const size_t x) const
 	return blockIdx * WORDSIZE + bitpos - 1;
 }
 
+void BitSequence375::prefetchSelect1(const size_t x) const
+{
+#ifdef __GNUC__
+	if(!indexReady || x==0 || x>numones) {
+		return;
+	}
+	uint32_t first, last;
+	selectRange(selectSamples1, x, &first, &last);
+	// Without samples the search touches a few lines of a big range, do not bother.
+	if(last-first>64) {
+		return;
+	}
+	for(uint32_t i=first; i<=last; i+=16) {
+		__builtin_prefetch(&superblocks[i]);
+	}
+	__builtin_prefetch(&superblocks[last]);
+#endif
+}
+
+void BitSequence375::prefetchSelect1Block(const size_t x) const
+{
+#ifdef __GNUC__
+	if(!indexReady || x==0 || x>numones) {
+		return;
+	}
+	uint32_t superBlockIndex = select1Superblock(x);
+	__builtin_prefetch(&blocks[superBlockIndex*BLOCKS_PER_SUPER]);
+	__builtin_prefetch(&array[superBlockIndex*BLOCKS_PER_SUPER]);
+#endif
+}
+
 size_t BitSequence375::select0(const size_t x1) const
 {
 	if(!indexReady) {
 		(const_cast<BitSequence375 *>(this))->buildIndex();
 	}
-	uint32_t spos,bpos,pos,word,x;
+	uint32_t spos,bpos,pos,word;
 	const unsigned char *blk;
 	size_t j = x1;
 	if (j > (numbits-numones)) return numbits;
-	spos = binsearch0((uint32_t*)&superblocks[0],(numbits+256-1)/256,j);
+	uint32_t first, last;
+	selectRange(selectSamples0, j, &first, &last);
+	spos = binsearch0((uint32_t*)&superblocks[0],first,last+1,j);
 
 	j -= 256*spos-superblocks[spos];
 	pos = spos<<8;
@@ -391,18 +463,8 @@ size_t BitSequence375::select0(const size_t x1) const
 	word = array[pos>>5];
 	j -= (32*bpos)-blk[bpos];
 
-	while (1) 
-	{
-		x = 8-popcount8(word);
-
-		if (j <= x) break;
-		j -= x; pos += 8;
-		word >>= 8;
-	}
-
-	while (j) { if (!(word & 1)) j--; word >>= 1; pos++; }
-
-	return pos-1;
+	// Search zero inside block
+	return pos + wordSelect1(~word, (uint32_t)j) - 1;
 }
 
 size_t BitSequence375::getNumBits() const {
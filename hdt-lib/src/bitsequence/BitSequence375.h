@@ -31,11 +31,11 @@ namespace hdt
 class BitSequence375 : public BitSeq
 {
 private:
-	const static uint8_t TYPE_BITMAP_PLAIN = 1;
 	const static unsigned char WORDSIZE = 32;
 	const static unsigned char LOGWORDSIZE = 5;
 
 	const static unsigned char BLOCKS_PER_SUPER = 8;
+	const static uint32_t DEFAULT_SELECT_SAMPLING = 1024;
 
 	/** Length of the bitstring */
 	uint64_t numbits;
@@ -50,12 +50,16 @@ private:
 	vector<uint32_t> superblocks;	// superblock counters
 	vector<unsigned char> blocks;	// block counters
 
+	uint32_t selectSampling;		// one sample every selectSampling ones/zeros (0 = disabled)
+	vector<uint32_t> selectSamples1;	// superblock holding the (k*selectSampling+1)-th one
+	vector<uint32_t> selectSamples0;	// superblock holding the (k*selectSampling+1)-th zero
+
 	bool indexReady;
 
-	static uint32_t binsearch (uint32_t *data, uint32_t size, uint32_t val)
+	static uint32_t binsearch (uint32_t *data, uint32_t first, uint32_t size, uint32_t val)
 	{
 		uint32_t i,j,m;
-		i = 0; j = size;
+		i = first; j = size;
 
 		while (i+1 < j)
 		{ 
@@ -71,11 +75,11 @@ private:
 		return i;
 	}
 
-	static uint32_t binsearch0 (uint32_t *data, uint32_t size, uint32_t val)
+	static uint32_t binsearch0 (uint32_t *data, uint32_t first, uint32_t size, uint32_t val)
 	{
 		uint32_t i,j,m;
 		uint32_t zeros;
-		i = 0; j = size;
+		i = first; j = size;
 
 		while (i+1 < j)
 		{ 
@@ -98,6 +102,38 @@ private:
 	}
 
 	void buildIndex();
+	void buildSelectSamples();
+
+	/** Range [first, last] of superblocks where the x-th one/zero may be, according to the samples. */
+	inline void selectRange(const vector<uint32_t> &samples, size_t x, uint32_t *first, uint32_t *last) const {
+		*first = 0;
+		*last = superblocks.size()-1;
+		if(selectSampling==0 || x==0) {
+			return;
+		}
+		size_t s = (x-1)/selectSampling;
+		if(s<samples.size()) {
+			*first = samples[s];
+		}
+		if(s+1<samples.size()) {
+			*last = samples[s+1];
+		}
+	}
+
+	/** Superblock holding the x-th one, 0 < x <= numones */
+	inline uint32_t select1Superblock(size_t x) const {
+		// Narrow the superblock search using the select samples
+		uint32_t first, last;
+		selectRange(selectSamples1, x, &first, &last);
+		uint32_t superBlockIndex = binsearch((uint32_t *)&superblocks[0],first,last+1,x);
+
+		// If there is a run of many zeros, two correlative superblocks may have the same value,
+		// We need to position at the first of them.
+		while(superBlockIndex>0 && (superblocks[superBlockIndex]>=x)) {
+			superBlockIndex--;
+		}
+		return superBlockIndex;
+	}
 
 public:
 	BitSequence375();
@@ -105,19 +141,41 @@ public:
 	BitSequence375(uint32_t *bitarray, uint64_t numbits);
 	~BitSequence375();
 
-	bool access(const size_t i) const;
+	inline bool access(const size_t i) const {
+		return array[i>>LOGWORDSIZE] & (1u << (i & 0x1F));
+	}
 	size_t rank1(const size_t i) const;
 	size_t rank0(const size_t i) const;
 	size_t selectPrev1(const size_t start) const;
 	size_t selectNext1(const size_t start) const;
 	size_t select0(size_t x) const;
 	size_t select1(size_t x) const;
+
+	/**
+	 * Prefetch the superblock counters that select1(x) searches. Issued for many
+	 * x before calling prefetchSelect1Block() on them, and then select1(), the
+	 * cache misses of the selects overlap instead of being paid one after another.
+	 */
+	void prefetchSelect1(size_t x) const;
+
+	/**
+	 * Prefetch the block counters and the word that select1(x) reads. It searches
+	 * the superblock, so the counters should be prefetched by prefetchSelect1(x).
+	 */
+	void prefetchSelect1Block(size_t x) const;
 	size_t getNumBits() const;
 
 	size_t countOnes() const;
 	size_t countZeros() const;
 	size_t getSizeBytes() const;
 
+	/**
+	 * Sets the sampling rate of the select directory: one sample every rate ones (and zeros).
+	 * Lower values speed up select0/select1 at the cost of more memory, 0 disables it.
+	 */
+	void setSelectSampling(uint32_t rate);
+	uint32_t getSelectSampling() const;
+
 	void trimToSize();
 
 	// Additional:
@@ -0,0 +1,581 @@
+/* BitSequenceRank9.cpp
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "BitSequenceRank9.h"
+
+#include "../util/bitutil.h"
+#include "../libdcs/VByte.h"
+
+#include "../util/crc8.h"
+#include "../util/crc32.h"
+
+#ifdef __GNUC__
+#define lowest_bit_set64(a) __builtin_ctzll(a)
+#define highest_bit_set64(a) (63-__builtin_clzll(a))
+#else
+inline uint32_t lowest_bit_set64(uint64_t a) { uint32_t i=0; while(!(a&1)) { a>>=1; i++; } return i; }
+inline uint32_t highest_bit_set64(uint64_t a) { uint32_t i=0; while(a>>=1) { i++; } return i; }
+#endif
+
+#ifdef WIN32
+#include <malloc.h>
+#define aligned_free(a) _aligned_free(a)
+#else
+#define aligned_free(a) free(a)
+#endif
+
+namespace hdt
+{
+
+BitSequenceRank9::BitSequenceRank9() : numbits(0), numones(0), array(NULL), numblocks(0), capacity(0),
+		isMapped(false), indexReady(false), selectSampling(DEFAULT_SELECT_SAMPLING)
+{
+}
+
+BitSequenceRank9::BitSequenceRank9(uint64_t cap) : numbits(0), numones(0), array(NULL), numblocks(0), capacity(0),
+		isMapped(false), indexReady(false), selectSampling(DEFAULT_SELECT_SAMPLING)
+{
+	ensureCapacity(numBlocks(cap));
+}
+
+BitSequenceRank9::~BitSequenceRank9()
+{
+	if(!isMapped && array!=NULL) {
+		aligned_free(array);
+	}
+}
+
+void BitSequenceRank9::ensureCapacity(size_t blocks)
+{
+	if(blocks<=capacity) {
+		return;
+	}
+	if(isMapped) {
+		throw "This data structure is readonly when mapped.";
+	}
+
+	size_t newCapacity = capacity*2 > blocks ? capacity*2 : blocks;
+
+	// Align to cache line, so each block spans exactly one line.
+	size_t bytes = newCapacity*WORDS_PER_BLOCK*sizeof(uint64_t);
+	void *ptr;
+#ifdef WIN32
+	ptr = _aligned_malloc(bytes, WORDS_PER_BLOCK*sizeof(uint64_t));
+	if(ptr==NULL) {
+#else
+	if(posix_memalign(&ptr, WORDS_PER_BLOCK*sizeof(uint64_t), bytes)!=0) {
+#endif
+		throw "BitSequenceRank9 could not allocate memory";
+	}
+	uint64_t *newArray = (uint64_t *)ptr;
+	if(array!=NULL) {
+		memcpy(newArray, array, capacity*WORDS_PER_BLOCK*sizeof(uint64_t));
+		aligned_free(array);
+	}
+	memset(&newArray[capacity*WORDS_PER_BLOCK], 0, (newCapacity-capacity)*WORDS_PER_BLOCK*sizeof(uint64_t));
+
+	array = newArray;
+	capacity = newCapacity;
+}
+
+void BitSequenceRank9::buildIndex()
+{
+	if(indexReady) return;
+
+	static const unsigned char shift[7] = { 0, 13, 20, 28, 37, 46, 55 };
+
+	uint64_t ones=0;
+	superOnes.resize(numSuperBlocks(numblocks));
+	for(size_t b=0;b<numblocks;b++) {
+		if(b%BLOCKS_PER_SUPER==0) {
+			superOnes[b/BLOCKS_PER_SUPER] = ones;
+		}
+		uint64_t *block = &array[b*WORDS_PER_BLOCK];
+		uint64_t counter = ones - superOnes[b/BLOCKS_PER_SUPER];
+		uint32_t relative = 0;
+		for(uint32_t w=1;w<DATA_WORDS;w++) {
+			relative += popcount64(block[w]);
+			counter |= (uint64_t)relative << shift[w];
+		}
+		block[0] = counter;
+		ones += relative + popcount64(block[DATA_WORDS]);
+	}
+	numones = ones;
+
+	buildSelectSamples();
+
+	indexReady=true;
+}
+
+void BitSequenceRank9::buildSelectSamples()
+{
+	selectSamples1.clear();
+	selectSamples0.clear();
+	if(selectSampling==0) {
+		return;
+	}
+
+	// For each sample, the last block with less than k*selectSampling+1 ones before it.
+	size_t b=0;
+	for(uint64_t target=1; target<=numones; target+=selectSampling) {
+		while(b+1<numblocks && onesBefore(b+1)<target) {
+			b++;
+		}
+		selectSamples1.push_back(b);
+	}
+
+	b=0;
+	uint64_t numzeros = numbits-numones;
+	for(uint64_t target=1; target<=numzeros; target+=selectSampling) {
+		while(b+1<numblocks && zerosBefore(b+1)<target) {
+			b++;
+		}
+		selectSamples0.push_back(b);
+	}
+}
+
+void BitSequenceRank9::setSelectSampling(uint32_t rate)
+{
+	selectSampling = rate;
+	if(indexReady) {
+		buildSelectSamples();
+	}
+}
+
+void BitSequenceRank9::selectRange(const std::vector<size_t> &samples, size_t x, size_t *first, size_t *last) const
+{
+	*first = 0;
+	*last = numblocks-1;
+	if(selectSampling==0) {
+		return;
+	}
+	size_t s = (x-1)/selectSampling;
+	if(s<samples.size()) {
+		*first = samples[s];
+	}
+	if(s+1<samples.size()) {
+		*last = samples[s+1];
+	}
+}
+
+bool BitSequenceRank9::access(const size_t i) const
+{
+	size_t block = i/BITS_PER_BLOCK;
+	uint32_t offset = i%BITS_PER_BLOCK;
+	return (array[block*WORDS_PER_BLOCK+1+(offset>>6)] >> (offset & 0x3F)) & 1;
+}
+
+size_t BitSequenceRank9::rank1(const size_t pos) const
+{
+	if(!indexReady) {
+		(const_cast<BitSequenceRank9 *>(this))->buildIndex();
+	}
+
+	if(pos>=numbits) {
+		return numones;
+	}
+
+	size_t block = pos/BITS_PER_BLOCK;
+	uint32_t offset = pos%BITS_PER_BLOCK;
+	uint32_t word = offset>>6;
+	const uint64_t *ptr = &array[block*WORDS_PER_BLOCK];
+
+	uint64_t counter = ptr[0];
+	size_t rank = superOnes[block/BLOCKS_PER_SUPER] + (counter & SUPER_MASK) + relativeOnes(counter, word);
+	rank += popcount64(ptr[1+word] & (~0ULL >> (63-(offset & 0x3F))));
+
+	return rank;
+}
+
+size_t BitSequenceRank9::rank0(const size_t pos) const
+{
+	if(pos>=numbits) {
+		return countZeros();
+	}
+	return pos+1-rank1(pos);
+}
+
+size_t BitSequenceRank9::select1(const size_t x) const
+{
+	if(!indexReady) {
+		(const_cast<BitSequenceRank9 *>(this))->buildIndex();
+	}
+
+	if(x==0) {
+		return (size_t)-1;
+	}
+	if(x>numones) {
+		return numbits;
+	}
+
+	// Last block with less than x ones before it
+	size_t first, last;
+	selectRange(selectSamples1, x, &first, &last);
+	while(first<last) {
+		size_t mid = first+(last-first+1)/2;
+		if(onesBefore(mid)<x) {
+			first = mid;
+		} else {
+			last = mid-1;
+		}
+	}
+
+	const uint64_t *ptr = &array[first*WORDS_PER_BLOCK];
+	uint64_t counter = ptr[0];
+	uint64_t rem = x - onesBefore(first);
+
+	// Locate the word using the relative counters
+	uint32_t word=DATA_WORDS-1;
+	while(word>0 && relativeOnes(counter, word)>=rem) {
+		word--;
+	}
+	rem -= relativeOnes(counter, word);
+
+	return first*BITS_PER_BLOCK + word*64 + wordSelect1(ptr[1+word], rem) - 1;
+}
+
+size_t BitSequenceRank9::select0(const size_t x) const
+{
+	if(!indexReady) {
+		(const_cast<BitSequenceRank9 *>(this))->buildIndex();
+	}
+
+	if(x==0) {
+		return (size_t)-1;
+	}
+	if(x>numbits-numones) {
+		return numbits;
+	}
+
+	// Last block with less than x zeros before it
+	size_t first, last;
+	selectRange(selectSamples0, x, &first, &last);
+	while(first<last) {
+		size_t mid = first+(last-first+1)/2;
+		if(zerosBefore(mid)<x) {
+			first = mid;
+		} else {
+			last = mid-1;
+		}
+	}
+
+	const uint64_t *ptr = &array[first*WORDS_PER_BLOCK];
+	uint64_t counter = ptr[0];
+	uint64_t rem = x - zerosBefore(first);
+
+	uint32_t word=DATA_WORDS-1;
+	while(word>0 && (64*word-relativeOnes(counter, word))>=rem) {
+		word--;
+	}
+	rem -= 64*word-relativeOnes(counter, word);
+
+	return first*BITS_PER_BLOCK + word*64 + wordSelect1(~ptr[1+word], rem) - 1;
+}
+
+size_t BitSequenceRank9::selectNext1(const size_t start) const
+{
+	if(start>=numbits) {
+		return numbits;
+	}
+	size_t block = start/BITS_PER_BLOCK;
+	uint32_t offset = start%BITS_PER_BLOCK;
+	uint32_t word = offset>>6;
+
+	uint64_t value = array[block*WORDS_PER_BLOCK+1+word] & (~0ULL << (offset & 0x3F));
+	while(true) {
+		if(value!=0) {
+			return block*BITS_PER_BLOCK + word*64 + lowest_bit_set64(value);
+		}
+		if(++word==DATA_WORDS) {
+			word=0;
+			if(++block>=numblocks) {
+				return numbits;
+			}
+		}
+		value = array[block*WORDS_PER_BLOCK+1+word];
+	}
+}
+
+size_t BitSequenceRank9::selectPrev1(const size_t start) const
+{
+	if(numbits==0) {
+		return (size_t)-1;
+	}
+	size_t pos = start>=numbits ? numbits-1 : start;
+	size_t block = pos/BITS_PER_BLOCK;
+	uint32_t offset = pos%BITS_PER_BLOCK;
+	uint32_t word = offset>>6;
+
+	uint64_t value = array[block*WORDS_PER_BLOCK+1+word] & (~0ULL >> (63-(offset & 0x3F)));
+	while(true) {
+		if(value!=0) {
+			return block*BITS_PER_BLOCK + word*64 + highest_bit_set64(value);
+		}
+		if(word==0) {
+			if(block==0) {
+				return (size_t)-1;
+			}
+			block--;
+			word=DATA_WORDS;
+		}
+		word--;
+		value = array[block*WORDS_PER_BLOCK+1+word];
+	}
+}
+
+void BitSequenceRank9::set(const size_t i, bool val)
+{
+	if(isMapped) {
+		throw "This data structure is readonly when mapped.";
+	}
+
+	size_t block = i/BITS_PER_BLOCK;
+	uint32_t offset = i%BITS_PER_BLOCK;
+	ensureCapacity(block+1);
+
+	uint64_t *word = &array[block*WORDS_PER_BLOCK+1+(offset>>6)];
+	if(val) {
+		*word |= 1ULL << (offset & 0x3F);
+	} else {
+		*word &= ~(1ULL << (offset & 0x3F));
+	}
+
+	numbits = i>=numbits ? i+1 : numbits;
+	numblocks = numBlocks(numbits);
+	indexReady = false;
+}
+
+void BitSequenceRank9::append(bool bit)
+{
+	this->set(numbits, bit);
+}
+
+size_t BitSequenceRank9::getNumBits() const
+{
+	return numbits;
+}
+
+size_t BitSequenceRank9::countOnes() const
+{
+	if(!indexReady) {
+		(const_cast<BitSequenceRank9 *>(this))->buildIndex();
+	}
+	return numones;
+}
+
+size_t BitSequenceRank9::countZeros() const
+{
+	return numbits-countOnes();
+}
+
+size_t BitSequenceRank9::getSizeBytes() const
+{
+	return numblocks*WORDS_PER_BLOCK*sizeof(uint64_t) + superOnes.size()*sizeof(uint64_t)
+			+ (selectSamples1.size()+selectSamples0.size())*sizeof(size_t) + sizeof(BitSeq);
+}
+
+void BitSequenceRank9::save(ostream & out) const
+{
+	if(!indexReady) {
+		(const_cast<BitSequenceRank9 *>(this))->buildIndex();
+	}
+
+	CRC8 crch;
+	CRC32 crcd;
+	unsigned char arr[9];
+	std::streamoff start = out.tellp();
+
+	// Write type
+	unsigned char type=BITMAP_TYPE_RANK9;
+	crch.writeData(out, &type, sizeof(type));
+
+	// Write NumBits and NumOnes
+	size_t headerLen = 1;
+	size_t len = csd::VByte::encode(arr, numbits);
+	crch.writeData(out, arr, len);
+	headerLen += len;
+	len = csd::VByte::encode(arr, numones);
+	crch.writeData(out, arr, len);
+	headerLen += len;
+
+	// Padding after the header CRC, so that the blocks start at a multiple
+	// of the cache line in the file, and so in memory when it is mapped.
+	// If the stream has no position it is not padded.
+	unsigned char padding = 0;
+	if(start>=0) {
+		size_t dataStart = start+headerLen+2;
+		padding = (BLOCK_BYTES - dataStart%BLOCK_BYTES) % BLOCK_BYTES;
+	}
+	crch.writeData(out, &padding, 1);
+
+	// Write header CRC
+	crch.writeCRC(out);
+
+	const char zeros[BLOCK_BYTES] = { 0 };
+	out.write(zeros, padding);
+
+	// Write blocks, counters included, and the superblock counters
+	crcd.writeData(out, (unsigned char*)&array[0], numblocks*WORDS_PER_BLOCK*sizeof(uint64_t));
+	if(superOnes.size()>0) {
+		crcd.writeData(out, (unsigned char*)&superOnes[0], superOnes.size()*sizeof(uint64_t));
+	}
+	crcd.writeCRC(out);
+}
+
+#define CHECKPTR(base, max, size) if(((base)+(size))>(max)) throw "Could not read completely the HDT from the file.";
+
+size_t BitSequenceRank9::load(const unsigned char *ptr, const unsigned char *maxPtr, ProgressListener *listener)
+{
+	size_t count=0;
+
+	// Check type
+	CHECKPTR(&ptr[count], maxPtr, 1);
+	if(ptr[count++]!=BITMAP_TYPE_RANK9) {
+		throw "Trying to read a BitSequenceRank9 but the type does not match";
+	}
+
+	// Read numbits, numones and padding
+	count += csd::VByte::decode(&ptr[count], maxPtr, &numbits);
+	count += csd::VByte::decode(&ptr[count], maxPtr, &numones);
+	CHECKPTR(&ptr[count], maxPtr, 1);
+	unsigned char padding = ptr[count++];
+
+	// CRC
+	CRC8 crch;
+	crch.update(&ptr[0], count);
+	CHECKPTR(&ptr[count], maxPtr, 1);
+	if(ptr[count++]!=crch.getValue()) {
+		throw "Wrong checksum in BitSequenceRank9 Header.";
+	}
+	CHECKPTR(&ptr[count], maxPtr, padding);
+	count += padding;
+
+	if(!isMapped && array!=NULL) {
+		aligned_free(array);
+	}
+	array = NULL;
+	capacity = 0;
+	isMapped = false;
+	numblocks = numBlocks(numbits);
+	size_t sizeBytes = numblocks*WORDS_PER_BLOCK*sizeof(uint64_t);
+	CHECKPTR(&ptr[count], maxPtr, sizeBytes);
+	if(((uintptr_t)&ptr[count]) % BLOCK_BYTES == 0) {
+		// Map blocks
+		array = (uint64_t *) &ptr[count];
+		capacity = numblocks;
+		isMapped = true;
+	} else {
+		// Written without padding, or to a buffer not aligned to the cache
+		// line. Copy the blocks so each one still spans a single line.
+		ensureCapacity(numblocks);
+		memcpy(array, &ptr[count], sizeBytes);
+	}
+	count += sizeBytes;
+
+	size_t superBytes = numSuperBlocks(numblocks)*sizeof(uint64_t);
+	CHECKPTR(&ptr[count], maxPtr, superBytes);
+	superOnes.resize(numSuperBlocks(numblocks));
+	if(superBytes>0) {
+		memcpy(&superOnes[0], &ptr[count], superBytes);
+	}
+	count += superBytes;
+
+	CHECKPTR(&ptr[count], maxPtr, 4);
+	count += 4; // CRC of data
+
+	// Counters come from the file, only the select samples are built.
+	buildSelectSamples();
+	indexReady = true;
+
+	return count;
+}
+
+BitSequenceRank9 * BitSequenceRank9::load(istream & in)
+{
+	CRC8 crch;
+	CRC32 crcd;
+	unsigned char arr[9];
+
+	// Read Type
+	unsigned char type;
+	in.read((char*)&type, sizeof(type));
+	if(type!=BITMAP_TYPE_RANK9) {
+		throw "Trying to read a BitSequenceRank9 but the type does not match";
+	}
+	crch.update(&type, sizeof(type));
+
+	BitSequenceRank9 * ret = new BitSequenceRank9();
+
+	// Load number of total bits and ones
+	ret->numbits = csd::VByte::decode(in);
+	size_t len = csd::VByte::encode(arr, ret->numbits);
+	crch.update(arr,len);
+
+	ret->numones = csd::VByte::decode(in);
+	len = csd::VByte::encode(arr, ret->numones);
+	crch.update(arr,len);
+
+	unsigned char padding;
+	in.read((char*)&padding, 1);
+	crch.update(&padding, 1);
+
+	crc8_t filecrch = crc8_read(in);
+	if(filecrch!=crch.getValue()) {
+		delete ret;
+		throw "Wrong checksum in BitSequenceRank9 Header.";
+	}
+	in.ignore(padding);
+
+	// Read blocks
+	ret->ensureCapacity(ret->numBlocks(ret->numbits));
+	ret->numblocks = ret->numBlocks(ret->numbits);
+	size_t bytes = ret->numblocks*WORDS_PER_BLOCK*sizeof(uint64_t);
+	in.read((char*)&ret->array[0], bytes);
+	if(in.gcount()!=bytes) {
+		delete ret;
+		throw "BitSequenceRank9 error reading array of bits.";
+	}
+
+	crcd.update((unsigned char*)&ret->array[0], bytes);
+
+	ret->superOnes.resize(ret->numSuperBlocks(ret->numblocks));
+	if(ret->superOnes.size()>0) {
+		size_t superBytes = ret->superOnes.size()*sizeof(uint64_t);
+		in.read((char*)&ret->superOnes[0], superBytes);
+		if(in.gcount()!=superBytes) {
+			delete ret;
+			throw "BitSequenceRank9 error reading superblock counters.";
+		}
+		crcd.update((unsigned char*)&ret->superOnes[0], superBytes);
+	}
+
+	crc32_t filecrcd = crc32_read(in);
+	if(filecrcd!=crcd.getValue()) {
+		delete ret;
+		throw "Wrong checksum in BitSequenceRank9 Data.";
+	}
+
+	ret->buildSelectSamples();
+	ret->indexReady = true;
+	return ret;
+}
+
+}
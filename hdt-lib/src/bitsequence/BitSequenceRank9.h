@@ -0,0 +1,142 @@
+/* BitSequenceRank9.h
+
+   Bitmap with rank/select directory interleaved with the data, so that
+   rank1() only touches one cache line.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+ */
+
+#ifndef _STATIC_BITSEQUENCE_RANK9_H
+#define _STATIC_BITSEQUENCE_RANK9_H
+
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+
+#include "BitSeq.h"
+
+namespace hdt
+{
+
+/**
+ * The bitmap is split in blocks of one cache line (8 words of 64 bits).
+ * The first word of each block is the counter, the remaining 7 words hold
+ * 448 bits of data. The counter stores the number of ones before the block
+ * since the start of its superblock of 16 blocks (13 bits) and, rank9-style,
+ * the number of ones of the block before each of the data words 1 to 6 (7,
+ * 8, 9, 9, 9 and 9 bits). The ones before each superblock are in a separate
+ * array, 8 bytes per 16 blocks, small enough to stay in the cache. So
+ * rank1() reads one cache line of the bitmap and does a single popcount.
+ *
+ * The blocks are serialized as is, so a mapped file needs no index rebuild.
+ * The header is padded so that the blocks start at a multiple of 64 bytes
+ * in the file, and so they stay aligned to the cache line when mapped.
+ */
+class BitSequenceRank9 : public BitSeq
+{
+private:
+	const static unsigned char WORDS_PER_BLOCK = 8;
+	const static size_t BLOCK_BYTES = 64;
+	const static unsigned char DATA_WORDS = 7;
+	const static uint32_t BITS_PER_BLOCK = 448;
+	const static uint32_t DEFAULT_SELECT_SAMPLING = 1024;
+
+	const static unsigned char BLOCKS_PER_SUPER = 16;
+	const static unsigned char SUPER_BITS = 13;
+	const static uint64_t SUPER_MASK = (1ULL<<13)-1;
+
+	/** Length of the bitstring */
+	uint64_t numbits;
+	uint64_t numones;
+
+	uint64_t *array;		// blocks of counter + data words
+	std::vector<uint64_t> superOnes;	// ones before each superblock
+	size_t numblocks;		// used blocks
+	size_t capacity;		// allocated blocks
+
+	bool isMapped;
+	bool indexReady;
+
+	uint32_t selectSampling;		// one sample every selectSampling ones/zeros (0 = disabled)
+	std::vector<size_t> selectSamples1;	// block holding the (k*selectSampling+1)-th one
+	std::vector<size_t> selectSamples0;	// block holding the (k*selectSampling+1)-th zero
+
+	inline uint64_t onesBefore(size_t block) const {
+		return superOnes[block/BLOCKS_PER_SUPER] + (array[block*WORDS_PER_BLOCK] & SUPER_MASK);
+	}
+
+	inline uint64_t zerosBefore(size_t block) const {
+		return (uint64_t)block*BITS_PER_BLOCK - onesBefore(block);
+	}
+
+	/** Ones of the block before data word w, for w in 0..6 */
+	static inline uint32_t relativeOnes(uint64_t counter, uint32_t w) {
+		// Branchless: w=0 has an empty mask.
+		static const unsigned char shift[7] = { 0, 13, 20, 28, 37, 46, 55 };
+		static const uint32_t mask[7] = { 0, 0x7F, 0xFF, 0x1FF, 0x1FF, 0x1FF, 0x1FF };
+		return (counter>>shift[w]) & mask[w];
+	}
+
+	inline size_t numSuperBlocks(size_t blocks) const {
+		return (blocks+BLOCKS_PER_SUPER-1)/BLOCKS_PER_SUPER;
+	}
+
+	inline size_t numBlocks(uint64_t bits) const {
+		return bits==0 ? 0 : ((bits-1)/BITS_PER_BLOCK)+1;
+	}
+
+	void ensureCapacity(size_t blocks);
+	void buildIndex();
+	void buildSelectSamples();
+	void selectRange(const std::vector<size_t> &samples, size_t x, size_t *first, size_t *last) const;
+
+public:
+	BitSequenceRank9();
+	BitSequenceRank9(uint64_t capacity);
+	~BitSequenceRank9();
+
+	bool access(const size_t i) const;
+	size_t rank1(const size_t i) const;
+	size_t rank0(const size_t i) const;
+	size_t selectPrev1(const size_t start) const;
+	size_t selectNext1(const size_t start) const;
+	size_t select0(size_t x) const;
+	size_t select1(size_t x) const;
+	size_t getNumBits() const;
+
+	size_t countOnes() const;
+	size_t countZeros() const;
+	size_t getSizeBytes() const;
+
+	/**
+	 * Sets the sampling rate of the select directory: one sample every rate ones (and zeros).
+	 * Lower values speed up select0/select1 at the cost of more memory, 0 disables it.
+	 */
+	void setSelectSampling(uint32_t rate);
+
+	// Additional:
+	void set(const size_t i, bool val);
+	void append(bool bit);
+
+	/*load-save functions*/
+	void save(ostream & f) const;
+	size_t load(const unsigned char *ptr, const unsigned char*maxPtr, ProgressListener *listener=NULL);
+
+	static BitSequenceRank9 * load(istream & f);
+};
+
+}
+#endif
@@ -33,13 +33,18 @@
 #include <HDTVocabulary.hpp>
 
 #include "../libdcs/CSD_PFC.h"
+#include "../libdcs/CSD_RePairDAC.h"
 #include "../libdcs/CSD_HTFC.h"
 #include "../libdcs/CSD_Cache.h"
 #include "../libdcs/CSD_Cache2.h"
+#include "../libdcs/CSD_BlockCache.h"
+#include "../util/StopWatch.hpp"
 
 namespace hdt {
 
-FourSectionDictionary::FourSectionDictionary() : blocksize(16)
+FourSectionDictionary::FourSectionDictionary() :
+	subjectsHash(NULL), predicatesHash(NULL), objectsHash(NULL), sharedHash(NULL),
+	subjectsBloom(NULL), predicatesBloom(NULL), objectsBloom(NULL), sharedBloom(NULL), blocksize(16)
 {
 	subjects = new csd::CSD_PFC();
 	predicates = new csd::CSD_PFC();
@@ -47,7 +52,9 @@ FourSectionDictionary::FourSectionDictionary() : blocksize(16)
 	shared = new csd::CSD_PFC();
 }
 
-FourSectionDictionary::FourSectionDictionary(HDTSpecification & spec) : blocksize(16)
+FourSectionDictionary::FourSectionDictionary(HDTSpecification & spec) :
+	subjectsHash(NULL), predicatesHash(NULL), objectsHash(NULL), sharedHash(NULL),
+	subjectsBloom(NULL), predicatesBloom(NULL), objectsBloom(NULL), sharedBloom(NULL), blocksize(16), spec(spec)
 {
 	subjects = new csd::CSD_PFC();
 	predicates = new csd::CSD_PFC();
@@ -66,13 +73,180 @@ FourSectionDictionary::~FourSectionDictionary()
 	delete predicates;
 	delete objects;
 	delete shared;
+	clearHashIndex();
+	clearBloomFilter();
 }
 
-csd::CSD *loadSection(IteratorUCharString *iterator, uint32_t blocksize, ProgressListener *listener) {
-	return new csd::CSD_PFC(iterator, blocksize, listener);
-	//return new csd::CSD_HTFC(iterator, blocksize, listener);
+std::string FourSectionDictionary::getSectionOption(const char *section, const char *option) {
+	std::string value = spec.get(std::string("dictionary.")+section+"."+option);
+	return value!="" ? value : spec.get(std::string("dictionary.")+option);
 }
 
+void FourSectionDictionary::applyHeadSampling(csd::CSD *csd, const char *section) {
+	std::string rate = getSectionOption(section, "headsampling");
+	csd::CSD_PFC *pfc = dynamic_cast<csd::CSD_PFC *>(csd);
+	if(rate!="" && pfc!=NULL) {
+		pfc->setHeadSampling(strtoul(rate.c_str(), NULL, 10));
+	}
+}
+
+csd::CSD *FourSectionDictionary::addBlockCache(csd::CSD *csd, const char *section) {
+	uint64_t budget = strtoull(getSectionOption(section, "cachesize").c_str(), NULL, 10);
+	if(budget==0) {
+		return csd;
+	}
+	std::string shards = spec.get("dictionary.cacheshards");
+	if(shards=="") {
+		return new csd::CSD_BlockCache(csd, budget);
+	}
+	return new csd::CSD_BlockCache(csd, budget, strtoul(shards.c_str(), NULL, 10));
+}
+
+void FourSectionDictionary::getCacheCounters(uint64_t *hits, uint64_t *misses) {
+	csd::CSD *sections[] = { shared, subjects, predicates, objects };
+	*hits = *misses = 0;
+	for(int i=0; i<4; i++) {
+		csd::CSD_BlockCache *cache = dynamic_cast<csd::CSD_BlockCache *>(sections[i]);
+		if(cache) {
+			*hits += cache->getHits();
+			*misses += cache->getMisses();
+		}
+	}
+}
+
+static csd::CSD *createSection(IteratorUCharString *iterator, const std::string &codec, uint32_t blocksize, ProgressListener *listener) {
+	if(codec=="" || codec=="pfc") {
+		return new csd::CSD_PFC(iterator, blocksize, listener);
+	} else if(codec=="htfc") {
+		return new csd::CSD_HTFC(iterator, blocksize, listener);
+	} else if(codec=="repairdac") {
+		return new csd::CSD_RePairDAC(iterator, blocksize, listener);
+	}
+	throw "Unknown codec of a dictionary section";
+}
+
+/** New iterator over the strings of a section of another dictionary. */
+static IteratorUCharString *getSectionStrings(Dictionary *other, const char *section) {
+	std::string name = section;
+	if(name=="subjects") {
+		return other->getSubjects();
+	} else if(name=="predicates") {
+		return other->getPredicates();
+	} else if(name=="objects") {
+		return other->getObjects();
+	}
+	return other->getShared();
+}
+
+/**
+ * Keeps runs of consecutive strings, so that front coding sees the real
+ * prefixes, spread over the whole section without knowing its length: when
+ * the sample is full, every other run is dropped and only half as many runs
+ * are taken from then on.
+ */
+static void sampleRuns(IteratorUCharString *iterator, std::vector<std::string> &sample) {
+	const size_t RUN = 1024, MAX_RUNS = 64;
+	size_t count=0, stride=1;
+	while(iterator->hasNext()) {
+		unsigned char *str = iterator->next();
+		size_t run = count/RUN;
+		if(count%RUN==0 && run%stride==0 && sample.size()==RUN*MAX_RUNS) {
+			size_t kept=0;
+			for(size_t r=0; r<MAX_RUNS; r+=2) {
+				for(size_t i=0; i<RUN; i++) {
+					sample[kept++].swap(sample[r*RUN+i]);
+				}
+			}
+			sample.resize(kept);
+			stride*=2;
+		}
+		if(run%stride==0) {
+			sample.push_back((char *)str);
+		}
+		iterator->freeStr(str);
+		count++;
+	}
+}
+
+/**
+ * Encodes the sample with each codec and returns the smallest one for the
+ * goal "size", the fastest to extract and locate for "speed", or otherwise
+ * the smallest one that is at most twice slower than the fastest.
+ */
+static std::string chooseCodec(std::vector<std::string> &sample, uint32_t blocksize, const std::string &goal) {
+	const size_t QUERIES = 2000;
+	if(sample.empty()) {
+		return "pfc";
+	}
+
+	const char *codecs[] = { "pfc", "htfc", "repairdac" };
+	const int numcodecs = 3;
+	uint64_t sizes[numcodecs], times[numcodecs];
+	std::string str;
+	for(int c=0; c<numcodecs; c++) {
+		VectorIteratorUCharString it(sample);
+		csd::CSD *csd = createSection(&it, codecs[c], blocksize, NULL);
+		sizes[c] = csd->getSize();
+
+		StopWatch st;
+		for(size_t i=0; i<QUERIES; i++) {
+			size_t id = (i*7919)%sample.size();
+			csd->extractString(id+1, str);
+			csd->locate((const unsigned char *)sample[id].c_str(), sample[id].length());
+		}
+		times[c] = st.stopReal();
+		delete csd;
+	}
+
+	int fastest = 0, smallest = 0;
+	for(int c=1; c<numcodecs; c++) {
+		if(times[c]<times[fastest]) {
+			fastest = c;
+		}
+		if(sizes[c]<sizes[smallest]) {
+			smallest = c;
+		}
+	}
+	if(goal=="size") {
+		return codecs[smallest];
+	} else if(goal=="speed") {
+		return codecs[fastest];
+	}
+	int best = fastest;
+	for(int c=0; c<numcodecs; c++) {
+		if(times[c]<=2*times[fastest] && sizes[c]<sizes[best]) {
+			best = c;
+		}
+	}
+	return codecs[best];
+}
+
+csd::CSD *FourSectionDictionary::loadSection(Dictionary *other, const char *section, ProgressListener *listener) {
+	std::string codec = getSectionOption(section, "codec");
+	if(codec!="" && codec!="pfc" && codec!="htfc" && codec!="repairdac" && codec!="auto") {
+		throw "Unknown codec of a dictionary section";
+	}
+	std::string blockSizeStr = getSectionOption(section, "blocksize");
+	uint32_t sectionBlocksize = blockSizeStr!="" ? atoi(blockSizeStr.c_str()) : blocksize;
+	if(sectionBlocksize==0) {
+		throw "The block size of a dictionary section must be positive";
+	}
+
+	IteratorUCharString *iterator;
+	if(codec=="auto") {
+		std::vector<std::string> sample;
+		iterator = getSectionStrings(other, section);
+		sampleRuns(iterator, sample);
+		delete iterator;
+		codec = chooseCodec(sample, sectionBlocksize, getSectionOption(section, "goal"));
+	}
+
+	iterator = getSectionStrings(other, section);
+	csd::CSD *csd = createSection(iterator, codec, sectionBlocksize, listener);
+	delete iterator;
+	applyHeadSampling(csd, section);
+	return csd;
+}
 
 std::string FourSectionDictionary::idToString(unsigned int id, TripleComponentRole position)
 {
@@ -94,6 +268,41 @@ std::string FourSectionDictionary::idToString(unsigned int id, TripleComponentRo
 	return string();
 }
 
+size_t FourSectionDictionary::extract(unsigned int id, TripleComponentRole position, char *buffer, size_t capacity)
+{
+	csd::CSD *section = getDictionarySection(id, position);
+	unsigned int localid = getLocalId(id, position);
+
+	if(localid<=section->getLength()) {
+		return section->extract(localid, (unsigned char *)buffer, capacity);
+	}
+	return 0;
+}
+
+void FourSectionDictionary::extractMany(const std::vector<unsigned int> &ids, TripleComponentRole position, std::vector<std::string> &out)
+{
+	out.resize(ids.size());
+
+	// Each run of IDs in the same section is decoded by the section at once.
+	std::vector<uint32_t> localIds;
+	std::vector<std::string> strings;
+	size_t begin=0;
+	while(begin<ids.size()) {
+		csd::CSD *section = getDictionarySection(ids[begin], position);
+		size_t end=begin;
+		localIds.clear();
+		while(end<ids.size() && getDictionarySection(ids[end], position)==section) {
+			localIds.push_back(getLocalId(ids[end], position));
+			end++;
+		}
+		section->extractMany(localIds, strings);
+		for(size_t i=begin;i<end;i++) {
+			out[i].swap(strings[i-begin]);
+		}
+		begin = end;
+	}
+}
+
 unsigned int FourSectionDictionary::stringToId(std::string &key, TripleComponentRole position)
 {
 	unsigned int ret;
@@ -104,37 +313,139 @@ unsigned int FourSectionDictionary::stringToId(std::string &key, TripleComponent
 
 	switch (position) {
 	case SUBJECT:
-		ret = shared->locate((const unsigned char *)key.c_str(), key.length());
+		ret = locate(shared, sharedHash, sharedBloom, key);
 		if( ret != 0) {
 			return getGlobalId(ret,SHARED_SUBJECT);
 		}
-		ret = subjects->locate((const unsigned char *)key.c_str(), key.length());
+		ret = locate(subjects, subjectsHash, subjectsBloom, key);
 		if(ret != 0) {
 			return getGlobalId(ret,NOT_SHARED_SUBJECT);
 		}
         return 0;
 	case PREDICATE:
-		ret = predicates->locate((const unsigned char *)key.c_str(), key.length());
+		ret = locate(predicates, predicatesHash, predicatesBloom, key);
 		if(ret!=0) {
 			return getGlobalId(ret, NOT_SHARED_PREDICATE);
 		}
         return 0;
 
 	case OBJECT:
-		ret = shared->locate((const unsigned char *)key.c_str(), key.length());
+		ret = locate(shared, sharedHash, sharedBloom, key);
 		if( ret != 0) {
 			return getGlobalId(ret,SHARED_OBJECT);
 		}
-		ret = objects->locate((const unsigned char *)key.c_str(), key.length());
-		if(ret != 0) {
-			return getGlobalId(ret,NOT_SHARED_OBJECT);
-		}
-		ret = objects->locate((const unsigned char *)key.c_str(), key.length());
+		ret = locate(objects, objectsHash, objectsBloom, key);
 		if(ret != 0) {
 			return getGlobalId(ret,NOT_SHARED_OBJECT);
 		}
         return 0;
 	}
+	return 0;
+}
+
+unsigned int FourSectionDictionary::locate(csd::CSD *section, csd::MPHIndex *hash, csd::BloomFilter *bloom, std::string &key)
+{
+	if(bloom!=NULL && !bloom->mayContain((const unsigned char *)key.c_str(), key.length())) {
+		return 0;
+	}
+	if(hash!=NULL) {
+		return hash->locate(section, (const unsigned char *)key.c_str(), key.length());
+	}
+	return section->locate((const unsigned char *)key.c_str(), key.length());
+}
+
+void FourSectionDictionary::stringToIds(std::vector<std::string> &strs, TripleComponentRole position, std::vector<unsigned int> &ids)
+{
+	ids.assign(strs.size(), 0);
+
+	switch (position) {
+	case SUBJECT:
+		locateMany(shared, sharedHash, sharedBloom, SHARED_SUBJECT, strs, ids);
+		locateMany(subjects, subjectsHash, subjectsBloom, NOT_SHARED_SUBJECT, strs, ids);
+		break;
+	case PREDICATE:
+		locateMany(predicates, predicatesHash, predicatesBloom, NOT_SHARED_PREDICATE, strs, ids);
+		break;
+	case OBJECT:
+		locateMany(shared, sharedHash, sharedBloom, SHARED_OBJECT, strs, ids);
+		locateMany(objects, objectsHash, objectsBloom, NOT_SHARED_OBJECT, strs, ids);
+		break;
+	}
+}
+
+void FourSectionDictionary::prefixRange(const std::string &prefix, TripleComponentRole position, std::vector<std::pair<unsigned int, unsigned int> > &ranges)
+{
+	ranges.clear();
+
+	switch (position) {
+	case SUBJECT:
+		addPrefixRange(shared, SHARED_SUBJECT, prefix, ranges);
+		addPrefixRange(subjects, NOT_SHARED_SUBJECT, prefix, ranges);
+		break;
+	case PREDICATE:
+		addPrefixRange(predicates, NOT_SHARED_PREDICATE, prefix, ranges);
+		break;
+	case OBJECT:
+		addPrefixRange(shared, SHARED_OBJECT, prefix, ranges);
+		addPrefixRange(objects, NOT_SHARED_OBJECT, prefix, ranges);
+		break;
+	}
+}
+
+/**
+ * Add the global IDs of the strings of the section that start with the prefix.
+ */
+void FourSectionDictionary::addPrefixRange(csd::CSD *section, DictionarySection position, const std::string &prefix, std::vector<std::pair<unsigned int, unsigned int> > &ranges)
+{
+	uint32_t begin, end;
+	section->prefixRange((const unsigned char *)prefix.c_str(), prefix.length(), &begin, &end);
+	if(begin<end) {
+		ranges.push_back(std::make_pair(getGlobalId(begin, position), getGlobalId(end-1, position)+1));
+	}
+}
+
+/**
+ * Locate in the section the strings that do not have an ID yet, and that
+ * pass its Bloom filter if it has one.
+ */
+void FourSectionDictionary::locateMany(csd::CSD *section, csd::MPHIndex *hash, csd::BloomFilter *bloom, DictionarySection position, std::vector<std::string> &strs, std::vector<unsigned int> &ids)
+{
+	// With a hash index each string is a single check, as in stringToId().
+	if(hash!=NULL) {
+		for(size_t i=0;i<strs.size();i++) {
+			if(ids[i]==0 && strs[i].length()!=0) {
+				uint32_t id = locate(section, hash, bloom, strs[i]);
+				if(id!=0) {
+					ids[i] = getGlobalId(id, position);
+				}
+			}
+		}
+		return;
+	}
+
+	// The section skips the strings whose local ID is not 0.
+	const uint32_t SKIP = (uint32_t)-1;
+	std::vector<uint32_t> localIds(strs.size(), 0);
+	bool search = false;
+	for(size_t i=0;i<strs.size();i++) {
+		if(ids[i]!=0 || strs[i].length()==0
+				|| (bloom!=NULL && !bloom->mayContain((const unsigned char *)strs[i].c_str(), strs[i].length()))) {
+			localIds[i] = SKIP;
+		} else {
+			search = true;
+		}
+	}
+	if(!search) {
+		return;
+	}
+
+	section->locateMany(strs, localIds);
+
+	for(size_t i=0;i<strs.size();i++) {
+		if(localIds[i]!=0 && localIds[i]!=SKIP) {
+			ids[i] = getGlobalId(localIds[i], position);
+		}
+	}
 }
 
 
@@ -146,6 +457,8 @@ void FourSectionDictionary::load(std::istream & input, ControlInformation & ci,
 	}
 	this->mapping = ci.getUint("mapping");
 	this->sizeStrings = ci.getUint("sizeStrings");
+	clearHashIndex();
+	clearBloomFilter();
 
 	IntermediateListener iListener(listener);
 
@@ -158,6 +471,8 @@ void FourSectionDictionary::load(std::istream & input, ControlInformation & ci,
 		throw "Could not read shared.";
 	}
 	//shared = new csd::CSD_Cache(shared);
+	applyHeadSampling(shared, "shared");
+	shared = addBlockCache(shared, "shared");
 
 	iListener.setRange(25,50);
 	iListener.notifyProgress(0, "Dictionary read subjects.");
@@ -168,6 +483,8 @@ void FourSectionDictionary::load(std::istream & input, ControlInformation & ci,
 		throw "Could not read subjects.";
 	}
 	//subjects = new csd::CSD_Cache(subjects);
+	applyHeadSampling(subjects, "subjects");
+	subjects = addBlockCache(subjects, "subjects");
 
 	iListener.setRange(50,75);
 	iListener.notifyProgress(0, "Dictionary read predicates.");
@@ -177,6 +494,7 @@ void FourSectionDictionary::load(std::istream & input, ControlInformation & ci,
 		predicates = new csd::CSD_PFC();
 		throw "Could not read predicates.";
 	}
+	applyHeadSampling(predicates, "predicates");
 	predicates = new csd::CSD_Cache2(predicates);
 
 	iListener.setRange(75,100);
@@ -188,6 +506,8 @@ void FourSectionDictionary::load(std::istream & input, ControlInformation & ci,
 		throw "Could not read objects.";
 	}
 	//objects = new csd::CSD_Cache(objects);
+	applyHeadSampling(objects, "objects");
+	objects = addBlockCache(objects, "objects");
 }
 
 size_t FourSectionDictionary::load(unsigned char *ptr, unsigned char *ptrMax, ProgressListener *listener)
@@ -200,6 +520,8 @@ size_t FourSectionDictionary::load(unsigned char *ptr, unsigned char *ptrMax, Pr
 
     this->mapping = ci.getUint("mapping");
     this->sizeStrings = ci.getUint("sizeStrings");
+    clearHashIndex();
+    clearBloomFilter();
 
     iListener.setRange(0,25);
     iListener.notifyProgress(0, "Dictionary read shared area.");
@@ -211,6 +533,8 @@ size_t FourSectionDictionary::load(unsigned char *ptr, unsigned char *ptrMax, Pr
     }
     count += shared->load(&ptr[count], ptrMax);
     //shared = new csd::CSD_Cache(shared);
+    applyHeadSampling(shared, "shared");
+    shared = addBlockCache(shared, "shared");
 
     iListener.setRange(25,50);
     iListener.notifyProgress(0, "Dictionary read subjects.");
@@ -222,6 +546,8 @@ size_t FourSectionDictionary::load(unsigned char *ptr, unsigned char *ptrMax, Pr
     }
     count += subjects->load(&ptr[count], ptrMax);
     //subjects = new csd::CSD_Cache(subjects);
+    applyHeadSampling(subjects, "subjects");
+    subjects = addBlockCache(subjects, "subjects");
 
     iListener.setRange(50,75);
     iListener.notifyProgress(0, "Dictionary read predicates.");
@@ -232,6 +558,7 @@ size_t FourSectionDictionary::load(unsigned char *ptr, unsigned char *ptrMax, Pr
         throw "Could not read predicates.";
     }
     count += predicates->load(&ptr[count], ptrMax);
+    applyHeadSampling(predicates, "predicates");
     predicates = new csd::CSD_Cache2(predicates);
 
     iListener.setRange(75,100);
@@ -244,6 +571,8 @@ size_t FourSectionDictionary::load(unsigned char *ptr, unsigned char *ptrMax, Pr
     }
     count += objects->load(&ptr[count], ptrMax);
     //objects = new csd::CSD_Cache(objects);
+    applyHeadSampling(objects, "objects");
+    objects = addBlockCache(objects, "objects");
 
     return count;
 }
@@ -251,36 +580,34 @@ size_t FourSectionDictionary::load(unsigned char *ptr, unsigned char *ptrMax, Pr
 
 void FourSectionDictionary::import(Dictionary *other, ProgressListener *listener) {
 
+	clearHashIndex();
+	clearBloomFilter();
 	try {
 		IntermediateListener iListener(listener);
 
 		NOTIFY(listener, "DictionaryPFC loading subjects", 0, 100);
 		iListener.setRange(0, 20);
-		IteratorUCharString *itSubj = other->getSubjects();
+		csd::CSD *newSubjects = loadSection(other, "subjects", &iListener);
 		delete subjects;
-		subjects = loadSection(itSubj, blocksize, &iListener);
-		delete itSubj;
+		subjects = newSubjects;
 
 		NOTIFY(listener, "DictionaryPFC loading predicates", 25, 30);
 		iListener.setRange(20, 21);
-		IteratorUCharString *itPred = other->getPredicates();
+		csd::CSD *newPredicates = loadSection(other, "predicates", &iListener);
 		delete predicates;
-		predicates = loadSection(itPred, blocksize, &iListener);
-		delete itPred;
+		predicates = newPredicates;
 
 		NOTIFY(listener, "DictionaryPFC loading objects", 30, 90);
 		iListener.setRange(21, 90);
-		IteratorUCharString *itObj = other->getObjects();
+		csd::CSD *newObjects = loadSection(other, "objects", &iListener);
 		delete objects;
-		objects = loadSection(itObj, blocksize, &iListener);
-		delete itObj;
+		objects = newObjects;
 
 		NOTIFY(listener, "DictionaryPFC loading shared", 90, 100);
 		iListener.setRange(90, 100);
-		IteratorUCharString *itShared = other->getShared();
+		csd::CSD *newShared = loadSection(other, "shared", &iListener);
 		delete shared;
-		shared = loadSection(itShared, blocksize, &iListener);
-		delete itShared;
+		shared = newShared;
 
 		this->sizeStrings = other->size();
 		this->mapping = other->getMapping();
@@ -297,6 +624,300 @@ void FourSectionDictionary::import(Dictionary *other, ProgressListener *listener
 	}
 }
 
+void FourSectionDictionary::generateHashIndex(ProgressListener *listener)
+{
+	clearHashIndex();
+	subjectsHash = new csd::MPHIndex();
+	predicatesHash = new csd::MPHIndex();
+	objectsHash = new csd::MPHIndex();
+	sharedHash = new csd::MPHIndex();
+
+	// Each section only reads its own CSD, so they can be built at the same time.
+	NOTIFY(listener, "Building dictionary hash index", 0, 100);
+	// One slot per section, so that the sections do not write the same variable.
+	const char *errors[4] = { NULL, NULL, NULL, NULL };
+#ifdef _OPENMP
+	#pragma omp parallel sections
+#endif
+	{
+#ifdef _OPENMP
+		#pragma omp section
+#endif
+		{
+			try { sharedHash->build(shared); } catch (const char *e) { errors[0] = e; }
+		}
+#ifdef _OPENMP
+		#pragma omp section
+#endif
+		{
+			try { subjectsHash->build(subjects); } catch (const char *e) { errors[1] = e; }
+		}
+#ifdef _OPENMP
+		#pragma omp section
+#endif
+		{
+			try { predicatesHash->build(predicates); } catch (const char *e) { errors[2] = e; }
+		}
+#ifdef _OPENMP
+		#pragma omp section
+#endif
+		{
+			try { objectsHash->build(objects); } catch (const char *e) { errors[3] = e; }
+		}
+	}
+	for(int i=0; i<4; i++) {
+		if(errors[i]!=NULL) {
+			clearHashIndex();
+			throw errors[i];
+		}
+	}
+}
+
+bool FourSectionDictionary::hasHashIndex()
+{
+	return sharedHash!=NULL;
+}
+
+void FourSectionDictionary::clearHashIndex()
+{
+	delete subjectsHash;
+	delete predicatesHash;
+	delete objectsHash;
+	delete sharedHash;
+	subjectsHash = predicatesHash = objectsHash = sharedHash = NULL;
+}
+
+void FourSectionDictionary::saveHashIndex(std::ostream &output, ControlInformation &ci, ProgressListener *listener)
+{
+	if(!hasHashIndex()) {
+		throw "The dictionary does not have a hash index to save.";
+	}
+	ci.clear();
+	ci.setType(INDEX);
+	ci.setFormat(HDTVocabulary::INDEX_TYPE_HASH);
+	ci.setUint("numShared", shared->getLength());
+	ci.setUint("numSubjects", subjects->getLength());
+	ci.setUint("numPredicates", predicates->getLength());
+	ci.setUint("numObjects", objects->getLength());
+	ci.save(output);
+
+	NOTIFY(listener, "Saving dictionary hash index", 0, 100);
+	sharedHash->save(output);
+	subjectsHash->save(output);
+	predicatesHash->save(output);
+	objectsHash->save(output);
+}
+
+/**
+ * Check that a hash index or Bloom filter of the given format belongs to the
+ * sections of this dictionary.
+ */
+static void checkSideIndex(ControlInformation &ci, const std::string &format, csd::CSD *shared, csd::CSD *subjects, csd::CSD *predicates, csd::CSD *objects)
+{
+	if(ci.getType()!=INDEX || ci.getFormat()!=format) {
+		throw format==HDTVocabulary::INDEX_TYPE_HASH ?
+				"Trying to read a dictionary hash index but the data is not a dictionary hash index." :
+				"Trying to read a dictionary Bloom filter but the data is not a dictionary Bloom filter.";
+	}
+	if(ci.getUint("numShared")!=shared->getLength() || ci.getUint("numSubjects")!=subjects->getLength()
+			|| ci.getUint("numPredicates")!=predicates->getLength() || ci.getUint("numObjects")!=objects->getLength()) {
+		throw format==HDTVocabulary::INDEX_TYPE_HASH ?
+				"The dictionary hash index does not belong to this dictionary." :
+				"The dictionary Bloom filter does not belong to this dictionary.";
+	}
+}
+
+void FourSectionDictionary::loadHashIndex(std::istream &input, ControlInformation &ci, ProgressListener *listener)
+{
+	checkSideIndex(ci, HDTVocabulary::INDEX_TYPE_HASH, shared, subjects, predicates, objects);
+
+	clearHashIndex();
+	subjectsHash = new csd::MPHIndex();
+	predicatesHash = new csd::MPHIndex();
+	objectsHash = new csd::MPHIndex();
+	sharedHash = new csd::MPHIndex();
+	try {
+		NOTIFY(listener, "Loading dictionary hash index", 0, 100);
+		sharedHash->load(input);
+		subjectsHash->load(input);
+		predicatesHash->load(input);
+		objectsHash->load(input);
+	} catch (const char *e) {
+		clearHashIndex();
+		throw e;
+	}
+}
+
+size_t FourSectionDictionary::loadHashIndex(unsigned char *ptr, unsigned char *ptrMax, ProgressListener *listener)
+{
+	size_t count=0;
+	ControlInformation ci;
+	count += ci.load(&ptr[count], ptrMax);
+	checkSideIndex(ci, HDTVocabulary::INDEX_TYPE_HASH, shared, subjects, predicates, objects);
+
+	clearHashIndex();
+	subjectsHash = new csd::MPHIndex();
+	predicatesHash = new csd::MPHIndex();
+	objectsHash = new csd::MPHIndex();
+	sharedHash = new csd::MPHIndex();
+	try {
+		NOTIFY(listener, "Loading dictionary hash index", 0, 100);
+		count += sharedHash->load(&ptr[count], ptrMax);
+		count += subjectsHash->load(&ptr[count], ptrMax);
+		count += predicatesHash->load(&ptr[count], ptrMax);
+		count += objectsHash->load(&ptr[count], ptrMax);
+	} catch (const char *e) {
+		clearHashIndex();
+		throw e;
+	}
+	return count;
+}
+
+void FourSectionDictionary::generateBloomFilter(uint32_t bitsPerString, ProgressListener *listener)
+{
+	clearBloomFilter();
+	subjectsBloom = new csd::BloomFilter();
+	predicatesBloom = new csd::BloomFilter();
+	objectsBloom = new csd::BloomFilter();
+	sharedBloom = new csd::BloomFilter();
+
+	NOTIFY(listener, "Building dictionary Bloom filter", 0, 100);
+	// One slot per section, so that the sections do not write the same variable.
+	const char *errors[4] = { NULL, NULL, NULL, NULL };
+#ifdef _OPENMP
+	#pragma omp parallel sections
+#endif
+	{
+#ifdef _OPENMP
+		#pragma omp section
+#endif
+		{
+			try { sharedBloom->build(shared, bitsPerString); } catch (const char *e) { errors[0] = e; }
+		}
+#ifdef _OPENMP
+		#pragma omp section
+#endif
+		{
+			try { subjectsBloom->build(subjects, bitsPerString); } catch (const char *e) { errors[1] = e; }
+		}
+#ifdef _OPENMP
+		#pragma omp section
+#endif
+		{
+			try { predicatesBloom->build(predicates, bitsPerString); } catch (const char *e) { errors[2] = e; }
+		}
+#ifdef _OPENMP
+		#pragma omp section
+#endif
+		{
+			try { objectsBloom->build(objects, bitsPerString); } catch (const char *e) { errors[3] = e; }
+		}
+	}
+	for(int i=0; i<4; i++) {
+		if(errors[i]!=NULL) {
+			clearBloomFilter();
+			throw errors[i];
+		}
+	}
+}
+
+bool FourSectionDictionary::hasBloomFilter()
+{
+	return sharedBloom!=NULL;
+}
+
+csd::BloomFilter *FourSectionDictionary::getBloomFilter(DictionarySection section)
+{
+	switch(section) {
+	case SHARED_SUBJECT:
+	case SHARED_OBJECT:
+		return sharedBloom;
+	case NOT_SHARED_SUBJECT:
+		return subjectsBloom;
+	case NOT_SHARED_PREDICATE:
+		return predicatesBloom;
+	case NOT_SHARED_OBJECT:
+		return objectsBloom;
+	}
+	return NULL;
+}
+
+void FourSectionDictionary::clearBloomFilter()
+{
+	delete subjectsBloom;
+	delete predicatesBloom;
+	delete objectsBloom;
+	delete sharedBloom;
+	subjectsBloom = predicatesBloom = objectsBloom = sharedBloom = NULL;
+}
+
+void FourSectionDictionary::saveBloomFilter(std::ostream &output, ControlInformation &ci, ProgressListener *listener)
+{
+	if(!hasBloomFilter()) {
+		throw "The dictionary does not have a Bloom filter to save.";
+	}
+	ci.clear();
+	ci.setType(INDEX);
+	ci.setFormat(HDTVocabulary::INDEX_TYPE_BLOOM);
+	ci.setUint("numShared", shared->getLength());
+	ci.setUint("numSubjects", subjects->getLength());
+	ci.setUint("numPredicates", predicates->getLength());
+	ci.setUint("numObjects", objects->getLength());
+	ci.save(output);
+
+	NOTIFY(listener, "Saving dictionary Bloom filter", 0, 100);
+	sharedBloom->save(output);
+	subjectsBloom->save(output);
+	predicatesBloom->save(output);
+	objectsBloom->save(output);
+}
+
+void FourSectionDictionary::loadBloomFilter(std::istream &input, ControlInformation &ci, ProgressListener *listener)
+{
+	checkSideIndex(ci, HDTVocabulary::INDEX_TYPE_BLOOM, shared, subjects, predicates, objects);
+
+	clearBloomFilter();
+	subjectsBloom = new csd::BloomFilter();
+	predicatesBloom = new csd::BloomFilter();
+	objectsBloom = new csd::BloomFilter();
+	sharedBloom = new csd::BloomFilter();
+	try {
+		NOTIFY(listener, "Loading dictionary Bloom filter", 0, 100);
+		sharedBloom->load(input);
+		subjectsBloom->load(input);
+		predicatesBloom->load(input);
+		objectsBloom->load(input);
+	} catch (const char *e) {
+		clearBloomFilter();
+		throw e;
+	}
+}
+
+size_t FourSectionDictionary::loadBloomFilter(unsigned char *ptr, unsigned char *ptrMax, ProgressListener *listener)
+{
+	size_t count=0;
+	ControlInformation ci;
+	count += ci.load(&ptr[count], ptrMax);
+	checkSideIndex(ci, HDTVocabulary::INDEX_TYPE_BLOOM, shared, subjects, predicates, objects);
+
+	clearBloomFilter();
+	subjectsBloom = new csd::BloomFilter();
+	predicatesBloom = new csd::BloomFilter();
+	objectsBloom = new csd::BloomFilter();
+	sharedBloom = new csd::BloomFilter();
+	try {
+		NOTIFY(listener, "Loading dictionary Bloom filter", 0, 100);
+		count += sharedBloom->load(&ptr[count], ptrMax);
+		count += subjectsBloom->load(&ptr[count], ptrMax);
+		count += predicatesBloom->load(&ptr[count], ptrMax);
+		count += objectsBloom->load(&ptr[count], ptrMax);
+	} catch (const char *e) {
+		clearBloomFilter();
+		throw e;
+	}
+	return count;
+}
+
 IteratorUCharString *FourSectionDictionary::getSubjects() {
 	return subjects->listAll();
 }
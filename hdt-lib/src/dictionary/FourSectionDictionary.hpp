@@ -37,6 +37,8 @@
 #include <Dictionary.hpp>
 
 #include "../libdcs/CSD.h"
+#include "../libdcs/MPHIndex.h"
+#include "../libdcs/BloomFilter.h"
 
 namespace hdt {
 
@@ -47,6 +49,17 @@ private:
 	csd::CSD *objects;
 	csd::CSD *shared;
 
+	// Optional minimal perfect hash of each section, used by stringToId().
+	csd::MPHIndex *subjectsHash;
+	csd::MPHIndex *predicatesHash;
+	csd::MPHIndex *objectsHash;
+	csd::MPHIndex *sharedHash;
+	// Optional Bloom filter of each section, that skips the search of most absent strings.
+	csd::BloomFilter *subjectsBloom;
+	csd::BloomFilter *predicatesBloom;
+	csd::BloomFilter *objectsBloom;
+	csd::BloomFilter *sharedBloom;
+
 	unsigned int mapping;
 	uint64_t sizeStrings;
 	uint32_t blocksize;
@@ -60,7 +73,11 @@ public:
 	~FourSectionDictionary();
 
 	std::string idToString(unsigned int id, TripleComponentRole position);
+	size_t extract(unsigned int id, TripleComponentRole position, char *buffer, size_t capacity);
+	void extractMany(const std::vector<unsigned int> &ids, TripleComponentRole position, std::vector<std::string> &out);
 	unsigned int stringToId(std::string &str, TripleComponentRole position);
+	void stringToIds(std::vector<std::string> &strs, TripleComponentRole position, std::vector<unsigned int> &ids);
+	void prefixRange(const std::string &prefix, TripleComponentRole position, std::vector<std::pair<unsigned int, unsigned int> > &ranges);
 
 	unsigned int getNumberOfElements();
 
@@ -94,8 +111,63 @@ public:
 
     void getSuggestions(const char *base, TripleComponentRole role, std::vector<string> &out, int maxResults);
 
+    /**
+     * Build a minimal perfect hash of each section, so that stringToId() checks
+     * a single candidate of each section instead of searching it. The sections
+     * are hashed in parallel. It is not part of the dictionary, it is saved and
+     * loaded separately with the methods below.
+     */
+    void generateHashIndex(ProgressListener *listener=NULL);
+    bool hasHashIndex();
+    void saveHashIndex(std::ostream &output, ControlInformation &ci, ProgressListener *listener=NULL);
+    void loadHashIndex(std::istream &input, ControlInformation &ci, ProgressListener *listener=NULL);
+    size_t loadHashIndex(unsigned char *ptr, unsigned char *ptrMax, ProgressListener *listener=NULL);
+
+    /**
+     * Build a Bloom filter of each section with bitsPerString bits per
+     * string, so that stringToId() and stringToIds() skip the sections that
+     * surely do not have a string. Like the hash index, it is saved and
+     * loaded separately.
+     */
+    void generateBloomFilter(uint32_t bitsPerString=csd::BloomFilter::DEFAULT_BITS_PER_STRING, ProgressListener *listener=NULL);
+    bool hasBloomFilter();
+    void saveBloomFilter(std::ostream &output, ControlInformation &ci, ProgressListener *listener=NULL);
+    void loadBloomFilter(std::istream &input, ControlInformation &ci, ProgressListener *listener=NULL);
+    size_t loadBloomFilter(unsigned char *ptr, unsigned char *ptrMax, ProgressListener *listener=NULL);
+
+    /** Bloom filter of a section, or NULL if there is none. */
+    csd::BloomFilter *getBloomFilter(DictionarySection section);
+
+    /**
+     * Hits and misses of the block caches of the sections, added. The cache
+     * of a section is created on load when the specification gives its
+     * budget in bytes with dictionary.<section>.cachesize or
+     * dictionary.cachesize, and dictionary.cacheshards sets the number of
+     * shards. The predicates are not cached by block.
+     */
+    void getCacheCounters(uint64_t *hits, uint64_t *misses);
+
 private:
+	void clearHashIndex();
+	void clearBloomFilter();
+	/** Option of a section, from dictionary.<section>.<option> or else dictionary.<option>. */
+	std::string getSectionOption(const char *section, const char *option);
+	/**
+	 * Builds a section from the same one of another dictionary with the
+	 * options codec: pfc (default), htfc, repairdac or auto; blocksize;
+	 * headsampling; and for auto, goal: size, speed or balanced (default). Auto reads the
+	 * strings twice, to sample them and then to build the section. Unknown
+	 * codecs throw.
+	 */
+	csd::CSD *loadSection(Dictionary *other, const char *section, ProgressListener *listener);
+	/** Builds the upper index of block heads of a PFC section if it has a headsampling. */
+	void applyHeadSampling(csd::CSD *csd, const char *section);
+	/** Wraps a loaded section with a CSD_BlockCache if it has a cachesize. */
+	csd::CSD *addBlockCache(csd::CSD *csd, const char *section);
+	unsigned int locate(csd::CSD *section, csd::MPHIndex *hash, csd::BloomFilter *bloom, std::string &key);
 	csd::CSD *getDictionarySection(unsigned int id, TripleComponentRole position);
+	void locateMany(csd::CSD *section, csd::MPHIndex *hash, csd::BloomFilter *bloom, DictionarySection position, std::vector<std::string> &strs, std::vector<unsigned int> &ids);
+	void addPrefixRange(csd::CSD *section, DictionarySection position, const std::string &prefix, std::vector<std::pair<unsigned int, unsigned int> > &ranges);
 	unsigned int getGlobalId(unsigned int mapping, unsigned int id, DictionarySection position);
 	unsigned int getGlobalId(unsigned int id, DictionarySection position);
 	unsigned int getLocalId(unsigned int mapping, unsigned int id, TripleComponentRole position);
@@ -99,6 +99,17 @@ std::string LiteralDictionary::idToString(unsigned int id, TripleComponentRole p
 	return string();
 }
 
+size_t LiteralDictionary::extract(unsigned int id, TripleComponentRole position, char *buffer, size_t capacity)
+{
+	csd::CSD *section = getDictionarySection(id, position);
+	unsigned int localid = getLocalId(id, position);
+
+	if(localid<=section->getLength()) {
+		return section->extract(localid, (unsigned char *)buffer, capacity);
+	}
+	return 0;
+}
+
 unsigned int LiteralDictionary::stringToId(std::string &key, TripleComponentRole position) {
 	unsigned int ret;
 
@@ -401,20 +412,21 @@ IteratorUCharString *LiteralDictionary::getShared() {
 	throw "Not implemented";
 }
 
+csd::CSD_FMIndex *LiteralDictionary::getLiteralsIndex() {
+	csd::CSD_Cache *cache = dynamic_cast<csd::CSD_Cache *>(objectsLiterals);
+	if(cache!=NULL) {
+		return dynamic_cast<csd::CSD_FMIndex  *>(cache->getChild());
+	}
+	return dynamic_cast<csd::CSD_FMIndex  *>(objectsLiterals);
+}
+
 uint32_t LiteralDictionary::substringToId(unsigned char *s, uint32_t len, uint32_t **occs){
 
 	if(len==0) {
 		return 0;
 	}
 
-	csd::CSD_FMIndex *fmIndex=NULL;
-
-	csd::CSD_Cache *cache = dynamic_cast<csd::CSD_Cache *>(objectsLiterals);
-	if(cache!=NULL) {
-		fmIndex = dynamic_cast<csd::CSD_FMIndex  *>(cache->getChild());
-	} else {
-		fmIndex = dynamic_cast<csd::CSD_FMIndex  *>(objectsLiterals);
-	}
+	csd::CSD_FMIndex *fmIndex=getLiteralsIndex();
 
 	if(fmIndex!=NULL) {
 		uint32_t ret = fmIndex->locate_substring(s,len,occs);
@@ -428,6 +440,28 @@ uint32_t LiteralDictionary::substringToId(unsigned char *s, uint32_t len, uint32
 	return 0;
 }
 
+IteratorUInt *LiteralDictionary::substringToIds(unsigned char *s, uint32_t len){
+
+	csd::CSD_FMIndex *fmIndex=getLiteralsIndex();
+
+	if(fmIndex==NULL) {
+		cerr << "Warning, trying to call LiteralDictionary::substringToIds() but it was not an FM-Index.";
+		return new IteratorUInt();
+	}
+	return new LiteralSubstringIterator(this, fmIndex->iterate_substring(s, len));
+}
+
+uint32_t LiteralDictionary::substringCount(unsigned char *s, uint32_t len){
+
+	csd::CSD_FMIndex *fmIndex=getLiteralsIndex();
+
+	if(fmIndex==NULL) {
+		cerr << "Warning, trying to call LiteralDictionary::substringCount() but it was not an FM-Index.";
+		return 0;
+	}
+	return fmIndex->count_substring(s, len);
+}
+
 void LiteralDictionary::save(std::ostream & output,	ControlInformation & controlInformation, ProgressListener *listener) {
 	controlInformation.setFormat(HDTVocabulary::DICTIONARY_TYPE_LITERAL);
 
@@ -662,6 +696,38 @@ unsigned int LiteralDictionary::getLocalId(unsigned int id, TripleComponentRole
 	return getLocalId(mapping, id, position);
 }
 
+void LiteralDictionary::prefixRange(const std::string &prefix, TripleComponentRole role, std::vector<std::pair<unsigned int, unsigned int> > &ranges) {
+	ranges.clear();
+
+	switch (role) {
+	case SUBJECT:
+		addPrefixRange(shared, getGlobalId(0, SHARED_SUBJECT), prefix, ranges);
+		addPrefixRange(subjects, getGlobalId(0, NOT_SHARED_SUBJECT), prefix, ranges);
+		break;
+	case PREDICATE:
+		addPrefixRange(predicates, getGlobalId(0, NOT_SHARED_PREDICATE), prefix, ranges);
+		break;
+	case OBJECT:
+		// The literals go before the other objects that are not shared.
+		addPrefixRange(shared, getGlobalId(0, SHARED_OBJECT), prefix, ranges);
+		addPrefixRange(objectsLiterals, getGlobalId(0, NOT_SHARED_OBJECT), prefix, ranges);
+		addPrefixRange(objectsNotLiterals, getGlobalId(0, NOT_SHARED_OBJECT)+objectsLiterals->getLength(), prefix, ranges);
+		break;
+	}
+}
+
+/**
+ * Add the IDs of the strings of the section that start with the prefix,
+ * offset is the global ID before the first string of the section.
+ */
+void LiteralDictionary::addPrefixRange(csd::CSD *section, unsigned int offset, const std::string &prefix, std::vector<std::pair<unsigned int, unsigned int> > &ranges) {
+	uint32_t begin, end;
+	section->prefixRange((const unsigned char *)prefix.c_str(), prefix.length(), &begin, &end);
+	if(begin<end) {
+		ranges.push_back(std::make_pair(offset+begin, offset+end));
+	}
+}
+
 void LiteralDictionary::getSuggestions(const char *base, hdt::TripleComponentRole role, std::vector<std::string> &out, int maxResults) {
 	if (role == PREDICATE) {
 		predicates->fillSuggestions(base, out, maxResults);
@@ -37,6 +37,11 @@
 #include <HDTSpecification.hpp>
 
 #include "../libdcs/CSD.h"
+#include "../sequence/IntSequence.hpp"
+
+namespace csd {
+class CSD_FMIndex;
+}
 
 namespace hdt {
 
@@ -61,6 +66,7 @@ public:
 	~LiteralDictionary();
 
 	std::string idToString(unsigned int id, TripleComponentRole position);
+	size_t extract(unsigned int id, TripleComponentRole position, char *buffer, size_t capacity);
 	unsigned int stringToId(std::string &str, TripleComponentRole position);
 
 	/** Returns the number of IDs that contain s[1,..len] as a substring. It also
@@ -71,6 +77,19 @@ public:
 	 * */
 	uint32_t substringToId(unsigned char *s, uint32_t len, uint32_t **occs);
 
+	/** Returns the distinct object IDs that contain s[1,..len] as a substring,
+	 *  one at a time and in no particular order, so that the first ones are
+	 *  found without locating all the occurrences.
+	 *  @s: the substring to be located.
+	 *  @len: the length (in characters) of the string s.
+	 * */
+	IteratorUInt *substringToIds(unsigned char *s, uint32_t len);
+
+	/** Returns the number of occurrences of s[1,..len], without locating them.
+	 *  A literal that contains it several times is counted several times.
+	 * */
+	uint32_t substringCount(unsigned char *s, uint32_t len);
+
 	unsigned int getNumberOfElements();
 
     unsigned int size();
@@ -110,13 +129,41 @@ public:
 	unsigned int getMapping();
 
 	void getSuggestions(const char *base, TripleComponentRole role, std::vector<string> &out, int maxResults);
+	void prefixRange(const std::string &prefix, TripleComponentRole role, std::vector<std::pair<unsigned int, unsigned int> > &ranges);
 
 private:
+	csd::CSD_FMIndex *getLiteralsIndex();
 	csd::CSD *getDictionarySection(unsigned int id, TripleComponentRole position);
 	unsigned int getGlobalId(unsigned int mapping, unsigned int id, DictionarySection position);
 	unsigned int getGlobalId(unsigned int id, DictionarySection position);
+	void addPrefixRange(csd::CSD *section, unsigned int offset, const std::string &prefix, std::vector<std::pair<unsigned int, unsigned int> > &ranges);
 	unsigned int getLocalId(unsigned int mapping, unsigned int id, TripleComponentRole position);
 	unsigned int getLocalId(unsigned int id, TripleComponentRole position);
+
+	friend class LiteralSubstringIterator;
+};
+
+/**
+ * Converts the IDs of the literals section to object IDs.
+ */
+class LiteralSubstringIterator : public IteratorUInt {
+private:
+	LiteralDictionary *dict;
+	IteratorUInt *child;
+public:
+	LiteralSubstringIterator(LiteralDictionary *dict, IteratorUInt *child) : dict(dict), child(child) { }
+	virtual ~LiteralSubstringIterator() {
+		delete child;
+	}
+	bool hasNext() {
+		return child->hasNext();
+	}
+	unsigned int next() {
+		return dict->getGlobalId(child->next(), NOT_SHARED_OBJECT);
+	}
+	void goToStart() {
+		child->goToStart();
+	}
 };
 
 }
@@ -0,0 +1,349 @@
+/*
+ * File: LiteralRangeIndex.cpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+
+#include <stdlib.h>
+#include <algorithm>
+
+#include <HDTVocabulary.hpp>
+
+#include "LiteralRangeIndex.hpp"
+#include "../libdcs/VByte.h"
+#include "../util/crc32.h"
+
+namespace hdt {
+
+static const std::string XSD = "http://www.w3.org/2001/XMLSchema#";
+
+static const char *numericTypes[] = {
+	"integer", "decimal", "double", "float", "int", "long", "short", "byte",
+	"nonNegativeInteger", "nonPositiveInteger", "negativeInteger", "positiveInteger",
+	"unsignedLong", "unsignedInt", "unsignedShort", "unsignedByte", NULL
+};
+
+/** Days from 1970-01-01 to the given date of the proleptic Gregorian calendar */
+static long daysFromCivil(long year, int month, int day) {
+	year -= month<=2;
+	long era = (year>=0 ? year : year-399)/400;
+	long yearOfEra = year-era*400;
+	long dayOfYear = (153*(month>2 ? month-3 : month+9)+2)/5+day-1;
+	long dayOfEra = yearOfEra*365 + yearOfEra/4 - yearOfEra/100 + dayOfYear;
+	return era*146097 + dayOfEra - 719468;
+}
+
+/** Reads exactly digits decimal digits */
+static bool parseDigits(const char *&str, int digits, long *out) {
+	*out = 0;
+	for(int i=0;i<digits;i++) {
+		if(*str<'0' || *str>'9') {
+			return false;
+		}
+		*out = *out*10 + (*str++-'0');
+	}
+	return true;
+}
+
+/**
+ * Parses [-]YYYY-MM-DD[THH:MM:SS[.s+]][Z|(+|-)HH:MM] into seconds since the epoch.
+ */
+static bool parseDateTime(const char *str, bool withTime, double *value) {
+	bool negative = *str=='-';
+	if(negative) {
+		str++;
+	}
+	long year=0, month, day, hour=0, minute=0, second=0;
+	int yearDigits=0;
+	while(*str>='0' && *str<='9') {
+		year = year*10 + (*str++-'0');
+		yearDigits++;
+	}
+	if(yearDigits<4 || *str++!='-' || !parseDigits(str, 2, &month) || *str++!='-' || !parseDigits(str, 2, &day)) {
+		return false;
+	}
+	if(month<1 || month>12 || day<1 || day>31) {
+		return false;
+	}
+	double fraction = 0;
+	if(withTime) {
+		if(*str++!='T' || !parseDigits(str, 2, &hour) || *str++!=':' || !parseDigits(str, 2, &minute) || *str++!=':' || !parseDigits(str, 2, &second)) {
+			return false;
+		}
+		if(hour>24 || minute>59 || second>60) {
+			return false;
+		}
+		if(*str=='.') {
+			char *end;
+			fraction = strtod(str, &end);
+			str = end;
+		}
+	}
+	long offset = 0;
+	if(*str=='Z') {
+		str++;
+	} else if(*str=='+' || *str=='-') {
+		long sign = *str++=='-' ? -1 : 1;
+		long offsetHour, offsetMinute;
+		if(!parseDigits(str, 2, &offsetHour) || *str++!=':' || !parseDigits(str, 2, &offsetMinute)) {
+			return false;
+		}
+		offset = sign*(offsetHour*3600+offsetMinute*60);
+	}
+	if(*str!='\0') {
+		return false;
+	}
+	long days = daysFromCivil(negative ? -year : year, month, day);
+	*value = (double)days*86400 + hour*3600 + minute*60 + second - offset + fraction;
+	return true;
+}
+
+bool LiteralRangeIndex::parseValue(const std::string &literal, LiteralValueType *type, double *value)
+{
+	if(literal.size()<4 || literal[0]!='"' || literal[literal.size()-1]!='>') {
+		return false;
+	}
+	size_t pos = literal.rfind("\"^^<");
+	if(pos==std::string::npos || pos==0) {
+		return false;
+	}
+	if(literal.compare(pos+4, XSD.size(), XSD)!=0) {
+		return false;
+	}
+	std::string datatype = literal.substr(pos+4+XSD.size(), literal.size()-pos-5-XSD.size());
+	std::string lexical = literal.substr(1, pos-1);
+	if(lexical.empty()) {
+		return false;
+	}
+
+	for(int i=0; numericTypes[i]!=NULL; i++) {
+		if(datatype==numericTypes[i]) {
+			char *end;
+			*value = strtod(lexical.c_str(), &end);
+			if(*end!='\0' || *value!=*value) {
+				// Trailing characters or NaN, which has no order.
+				return false;
+			}
+			*type = LITERAL_NUMERIC;
+			return true;
+		}
+	}
+	if(datatype=="dateTime" || datatype=="dateTimeStamp" || datatype=="date") {
+		if(!parseDateTime(lexical.c_str(), datatype!="date", value)) {
+			return false;
+		}
+		*type = LITERAL_DATETIME;
+		return true;
+	}
+	return false;
+}
+
+LiteralRangeIndex::LiteralRangeIndex() : maxObjectID(0), numShared(0), numObjects(0)
+{
+	for(int t=0;t<NUM_LITERAL_VALUE_TYPES;t++) {
+		ids[t] = new LogSequence2();
+	}
+}
+
+LiteralRangeIndex::~LiteralRangeIndex()
+{
+	for(int t=0;t<NUM_LITERAL_VALUE_TYPES;t++) {
+		delete ids[t];
+	}
+}
+
+void LiteralRangeIndex::clear()
+{
+	for(int t=0;t<NUM_LITERAL_VALUE_TYPES;t++) {
+		values[t].clear();
+		delete ids[t];
+		ids[t] = new LogSequence2();
+	}
+	maxObjectID = 0;
+	numShared = 0;
+	numObjects = 0;
+}
+
+void LiteralRangeIndex::generate(Dictionary *dictionary, ProgressListener *listener)
+{
+	clear();
+
+	// Literals cannot be subjects, so they are not in the shared section.
+	unsigned int first = dictionary->getNshared()+1;
+	maxObjectID = dictionary->getMaxObjectID();
+	numShared = dictionary->getNshared();
+	numObjects = dictionary->getNobjects()-numShared;
+
+	std::vector<std::pair<double, unsigned int> > entries[NUM_LITERAL_VALUE_TYPES];
+	std::string str;
+	for(unsigned int id=first; id<=maxObjectID; id++) {
+		dictionary->extractString(id, OBJECT, str);
+		LiteralValueType type;
+		double value;
+		if(parseValue(str, &type, &value)) {
+			entries[type].push_back(std::make_pair(value, id));
+		}
+		NOTIFYCOND(listener, "Generating literal range index", id-first, maxObjectID-first+1);
+	}
+
+	for(int t=0;t<NUM_LITERAL_VALUE_TYPES;t++) {
+		std::sort(entries[t].begin(), entries[t].end());
+		values[t].reserve(entries[t].size());
+		delete ids[t];
+		ids[t] = new LogSequence2(bits(maxObjectID), entries[t].size());
+		for(size_t i=0;i<entries[t].size();i++) {
+			values[t].push_back(entries[t][i].first);
+			ids[t]->push_back(entries[t][i].second);
+		}
+	}
+}
+
+size_t LiteralRangeIndex::getNumberOfValues(LiteralValueType type)
+{
+	return values[type].size();
+}
+
+void LiteralRangeIndex::findRange(LiteralValueType type, double low, bool lowInclusive, double high, bool highInclusive, size_t *begin, size_t *end)
+{
+	std::vector<double> &sorted = values[type];
+	std::vector<double>::iterator first = lowInclusive ?
+			std::lower_bound(sorted.begin(), sorted.end(), low) :
+			std::upper_bound(sorted.begin(), sorted.end(), low);
+	std::vector<double>::iterator last = highInclusive ?
+			std::upper_bound(sorted.begin(), sorted.end(), high) :
+			std::lower_bound(sorted.begin(), sorted.end(), high);
+	*begin = first-sorted.begin();
+	*end = last<first ? *begin : last-sorted.begin();
+}
+
+double LiteralRangeIndex::getValue(LiteralValueType type, size_t pos)
+{
+	if(pos>=values[type].size()) {
+		throw "Trying to get a value beyond the end of the literal range index.";
+	}
+	return values[type][pos];
+}
+
+unsigned int LiteralRangeIndex::getObjectID(LiteralValueType type, size_t pos)
+{
+	return ids[type]->get(pos);
+}
+
+void LiteralRangeIndex::getObjectIDs(LiteralValueType type, double low, bool lowInclusive, double high, bool highInclusive, std::vector<unsigned int> &out)
+{
+	size_t begin, end;
+	findRange(type, low, lowInclusive, high, highInclusive, &begin, &end);
+	out.clear();
+	out.reserve(end-begin);
+	for(size_t pos=begin; pos<end; pos++) {
+		out.push_back(ids[type]->get(pos));
+	}
+	std::sort(out.begin(), out.end());
+}
+
+BitSequence375 *LiteralRangeIndex::getBitmap(LiteralValueType type, double low, bool lowInclusive, double high, bool highInclusive)
+{
+	size_t begin, end;
+	findRange(type, low, lowInclusive, high, highInclusive, &begin, &end);
+	BitSequence375 *bitmap = new BitSequence375(maxObjectID+1);
+	bitmap->set(maxObjectID, false);
+	for(size_t pos=begin; pos<end; pos++) {
+		bitmap->set(ids[type]->get(pos), true);
+	}
+	return bitmap;
+}
+
+size_t LiteralRangeIndex::size()
+{
+	size_t total = 0;
+	for(int t=0;t<NUM_LITERAL_VALUE_TYPES;t++) {
+		total += values[t].size()*sizeof(double) + ids[t]->size();
+	}
+	return total;
+}
+
+void LiteralRangeIndex::save(std::ostream &output, ControlInformation &controlInformation, ProgressListener *listener)
+{
+	controlInformation.clear();
+	controlInformation.setType(INDEX);
+	controlInformation.setFormat(HDTVocabulary::INDEX_TYPE_LITERAL_RANGE);
+	controlInformation.setUint("maxObjectID", maxObjectID);
+	controlInformation.setUint("numShared", numShared);
+	controlInformation.setUint("numObjects", numObjects);
+	controlInformation.save(output);
+
+	unsigned char data[9];
+	for(int t=0;t<NUM_LITERAL_VALUE_TYPES;t++) {
+		NOTIFY(listener, "Saving literal range index", t, NUM_LITERAL_VALUE_TYPES);
+		unsigned int len = csd::VByte::encode(data, values[t].size());
+		output.write((char *)data, len);
+
+		CRC32 crc;
+		if(values[t].size()>0) {
+			crc.writeData(output, (unsigned char *)&values[t][0], values[t].size()*sizeof(double));
+		}
+		crc.writeCRC(output);
+
+		ids[t]->save(output);
+	}
+}
+
+void LiteralRangeIndex::load(std::istream &input, ControlInformation &controlInformation, ProgressListener *listener)
+{
+	if(controlInformation.getType()!=INDEX || controlInformation.getFormat()!=HDTVocabulary::INDEX_TYPE_LITERAL_RANGE) {
+		throw "Trying to read a literal range index but the data is not a literal range index.";
+	}
+	clear();
+	maxObjectID = controlInformation.getUint("maxObjectID");
+	numShared = controlInformation.getUint("numShared");
+	numObjects = controlInformation.getUint("numObjects");
+
+	for(int t=0;t<NUM_LITERAL_VALUE_TYPES;t++) {
+		NOTIFY(listener, "Loading literal range index", t, NUM_LITERAL_VALUE_TYPES);
+		uint64_t numValues = csd::VByte::decode(input);
+		values[t].resize(numValues);
+
+		CRC32 crc;
+		if(numValues>0) {
+			input.read((char *)&values[t][0], numValues*sizeof(double));
+			crc.update((unsigned char *)&values[t][0], numValues*sizeof(double));
+		}
+		crc32_t filecrc = crc32_read(input);
+		if(crc.getValue()!=filecrc) {
+			throw "Checksum error while reading the literal range index.";
+		}
+
+		ids[t]->load(input);
+		if(ids[t]->getNumberOfElements()!=numValues) {
+			throw "The literal range index has different number of values and IDs.";
+		}
+	}
+}
+
+}
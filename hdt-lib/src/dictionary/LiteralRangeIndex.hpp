@@ -0,0 +1,133 @@
+/*
+ * File: LiteralRangeIndex.hpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+
+#ifndef LITERALRANGEINDEX_HPP_
+#define LITERALRANGEINDEX_HPP_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Dictionary.hpp>
+#include <HDTListener.hpp>
+#include <ControlInformation.hpp>
+
+#include "../sequence/LogSequence2.hpp"
+#include "../bitsequence/BitSequence375.h"
+
+namespace hdt {
+
+/**
+ * Kinds of typed literals ordered by value. All the XSD numeric types are
+ * compared together, as SPARQL does, and xsd:date/xsd:dateTime by instant.
+ */
+enum LiteralValueType {
+	LITERAL_NUMERIC = 0,
+	LITERAL_DATETIME = 1,
+	NUM_LITERAL_VALUE_TYPES = 2
+};
+
+/**
+ * Secondary index of the typed literals of the objects in value order. The
+ * dictionary sorts them by their serialization, so "9" comes after "10" and a
+ * range of values is not a range of IDs. For each LiteralValueType the index
+ * keeps the sorted values and the permutation of the object IDs that have them.
+ *
+ * dateTime values are seconds since 1970-01-01T00:00:00Z, those without
+ * timezone are taken as UTC, and xsd:date as the start of the day.
+ */
+class LiteralRangeIndex {
+private:
+	std::vector<double> values[NUM_LITERAL_VALUE_TYPES];
+	LogSequence2 *ids[NUM_LITERAL_VALUE_TYPES];
+	unsigned int maxObjectID;
+	// Sizes of the shared and object sections of the dictionary it was generated from
+	unsigned int numShared, numObjects;
+
+	void clear();
+
+public:
+	LiteralRangeIndex();
+	~LiteralRangeIndex();
+
+	/**
+	 * Parses a literal as serialized by the dictionary, for example
+	 * "42"^^<http://www.w3.org/2001/XMLSchema#integer>.
+	 * @return true if it is a numeric or date literal with a valid value.
+	 */
+	static bool parseValue(const std::string &literal, LiteralValueType *type, double *value);
+
+	/**
+	 * Build the index from the objects of the dictionary.
+	 */
+	void generate(Dictionary *dictionary, ProgressListener *listener=NULL);
+
+	/**
+	 * Number of literals of the type
+	 */
+	size_t getNumberOfValues(LiteralValueType type);
+
+	/**
+	 * Find the literals of the type whose value is in the interval.
+	 * @param begin,end Receive the range [begin, end) of positions in value order.
+	 */
+	void findRange(LiteralValueType type, double low, bool lowInclusive, double high, bool highInclusive, size_t *begin, size_t *end);
+
+	/**
+	 * Value and object ID of the literal at a position in value order.
+	 */
+	double getValue(LiteralValueType type, size_t pos);
+	unsigned int getObjectID(LiteralValueType type, size_t pos);
+
+	/**
+	 * Object IDs of the literals of the type whose value is in the interval, sorted by ID.
+	 */
+	void getObjectIDs(LiteralValueType type, double low, bool lowInclusive, double high, bool highInclusive, std::vector<unsigned int> &out);
+
+	/**
+	 * Bitmap with the bit of each object ID set when its value is in the interval,
+	 * to filter the bindings of a variable in constant time. Must be deleted by the caller.
+	 */
+	BitSequence375 *getBitmap(LiteralValueType type, double low, bool lowInclusive, double high, bool highInclusive);
+
+	/**
+	 * Size of the index in bytes
+	 */
+	size_t size();
+
+	void save(std::ostream &output, ControlInformation &controlInformation, ProgressListener *listener=NULL);
+	void load(std::istream &input, ControlInformation &controlInformation, ProgressListener *listener=NULL);
+};
+
+}
+
+#endif /* LITERALRANGEINDEX_HPP_ */
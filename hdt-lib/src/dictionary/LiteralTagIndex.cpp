@@ -0,0 +1,349 @@
+/*
+ * File: LiteralTagIndex.cpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+
+#include <string.h>
+#include <map>
+#include <algorithm>
+
+#include <HDTVocabulary.hpp>
+
+#include "LiteralTagIndex.hpp"
+#include "../libdcs/VByte.h"
+#include "../util/crc32.h"
+
+namespace hdt {
+
+static const std::string XSD_STRING = "<http://www.w3.org/2001/XMLSchema#string>";
+static const std::string RDF_LANGSTRING = "<http://www.w3.org/1999/02/22-rdf-syntax-ns#langString>";
+
+const unsigned int LiteralTagIndex::NOT_LITERAL;
+const unsigned int LiteralTagIndex::SIMPLE_LITERAL;
+const unsigned int LiteralTagIndex::FIRST_TAG;
+
+LiteralTagIndex::LiteralTagIndex() : codes(NULL), firstObjectID(1), maxObjectID(0), numObjects(0)
+{
+}
+
+LiteralTagIndex::~LiteralTagIndex()
+{
+	delete codes;
+}
+
+void LiteralTagIndex::clear()
+{
+	tags.clear();
+	delete codes;
+	codes = NULL;
+	firstObjectID = 1;
+	maxObjectID = 0;
+	numObjects = 0;
+}
+
+bool LiteralTagIndex::parseTag(const std::string &literal, std::string &tag)
+{
+	size_t quote = literal.rfind('"');
+	if(literal.size()<2 || literal[0]!='"' || quote==0) {
+		return false;
+	}
+	tag.clear();
+	if(quote+1==literal.size()) {
+		return true;
+	}
+	if(literal[quote+1]=='@') {
+		tag.assign(literal, quote+1, std::string::npos);
+		return true;
+	}
+	if(literal.compare(quote+1, 3, "^^<")==0 && literal[literal.size()-1]=='>') {
+		tag.assign(literal, quote+3, std::string::npos);
+		return true;
+	}
+	return false;
+}
+
+std::string LiteralTagIndex::getDatatypeOfTag(const std::string &tag)
+{
+	if(tag.empty()) {
+		return XSD_STRING;
+	}
+	return tag[0]=='@' ? RDF_LANGSTRING : tag;
+}
+
+void LiteralTagIndex::generate(Dictionary *dictionary, ProgressListener *listener)
+{
+	clear();
+
+	// Literals cannot be subjects, so they are not in the shared section.
+	firstObjectID = dictionary->getNshared()+1;
+	maxObjectID = dictionary->getMaxObjectID();
+	numObjects = dictionary->getNobjects()-dictionary->getNshared();
+	if(maxObjectID<firstObjectID) {
+		maxObjectID = firstObjectID-1;
+		return;
+	}
+
+	// Number the tags as they appear, and renumber them in order at the end.
+	std::map<std::string, unsigned int> found;
+	std::vector<unsigned int> values;
+	values.reserve(maxObjectID-firstObjectID+1);
+	std::string str, tag;
+	for(unsigned int id=firstObjectID; id<=maxObjectID; id++) {
+		dictionary->extractString(id, OBJECT, str);
+		if(!parseTag(str, tag)) {
+			values.push_back(NOT_LITERAL);
+		} else if(tag.empty()) {
+			values.push_back(SIMPLE_LITERAL);
+		} else {
+			std::map<std::string, unsigned int>::iterator it = found.find(tag);
+			if(it==found.end()) {
+				it = found.insert(std::make_pair(tag, (unsigned int)found.size())).first;
+			}
+			values.push_back(FIRST_TAG+it->second);
+		}
+		NOTIFYCOND(listener, "Generating literal tag index", id-firstObjectID, maxObjectID-firstObjectID+1);
+	}
+
+	std::vector<unsigned int> order(found.size());
+	for(std::map<std::string, unsigned int>::iterator it=found.begin(); it!=found.end(); ++it) {
+		order[it->second] = tags.size();
+		tags.push_back(it->first);
+	}
+	for(size_t i=0;i<values.size();i++) {
+		if(values[i]>=FIRST_TAG) {
+			values[i] = FIRST_TAG+order[values[i]-FIRST_TAG];
+		}
+	}
+
+	VectorUIntIterator it(values);
+	codes = new WaveletSequence();
+	codes->add(it);
+}
+
+unsigned int LiteralTagIndex::getCode(unsigned int id)
+{
+	if(codes==NULL || id<firstObjectID || id>maxObjectID) {
+		return NOT_LITERAL;
+	}
+	return codes->get(id-firstObjectID);
+}
+
+unsigned int LiteralTagIndex::getCode(const std::string &tag)
+{
+	if(tag.empty()) {
+		return SIMPLE_LITERAL;
+	}
+	std::vector<std::string>::iterator it = std::lower_bound(tags.begin(), tags.end(), tag);
+	if(it==tags.end() || *it!=tag) {
+		return NOT_LITERAL;
+	}
+	return FIRST_TAG+(it-tags.begin());
+}
+
+std::string LiteralTagIndex::getTag(unsigned int code)
+{
+	if(code<FIRST_TAG || code-FIRST_TAG>=tags.size()) {
+		return "";
+	}
+	return tags[code-FIRST_TAG];
+}
+
+unsigned int LiteralTagIndex::getNumberOfCodes()
+{
+	return FIRST_TAG+tags.size();
+}
+
+bool LiteralTagIndex::isLiteral(unsigned int id)
+{
+	return getCode(id)!=NOT_LITERAL;
+}
+
+std::string LiteralTagIndex::getLanguage(unsigned int id)
+{
+	std::string tag = getTag(getCode(id));
+	return tag.size()>0 && tag[0]=='@' ? tag.substr(1) : "";
+}
+
+std::string LiteralTagIndex::getDatatype(unsigned int id)
+{
+	unsigned int code = getCode(id);
+	if(code==NOT_LITERAL) {
+		return "";
+	}
+	return getDatatypeOfTag(getTag(code));
+}
+
+size_t LiteralTagIndex::count(unsigned int code)
+{
+	if(codes==NULL || code>=getNumberOfCodes()) {
+		return 0;
+	}
+	return codes->rank(code, codes->getNumberOfElements()-1);
+}
+
+unsigned int LiteralTagIndex::select(unsigned int code, size_t occurrence)
+{
+	if(occurrence==0 || occurrence>count(code)) {
+		throw "Trying to select beyond the objects with the code.";
+	}
+	return firstObjectID+codes->select(code, occurrence);
+}
+
+void LiteralTagIndex::getObjectIDs(unsigned int code, std::vector<unsigned int> &out)
+{
+	size_t total = count(code);
+	out.clear();
+	out.reserve(total);
+	for(size_t i=1; i<=total; i++) {
+		out.push_back(firstObjectID+codes->select(code, i));
+	}
+}
+
+void LiteralTagIndex::getObjectIDsByLanguage(const std::string &language, std::vector<unsigned int> &out)
+{
+	unsigned int code = language.empty() ? NOT_LITERAL : getCode("@"+language);
+	if(code==NOT_LITERAL) {
+		out.clear();
+		return;
+	}
+	getObjectIDs(code, out);
+}
+
+void LiteralTagIndex::getObjectIDsByDatatype(const std::string &datatype, std::vector<unsigned int> &out)
+{
+	std::vector<unsigned int> matching;
+	if(datatype==RDF_LANGSTRING) {
+		// The languages are the last tags.
+		std::vector<std::string>::iterator first = std::lower_bound(tags.begin(), tags.end(), std::string("@"));
+		for(unsigned int code=FIRST_TAG+(first-tags.begin()); code<getNumberOfCodes(); code++) {
+			matching.push_back(code);
+		}
+	} else {
+		if(datatype==XSD_STRING) {
+			matching.push_back(SIMPLE_LITERAL);
+		}
+		unsigned int code = datatype.size()>0 && datatype[0]=='<' ? getCode(datatype) : NOT_LITERAL;
+		if(code!=NOT_LITERAL) {
+			matching.push_back(code);
+		}
+	}
+
+	out.clear();
+	std::vector<unsigned int> ids;
+	for(size_t i=0;i<matching.size();i++) {
+		getObjectIDs(matching[i], ids);
+		out.insert(out.end(), ids.begin(), ids.end());
+	}
+	if(matching.size()>1) {
+		std::sort(out.begin(), out.end());
+	}
+}
+
+BitSequence375 *LiteralTagIndex::getBitmap(unsigned int code)
+{
+	BitSequence375 *bitmap = new BitSequence375(maxObjectID+1);
+	bitmap->set(maxObjectID, false);
+	size_t total = count(code);
+	for(size_t i=1; i<=total; i++) {
+		bitmap->set(firstObjectID+codes->select(code, i), true);
+	}
+	return bitmap;
+}
+
+size_t LiteralTagIndex::size()
+{
+	size_t total = codes!=NULL ? codes->size() : 0;
+	for(size_t i=0;i<tags.size();i++) {
+		total += tags[i].size()+1;
+	}
+	return total;
+}
+
+void LiteralTagIndex::save(std::ostream &output, ControlInformation &controlInformation, ProgressListener *listener)
+{
+	controlInformation.clear();
+	controlInformation.setType(INDEX);
+	controlInformation.setFormat(HDTVocabulary::INDEX_TYPE_LITERAL_TAG);
+	controlInformation.setUint("firstObjectID", firstObjectID);
+	controlInformation.setUint("maxObjectID", maxObjectID);
+	controlInformation.setUint("numShared", firstObjectID-1);
+	controlInformation.setUint("numObjects", numObjects);
+	controlInformation.save(output);
+
+	NOTIFY(listener, "Saving literal tag index", 0, 100);
+	unsigned char data[9];
+	unsigned int len = csd::VByte::encode(data, tags.size());
+	output.write((char *)data, len);
+
+	CRC32 crc;
+	for(size_t i=0;i<tags.size();i++) {
+		crc.writeData(output, (unsigned char *)tags[i].c_str(), tags[i].size()+1);
+	}
+	crc.writeCRC(output);
+
+	if(codes!=NULL) {
+		codes->save(output);
+	}
+}
+
+void LiteralTagIndex::load(std::istream &input, ControlInformation &controlInformation, ProgressListener *listener)
+{
+	if(controlInformation.getType()!=INDEX || controlInformation.getFormat()!=HDTVocabulary::INDEX_TYPE_LITERAL_TAG) {
+		throw "Trying to read a literal tag index but the data is not a literal tag index.";
+	}
+	clear();
+	firstObjectID = controlInformation.getUint("firstObjectID");
+	maxObjectID = controlInformation.getUint("maxObjectID");
+	numObjects = controlInformation.getUint("numObjects");
+
+	NOTIFY(listener, "Loading literal tag index", 0, 100);
+	uint64_t numTags = csd::VByte::decode(input);
+	CRC32 crc;
+	std::string tag;
+	for(uint64_t i=0;i<numTags;i++) {
+		std::getline(input, tag, '\0');
+		crc.update((unsigned char *)tag.c_str(), tag.size()+1);
+		tags.push_back(tag);
+	}
+	crc32_t filecrc = crc32_read(input);
+	if(crc.getValue()!=filecrc) {
+		throw "Checksum error while reading the literal tag index.";
+	}
+
+	if(maxObjectID>=firstObjectID) {
+		codes = new WaveletSequence();
+		codes->load(input);
+		if(codes->getNumberOfElements()!=maxObjectID-firstObjectID+1) {
+			throw "The literal tag index does not have a code for each object.";
+		}
+	}
+}
+
+}
@@ -0,0 +1,175 @@
+/*
+ * File: LiteralTagIndex.hpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+
+#ifndef LITERALTAGINDEX_HPP_
+#define LITERALTAGINDEX_HPP_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Dictionary.hpp>
+#include <HDTListener.hpp>
+#include <ControlInformation.hpp>
+
+#include "../sequence/WaveletSequence.hpp"
+#include "../bitsequence/BitSequence375.h"
+
+namespace hdt {
+
+/**
+ * Side index with the language tag or datatype of each literal of the
+ * objects, so that lang(), datatype() and isLiteral() filters are resolved
+ * with the IDs instead of extracting and parsing the strings.
+ *
+ * The distinct tags are kept sorted as they are serialized, "<datatype>" or
+ * "@language", so the datatypes come before the languages. Each object ID
+ * after the shared ones has a code in a wavelet tree: NOT_LITERAL,
+ * SIMPLE_LITERAL, or FIRST_TAG plus the position of its tag. The object IDs
+ * with a code are found with select() on the wavelet tree.
+ */
+class LiteralTagIndex {
+public:
+	static const unsigned int NOT_LITERAL = 0;
+	static const unsigned int SIMPLE_LITERAL = 1;
+	static const unsigned int FIRST_TAG = 2;
+
+private:
+	std::vector<std::string> tags;
+	WaveletSequence *codes;
+	unsigned int firstObjectID;
+	unsigned int maxObjectID;
+	// Size of the object section of the dictionary it was generated from
+	unsigned int numObjects;
+
+	void clear();
+
+public:
+	LiteralTagIndex();
+	~LiteralTagIndex();
+
+	/**
+	 * Gets the tag of a literal as serialized by the dictionary: "" for
+	 * "foo", "@en" for "foo"@en and "<datatype>" for "12"^^<datatype>.
+	 * @return false if it is not a literal.
+	 */
+	static bool parseTag(const std::string &literal, std::string &tag);
+
+	/**
+	 * Datatype of the literals with the tag, as getDatatype() gives it.
+	 */
+	static std::string getDatatypeOfTag(const std::string &tag);
+
+	/**
+	 * Build the index from the objects of the dictionary.
+	 */
+	void generate(Dictionary *dictionary, ProgressListener *listener=NULL);
+
+	/**
+	 * Code of an object ID.
+	 */
+	unsigned int getCode(unsigned int id);
+
+	/**
+	 * Code of a tag, "@language" or "<datatype>", or NOT_LITERAL if no literal has it.
+	 */
+	unsigned int getCode(const std::string &tag);
+
+	/**
+	 * Tag of a code, or "" for NOT_LITERAL and SIMPLE_LITERAL.
+	 */
+	std::string getTag(unsigned int code);
+
+	/**
+	 * Number of codes, that is, FIRST_TAG plus the distinct tags.
+	 */
+	unsigned int getNumberOfCodes();
+
+	bool isLiteral(unsigned int id);
+
+	/**
+	 * Language of the object, without '@', or "" if it has none.
+	 */
+	std::string getLanguage(unsigned int id);
+
+	/**
+	 * Datatype of the object as SPARQL datatype() gives it: xsd:string for
+	 * simple literals and rdf:langString for literals with language. It is ""
+	 * if the object is not a literal.
+	 */
+	std::string getDatatype(unsigned int id);
+
+	/**
+	 * Number of objects with the code.
+	 */
+	size_t count(unsigned int code);
+
+	/**
+	 * Object ID of the occurrence-th object with the code, from 1.
+	 */
+	unsigned int select(unsigned int code, size_t occurrence);
+
+	/**
+	 * Object IDs with the code, sorted.
+	 */
+	void getObjectIDs(unsigned int code, std::vector<unsigned int> &out);
+
+	/**
+	 * Object IDs of the literals with the language, without '@', sorted.
+	 */
+	void getObjectIDsByLanguage(const std::string &language, std::vector<unsigned int> &out);
+
+	/**
+	 * Object IDs of the literals with the datatype, written between '<' and
+	 * '>', sorted. xsd:string includes the simple literals and rdf:langString
+	 * all the literals with language.
+	 */
+	void getObjectIDsByDatatype(const std::string &datatype, std::vector<unsigned int> &out);
+
+	/**
+	 * Bitmap with the bit of each object ID set when it has the code, to filter
+	 * the bindings of a variable in constant time. Must be deleted by the caller.
+	 */
+	BitSequence375 *getBitmap(unsigned int code);
+
+	/**
+	 * Size of the index in bytes
+	 */
+	size_t size();
+
+	void save(std::ostream &output, ControlInformation &controlInformation, ProgressListener *listener=NULL);
+	void load(std::istream &input, ControlInformation &controlInformation, ProgressListener *listener=NULL);
+};
+
+}
+
+#endif /* LITERALTAGINDEX_HPP_ */
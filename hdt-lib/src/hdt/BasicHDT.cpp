@@ -65,12 +65,18 @@ using namespace std;
 
 namespace hdt {
 
+// Suffixes of the indexes saved next to the HDT file, besides .index
+static const char *LITERALS_SUFFIX = ".literals";
+static const char *TAGS_SUFFIX = ".tags";
+static const char *HASH_SUFFIX = ".hash";
+static const char *BLOOM_SUFFIX = ".bloom";
 
-BasicHDT::BasicHDT() : mappedHDT(NULL), mappedIndex(NULL) {
+
+BasicHDT::BasicHDT() : mappedHDT(NULL), mappedIndex(NULL), mappedHash(NULL), mappedBloom(NULL), literalIndex(NULL), tagIndex(NULL) {
 	createComponents();
 }
 
-BasicHDT::BasicHDT(HDTSpecification &spec) : mappedHDT(NULL), mappedIndex(NULL) {
+BasicHDT::BasicHDT(HDTSpecification &spec) : mappedHDT(NULL), mappedIndex(NULL), mappedHash(NULL), mappedBloom(NULL), literalIndex(NULL), tagIndex(NULL) {
 	this->spec = spec;
 	createComponents();
 }
@@ -84,6 +90,12 @@ BasicHDT::~BasicHDT() {
     if(mappedIndex) {
        delete mappedIndex;
     }
+    if(mappedHash) {
+       delete mappedHash;
+    }
+    if(mappedBloom) {
+       delete mappedBloom;
+    }
 }
 
 void BasicHDT::createComponents() {
@@ -122,6 +134,15 @@ void BasicHDT::createComponents() {
 }
 
 void BasicHDT::deleteComponents() {
+	if (literalIndex != NULL) {
+		delete literalIndex;
+		literalIndex = NULL;
+	}
+	if (tagIndex != NULL) {
+		delete tagIndex;
+		tagIndex = NULL;
+	}
+
 	if (header != NULL)
 		delete header;
 
@@ -380,6 +401,20 @@ void BasicHDT::loadFromRDF(const char *fileName, string baseUri, RDFNotation not
 		loadTriples(fileName, baseUri.c_str(), notation, &iListener);
 		fillHeader(baseUri);
 
+		if(spec.get("literals.rangeindex")=="true") {
+			iListener.setRange(99,100);
+			generateLiteralRangeIndex(&iListener);
+		}
+		if(spec.get("literals.tagindex")=="true") {
+			generateLiteralTagIndex(&iListener);
+		}
+		if(spec.get("dictionary.hashindex")=="true") {
+			generateHashIndex(&iListener);
+		}
+		if(spec.get("dictionary.bloomfilter")=="true") {
+			generateBloomFilter(&iListener);
+		}
+
 	}catch (const char *e) {
 		cout << "Catch exception load: " << e << endl;
 		deleteComponents();
@@ -464,6 +499,28 @@ void BasicHDT::loadDictionaryFromHDTs(const char** fileName, size_t numFiles, co
         }
 }
 
+/**
+ * Fill map with the IDs in the dictionary "to" of the strings with IDs 1..n in
+ * "from", decoding and locating them in batches.
+ */
+static void mapIds(Dictionary *from, Dictionary *to, TripleComponentRole role, unsigned int n, LogSequence2 &map) {
+	const unsigned int BATCH = 4096;
+	vector<unsigned int> ids, newIds;
+	vector<string> strs;
+	for(unsigned int first=0; first<n; first+=BATCH) {
+		unsigned int last = first+BATCH<n ? first+BATCH : n;
+		ids.clear();
+		for(unsigned int i=first; i<last; i++) {
+			ids.push_back(i+1);
+		}
+		from->extractMany(ids, role, strs);
+		to->stringToIds(strs, role, newIds);
+		for(unsigned int i=first; i<last; i++) {
+			map.set(i, newIds[i-first]);
+		}
+	}
+}
+
 void BasicHDT::loadTriplesFromHDTs(const char** fileNames, size_t numFiles, const char* baseUri, ProgressListener* listener) {
 	// Generate Triples
 	ModifiableTriples* triplesList = new TriplesList(spec);
@@ -495,37 +552,29 @@ void BasicHDT::loadTriplesFromHDTs(const char** fileNames, size_t numFiles, cons
 	        unsigned int nsubjects = dict->getNsubjects();
 	        LogSequence2 subjectMap(bits(dictionary->getNsubjects()), nsubjects);
 	        subjectMap.resize(nsubjects);
-	        for(unsigned int i=0;i<nsubjects;i++) {
-	        	string str = dict->idToString(i+1, SUBJECT);
-	        	unsigned int newid = dictionary->stringToId(str, SUBJECT);
-	        	subjectMap.set(i, newid);
-	        }
+	        mapIds(dict, dictionary, SUBJECT, nsubjects, subjectMap);
 
 	        cout << "Generating mapping predicates" << endl;
 	        unsigned int npredicates = dict->getNpredicates();
 	        LogSequence2 predicateMap(bits(dictionary->getNpredicates()), npredicates);
 	        predicateMap.resize(npredicates);
-	        for(unsigned int i=0;i<npredicates;i++) {
-	        	string str = dict->idToString(i+1, PREDICATE);
-	        	unsigned int newid = dictionary->stringToId(str, PREDICATE);
-	        	predicateMap.set(i, newid);
-	        }
+	        mapIds(dict, dictionary, PREDICATE, npredicates, predicateMap);
 
 	        cout << "Generating mapping objects" << endl;
 	        unsigned int nobjects = dict->getNobjects();
 	        LogSequence2 objectMap(bits(dictionary->getNobjects()), nobjects);
 	        objectMap.resize(nobjects);
-	        for(unsigned int i=0;i<nobjects;i++) {
-	        	string str = dict->idToString(i+1, OBJECT);
-	        	unsigned int newid = dictionary->stringToId(str, OBJECT);
-	        	objectMap.set(i, newid);
-	        }
+	        mapIds(dict, dictionary, OBJECT, nobjects, objectMap);
 
 	        totalOriginalSize += hdt.getHeader()->getPropertyLong("_:statistics", HDTVocabulary::ORIGINAL_SIZE.c_str());
 
 	        size_t numtriples = hdt.getTriples()->getNumberOfElements();
 	        IteratorTripleID *it = hdt.getTriples()->searchAll();
 
+	        // The subjects come in order, so their map is read by blocks.
+	        // Predicates and objects jump around and are read one by one.
+	        SequenceBuffer subjectBuffer(&subjectMap);
+
 	        TripleID newTid;
 	        char str[100];
 	        long long int j = 0;
@@ -533,7 +582,7 @@ void BasicHDT::loadTriplesFromHDTs(const char** fileNames, size_t numFiles, cons
 	        	TripleID *tid = it->next();
 
 	        	newTid.setAll(
-	        			(unsigned int)subjectMap.get(tid->getSubject()-1),
+	        			subjectBuffer.get(tid->getSubject()-1),
 	        			(unsigned int)predicateMap.get(tid->getPredicate()-1),
 	        			(unsigned int)objectMap.get(tid->getObject()-1)
 	        			);
@@ -610,6 +659,20 @@ void BasicHDT::loadFromSeveralHDT(const char **fileNames, size_t numFiles, strin
 
 		fillHeader(baseUri);
 
+		if(spec.get("literals.rangeindex")=="true") {
+			iListener.setRange(99,100);
+			generateLiteralRangeIndex(&iListener);
+		}
+		if(spec.get("literals.tagindex")=="true") {
+			generateLiteralTagIndex(&iListener);
+		}
+		if(spec.get("dictionary.hashindex")=="true") {
+			generateHashIndex(&iListener);
+		}
+		if(spec.get("dictionary.bloomfilter")=="true") {
+			generateBloomFilter(&iListener);
+		}
+
 	}catch (const char *e) {
 		cout << "Catch exception load: " << e << endl;
 		deleteComponents();
@@ -674,7 +737,11 @@ void BasicHDT::loadFromHDT(std::istream & input, ProgressListener *listener)
 	iListener.setRange(5, 60);
 	controlInformation.load(input);
 	delete dictionary;
-	dictionary = HDTFactory::readDictionary(controlInformation);
+	delete literalIndex;
+	literalIndex = NULL;
+	delete tagIndex;
+	tagIndex = NULL;
+	dictionary = HDTFactory::readDictionary(controlInformation, spec);
 	dictionary->load(input, controlInformation, &iListener);
 
 	// Load Triples
@@ -765,7 +832,11 @@ size_t BasicHDT::loadMMap(unsigned char *ptr, unsigned char *ptrMax, ProgressLis
     iListener.setRange(5, 60);
     controlInformation.load(&ptr[count], ptrMax);
     delete dictionary;
-    dictionary = HDTFactory::readDictionary(controlInformation);
+    delete literalIndex;
+    literalIndex = NULL;
+    delete tagIndex;
+    tagIndex = NULL;
+    dictionary = HDTFactory::readDictionary(controlInformation, spec);
     count += dictionary->load(&ptr[count], ptrMax, &iListener);
 
 	// Load triples
@@ -807,6 +878,10 @@ void BasicHDT::saveToHDT(const char *fileName, ProgressListener *listener)
         this->fileName = fileName;
         this->saveToHDT(out, listener);
         this->saveIndex(listener);
+        this->saveLiteralRangeIndex(listener);
+        this->saveLiteralTagIndex(listener);
+        this->saveHashIndex(listener);
+        this->saveBloomFilter(listener);
         out.close();
     } catch (const char *ex) {
         // Fixme: delete file if exists.
@@ -863,6 +938,19 @@ void BasicHDT::loadOrCreateIndex(ProgressListener *listener) {
 		triples->generateIndex(listener);
 		this->saveIndex(listener);
     }
+
+	if(!this->loadLiteralRangeIndex(listener) && spec.get("literals.rangeindex")=="true") {
+		this->generateLiteralRangeIndex(listener);
+	}
+	if(!this->loadLiteralTagIndex(listener) && spec.get("literals.tagindex")=="true") {
+		this->generateLiteralTagIndex(listener);
+	}
+	if(!this->loadHashIndex(listener) && spec.get("dictionary.hashindex")=="true") {
+		this->generateHashIndex(listener);
+	}
+	if(!this->loadBloomFilter(listener) && spec.get("dictionary.bloomfilter")=="true") {
+		this->generateBloomFilter(listener);
+	}
 }
 
 void BasicHDT::saveIndex(ProgressListener *listener) {
@@ -878,4 +966,242 @@ void BasicHDT::saveIndex(ProgressListener *listener) {
 	out.close();
 }
 
+/**
+ * Opens the index saved next to the HDT file with the given suffix and reads its
+ * ControlInformation. Returns false if the HDT has no file or there is no index.
+ * Throws if the index was generated for a dictionary with other sections.
+ */
+bool BasicHDT::openSideIndex(const char *suffix, ifstream &in, ControlInformation &ci) {
+	if(this->fileName.size()==0) {
+		return false;
+	}
+	string name = this->fileName + suffix;
+	in.open(name.c_str(), ios::binary);
+	if(!in.good()) {
+		return false;
+	}
+
+	ci.load(in);
+	if(ci.getUint("numShared")!=dictionary->getNshared()
+			|| ci.getUint("numObjects")!=dictionary->getNobjects()-dictionary->getNshared()) {
+		throw "An index saved next to the HDT file does not belong to its dictionary.";
+	}
+	return true;
+}
+
+/**
+ * Opens the file of the index with the given suffix for writing. If there is no
+ * index, removes the file of a previous HDT with the same name and returns false.
+ */
+bool BasicHDT::createSideIndex(const char *suffix, bool exists, ofstream &out) {
+	if(this->fileName.size()==0) {
+		return false;
+	}
+	string name = this->fileName + suffix;
+	if(!exists) {
+		remove(name.c_str());
+		return false;
+	}
+	out.open(name.c_str(), ios::binary);
+	if(!out.good()) {
+		throw "Error opening file to save an index of the HDT.";
+	}
+	return true;
+}
+
+LiteralRangeIndex *BasicHDT::getLiteralRangeIndex() {
+	return literalIndex;
+}
+
+void BasicHDT::generateLiteralRangeIndex(ProgressListener *listener) {
+	LiteralRangeIndex *index = new LiteralRangeIndex();
+	try {
+		index->generate(dictionary, listener);
+	} catch (const char *e) {
+		delete index;
+		throw e;
+	}
+	delete literalIndex;
+	literalIndex = index;
+
+	this->saveLiteralRangeIndex(listener);
+}
+
+bool BasicHDT::loadLiteralRangeIndex(ProgressListener *listener) {
+	ifstream in;
+	ControlInformation ci;
+	if(!openSideIndex(LITERALS_SUFFIX, in, ci)) {
+		return false;
+	}
+
+	LiteralRangeIndex *index = new LiteralRangeIndex();
+	try {
+		index->load(in, ci, listener);
+	} catch (const char *e) {
+		delete index;
+		throw e;
+	}
+	in.close();
+	delete literalIndex;
+	literalIndex = index;
+	return true;
+}
+
+void BasicHDT::saveLiteralRangeIndex(ProgressListener *listener) {
+	ofstream out;
+	if(createSideIndex(LITERALS_SUFFIX, literalIndex!=NULL, out)) {
+		ControlInformation ci;
+		literalIndex->save(out, ci, listener);
+		out.close();
+	}
+}
+
+LiteralTagIndex *BasicHDT::getLiteralTagIndex() {
+	return tagIndex;
+}
+
+void BasicHDT::generateLiteralTagIndex(ProgressListener *listener) {
+	LiteralTagIndex *index = new LiteralTagIndex();
+	try {
+		index->generate(dictionary, listener);
+	} catch (const char *e) {
+		delete index;
+		throw e;
+	}
+	delete tagIndex;
+	tagIndex = index;
+
+	this->saveLiteralTagIndex(listener);
+}
+
+bool BasicHDT::loadLiteralTagIndex(ProgressListener *listener) {
+	ifstream in;
+	ControlInformation ci;
+	if(!openSideIndex(TAGS_SUFFIX, in, ci)) {
+		return false;
+	}
+
+	LiteralTagIndex *index = new LiteralTagIndex();
+	try {
+		index->load(in, ci, listener);
+	} catch (const char *e) {
+		delete index;
+		throw e;
+	}
+	in.close();
+	delete tagIndex;
+	tagIndex = index;
+	return true;
+}
+
+void BasicHDT::saveLiteralTagIndex(ProgressListener *listener) {
+	ofstream out;
+	if(createSideIndex(TAGS_SUFFIX, tagIndex!=NULL, out)) {
+		ControlInformation ci;
+		tagIndex->save(out, ci, listener);
+		out.close();
+	}
+}
+
+void BasicHDT::generateHashIndex(ProgressListener *listener) {
+	FourSectionDictionary *dict = dynamic_cast<FourSectionDictionary *>(dictionary);
+	if(dict==NULL) {
+		return;
+	}
+	dict->generateHashIndex(listener);
+
+	this->saveHashIndex(listener);
+}
+
+bool BasicHDT::loadHashIndex(ProgressListener *listener) {
+	FourSectionDictionary *dict = dynamic_cast<FourSectionDictionary *>(dictionary);
+	ifstream in;
+	ControlInformation ci;
+	if(dict==NULL || !openSideIndex(HASH_SUFFIX, in, ci)) {
+		return false;
+	}
+
+	if(mappedHDT) {
+		// The dictionary drops the previous index before the old map is released.
+		FileMap *map = new FileMap((this->fileName + HASH_SUFFIX).c_str());
+		try {
+			dict->loadHashIndex(map->getPtr(), map->getPtr()+map->getMappedSize(), listener);
+		} catch (const char *e) {
+			delete map;
+			throw e;
+		}
+		delete mappedHash;
+		mappedHash = map;
+	} else {
+		dict->loadHashIndex(in, ci, listener);
+	}
+	in.close();
+	return true;
+}
+
+void BasicHDT::saveHashIndex(ProgressListener *listener) {
+	FourSectionDictionary *dict = dynamic_cast<FourSectionDictionary *>(dictionary);
+	ofstream out;
+	if(createSideIndex(HASH_SUFFIX, dict!=NULL && dict->hasHashIndex(), out)) {
+		ControlInformation ci;
+		dict->saveHashIndex(out, ci, listener);
+		out.close();
+	}
+}
+
+void BasicHDT::generateBloomFilter(ProgressListener *listener) {
+	FourSectionDictionary *dict = dynamic_cast<FourSectionDictionary *>(dictionary);
+	if(dict==NULL) {
+		return;
+	}
+	uint32_t bits = csd::BloomFilter::DEFAULT_BITS_PER_STRING;
+	string bitsStr = spec.get("dictionary.bloombits");
+	if(bitsStr!="") {
+		bits = atoi(bitsStr.c_str());
+	}
+	dict->generateBloomFilter(bits, listener);
+
+	this->saveBloomFilter(listener);
+}
+
+bool BasicHDT::loadBloomFilter(ProgressListener *listener) {
+	FourSectionDictionary *dict = dynamic_cast<FourSectionDictionary *>(dictionary);
+	ifstream in;
+	ControlInformation ci;
+	if(dict==NULL || !openSideIndex(BLOOM_SUFFIX, in, ci)) {
+		return false;
+	}
+
+	if(mappedHDT) {
+		// The dictionary drops the previous filter before the old map is released.
+		FileMap *map = new FileMap((this->fileName + BLOOM_SUFFIX).c_str());
+		try {
+			dict->loadBloomFilter(map->getPtr(), map->getPtr()+map->getMappedSize(), listener);
+		} catch (const char *e) {
+			delete map;
+			throw e;
+		}
+		delete mappedBloom;
+		mappedBloom = map;
+	} else {
+		dict->loadBloomFilter(in, ci, listener);
+	}
+	in.close();
+	return true;
+}
+
+bool BasicHDT::openBloomFilter(ifstream &in, ControlInformation &ci) {
+	return openSideIndex(BLOOM_SUFFIX, in, ci);
+}
+
+void BasicHDT::saveBloomFilter(ProgressListener *listener) {
+	FourSectionDictionary *dict = dynamic_cast<FourSectionDictionary *>(dictionary);
+	ofstream out;
+	if(createSideIndex(BLOOM_SUFFIX, dict!=NULL && dict->hasBloomFilter(), out)) {
+		ControlInformation ci;
+		dict->saveBloomFilter(out, ci, listener);
+		out.close();
+	}
+}
+
 }
@@ -31,7 +31,12 @@
 #include <HDTSpecification.hpp>
 #include <HDT.hpp>
 
+#include <fstream>
+
 #include "../util/filemap.h"
+#include "ControlInformation.hpp"
+#include "../dictionary/LiteralRangeIndex.hpp"
+#include "../dictionary/LiteralTagIndex.hpp"
 
 namespace hdt {
 
@@ -44,7 +49,9 @@ private:
 	HDTSpecification spec;
 	string fileName;
 
-	FileMap *mappedHDT, *mappedIndex;
+	FileMap *mappedHDT, *mappedIndex, *mappedHash, *mappedBloom;
+	LiteralRangeIndex *literalIndex;
+	LiteralTagIndex *tagIndex;
 
 	void createComponents();
 	void deleteComponents();
@@ -64,6 +71,21 @@ private:
     size_t loadMMap(unsigned char *ptr, unsigned char *ptrMax, ProgressListener *listener=NULL);
     size_t loadMMapIndex(ProgressListener *listener=NULL);
 
+	bool openSideIndex(const char *suffix, std::ifstream &in, ControlInformation &ci);
+	bool createSideIndex(const char *suffix, bool exists, std::ofstream &out);
+
+	bool loadLiteralRangeIndex(ProgressListener *listener=NULL);
+	void saveLiteralRangeIndex(ProgressListener *listener=NULL);
+
+	bool loadLiteralTagIndex(ProgressListener *listener=NULL);
+	void saveLiteralTagIndex(ProgressListener *listener=NULL);
+
+	bool loadHashIndex(ProgressListener *listener=NULL);
+	void saveHashIndex(ProgressListener *listener=NULL);
+
+	bool loadBloomFilter(ProgressListener *listener=NULL);
+	void saveBloomFilter(ProgressListener *listener=NULL);
+
 public:
 	BasicHDT();
 
@@ -126,6 +148,59 @@ public:
 
 	void saveIndex(ProgressListener *listener = NULL);
 
+	/**
+	 * Index of the numeric and date literals of the objects in value order, or
+	 * NULL if it was not generated. It is generated with the HDT when the option
+	 * "literals.rangeindex" is "true", saved next to the file as .literals, and
+	 * loaded with the other indexes.
+	 */
+	LiteralRangeIndex *getLiteralRangeIndex();
+
+	/**
+	 * Generate the literal range index, and save it if the HDT has a file.
+	 */
+	void generateLiteralRangeIndex(ProgressListener *listener = NULL);
+
+	/**
+	 * Index of the language tag or datatype of each object, or NULL if it was
+	 * not generated. It is generated with the HDT when the option
+	 * "literals.tagindex" is "true", saved next to the file as .tags, and
+	 * loaded with the other indexes.
+	 */
+	LiteralTagIndex *getLiteralTagIndex();
+
+	/**
+	 * Generate the literal tag index, and save it if the HDT has a file.
+	 */
+	void generateLiteralTagIndex(ProgressListener *listener = NULL);
+
+	/**
+	 * Generate the minimal perfect hash of the sections of the dictionary used
+	 * by stringToId(), and save it if the HDT has a file. It is generated with the
+	 * HDT when the option "dictionary.hashindex" is "true", saved next to the file
+	 * as .hash, and loaded (mapped with mapHDT) with the other indexes. Only the
+	 * FourSectionDictionary supports it.
+	 */
+	void generateHashIndex(ProgressListener *listener = NULL);
+
+	/**
+	 * Generate the Bloom filter of the sections of the dictionary, that lets
+	 * stringToId() reject most absent strings without searching, and save it if
+	 * the HDT has a file. It is generated with the HDT when the option
+	 * "dictionary.bloomfilter" is "true", with "dictionary.bloombits" bits per
+	 * string (10 by default), saved next to the file as .bloom, and loaded
+	 * (mapped with mapHDT) with the other indexes. Only the
+	 * FourSectionDictionary supports it.
+	 */
+	void generateBloomFilter(ProgressListener *listener = NULL);
+
+	/**
+	 * Open the Bloom filter saved next to the HDT file, after reading its
+	 * ControlInformation, to inspect it without loading it. Returns false if
+	 * there is none, and throws if it was generated for another dictionary.
+	 */
+	bool openBloomFilter(std::ifstream &in, ControlInformation &ci);
+
 	/**
 	 * @param subject
 	 * @param predicate
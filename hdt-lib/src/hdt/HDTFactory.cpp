@@ -111,6 +111,13 @@ Dictionary *HDTFactory::readDictionary(ControlInformation &controlInformation) {
 	throw "Dictionary Implementation not available";
 }
 
+Dictionary *HDTFactory::readDictionary(ControlInformation &controlInformation, HDTSpecification &specification) {
+	if(controlInformation.getFormat()==HDTVocabulary::DICTIONARY_TYPE_FOUR) {
+		return new FourSectionDictionary(specification);
+	}
+	return readDictionary(controlInformation);
+}
+
 Header *HDTFactory::readHeader(ControlInformation &controlInformation) {
     if(controlInformation.getType()!=HEADER)
 		throw "Trying to get Header from Non-Header section";
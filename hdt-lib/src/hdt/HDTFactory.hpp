@@ -83,6 +83,11 @@ public:
 	 */
 	static Dictionary *readDictionary(ControlInformation &controlInformation);
 
+	/** Same, passing the specification to the dictionaries that read options
+	 * on load, such as the cache of the sections of FourSectionDictionary.
+	 */
+	static Dictionary *readDictionary(ControlInformation &controlInformation, HDTSpecification &specification);
+
 	/** Returns the instance of Triples as specified in the ControlInformation
 	 *
 	 * @param controlInformation
@@ -42,5 +42,13 @@ void TripleIDStringIterator::goToStart() {
 	iterator->goToStart();
 }
 
+bool TripleIDStringIterator::canGoTo() {
+	return iterator->canGoTo();
+}
+
+void TripleIDStringIterator::goTo(unsigned int pos) {
+	iterator->goTo(pos);
+}
+
 }
 
@@ -27,6 +27,8 @@ public:
 	bool hasPrevious();
 	TripleString *previous();
 	void goToStart();
+	bool canGoTo();
+	void goTo(unsigned int pos);
 };
 
 } /* namespace hdt */
@@ -0,0 +1,270 @@
+/* BloomFilter.cpp
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Side filter of a Compressed String Dictionary that rejects most strings
+ * that are not in it without searching the CSD, using a blocked Bloom filter
+ * as described in:
+ *
+ *   ==========================================================================
+ *     "Cache-, Hash- and Space-Efficient Bloom Filters"
+ *     Felix Putze, Peter Sanders and Johannes Singler.
+ *     WEA'2007, LNCS 4525, p.108-121, 2007.
+ *   ==========================================================================
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ */
+
+#include <string.h>
+#include <math.h>
+
+#include "../util/crc8.h"
+#include "../util/crc32.h"
+#include "../util/bitutil.h"
+#include "BloomFilter.h"
+#include "MurmurHash.h"
+#include "VByte.h"
+
+namespace csd
+{
+
+static const uint64_t SEED = 0x9e3779b97f4a7c15ULL;
+
+#define CHECKPTR(base, max, size) if(((base)+(size))>(max)) throw "Could not read completely the Bloom filter from the file.";
+
+/** Block of a hash, from its high 32 bits. */
+static inline uint64_t blockOf(uint64_t hash, uint64_t numblocks)
+{
+	return ((hash >> 32) * numblocks) >> 32;
+}
+
+/** Bits of the probes of a hash, mixed so they do not depend on its block. */
+static inline uint64_t probesOf(uint64_t hash)
+{
+	hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+	return hash ^ (hash >> 31);
+}
+
+BloomFilter::BloomFilter() : numstrings(0), numblocks(0), probes(0), bits(NULL), mapped(false)
+{
+}
+
+BloomFilter::~BloomFilter()
+{
+	clear();
+}
+
+void BloomFilter::clear()
+{
+	if(!mapped) {
+		delete [] bits;
+	}
+	bits = NULL;
+	mapped = false;
+	numstrings = 0;
+	numblocks = 0;
+	probes = 0;
+}
+
+inline void BloomFilter::set(uint64_t hash)
+{
+	unsigned char *block = &bits[blockOf(hash, numblocks)*(BLOCK_BITS/8)];
+	uint64_t positions = probesOf(hash);
+	for(uint32_t i=0; i<probes; i++) {
+		uint32_t bit = positions & (BLOCK_BITS-1);
+		block[bit>>3] |= 1 << (bit&7);
+		positions >>= 9;
+	}
+}
+
+void BloomFilter::build(CSD *csd, uint32_t bitsPerString, hdt::ProgressListener *listener)
+{
+	clear();
+	if(bitsPerString==0) {
+		throw "The Bloom filter needs at least one bit per string.";
+	}
+	numstrings = csd->getLength();
+
+	// k = ln(2)*m/n minimizes the false positives of a plain Bloom filter.
+	probes = (uint32_t)(bitsPerString*0.693+0.5);
+	probes = probes<1 ? 1 : probes>MAX_PROBES ? MAX_PROBES : probes;
+	numblocks = ((uint64_t)numstrings*bitsPerString+BLOCK_BITS-1)/BLOCK_BITS;
+	if(numblocks==0) {
+		numblocks = 1;
+	}
+	bits = new unsigned char[numblocks*(BLOCK_BITS/8)];
+	memset(bits, 0, numblocks*(BLOCK_BITS/8));
+
+	hdt::IteratorUCharString *it = csd->listAll();
+	uint32_t count = 0;
+	while(it->hasNext()) {
+		unsigned char *str = it->next();
+		set(murmurHash64A(str, strlen((char *)str), SEED));
+		it->freeStr(str);
+		count++;
+		NOTIFYCOND(listener, "Building Bloom filter", count, numstrings);
+	}
+	delete it;
+	if(count!=numstrings) {
+		throw "The CSD returned a different number of strings than its length";
+	}
+}
+
+bool BloomFilter::mayContain(const unsigned char *s, uint32_t len)
+{
+	if(bits==NULL) {
+		return true;
+	}
+	uint64_t hash = murmurHash64A(s, len, SEED);
+	const unsigned char *block = &bits[blockOf(hash, numblocks)*(BLOCK_BITS/8)];
+	uint64_t positions = probesOf(hash);
+	for(uint32_t i=0; i<probes; i++) {
+		uint32_t bit = positions & (BLOCK_BITS-1);
+		if(!(block[bit>>3] & (1 << (bit&7)))) {
+			return false;
+		}
+		positions >>= 9;
+	}
+	return true;
+}
+
+uint32_t BloomFilter::getLength()
+{
+	return numstrings;
+}
+
+uint32_t BloomFilter::getNumberOfProbes()
+{
+	return probes;
+}
+
+double BloomFilter::getFalsePositiveRate()
+{
+	if(bits==NULL) {
+		return 1;
+	}
+
+	// A string that is not in the CSD falls in any block with the same
+	// probability, and passes if all its probes find a bit set.
+	double total = 0;
+	for(uint64_t b=0; b<numblocks; b++) {
+		const unsigned char *block = &bits[b*(BLOCK_BITS/8)];
+		uint32_t ones = 0;
+		for(uint32_t i=0; i<BLOCK_BITS/64; i++) {
+			uint64_t word;
+			memcpy(&word, &block[i*8], sizeof(word));
+			ones += hdt::popcount64(word);
+		}
+		total += pow((double)ones/BLOCK_BITS, (double)probes);
+	}
+	return total/numblocks;
+}
+
+size_t BloomFilter::size()
+{
+	return numblocks*(BLOCK_BITS/8);
+}
+
+void BloomFilter::save(std::ostream &out)
+{
+	if(bits==NULL) {
+		throw "The Bloom filter was not built.";
+	}
+
+	CRC8 crch;
+	unsigned char buf[27]; // 9 bytes per VByte (max) * 3 values.
+
+	uint8_t pos = 0;
+	pos += VByte::encode(&buf[pos], numstrings);
+	pos += VByte::encode(&buf[pos], numblocks);
+	pos += VByte::encode(&buf[pos], probes);
+
+	crch.writeData(out, buf, pos);
+	crch.writeCRC(out);
+
+	CRC32 crcd;
+	crcd.writeData(out, bits, numblocks*(BLOCK_BITS/8));
+	crcd.writeCRC(out);
+}
+
+void BloomFilter::load(std::istream &in)
+{
+	CRC8 crch;
+	unsigned char buf[27]; // 9 bytes per VByte (max) * 3 values.
+
+	clear();
+	numstrings = (uint32_t) VByte::decode(in);
+	numblocks = VByte::decode(in);
+	probes = (uint32_t) VByte::decode(in);
+
+	uint8_t pos = 0;
+	pos += VByte::encode(&buf[pos], numstrings);
+	pos += VByte::encode(&buf[pos], numblocks);
+	pos += VByte::encode(&buf[pos], probes);
+	crch.update(buf, pos);
+
+	crc8_t filecrc = crc8_read(in);
+	if(crch.getValue()!=filecrc) {
+		throw "Checksum error while reading the Bloom filter header.";
+	}
+	if(numblocks==0 || probes==0 || probes>MAX_PROBES) {
+		throw "Wrong parameters in the Bloom filter header.";
+	}
+
+	bits = new unsigned char[numblocks*(BLOCK_BITS/8)];
+	CRC32 crcd;
+	crcd.readData(in, bits, numblocks*(BLOCK_BITS/8));
+	if(crcd.getValue()!=crc32_read(in)) {
+		clear();
+		throw "Checksum error while reading the Bloom filter.";
+	}
+}
+
+size_t BloomFilter::load(unsigned char *ptr, unsigned char *ptrMax)
+{
+	size_t count=0;
+
+	clear();
+	count += VByte::decode(&ptr[count], ptrMax, &numstrings);
+	count += VByte::decode(&ptr[count], ptrMax, &numblocks);
+	count += VByte::decode(&ptr[count], ptrMax, &probes);
+
+	CRC8 crch;
+	crch.update(&ptr[0], count);
+	CHECKPTR(&ptr[count], ptrMax, 1);
+	if(crch.getValue()!=ptr[count++])
+		throw "CRC Error while reading the Bloom filter header.";
+	if(numblocks==0 || probes==0 || probes>MAX_PROBES) {
+		throw "Wrong parameters in the Bloom filter header.";
+	}
+
+	// The bits are used from the map, without checking them.
+	CHECKPTR(&ptr[count], ptrMax, numblocks*(BLOCK_BITS/8)+4);
+	bits = &ptr[count];
+	mapped = true;
+	count += numblocks*(BLOCK_BITS/8);
+	count += 4; // CRC of data
+
+	return count;
+}
+
+}
@@ -0,0 +1,104 @@
+/* BloomFilter.h
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Side filter of a Compressed String Dictionary that rejects most strings
+ * that are not in it without searching the CSD, using a blocked Bloom filter
+ * as described in:
+ *
+ *   ==========================================================================
+ *     "Cache-, Hash- and Space-Efficient Bloom Filters"
+ *     Felix Putze, Peter Sanders and Johannes Singler.
+ *     WEA'2007, LNCS 4525, p.108-121, 2007.
+ *   ==========================================================================
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ */
+
+#ifndef _BLOOMFILTER_H
+#define _BLOOMFILTER_H
+
+#include <iostream>
+
+#include <HDTListener.hpp>
+
+#include "CSD.h"
+
+namespace csd
+{
+
+/**
+ * Set of bits where each string of a CSD sets some bits chosen by its hash,
+ * all of them in the same block of 512 bits, so a lookup reads a single
+ * cache line. A string with any of its bits unset is surely not in the CSD,
+ * the others may be, with a small probability of a false positive.
+ */
+class BloomFilter
+{
+  public:
+    static const uint32_t BLOCK_BITS = 512;
+    static const uint32_t DEFAULT_BITS_PER_STRING = 10;
+    static const uint32_t MAX_PROBES = 7;	//! Bits per string, each one takes 9 bits of the hash.
+
+    BloomFilter();
+    ~BloomFilter();
+
+    /** Builds the filter with all the strings of the CSD. */
+    void build(CSD *csd, uint32_t bitsPerString=DEFAULT_BITS_PER_STRING, hdt::ProgressListener *listener=NULL);
+
+    /**
+     * @return false if s[0..len) is surely not in the CSD, true if it may be.
+     */
+    bool mayContain(const unsigned char *s, uint32_t len);
+
+    /** Number of strings */
+    uint32_t getLength();
+
+    /** Bits set by each string */
+    uint32_t getNumberOfProbes();
+
+    /**
+     * Probability that a string that is not in the CSD passes the filter,
+     * computed from the bits set in each block.
+     */
+    double getFalsePositiveRate();
+
+    /** Size of the filter in bytes */
+    size_t size();
+
+    void save(std::ostream &out);
+    void load(std::istream &in);
+    size_t load(unsigned char *ptr, unsigned char *ptrMax);
+
+  protected:
+    uint32_t numstrings;	//! Number of strings.
+    uint64_t numblocks;	//! Blocks of BLOCK_BITS bits.
+    uint32_t probes;	//! Bits set by each string.
+    unsigned char *bits;	//! Bits of all the blocks.
+    bool mapped;	//! The bits belong to a mapped file.
+
+    void clear();
+    void set(uint64_t hash);
+};
+
+}
+
+#endif  /* _BLOOMFILTER_H */
@@ -35,7 +35,9 @@
 #include "CSD_PFC.h"
 #include "CSD_HTFC.h"
 #include "CSD_FMIndex.h"
+#include "CSD_RePairDAC.h"
 
+#include <string.h>
 #include <libcdsBasics.h>
 
 using namespace cds_utils;
@@ -55,6 +57,7 @@ CSD * CSD::load(istream & fp)
     case HTFC: return CSD_HTFC::load(fp);
     case PFC: return CSD_PFC::load(fp);
     case FMINDEX: return CSD_FMIndex::load(fp);
+    case REPAIRDAC: return CSD_RePairDAC::load(fp);
     }
     return NULL;
 }
@@ -66,6 +69,7 @@ CSD *CSD::create(uchar type)
     case HTFC: return new CSD_HTFC();
     case PFC: return new CSD_PFC();
     case FMINDEX: return new CSD_FMIndex();
+    case REPAIRDAC: return new CSD_RePairDAC();
     }
 
     return NULL;
@@ -76,6 +80,101 @@ uint32_t CSD::getLength()
 	return numstrings;
 }
 
+size_t CSD::extract(uint32_t id, unsigned char *buffer, size_t capacity)
+{
+	unsigned char *str = extract(id);
+	if(str==NULL) {
+		return 0;
+	}
+	size_t len = strlen((char *)str);
+	if(len<capacity) {
+		memcpy(buffer, str, len+1);
+	}
+	freeString(str);
+	return len;
+}
+
+size_t CSD::extractString(uint32_t id, std::string &out)
+{
+	// Use all the memory that the string already has, and grow it only once if needed.
+	out.resize(out.capacity()>15 ? out.capacity() : 15);
+	size_t len = extract(id, (unsigned char *)&out[0], out.size()+1);
+	if(len>out.size()) {
+		out.resize(len);
+		len = extract(id, (unsigned char *)&out[0], out.size()+1);
+	}
+	out.resize(len);
+	return len;
+}
+
+uint32_t CSD::getBlockSize()
+{
+	return 16;
+}
+
+void CSD::extractBlock(uint32_t block, std::string &data, std::vector<uint32_t> &offsets)
+{
+	uint32_t blocksize = getBlockSize();
+	uint32_t first = block*blocksize+1;
+	std::string str;
+	data.clear();
+	offsets.clear();
+	for(uint32_t id=first; id<first+blocksize && id<=numstrings; id++) {
+		offsets.push_back(data.size());
+		extractString(id, str);
+		data.append(str);
+		data.push_back('\0');
+	}
+	offsets.push_back(data.size());
+}
+
+void CSD::locateMany(const std::vector<std::string> &strings, std::vector<uint32_t> &ids)
+{
+	if(ids.size()!=strings.size()) {
+		ids.assign(strings.size(), 0);
+	}
+	for(size_t i=0;i<strings.size();i++) {
+		if(ids[i]==0) {
+			ids[i] = locate((const unsigned char *)strings[i].c_str(), strings[i].length());
+		}
+	}
+}
+
+/**
+ * Number of strings that are smaller than s or, if prefix is true, that are
+ * smaller or start with s, using binary search on the extracted strings.
+ */
+static uint32_t countBefore(CSD *csd, const unsigned char *s, uint32_t len, bool prefix)
+{
+	std::string str;
+	uint32_t left = 0, right = csd->getLength();
+	while(left<right) {
+		uint32_t center = left+(right-left)/2;
+		csd->extractString(center+1, str);
+		int cmp = prefix ? strncmp(str.c_str(), (const char *)s, len) : str.compare(0, std::string::npos, (const char *)s, len);
+		if(cmp<0 || (prefix && cmp==0)) {
+			left = center+1;
+		} else {
+			right = center;
+		}
+	}
+	return left;
+}
+
+void CSD::prefixRange(const unsigned char *prefix, uint32_t len, uint32_t *begin, uint32_t *end)
+{
+	*begin = countBefore(this, prefix, len, false)+1;
+	*end = countBefore(this, prefix, len, true)+1;
+}
+
+void CSD::extractMany(const std::vector<uint32_t> &ids, std::vector<std::string> &out)
+{
+	out.resize(ids.size());
+	for(size_t i=0;i<ids.size();i++) {
+		extractString(ids[i], out[i]);
+	}
+}
+
 }
 
 
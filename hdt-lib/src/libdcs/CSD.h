@@ -37,6 +37,7 @@
 #include <stdint.h>
 #include <Iterator.hpp>
 #include <iostream>
+#include <string>
 #include <cassert>
 #include <vector>
 using namespace std;
@@ -73,6 +74,60 @@ class CSD
      */
     virtual void freeString(const unsigned char *)=0;
 
+    /** Decodes the string identified by id into buffer, followed by '\0',
+	without allocating memory. Returns the length of the string, or 0 if the
+	id does not exist. If the result is capacity or more the string was not
+	written, and the call has to be repeated with a buffer bigger than the
+	result, which some implementations round up to their longest string.
+	@id: the identifier to be extracted.
+	@buffer: memory owned by the caller.
+	@capacity: size of the buffer in bytes.
+    */
+    virtual size_t extract(uint32_t id, unsigned char *buffer, size_t capacity);
+
+    /** Decodes the string identified by id into out, reusing the memory that
+	out already has. Returns the length of the string, or 0 if the id does
+	not exist.
+    */
+    size_t extractString(uint32_t id, std::string &out);
+
+    /** Decodes the strings of ids into out, in the same order. Sections
+	that decode blocks sequentially resolve sorted ids of the same block
+	in one pass.
+	@ids: identifiers, preferably in increasing order.
+	@out: resized to the number of ids, reusing its strings.
+    */
+    virtual void extractMany(const std::vector<uint32_t> &ids, std::vector<std::string> &out);
+
+    /** Locates several strings, writing in ids the ID of each one in the
+	same order, or 0 if it does not exist. Sorted sections search each string
+	from the position of the previous one when the strings come in order.
+	@strings: the strings to be located, in any order.
+	@ids: one entry for each string. Only the strings whose entry is 0 are
+	located, so a caller can skip some. If its size differs it is resized
+	and filled with 0.
+    */
+    virtual void locateMany(const std::vector<std::string> &strings, std::vector<uint32_t> &ids);
+
+    /** Finds the IDs of the strings that start with a prefix. As the strings
+	are sorted they are contiguous, so they are returned as [begin, end),
+	and begin==end if there are none.
+	@prefix: the prefix, of len characters. An empty one matches all.
+    */
+    virtual void prefixRange(const unsigned char *prefix, uint32_t len, uint32_t *begin, uint32_t *end);
+
+    /** Number of consecutive strings that extractBlock() decodes together.
+	Sections stored in blocks return the size of their blocks.
+    */
+    virtual uint32_t getBlockSize();
+
+    /** Decodes the strings of a block, from the ID block*getBlockSize()+1,
+	into data, each one followed by '\0', and the position of each one in
+	offsets, plus the end of the last one. By default the strings are
+	extracted one by one.
+    */
+    virtual void extractBlock(uint32_t block, std::string &data, std::vector<uint32_t> &offsets);
+
     /** Returns the size of the structure in bytes. */
     virtual uint64_t getSize()=0;
 
@@ -0,0 +1,266 @@
+/*
+ * File: CSD_BlockCache.cpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+#include <string.h>
+#include <cassert>
+
+#include "CSD_BlockCache.h"
+
+namespace csd
+{
+
+CSD_BlockCache::CSD_BlockCache(CSD *child, uint64_t budget, uint32_t shards) : child(child)
+{
+	assert(child);
+	numstrings = child->getLength();
+	blocksize = child->getBlockSize();
+	if(blocksize==0) {
+		blocksize = 1;
+	}
+	uint32_t nblocks = numstrings/blocksize + (numstrings%blocksize ? 1 : 0);
+
+	// A slot holds twice the average decoded block of a sample, so only
+	// the blocks of unusually long strings are left out.
+	uint64_t sampled = 0, sampleBytes = 0;
+	std::string data;
+	std::vector<uint32_t> offsets;
+	uint32_t step = nblocks>64 ? nblocks/64 : 1;
+	for(uint32_t block=0; block<nblocks; block+=step) {
+		child->extractBlock(block, data, offsets);
+		sampleBytes += data.size();
+		sampled++;
+	}
+	uint64_t slot = sampled>0 ? 2*sampleBytes/sampled : 0;
+	slot = (slot+63) & ~(uint64_t)63;
+	slotBytes = slot<64 ? 64 : slot>(1<<24) ? (1<<24) : (uint32_t)slot;
+
+	nshards = shards==0 ? 1 : shards;
+	if(nshards>nblocks) {
+		nshards = nblocks>0 ? nblocks : 1;
+	}
+
+	// Fill the budget with sets of WAYS slots, but not with more slots than blocks.
+	uint64_t bytesPerSlot = slotBytes + sizeof(uint32_t)*(blocksize+1);
+	uint64_t perShard = budget/bytesPerSlot/nshards;
+	nsets = perShard/WAYS;
+	uint64_t needed = ((uint64_t)nblocks+nshards-1)/nshards;
+	if(nsets>(needed+WAYS-1)/WAYS) {
+		nsets = (needed+WAYS-1)/WAYS;
+	}
+	if(nsets==0) {
+		nsets = 1;
+	}
+
+	this->shards = new Shard[nshards];
+	for(uint32_t i=0; i<nshards; i++) {
+		this->shards[i].lock = 0;
+		this->shards[i].hits = 0;
+		this->shards[i].misses = 0;
+		this->shards[i].hands = new unsigned char[nsets];
+		memset(this->shards[i].hands, 0, nsets);
+	}
+
+	uint64_t nslots = (uint64_t)nshards*nsets*WAYS;
+	slots = new Slot[nslots];
+	memory = new char[nslots*bytesPerSlot];
+	uint32_t *offsetMemory = (uint32_t *)memory;
+	char *dataMemory = memory + nslots*sizeof(uint32_t)*(blocksize+1);
+	for(uint64_t i=0; i<nslots; i++) {
+		slots[i].version = 0;
+		slots[i].block = EMPTY;
+		slots[i].referenced = 0;
+		slots[i].count = 0;
+		slots[i].offsets = offsetMemory + i*(blocksize+1);
+		slots[i].data = dataMemory + i*slotBytes;
+	}
+}
+
+CSD_BlockCache::~CSD_BlockCache()
+{
+	for(uint32_t i=0; i<nshards; i++) {
+		delete [] shards[i].hands;
+	}
+	delete [] shards;
+	delete [] slots;
+	delete [] memory;
+	delete child;
+}
+
+size_t CSD_BlockCache::lookup(uint32_t block, uint32_t index, unsigned char *buffer, size_t capacity)
+{
+	Slot *set = getSet(block);
+	for(uint32_t w=0; w<WAYS; w++) {
+		Slot &slot = set[w];
+		uint32_t version = slot.version;
+		__sync_synchronize();
+		if((version&1) || slot.block!=block || index>=slot.count) {
+			continue;
+		}
+
+		// The values read may be torn by a writer, check them before using them.
+		uint32_t start = slot.offsets[index];
+		uint32_t end = slot.offsets[index+1];
+		if(start>=end || end>slotBytes) {
+			continue;
+		}
+		size_t len = end-start-1;
+		if(len<capacity) {
+			memcpy(buffer, slot.data+start, len);
+			buffer[len] = '\0';
+		}
+
+		__sync_synchronize();
+		if(slot.version!=version) {
+			continue;
+		}
+		if(!slot.referenced) {
+			slot.referenced = 1;
+		}
+		return len;
+	}
+	return MISS;
+}
+
+void CSD_BlockCache::insert(uint32_t block, const std::string &data, const std::vector<uint32_t> &offsets)
+{
+	Slot *set = getSet(block);
+	Shard &shard = shards[block%nshards];
+	unsigned char &hand = shard.hands[(block/nshards)%nsets];
+
+	while(__sync_lock_test_and_set(&shard.lock, 1)) {
+		while(shard.lock) { }
+	}
+
+	// Another thread may have stored it meanwhile.
+	for(uint32_t w=0; w<WAYS; w++) {
+		if(set[w].block==block) {
+			__sync_lock_release(&shard.lock);
+			return;
+		}
+	}
+
+	// CLOCK: give a second chance to the slots used since the last pass.
+	while(set[hand].block!=EMPTY && set[hand].referenced) {
+		set[hand].referenced = 0;
+		hand = (hand+1)%WAYS;
+	}
+	Slot &slot = set[hand];
+	hand = (hand+1)%WAYS;
+
+	slot.version++;
+	__sync_synchronize();
+	slot.block = block;
+	slot.count = offsets.size()-1;
+	memcpy(slot.offsets, &offsets[0], offsets.size()*sizeof(uint32_t));
+	memcpy(slot.data, data.data(), data.size());
+	slot.referenced = 1;
+	__sync_synchronize();
+	slot.version++;
+
+	__sync_lock_release(&shard.lock);
+}
+
+size_t CSD_BlockCache::extract(uint32_t id, unsigned char *buffer, size_t capacity)
+{
+	if(id==0 || id>numstrings) {
+		return 0;
+	}
+	uint32_t block = (id-1)/blocksize;
+	uint32_t index = (id-1)%blocksize;
+	Shard &shard = shards[block%nshards];
+
+	size_t len = lookup(block, index, buffer, capacity);
+	if(len!=MISS) {
+		__sync_fetch_and_add(&shard.hits, 1);
+		return len;
+	}
+	__sync_fetch_and_add(&shard.misses, 1);
+
+	std::string data;
+	std::vector<uint32_t> offsets;
+	child->extractBlock(block, data, offsets);
+	if(index+1>=offsets.size()) {
+		return 0;
+	}
+	if(data.size()<=slotBytes && offsets.size()<=blocksize+1) {
+		insert(block, data, offsets);
+	}
+
+	len = offsets[index+1]-offsets[index]-1;
+	if(len<capacity) {
+		memcpy(buffer, &data[offsets[index]], len+1);
+	}
+	return len;
+}
+
+unsigned char *CSD_BlockCache::extract(uint32_t id)
+{
+	if(id==0 || id>numstrings) {
+		return NULL;
+	}
+	// The strings of the cached blocks fit in slotBytes, so it is usually a single lookup.
+	unsigned char *out = new unsigned char[slotBytes+1];
+	size_t len = extract(id, out, slotBytes+1);
+	if(len>slotBytes) {
+		delete [] out;
+		out = new unsigned char[len+1];
+		extract(id, out, len+1);
+	}
+	return out;
+}
+
+void CSD_BlockCache::freeString(const unsigned char *str)
+{
+	delete [] str;
+}
+
+uint64_t CSD_BlockCache::getSize()
+{
+	uint64_t nslots = (uint64_t)nshards*nsets*WAYS;
+	return child->getSize() + nslots*(sizeof(Slot)+slotBytes+sizeof(uint32_t)*(blocksize+1))
+			+ nshards*(sizeof(Shard)+nsets);
+}
+
+uint64_t CSD_BlockCache::getHits()
+{
+	uint64_t total = 0;
+	for(uint32_t i=0; i<nshards; i++) {
+		total += shards[i].hits;
+	}
+	return total;
+}
+
+uint64_t CSD_BlockCache::getMisses()
+{
+	uint64_t total = 0;
+	for(uint32_t i=0; i<nshards; i++) {
+		total += shards[i].misses;
+	}
+	return total;
+}
+
+}
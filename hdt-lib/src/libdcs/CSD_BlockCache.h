@@ -0,0 +1,178 @@
+/*
+ * File: CSD_BlockCache.h
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+#ifndef _CSDBLOCKCACHE_H
+#define _CSDBLOCKCACHE_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "CSD.h"
+
+namespace csd
+{
+
+/**
+ * Keeps the decoded blocks of a CSD, so extracting a string of a recently
+ * used block is a copy instead of decoding the block up to it. It can be
+ * shared by several threads.
+ *
+ * The blocks are spread over shards by block number, and in each shard over
+ * sets of WAYS slots. Each slot has a fixed buffer allocated at the
+ * beginning, so the memory stays within the budget and is never freed
+ * while the cache is in use. Readers take no lock: a slot has a version that
+ * is odd while it is being written, and a copy is only valid if the version
+ * was even and did not change during it. Writers of a shard take its lock
+ * and choose the slot to replace in the set with the CLOCK algorithm.
+ * Blocks that do not fit in a slot are decoded each time.
+ */
+class CSD_BlockCache : public CSD
+{
+public:
+	/** Slots of each set. */
+	static const uint32_t WAYS = 8;
+
+	/** Default number of shards. */
+	static const uint32_t DEFAULT_SHARDS = 16;
+
+	/** Wraps child, that is deleted with the cache, using about budget bytes. */
+	CSD_BlockCache(CSD *child, uint64_t budget, uint32_t shards=DEFAULT_SHARDS);
+
+	~CSD_BlockCache();
+
+	uint32_t locate(const unsigned char *s, uint32_t len) {
+		return child->locate(s, len);
+	}
+
+	unsigned char * extract(uint32_t id);
+
+	void freeString(const unsigned char *str);
+
+	size_t extract(uint32_t id, unsigned char *buffer, size_t capacity);
+
+	void locateMany(const std::vector<std::string> &strings, std::vector<uint32_t> &ids) {
+		child->locateMany(strings, ids);
+	}
+
+	void prefixRange(const unsigned char *prefix, uint32_t len, uint32_t *begin, uint32_t *end) {
+		child->prefixRange(prefix, len, begin, end);
+	}
+
+	uint32_t getBlockSize() {
+		return blocksize;
+	}
+
+	void extractBlock(uint32_t block, std::string &data, std::vector<uint32_t> &offsets) {
+		child->extractBlock(block, data, offsets);
+	}
+
+	/** Returns the size of the child plus the memory of the cache. */
+	uint64_t getSize();
+
+	hdt::IteratorUCharString *listAll() {
+		return child->listAll();
+	}
+
+	void fillSuggestions(const char *base, vector<string> &out, int maxResults) {
+		child->fillSuggestions(base, out, maxResults);
+	}
+
+	void save(ostream &fp) {
+		child->save(fp);
+	}
+
+	size_t load(unsigned char *ptr, unsigned char *ptrMax) {
+		throw "The cache must be created on a loaded CSD.";
+	}
+
+	CSD *getChild() {
+		return child;
+	}
+
+	/** Number of extractions answered by a cached block. */
+	uint64_t getHits();
+
+	/** Number of extractions that decoded the block. */
+	uint64_t getMisses();
+
+	/** Bytes of the decoded strings that fit in each slot. */
+	uint32_t getSlotBytes() {
+		return slotBytes;
+	}
+
+	/** Number of slots of all the shards. */
+	uint32_t getNumberOfSlots() {
+		return nshards*nsets*WAYS;
+	}
+
+private:
+	static const uint32_t EMPTY = 0xFFFFFFFF;
+	static const size_t MISS = (size_t)-1;
+
+	struct Slot {
+		volatile uint32_t version;	//! Odd while the slot is being written.
+		volatile uint32_t block;	//! Block stored, or EMPTY.
+		volatile uint32_t referenced;	//! Used since the CLOCK hand passed.
+		volatile uint32_t count;	//! Strings of the block.
+		uint32_t *offsets;	//! Position of each string in data, plus the end.
+		char *data;	//! Strings of the block, each one followed by '\0'.
+	};
+
+	struct Shard {
+		volatile int lock;
+		volatile uint64_t hits;
+		volatile uint64_t misses;
+		unsigned char *hands;	//! CLOCK hand of each set.
+		char padding[64];	//! Keeps the counters of different shards in different cache lines.
+	};
+
+	CSD *child;
+	uint32_t blocksize;
+	uint32_t slotBytes;
+	uint32_t nshards;
+	uint32_t nsets;	//! Sets of each shard.
+	Shard *shards;
+	Slot *slots;
+	char *memory;
+
+	inline Slot *getSet(uint32_t block) {
+		return &slots[((block%nshards)*nsets + (block/nshards)%nsets)*WAYS];
+	}
+
+	/** Copies the string index of block from a slot, as extract(id, buffer, capacity),
+	 *  or returns MISS if the block is not cached. */
+	size_t lookup(uint32_t block, uint32_t index, unsigned char *buffer, size_t capacity);
+
+	/** Stores the decoded block in a slot of its set. */
+	void insert(uint32_t block, const std::string &data, const std::vector<uint32_t> &offsets);
+};
+
+}
+
+#endif
@@ -95,6 +95,25 @@ void CSD_Cache::freeString(const unsigned char *str) {
 	// Do nothing.
 }
 
+size_t CSD_Cache::extract(uint32_t id, unsigned char *buffer, size_t capacity)
+{
+	LRU_Int::const_iterator it = cacheint.find(id);
+
+	if (it != cacheint.end()) {
+		size_t len = it.value().length();
+		if(len<capacity) {
+			memcpy(buffer, it.value().c_str(), len+1);
+		}
+		return len;
+	}
+
+	size_t len = child->extract(id, buffer, capacity);
+	if(len<capacity && len>0) {
+		cacheint[id] = string((char *)buffer, len);
+	}
+	return len;
+}
+
 uint64_t CSD_Cache::getSize()
 {
 	return child->getSize();
@@ -77,6 +77,8 @@ private:
 
     void freeString(const unsigned char *str);
 
+    size_t extract(uint32_t id, unsigned char *buffer, size_t capacity);
+
     /** Obtains the original Tdict from its CSD_PFC representation. Each string is
 	separated by '\n' symbols.
 	@dict: the plain uncompressed dictionary.
@@ -106,6 +108,10 @@ private:
     	child->fillSuggestions(base, out, maxResults);
     }
 
+    void prefixRange(const unsigned char *prefix, uint32_t len, uint32_t *begin, uint32_t *end) {
+    	child->prefixRange(prefix, len, begin, end);
+    }
+
     CSD *getChild() {
     	return child;
     }
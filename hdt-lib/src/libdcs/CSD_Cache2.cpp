@@ -37,7 +37,11 @@ CSD_Cache2::CSD_Cache2(CSD *child) : child(child)
 	assert(child);
 	numstrings = child->getLength();
 
+	// Filled up front, so that extract() only reads and concurrent readers are safe.
 	array.resize(child->getLength(), NULL);
+	for(uint32_t id=1; id<=array.size(); id++) {
+		array[id-1] = child->extract(id);
+	}
 }
 
 
@@ -65,23 +69,27 @@ unsigned char* CSD_Cache2::extract(uint32_t id)
 	if(id<1 || id>array.size()) {
 		return NULL;
 	}
-
-	if(array[id-1]!=NULL) {
-		return array[id-1];
-	}
-
-	// Not found, fetch and add
-	unsigned char *value = child->extract(id);
-
-	array[id-1] = value;
-
-	return value;
+	return array[id-1];
 }
 
 void CSD_Cache2::freeString(const unsigned char *str) {
 	// Do nothing, all freed on destruction.
 }
 
+size_t CSD_Cache2::extract(uint32_t id, unsigned char *buffer, size_t capacity)
+{
+	// The cache keeps the strings, so nothing is allocated.
+	unsigned char *value = extract(id);
+	if(value==NULL) {
+		return 0;
+	}
+	size_t len = strlen((char *)value);
+	if(len<capacity) {
+		memcpy(buffer, value, len+1);
+	}
+	return len;
+}
+
 uint64_t CSD_Cache2::getSize()
 {
 	return child->getSize();
@@ -43,6 +43,8 @@ using namespace std;
 namespace csd
 {
 
+/** Keeps every string of a small section, such as the predicates, extracted
+    when it is created. */
 class CSD_Cache2 : public CSD
 {
 private:
@@ -70,6 +72,8 @@ private:
 
     void freeString(const unsigned char *str);
 
+    size_t extract(uint32_t id, unsigned char *buffer, size_t capacity);
+
     /** Obtains the original Tdict from its CSD_PFC representation. Each string is
 	separated by '\n' symbols.
 	@dict: the plain uncompressed dictionary.
@@ -99,6 +103,10 @@ private:
     	child->fillSuggestions(base, out, maxResults);
     }
 
+    void prefixRange(const unsigned char *prefix, uint32_t len, uint32_t *begin, uint32_t *end) {
+    	child->prefixRange(prefix, len, begin, end);
+    }
+
     CSD *getChild() {
     	return child;
     }
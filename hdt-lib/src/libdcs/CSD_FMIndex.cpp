@@ -37,6 +37,7 @@
 #include <string.h>
 #include <sstream>
 #include <vector>
+#include <algorithm>
 
 namespace csd {
 
@@ -194,30 +195,70 @@ uint32_t CSD_FMIndex::locate(const unsigned char *s, uint32_t len) {
 }
 
 uint32_t CSD_FMIndex::locate_substring(unsigned char *s, uint32_t len, uint32_t **occs) {
-	if (!use_sampling) {
+	FMIndexSubstringIterator *it = (FMIndexSubstringIterator *) iterate_substring(s, len);
+	vector<uint32_t> ids;
+	while (it->hasNext())
+		ids.push_back(it->next());
+	delete it;
+	if (ids.empty()) {
 		*occs = NULL;
 		return 0;
 	}
-	uint num_occ, i;
-	uint32_t res = 0;
-	uint32_t temp;
-	num_occ = fm_index->locate(s, (uint) len, occs);
-	if (num_occ == 0) {
-		*occs = NULL;
-		return 0;
-	}
-	quicksort((*occs), 0, num_occ - 1);
-	i = 1;
-	(*occs)[res] = separators->rank1((*occs)[0]);
-	while (i < num_occ) {
-		temp = separators->rank1((*occs)[i]);
-		if (temp != (*occs)[res]) {
-			(*occs)[res + 1] = temp;
-			res++;
+	sort(ids.begin(), ids.end());
+	*occs = new uint32_t[ids.size()];
+	for (size_t i = 0; i < ids.size(); i++)
+		(*occs)[i] = ids[i];
+	return ids.size();
+}
+
+hdt::IteratorUInt *CSD_FMIndex::iterate_substring(unsigned char *s, uint32_t len) {
+	uint sp, ep;
+	if (!fm_index->backward_search(s, len, &sp, &ep))
+		return new FMIndexSubstringIterator(this, 1, 0);
+	return new FMIndexSubstringIterator(this, sp, ep);
+}
+
+uint32_t CSD_FMIndex::count_substring(unsigned char *s, uint32_t len) {
+	return fm_index->count(s, len);
+}
+
+uint32_t CSD_FMIndex::id_of_row(uint row) {
+	if (use_sampling)
+		return separators->rank1(fm_index->locate_row(row));
+	// The row of the '\1' before the string k is k+2, see extract().
+	return fm_index->row_of_previous(row, '\1') - 2;
+}
+
+FMIndexSubstringIterator::FMIndexSubstringIterator(CSD_FMIndex *fmindex, uint sp, uint ep) :
+		fmindex(fmindex), sp(sp), ep(ep) {
+	goToStart();
+}
+
+void FMIndexSubstringIterator::findNext() {
+	nextId = 0;
+	while (row <= ep) {
+		uint32_t id = fmindex->id_of_row(row++);
+		if (returned.insert(id).second) {
+			nextId = id;
+			return;
 		}
-		i++;
 	}
-	return res + 1;
+}
+
+bool FMIndexSubstringIterator::hasNext() {
+	return nextId != 0;
+}
+
+unsigned int FMIndexSubstringIterator::next() {
+	uint32_t id = nextId;
+	findNext();
+	return id;
+}
+
+void FMIndexSubstringIterator::goToStart() {
+	returned.clear();
+	row = sp;
+	findNext();
 }
 
 unsigned char * CSD_FMIndex::extract(uint32_t id) {
@@ -235,6 +276,20 @@ void CSD_FMIndex::freeString(const unsigned char *str) {
 	delete [] str;
 }
 
+size_t CSD_FMIndex::extract(uint32_t id, unsigned char *buffer, size_t capacity) {
+	if (id == 0 || id > numstrings)
+		return 0;
+	// The string is decoded backwards from the end of the buffer.
+	if (capacity < (size_t)maxlength+2)
+		return maxlength+1;
+	uint i;
+	if (id == numstrings)
+		i = 2;
+	else
+		i = id + 3;
+	return fm_index->extract_id(i, maxlength, buffer);
+}
+
 uint CSD_FMIndex::decompress(unsigned char **dict) {
 	uint len = 0;
 	unsigned char *text = new unsigned char[tlength];
@@ -312,41 +367,6 @@ CSD * CSD_FMIndex::load(istream & fp) {
 	return fm;
 }
 
-size_t CSD_FMIndex::get_pivot(uint32_t *occs, size_t ini, size_t end) {
-	size_t izq, der;
-	size_t pivot;
-	size_t temp;
-	pivot = occs[ini];
-	izq = ini;
-	der = end;
-	while (izq < der) {
-		while (occs[der] > pivot)
-			der--;
-		while ((izq < der) && (occs[izq] <= pivot))
-			izq++;
-		if (izq < der) {
-			temp = occs[izq];
-			occs[izq] = occs[der];
-			occs[der] = temp;
-		}
-	}
-	temp = occs[der];
-	occs[der] = occs[ini];
-	occs[ini] = temp;
-	return der;
-}
-
-void CSD_FMIndex::quicksort(uint32_t *occs, size_t ini, size_t end) {
-	size_t pivot;
-	if (ini < end) {
-		pivot = get_pivot(occs, ini, end);
-		if (pivot == ini)
-			return;
-		quicksort(occs, ini, pivot - 1);
-		quicksort(occs, pivot + 1, end);
-	}
-}
-
 void CSD_FMIndex::dumpAll() {
 	//FIXME: To be completed
 
@@ -42,6 +42,7 @@
 #include <BitSequenceBuilder.h>
 #include <BitSequence.h>
 #include "fmindex/SSA.h"
+#include "../sequence/IntSequence.hpp"
 
 #include <set>
 using namespace std;
@@ -81,6 +82,22 @@ namespace csd{
 			 * */
 			uint32_t locate_substring(unsigned char *s, uint32_t len, uint32_t **occs);
 
+			/** Returns the distinct IDs that contain s[1,..len] as a substring,
+			 * one at a time in no particular order, locating only the occurrences
+			 * needed to find the next one. It works with or without the sampling.
+			 *  @s: the substring to be located.
+			 *  @len: the length (in characters) of the string s.
+			 * */
+			hdt::IteratorUInt *iterate_substring(unsigned char *s, uint32_t len);
+
+			/** Returns the number of occurrences of s[1,..len] from the range of
+			 * the backward search, without locating them. A string that contains
+			 * it several times is counted several times.
+			 *  @s: the substring to be counted.
+			 *  @len: the length (in characters) of the string s.
+			 * */
+			uint32_t count_substring(unsigned char *s, uint32_t len);
+
 			/** Returns the string identified by id.
 			 * @id: the identifier to be extracted.
 			 **/
@@ -88,6 +105,11 @@ namespace csd{
 
 			void freeString(const unsigned char *str);
 
+			/** Decodes directly into buffer when it can hold the longest string,
+			 * otherwise returns the size that it needs.
+			 **/
+			size_t extract(uint32_t id, unsigned char *buffer, size_t capacity);
+
 			/** Obtains the original Tdict from its CSD_RePairDAC representation. Each 
 			 * string is separated by '\n' symbols.
 			 * @dict: the plain uncompressed dictionary.
@@ -126,10 +148,32 @@ namespace csd{
 			uint32_t maxlength;
 
 			void build_ssa(unsigned char *text, size_t len, bool sparse_bitsequence, int bparam, bool use_sample, size_t bwt_sample);
-			
-			void quicksort(uint32_t *occs, size_t ini, size_t len);
 
-			size_t get_pivot(uint32_t *occs, size_t ini, size_t end);
+			/** ID of the string that contains the suffix at the row of the BWT. */
+			uint32_t id_of_row(uint row);
+
+			friend class FMIndexSubstringIterator;
+	};
+
+	/**
+	 * Goes over the rows of the backward search of a substring, finding the
+	 * ID of each occurrence and skipping the IDs already returned.
+	 */
+	class FMIndexSubstringIterator : public hdt::IteratorUInt {
+		private:
+			CSD_FMIndex *fmindex;
+			uint sp, ep;	//! Range of rows of the occurrences.
+			uint row;	//! Next row to locate.
+			uint32_t nextId;	//! Next ID to return, 0 at the end.
+			set<uint32_t> returned;
+
+			void findNext();
+		public:
+			FMIndexSubstringIterator(CSD_FMIndex *fmindex, uint sp, uint ep);
+			virtual ~FMIndexSubstringIterator() { }
+			bool hasNext();
+			unsigned int next();
+			void goToStart();
 	};
 
 };
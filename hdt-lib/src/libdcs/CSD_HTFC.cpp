@@ -56,8 +56,9 @@ CSD_HTFC::CSD_HTFC(hdt::IteratorUCharString *it, uint32_t blocksize, hdt::Progre
 
 	vector<uint> xblocks; // Temporal storage for start positions
 
-	unsigned char *previousStr, *currentStr = NULL;
-	uint previousLength = 0, currentLength = 0;
+	string previousStr;
+	unsigned char *currentStr = NULL;
+	uint currentLength = 0;
 
 	while (it->hasNext())
 	{
@@ -101,7 +102,7 @@ CSD_HTFC::CSD_HTFC(hdt::IteratorUCharString *it, uint32_t blocksize, hdt::Progre
 			// Regular string
 
 			// Calculating the length of the long common prefix
-			uint delta = longest_common_prefix(previousStr, currentStr, previousLength, currentLength);
+			uint delta = longest_common_prefix((unsigned char *)previousStr.c_str(), currentStr, previousStr.length(), currentLength);
 
 			//cout << "Block: " << nblocks << " Pos: "<< length << endl;
 			//cout << previousStr << endl << currentStr << endl << " Delta: " << delta << " Difference: " << currentStr + delta << endl << endl;
@@ -120,8 +121,7 @@ CSD_HTFC::CSD_HTFC(hdt::IteratorUCharString *it, uint32_t blocksize, hdt::Progre
 
 		// New string processed
 		numstrings++;
-		memcpy(previousStr, currentStr, currentLength);
-		previousLength = currentLength;
+		previousStr.assign((char*)currentStr, currentLength);
 
 		it->freeStr(currentStr);
 		//NOTIFYCOND(listener, "Converting dictionary to HTFC", length, it->getNumberOfElements());
@@ -389,6 +389,18 @@ void CSD_HTFC::freeString(const unsigned char *str) {
 	delete [] str;
 }
 
+size_t CSD_HTFC::extract(uint32_t id, unsigned char *buffer, size_t capacity)
+{
+	if(!text || !blocks || id==0 || id>numstrings) {
+		return 0;
+	}
+	// The previous strings of the block are decoded in the same buffer.
+	if(capacity<=maxlength) {
+		return maxlength;
+	}
+	return extractInBlock((id-1)/blocksize, (id-1)%blocksize, buffer);
+}
+
 uint64_t CSD_HTFC::getSize()
 {
 	if(!text || !blocks) {
@@ -424,68 +436,105 @@ void CSD_HTFC::save(ostream & fp)
     }
 }
 
+/**
+ * Reads a block of memory as a stream, without copying it.
+ */
+class MemoryBuffer : public std::streambuf {
+public:
+	MemoryBuffer(unsigned char *begin, unsigned char *end) {
+		setg((char *)begin, (char *)begin, (char *)end);
+	}
+
+	/** Bytes read so far. */
+	size_t consumed() {
+		return gptr()-eback();
+	}
+};
+
 size_t CSD_HTFC::load(unsigned char *ptr, unsigned char *ptrMax)
 {
-    throw "Not implemented";
+	if(ptr>=ptrMax || ptr[0]!=HTFC) {
+		throw "Trying to read a CSD_HTFC but type does not match";
+	}
+
+	MemoryBuffer buffer(ptr+1, ptrMax);
+	istream in(&buffer);
+	loadFields(in);
+	if(!in.good()) {
+		throw "Could not read completely the CSD_HTFC.";
+	}
+	return 1+buffer.consumed();
 }
 
 CSD* CSD_HTFC::load(istream &fp)
 {
 	CSD_HTFC *dicc = new CSD_HTFC();
+	dicc->loadFields(fp);
+	return dicc;
+}
+
+void CSD_HTFC::loadFields(istream &fp)
+{
+	if(this->text) {
+		free(this->text);
+	}
+	if(this->blocks) {
+		delete this->blocks;
+	}
 
-	dicc->type = HTFC;  // Type already read by CSD
-	dicc->numstrings = loadValue<uint32_t>(fp);
-	dicc->tlength = loadValue<uint32_t>(fp);
-	dicc->maxlength = loadValue<uint32_t>(fp);
-	dicc->bytes = loadValue<uint64_t>(fp);
+	this->type = HTFC;  // Type already read by CSD
+	this->numstrings = loadValue<uint32_t>(fp);
+	this->tlength = loadValue<uint32_t>(fp);
+	this->maxlength = loadValue<uint32_t>(fp);
+	this->bytes = loadValue<uint64_t>(fp);
 
 
 #ifdef WIN32
-	dicc->text = (unsigned char *)malloc(dicc->bytes);
+	this->text = (unsigned char *)malloc(this->bytes);
 	const unsigned int blocksize = 8192;
 	unsigned int counter=0;
-	char *ptr = (char *)dicc->text;
-	while(counter<dicc->bytes && fp.good()) {
-		fp.read(ptr, dicc->bytes-counter > blocksize ? blocksize : dicc->bytes-counter);
+	char *ptr = (char *)this->text;
+	while(counter<this->bytes && fp.good()) {
+		fp.read(ptr, this->bytes-counter > blocksize ? blocksize : this->bytes-counter);
 		ptr += fp.gcount();
 		counter += fp.gcount();
 	}
-	//cout << "FINAL Read: " << counter << " / " << dicc->bytes << endl;
+	//cout << "FINAL Read: " << counter << " / " << this->bytes << endl;
 #else
-	dicc->text = (unsigned char *) malloc(dicc->bytes*sizeof(unsigned char*));
-	fp.read((char *)dicc->text, dicc->bytes);
+	this->text = (unsigned char *) malloc(this->bytes*sizeof(unsigned char*));
+	fp.read((char *)this->text, this->bytes);
 #endif
 
-	dicc->blocksize = loadValue<uint32_t>(fp);
-	dicc->nblocks = loadValue<uint32_t>(fp);
-	dicc->blocks = new Array(fp);
+	this->blocksize = loadValue<uint32_t>(fp);
+	this->nblocks = loadValue<uint32_t>(fp);
+	this->blocks = new Array(fp);
 
 	/* HUTUCKER */
 
-	dicc->tree = new BitString(fp);
+	this->tree = new BitString(fp);
 
 	// Building HTtree
-	dicc->HTtree = new Node[dicc->tree->getLength()/2];
+	this->HTtree = new Node[this->tree->getLength()/2];
 
 	vector<uint> traversing;
 	uint node = 0, symbol = 0;
 
-	for (uint i=0; i<dicc->tree->getLength(); i++)
+	for (uint i=0; i<this->tree->getLength(); i++)
 	{
-		if (dicc->tree->getBit(i) == 0)
+		if (this->tree->getBit(i) == 0)
 		{
-			dicc->HTtree[node].children[0] = -1;
-			dicc->HTtree[node].children[1] = -1;
-			dicc->HTtree[node].symbol = 0;
+			this->HTtree[node].children[0] = -1;
+			this->HTtree[node].children[1] = -1;
+			this->HTtree[node].symbol = 0;
 
 			if (traversing.size() > 0)
 			{
 				uint parent = traversing[traversing.size()-1];
 
-				if (dicc->HTtree[parent].symbol == 0) dicc->HTtree[parent].children[0] = node;
-				else dicc->HTtree[parent].children[1] = node;
+				if (this->HTtree[parent].symbol == 0) this->HTtree[parent].children[0] = node;
+				else this->HTtree[parent].children[1] = node;
 
-				dicc->HTtree[parent].symbol++;
+				this->HTtree[parent].symbol++;
 			}
 
 			traversing.push_back(node);
@@ -498,27 +547,55 @@ CSD* CSD_HTFC::load(istream &fp)
 
 			if (last == (node-1))
 			{
-				dicc->HTtree[last].symbol = symbol;
+				this->HTtree[last].symbol = symbol;
 				symbol++;
 			}
 			else
 			{
-				dicc->HTtree[last].symbol = -1;
+				this->HTtree[last].symbol = -1;
 			}
 		}
 	}
 
-	dicc->leafs = loadValue<uint>(fp);
-	dicc->HTcode = new Tcode[dicc->leafs];
+	this->leafs = loadValue<uint>(fp);
+	this->HTcode = new Tcode[this->leafs];
 
-	for (uint i=0; i<dicc->leafs; i++)
+	for (uint i=0; i<this->leafs; i++)
 	{
-		dicc->HTcode[i].code = loadValue<uint>(fp);
-		dicc->HTcode[i].cbits = loadValue<uint>(fp);
+		this->HTcode[i].code = loadValue<uint>(fp);
+		this->HTcode[i].cbits = loadValue<uint>(fp);
 	}
+}
 
+hdt::IteratorUCharString *CSD_HTFC::listAll()
+{
+	if(!text || !blocks) {
+		return new hdt::IteratorUCharString();
+	}
+	return new HTFCIterator(this);
+}
 
-	return dicc;
+unsigned char *HTFCIterator::next()
+{
+	uint len;
+	if(count%htfc->blocksize==0) {
+		// The first string of a block is complete.
+		uint delta;
+		pos = htfc->blocks->getField(count/htfc->blocksize);
+		pos += VByte::decode(htfc->text+pos, htfc->text+htfc->bytes, &delta);
+		offset = 0;
+		len = htfc->decompressFirstWord(htfc->text, &pos, current);
+	} else {
+		// The others keep a prefix of the previous one.
+		uchar deltaseq[DELTA];
+		uint delta;
+		htfc->decompressDelta(htfc->text, &pos, &offset, deltaseq);
+		VByte::decode(deltaseq, deltaseq+DELTA, &delta);
+		len = delta+htfc->decompressWord(htfc->text, &pos, &offset, current+delta);
+	}
+	current[len] = '\0';
+	count++;
+	return current;
 }
 
 bool CSD_HTFC::locateBlock(const unsigned char *s, uint *block)
@@ -658,9 +735,9 @@ uint CSD_HTFC::locateInBlock(uint block, const unsigned char *s, uint len)
 	return id;
 }
 
-void CSD_HTFC::extractInBlock(uint block, uint o, unsigned char *s)
+uint CSD_HTFC::extractInBlock(uint block, uint o, unsigned char *s)
 {
-	unsigned char *deltaseq = new unsigned char[DELTA];
+	unsigned char deltaseq[DELTA];
 	uint delta;
 	uint offset = 0;
 
@@ -679,7 +756,51 @@ void CSD_HTFC::extractInBlock(uint block, uint o, unsigned char *s)
 	}
 
 	s[delta] = '\0';
-	delete [] deltaseq;
+	return delta;
+}
+
+uint32_t CSD_HTFC::getBlockSize()
+{
+	return blocksize;
+}
+
+void CSD_HTFC::extractBlock(uint32_t block, std::string &data, std::vector<uint32_t> &offsets)
+{
+	data.clear();
+	offsets.clear();
+	if(!text || !blocks || (uint64_t)block*blocksize>=numstrings) {
+		offsets.push_back(0);
+		return;
+	}
+
+	// As extractInBlock(), keeping every string of the block.
+	unsigned char *s = new unsigned char[maxlength+1];
+	unsigned char deltaseq[DELTA];
+	uint delta;
+	uint offset = 0;
+
+	uint pos = blocks->getField(block);
+	pos += VByte::decode(text+pos, text+bytes, &delta);
+	delta = decompressFirstWord(text, &pos, s);
+
+	uint32_t first = block*blocksize+1;
+	for(uint32_t id=first; ; id++) {
+		offsets.push_back(data.size());
+		data.append((char *)s, delta);
+		data.push_back('\0');
+		if(id+1>=first+blocksize || id+1>numstrings) {
+			break;
+		}
+
+		// Decoding the prefix (delta)
+		decompressDelta(text, &pos, &offset, deltaseq);
+		VByte::decode(deltaseq, deltaseq+DELTA, &delta);
+
+		// Decoding the suffix
+		delta += decompressWord(text, &pos, &offset, s+delta);
+	}
+	offsets.push_back(data.size());
+	delete [] s;
 }
 
 void CSD_HTFC::decompressDelta(unsigned char *seq, uint *pos, uint *offset, unsigned char *deltaseq)
@@ -58,6 +58,8 @@ typedef struct
 
 static const size_t DELTA = 5;        // Maxixum possible length for a VByte encoding delta.
 
+class HTFCIterator;
+
 class CSD_HTFC : public CSD
 {		
   public:		
@@ -83,6 +85,11 @@ class CSD_HTFC : public CSD
 
     void freeString(const unsigned char *str);
 
+    /** Decodes directly into buffer when it can hold the longest string,
+	otherwise returns that longest length.
+    */
+    size_t extract(uint32_t id, unsigned char *buffer, size_t capacity);
+
     /** Obtains the original Tdict from its CSD_HTFC representation. Each string is
 	separated by '\n' symbols.
 	@dict: the plain uncompressed dictionary.
@@ -93,6 +100,10 @@ class CSD_HTFC : public CSD
     void dumpAll();
     void dumpBlock(uint block);
 
+    uint32_t getBlockSize();
+
+    void extractBlock(uint32_t block, std::string &data, std::vector<uint32_t> &offsets);
+
     /** Returns the size of the structure in bytes. */
     uint64_t getSize();
 
@@ -101,6 +112,9 @@ class CSD_HTFC : public CSD
     */
     void save(ostream & fp);
 
+    /** The structures of libcds cannot be mapped, so they are read from
+	memory as from a stream, copying them.
+    */
     size_t load(unsigned char *ptr, unsigned char *ptrMax);
 
     /** Loads a CSD_HTFC structure from a file pointer.
@@ -109,7 +123,7 @@ class CSD_HTFC : public CSD
 
     void fillSuggestions(const char *base, vector<string> &out, int maxResults);
 		
-    hdt::IteratorUCharString *listAll() { throw "Not implemented"; }
+    hdt::IteratorUCharString *listAll();
 
   protected:
     uint64_t bytes;	//! Size of the Front-Coding encoded sequence (in bytes).
@@ -126,6 +140,9 @@ class CSD_HTFC : public CSD
     Tcode *HTcode;	//! Vector assigning Hu-Tucker codes to the symbols in the text.
     bool search;
 
+    /** Reads all the fields that follow the type. */
+    void loadFields(istream & fp);
+
     /** Locates the block in where the string 's' can be stored. This method is
 	based on a binary search comparing the first string in each block and
 	the given string 's'.
@@ -149,8 +166,9 @@ class CSD_HTFC : public CSD
 	@block: block to be accesed.
 	@o: internal offset for the required string in the block.
 	@s: the extracted string.
+	@return: the length of the string.
     */
-    void extractInBlock(uint block, uint o, uchar *s);
+    uint extractInBlock(uint block, uint o, uchar *s);
 
     /** Obtains the length of the long common prefix (lcp) of str1 and str2.
 	@str1: first string in the comparison.
@@ -202,7 +220,44 @@ class CSD_HTFC : public CSD
 	@return: the decoded char.
     */
     uchar decodeHT(uchar *seq, uint *pos, uint *offset);
+
+    friend class HTFCIterator;
   };
+
+/**
+ * Decodes all the strings of a CSD_HTFC in order, continuing each one from
+ * the previous string of its block.
+ */
+class HTFCIterator : public hdt::IteratorUCharString {
+private:
+	CSD_HTFC *htfc;
+	uint32_t count;
+	uint pos;	//! Byte of the text after the last decoded string.
+	uint offset;	//! Bit within that byte.
+	uchar *current;
+public:
+	HTFCIterator(CSD_HTFC *htfc) : htfc(htfc), count(0), pos(0), offset(0) {
+		current = new uchar[htfc->maxlength+1];
+	}
+
+	virtual ~HTFCIterator() {
+		delete [] current;
+	}
+
+	bool hasNext() {
+		return count<htfc->numstrings;
+	}
+
+	unsigned char *next();
+
+	unsigned int getNumberOfElements() {
+		return htfc->numstrings;
+	}
+
+	virtual void freeStr(unsigned char *ptr) {
+		// The string belongs to the iterator.
+	}
+};
 };
 
 #endif  
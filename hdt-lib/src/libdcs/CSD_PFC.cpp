@@ -34,7 +34,7 @@
 
 namespace csd
 {
-CSD_PFC::CSD_PFC() : isMapped(false)
+CSD_PFC::CSD_PFC() : isMapped(false), headSampling(0)
 {
 	this->type = PFC;
 	this->numstrings = 0;
@@ -45,7 +45,7 @@ CSD_PFC::CSD_PFC() : isMapped(false)
 	this->blocks = NULL;
 }
 
-CSD_PFC::CSD_PFC(hdt::IteratorUCharString *it, uint32_t blocksize, hdt::ProgressListener *listener) : isMapped(false)
+CSD_PFC::CSD_PFC(hdt::IteratorUCharString *it, uint32_t blocksize, hdt::ProgressListener *listener) : isMapped(false), headSampling(0)
 {
     this->type = PFC;
     this->numstrings = 0;
@@ -121,6 +121,8 @@ CSD_PFC::CSD_PFC(hdt::IteratorUCharString *it, uint32_t blocksize, hdt::Progress
     text = (unsigned char *) realloc(text, bytes*sizeof(unsigned char));
 
     blocks->reduceBits();
+
+    buildHeadIndex();
 }
 
 CSD_PFC::~CSD_PFC()
@@ -187,6 +189,14 @@ void CSD_PFC::freeString(const unsigned char *str) {
 	delete [] str;
 }
 
+size_t CSD_PFC::extract(uint32_t id, unsigned char *buffer, size_t capacity)
+{
+	if(!text || !blocks || id==0 || id>numstrings) {
+		return 0;
+	}
+	return extractInBlock((id-1)/blocksize, (id-1)%blocksize, buffer, capacity);
+}
+
 uint64_t CSD_PFC::getSize()
 {
 	if(!text || !blocks) {
@@ -292,6 +302,8 @@ CSD* CSD_PFC::load(istream & fp)
 		throw "Checksum error in the data section of the Plain Front Coding.";
 	}
 
+	dicc->buildHeadIndex();
+
 	return dicc;
 }
 
@@ -329,17 +341,84 @@ size_t CSD_PFC::load(unsigned char *ptr, unsigned char *ptrMax) {
 
 	isMapped=true;
 
+	buildHeadIndex();
+
 	return count;
 }
 
+void CSD_PFC::buildHeadIndex()
+{
+	headOffsets.clear();
+	headKeys.clear();
+	if(headSampling==0 || !text || !blocks || nblocks<=headSampling) {
+		return;
+	}
+
+	// The key of the first sample is empty, it is never used for comparing.
+	const unsigned char *previous = (const unsigned char *)"";
+	for(size_t block=0; block<nblocks; block+=headSampling) {
+		const unsigned char *head = text+blocks->get(block);
+		size_t len = 0;
+		if(block>0) {
+			while(previous[len]==head[len]) {
+				len++;
+			}
+			len++;
+		}
+		headOffsets.push_back(headKeys.size());
+		headKeys.insert(headKeys.end(), head, head+len);
+		headKeys.push_back('\0');
+		previous = head;
+	}
+}
+
+void CSD_PFC::setHeadSampling(uint32_t rate)
+{
+	headSampling = rate;
+	buildHeadIndex();
+}
+
+uint32_t CSD_PFC::getHeadSampling() const
+{
+	return headSampling;
+}
+
 bool CSD_PFC::locateBlock(const unsigned char *s, unsigned int *block)
 {
 	if(nblocks==0) {
 		return false;
 	}
 
-	long long int left = 0, right = nblocks-1, center;
-	int cmp;
+	if(headOffsets.size()==0) {
+		return locateBlock(s, block, 0, nblocks-1);
+	}
+
+	// Last sampled head whose key is not bigger than s. The keys are small and
+	// contiguous, so this search does not touch the encoded text.
+	size_t left = 1, right = headOffsets.size();
+	while(left<right) {
+		size_t center = (left+right)/2;
+		if(strcmp(&headKeys[headOffsets[center]], (const char *)s)<=0) {
+			left = center+1;
+		} else {
+			right = center;
+		}
+	}
+	size_t sample = left-1;
+
+	// s can be bigger than the key and still smaller than the head itself.
+	size_t first = sample*headSampling;
+	if(sample>0 && strcmp((char *)(text+blocks->get(first)), (const char *)s)>0) {
+		first -= headSampling;
+	}
+	size_t last = first+headSampling<nblocks ? first+headSampling : nblocks;
+	return locateBlock(s, block, first, last-1);
+}
+
+bool CSD_PFC::locateBlock(const unsigned char *s, unsigned int *block, unsigned int first, unsigned int last)
+{
+	long long int left = first, right = last, center = first;
+	int cmp = 0;
 
 	while (left <= right)
 	{
@@ -383,55 +462,68 @@ bool CSD_PFC::locateBlock(const unsigned char *s, unsigned int *block)
 	return false;
 }
 
-unsigned int CSD_PFC::locateInBlock(unsigned int block, const unsigned char *str, unsigned int len)
+unsigned int CSD_PFC::locateInBlock(unsigned int block, const unsigned char *str, unsigned int len, size_t *end)
 {
 	if(block>=nblocks){
 		return 0;
 	}
 
-	unsigned int delta = 0;
-	unsigned int idInBlock = 0;
 	unsigned int commonPrefix = 0;
 
 	size_t pos = blocks->get(block);
 
-	// Read the first string
-	std::string tmpStr((char*)text+pos);
+	// Compare the first string, it must be smaller than the searched one.
+	const unsigned char *head = text+pos;
+	while(commonPrefix<len && head[commonPrefix]!='\0' && head[commonPrefix]==str[commonPrefix]) {
+		commonPrefix++;
+	}
+	if(commonPrefix<len && head[commonPrefix]>str[commonPrefix]) {
+		return 0;
+	}
 
-	pos+=tmpStr.length()+1;
-	idInBlock++;
+	pos+=commonPrefix+strlen((char*)head+commonPrefix)+1;
 
-	// Read the rest
+	return scanBlock(1, pos, commonPrefix, str, len, end);
+}
+
+unsigned int CSD_PFC::scanBlock(unsigned int idInBlock, size_t pos, unsigned int commonPrefix, const unsigned char *str, unsigned int len, size_t *end)
+{
+	unsigned int delta = 0;
+
+	// Check the rest directly in the text, keeping the common prefix of the
+	// previous string with the searched one.
 	while ( (idInBlock<blocksize) && (pos<bytes))
 	{
 		// Decode the prefix
 		pos += VByte::decode(text+pos, text+bytes, &delta);
+		const unsigned char *suffix = text+pos;
 
-		// Copy the suffix
-		tmpStr.resize(delta);
-		tmpStr.append((char*)(text+pos));
+		if (delta < commonPrefix) {
+			// It differs before the common prefix, so it is already bigger.
+			return 0;
+		}
 
-		if (delta >= commonPrefix)
-		{
-			// Compare tmpString with the searched one, only after commonPrefix characters.
-			// (We already knew that commonPrefix was common anyway).
-			commonPrefix += longest_common_prefix(
-					(unsigned char*)tmpStr.c_str()+commonPrefix,
-					str+commonPrefix,
-					tmpStr.length()-commonPrefix,
-					len-commonPrefix
-				);
-
-			// We found it!
-			if ((commonPrefix == len) && (tmpStr.length() == len)) {
+		unsigned int matched = 0;
+		if (delta == commonPrefix) {
+			while(commonPrefix+matched<len && suffix[matched]!='\0' && suffix[matched]==str[commonPrefix+matched]) {
+				matched++;
+			}
+			if(suffix[matched]=='\0' && commonPrefix+matched==len) {
+				// We found it!
+				if(end!=NULL) {
+					*end = pos+matched+1;
+				}
 				return idInBlock;
 			}
-		} else {
-			// The common prefix is even worse than before, not found.
-			return 0;
+			if(commonPrefix+matched==len || (suffix[matched]!='\0' && suffix[matched]>str[commonPrefix+matched])) {
+				// Bigger than the searched one, not found.
+				return 0;
+			}
+			commonPrefix += matched;
 		}
+		// Otherwise it keeps the byte of the previous string that was smaller.
 
-		pos += tmpStr.length()+1-delta;
+		pos += matched+strlen((char*)suffix+matched)+1;
 		idInBlock++;
 	}
 
@@ -466,6 +558,179 @@ unsigned char *CSD_PFC::extractInBlock(unsigned int block, unsigned int o)
 	return buf;
 }
 
+size_t CSD_PFC::extractInBlock(unsigned int block, unsigned int o, unsigned char *buffer, size_t capacity)
+{
+	size_t pos = blocks->get(block);
+	unsigned int delta = 0;
+	size_t len = 0;
+
+	// Each string is the prefix of the previous one plus its suffix. Bytes
+	// beyond the capacity are only counted, the prefixes that reach them are
+	// longer than the capacity so the final string does not fit anyway.
+	const unsigned char *suffix = text+pos;
+	for (unsigned int j=0; ; j++)
+	{
+		len = delta;
+		while(*suffix) {
+			if(len<capacity) {
+				buffer[len] = *suffix;
+			}
+			len++;
+			suffix++;
+		}
+		pos = suffix-text+1;
+
+		if(j==o) {
+			break;
+		}
+		pos += VByte::decode(text+pos, text+bytes, &delta);
+		suffix = text+pos;
+	}
+
+	if(len<capacity) {
+		buffer[len] = '\0';
+	}
+	return len;
+}
+
+uint32_t CSD_PFC::getBlockSize()
+{
+	return blocksize;
+}
+
+void CSD_PFC::extractBlock(uint32_t block, std::string &data, std::vector<uint32_t> &offsets)
+{
+	data.clear();
+	offsets.clear();
+	if(!text || !blocks || (uint64_t)block*blocksize>=numstrings) {
+		offsets.push_back(0);
+		return;
+	}
+
+	size_t pos = blocks->get(block);
+	unsigned int delta = 0;
+	string current;
+	uint32_t first = block*blocksize+1;
+	for(uint32_t id=first; id<first+blocksize && id<=numstrings; id++) {
+		if(id>first) {
+			pos += VByte::decode(text+pos, text+bytes, &delta);
+		}
+		size_t len = strlen((char *)(text+pos));
+		current.resize(delta);
+		current.append((char *)(text+pos), len);
+		pos += len+1;
+
+		offsets.push_back(data.size());
+		data.append(current);
+		data.push_back('\0');
+	}
+	offsets.push_back(data.size());
+}
+
+void CSD_PFC::extractMany(const std::vector<uint32_t> &ids, std::vector<std::string> &out)
+{
+	out.resize(ids.size());
+	PFCCursor cursor(this);
+	for(size_t i=0;i<ids.size();i++) {
+		out[i] = cursor.extract(ids[i]);
+	}
+}
+
+void CSD_PFC::locateMany(const std::vector<std::string> &strings, std::vector<uint32_t> &ids)
+{
+	if(ids.size()!=strings.size()) {
+		ids.assign(strings.size(), 0);
+	}
+	if(!text || !blocks || nblocks==0) {
+		return;
+	}
+
+	// The last string found is also the last one decoded in its block. A
+	// bigger string that is before the next block continues the scan from
+	// it, with their common prefix. Any other string is located as usual.
+	const unsigned char *previous = NULL;
+	unsigned int block = 0;
+	unsigned int idInBlock = 0;
+	size_t pos = 0;
+
+	for(size_t i=0;i<strings.size();i++) {
+		const unsigned char *str = (const unsigned char *)strings[i].c_str();
+		unsigned int len = strings[i].length();
+		if(ids[i]!=0 || len==0) {
+			continue;
+		}
+
+		if(previous!=NULL) {
+			unsigned int common = 0;
+			while(previous[common]!='\0' && previous[common]==str[common]) {
+				common++;
+			}
+			if(previous[common]=='\0' && str[common]=='\0') {
+				ids[i] = block*blocksize+idInBlock+1;
+				continue;
+			}
+			if(previous[common]<str[common]
+					&& (block+1==nblocks || strcmp((char *)(text+blocks->get(block+1)), (const char *)str)>0)) {
+				unsigned int found = scanBlock(idInBlock+1, pos, common, str, len, &pos);
+				if(found!=0) {
+					idInBlock = found;
+					previous = str;
+					ids[i] = block*blocksize+idInBlock+1;
+				}
+				continue;
+			}
+		}
+
+		unsigned int candidate;
+		unsigned int found;
+		if(locateBlock(str, &candidate)) {
+			found = 0;
+			pos = blocks->get(candidate);
+			pos += strlen((char *)(text+pos))+1;
+		} else {
+			found = locateInBlock(candidate, str, len, &pos);
+			if(found==0) {
+				continue;
+			}
+		}
+		block = candidate;
+		idInBlock = found;
+		previous = str;
+		ids[i] = block*blocksize+idInBlock+1;
+	}
+}
+
+const std::string &PFCCursor::extract(uint32_t id)
+{
+	if(!pfc->text || !pfc->blocks || id==0 || id>pfc->numstrings) {
+		this->id = 0;
+		current.clear();
+		return current;
+	}
+
+	// Going back or to another block starts again from the head of the block.
+	unsigned int block = (id-1)/pfc->blocksize;
+	if(this->id==0 || id<this->id || (this->id-1)/pfc->blocksize!=block) {
+		pos = pfc->blocks->get(block);
+		current.assign((char *)(pfc->text+pos));
+		pos += current.length()+1;
+		this->id = block*pfc->blocksize+1;
+	}
+
+	unsigned int delta = 0;
+	while(this->id<id) {
+		// Decode the prefix and append the suffix
+		pos += VByte::decode(pfc->text+pos, pfc->text+pfc->bytes, &delta);
+		const char *suffix = (char *)(pfc->text+pos);
+		size_t len = strlen(suffix);
+		current.resize(delta);
+		current.append(suffix, len);
+		pos += len+1;
+		this->id++;
+	}
+	return current;
+}
+
 unsigned int CSD_PFC::longest_common_prefix(const unsigned char* str1, const unsigned char* str2, unsigned int lstr1, unsigned int lstr2)
 {
 	unsigned int delta = 0;
@@ -483,6 +748,68 @@ hdt::IteratorUCharString *CSD_PFC::listAll() {
 	return new PFCIterator(this);
 }
 
+/**
+ * Compare the string str with s[0..len). If prefix is true, only its first
+ * len characters, so the strings that start with s are equal.
+ */
+static inline int comparePrefix(const char *str, const unsigned char *s, uint32_t len, bool prefix)
+{
+	int cmp = strncmp(str, (const char *)s, len);
+	if(cmp!=0 || prefix) {
+		return cmp;
+	}
+	return str[len]=='\0' ? 0 : 1;
+}
+
+uint32_t CSD_PFC::countBefore(const unsigned char *s, uint32_t len, bool prefix)
+{
+	if(!text || !blocks) {
+		return 0;
+	}
+
+	// First block whose head does not go before s, the previous one has the limit.
+	unsigned int left = 0, right = nblocks;
+	while(left<right) {
+		unsigned int center = left+(right-left)/2;
+		int cmp = comparePrefix((char *)(text+blocks->get(center)), s, len, prefix);
+		if(cmp<0 || (prefix && cmp==0)) {
+			left = center+1;
+		} else {
+			right = center;
+		}
+	}
+	if(left==0) {
+		return 0;
+	}
+	unsigned int block = left-1;
+
+	// Count the strings of the block that go before s.
+	size_t pos = blocks->get(block);
+	std::string current((char *)(text+pos));
+	pos += current.length()+1;
+	uint32_t count = 1;
+	unsigned int delta = 0;
+	while(count<blocksize && pos<bytes) {
+		pos += VByte::decode(text+pos, text+bytes, &delta);
+		current.resize(delta);
+		current.append((char *)(text+pos));
+		pos += current.length()+1-delta;
+
+		int cmp = comparePrefix(current.c_str(), s, len, prefix);
+		if(!(cmp<0 || (prefix && cmp==0))) {
+			break;
+		}
+		count++;
+	}
+	return block*blocksize+count;
+}
+
+void CSD_PFC::prefixRange(const unsigned char *prefix, uint32_t len, uint32_t *begin, uint32_t *end)
+{
+	*begin = countBefore(prefix, len, false)+1;
+	*end = countBefore(prefix, len, true)+1;
+}
+
 void CSD_PFC::fillSuggestions(const char *base, vector<std::string> &out, int maxResults)
 {
 	unsigned int block;
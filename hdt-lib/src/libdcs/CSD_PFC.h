@@ -51,6 +51,10 @@ class PFCIterator;
 class CSD_PFC : public CSD
 {		
   public:		
+    /** Head sampling worth trying with setHeadSampling(), there is no
+	upper index unless it is requested. */
+    const static uint32_t SUGGESTED_HEAD_SAMPLING = 8;
+
     /** General constructor **/
     CSD_PFC();
 
@@ -73,6 +77,17 @@ class CSD_PFC : public CSD
 
     void freeString(const unsigned char *str);
 
+    size_t extract(uint32_t id, unsigned char *buffer, size_t capacity);
+
+    void extractMany(const std::vector<uint32_t> &ids, std::vector<std::string> &out);
+
+    void locateMany(const std::vector<std::string> &strings, std::vector<uint32_t> &ids);
+
+    /** Finds the range of IDs of the strings that start with a prefix with
+	two binary searches on the block heads, decoding one block for each.
+    */
+    void prefixRange(const unsigned char *prefix, uint32_t len, uint32_t *begin, uint32_t *end);
+
     /** Obtains the original Tdict from its CSD_PFC representation. Each string is
 	separated by '\n' symbols.
 	@dict: the plain uncompressed dictionary.
@@ -80,6 +95,10 @@ class CSD_PFC : public CSD
     */
     unsigned int decompress(unsigned char **dict);
 
+    uint32_t getBlockSize();
+
+    void extractBlock(uint32_t block, std::string &data, std::vector<uint32_t> &offsets);
+
     /** Returns the size of the structure in bytes. */
     uint64_t getSize();
 
@@ -94,6 +113,14 @@ class CSD_PFC : public CSD
 	@fp: pointer to the file storing a CSD_PFC structure. */
     static CSD * load(istream & fp);
 
+    /** Builds an upper index for locate() keeping one block head out of
+	rate, or drops it with 0, the default. It is built in memory, so the
+	saved format does not change. FourSectionDictionary calls it with the
+	option dictionary.<section>.headsampling.
+    */
+    void setHeadSampling(uint32_t rate);
+    uint32_t getHeadSampling() const;
+
     void fillSuggestions(const char *base, vector<string> &out, int maxResults);
 		
     hdt::IteratorUCharString *listAll();
@@ -107,6 +134,13 @@ class CSD_PFC : public CSD
     hdt::LogSequence2 *blocks;	//! Start positions of each block in the encoded sequence.
     uint32_t nblocks;   //! Number of blocks
 
+    uint32_t headSampling;	//! Blocks between the sampled heads, 0 without upper index.
+    std::vector<uint32_t> headOffsets;	//! Start of the key of each sampled head in headKeys.
+    std::vector<char> headKeys;	//! Shortest prefix of each sampled head that is bigger than the previous one.
+
+    /** Builds the upper index of sampled block heads. */
+    void buildHeadIndex();
+
     /** Locates the block in where the string 's' can be stored. This method is
 	based on a binary search comparing the first string in each block and
 	the given string 's'.
@@ -117,14 +151,34 @@ class CSD_PFC : public CSD
     */
     bool locateBlock(const unsigned char *s, unsigned int *block);
 
+    /** Same as locateBlock(), searching only the blocks from left to right.
+	The first string of the left block must not be bigger than 's', unless
+	left is 0.
+    */
+    bool locateBlock(const unsigned char *s, unsigned int *block, unsigned int left, unsigned int right);
+
+    /** Number of strings smaller than s[0..len) or, if prefix is true,
+	that are smaller or start with it.
+    */
+    uint32_t countBefore(const unsigned char *s, uint32_t len, bool prefix);
+
     /** Locates the offset for 's' in 'block' (returning its global ID) or 
 	return 0 if it is  not exist 
 	@block: block to be queried.
 	@s: the required string.
 	@len: the length (in characters) of the string s.
 	@return: the ID for 's' or 0 if it is not exist.
+	@end: if not NULL and 's' is found, the position after it in the text.
+    */
+    unsigned int locateInBlock(unsigned int block, const unsigned char *s, unsigned int len, size_t *end=NULL);
+
+    /** Continues the scan of a block with the string idInBlock, whose
+	encoding starts at pos. The previous string is smaller than 's' and has
+	its first commonPrefix characters. Returns the position of 's' in the
+	block, or 0 if it is not there. When found, *end (if not NULL) is the
+	position after it.
     */
-    unsigned int locateInBlock(unsigned int block, const unsigned char *s, unsigned int len);
+    unsigned int scanBlock(unsigned int idInBlock, size_t pos, unsigned int commonPrefix, const unsigned char *s, unsigned int len, size_t *end);
 
     /** Extracts the o-th string in the given 'block'.
 	@block: block to be accesed.
@@ -133,6 +187,12 @@ class CSD_PFC : public CSD
     */
     unsigned char *extractInBlock(unsigned int block, unsigned int o);
 
+    /** Extracts the o-th string in the given 'block' into buffer, writing
+	at most capacity bytes.
+	@return: the length of the string, even if it did not fit.
+    */
+    size_t extractInBlock(unsigned int block, unsigned int o, unsigned char *buffer, size_t capacity);
+
 
     /** Obtains the length of the long common prefix (lcp) of str1 and str2.
 	@str1: first string in the comparison.
@@ -143,15 +203,36 @@ class CSD_PFC : public CSD
     inline unsigned int longest_common_prefix(const unsigned char* str1, const unsigned char* str2, unsigned int lstr1, unsigned int lstr2);
 
     friend class PFCIterator;
+    friend class PFCCursor;
   };
 
-class PFCIterator : public hdt::IteratorUCharString {
+/**
+ * Decodes strings of a CSD_PFC remembering the last one, so that the next IDs
+ * of the same block continue from it instead of from the head of the block.
+ */
+class PFCCursor {
 private:
 	CSD_PFC *pfc;
+	uint32_t id;		//! Last decoded ID, 0 if none.
+	size_t pos;		//! Position in the text after the last decoded string.
+	std::string current;
+public:
+	PFCCursor(CSD_PFC *pfc) : pfc(pfc), id(0), pos(0) { }
+
+	/** Returns the string identified by id, or an empty string if it does
+	not exist. It is valid until the next call.
+	@id: the identifier to be extracted.
+	*/
+	const std::string &extract(uint32_t id);
+};
+
+class PFCIterator : public hdt::IteratorUCharString {
+private:
+	PFCCursor cursor;
 	size_t max;
 	size_t count;
 public:
-	PFCIterator(CSD_PFC *pfc) : pfc(pfc), count(1) {
+	PFCIterator(CSD_PFC *pfc) : cursor(pfc), count(1) {
 		max = pfc->getLength();
 	}
 
@@ -162,7 +243,7 @@ public:
 	}
 
 	unsigned char *next() {
-		return pfc->extract(count++);
+		return (unsigned char *)cursor.extract(count++).c_str();
 	}
 
 	unsigned int getNumberOfElements() {
@@ -170,7 +251,7 @@ public:
 	}
 
 	virtual void freeStr(unsigned char *ptr) {
-		pfc->freeString(ptr);
+		// The string belongs to the cursor.
 	}
 };
 
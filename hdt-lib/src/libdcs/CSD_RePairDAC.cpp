@@ -0,0 +1,519 @@
+/* CSD_RePairDAC.cpp
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+
+#include "../util/crc8.h"
+
+#include "CSD_RePairDAC.h"
+#include "VByte.h"
+
+namespace csd
+{
+
+/** Symbols of the strings while building, the characters keep their value and rule r is FIRST_RULE+r. */
+static const uint32_t FIRST_RULE = 256;
+
+CSD_RePairDAC::CSD_RePairDAC() : bytes(0), maxlength(0), height(0), numterminals(0), rules(NULL), blocksize(0), nblocks(0), blocks(NULL), symbols(NULL)
+{
+	this->type = REPAIRDAC;
+	this->numstrings = 0;
+}
+
+/**
+ * Replaces the most frequent pairs of adjacent symbols of seq, where 0
+ * separates the strings, with new rules appended to pairs.
+ * @return: false if no pair is frequent enough.
+ */
+static bool replacePairs(std::vector<uint32_t> &seq, std::vector<uint32_t> &pairs)
+{
+	// Count the pairs by sorting them.
+	std::vector<uint64_t> keys;
+	keys.reserve(seq.size());
+	for(size_t i=0; i+1<seq.size(); i++) {
+		if(seq[i]!=0 && seq[i+1]!=0) {
+			keys.push_back(((uint64_t)seq[i] << 32) | seq[i+1]);
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+
+	std::vector<std::pair<uint32_t, uint64_t> > frequent;
+	for(size_t i=0; i<keys.size(); ) {
+		size_t j=i+1;
+		while(j<keys.size() && keys[j]==keys[i]) {
+			j++;
+		}
+		if(j-i>=CSD_RePairDAC::MIN_FREQUENCY) {
+			frequent.push_back(std::make_pair((uint32_t)(j-i), keys[i]));
+		}
+		i=j;
+	}
+	std::vector<uint64_t>().swap(keys);
+
+	if(frequent.empty()) {
+		return false;
+	}
+	if(frequent.size()>CSD_RePairDAC::MAX_RULES_PER_ROUND) {
+		std::nth_element(frequent.begin(), frequent.begin()+CSD_RePairDAC::MAX_RULES_PER_ROUND, frequent.end(), std::greater<std::pair<uint32_t, uint64_t> >());
+		frequent.resize(CSD_RePairDAC::MAX_RULES_PER_ROUND);
+	}
+
+	// New rule for each chosen pair, sorted by pair to find them.
+	uint32_t nextSymbol = FIRST_RULE+pairs.size()/2;
+	std::vector<std::pair<uint64_t, uint32_t> > chosen(frequent.size());
+	std::vector<bool> first(nextSymbol, false);
+	for(size_t i=0; i<frequent.size(); i++) {
+		uint64_t key = frequent[i].second;
+		chosen[i] = std::make_pair(key, (uint32_t)0);
+		first[key>>32] = true;
+	}
+	std::sort(chosen.begin(), chosen.end());
+	for(size_t i=0; i<chosen.size(); i++) {
+		pairs.push_back(chosen[i].first>>32);
+		pairs.push_back(chosen[i].first & 0xFFFFFFFF);
+		chosen[i].second = FIRST_RULE+pairs.size()/2-1;
+	}
+
+	// Replace them from left to right, overlapping occurrences are skipped.
+	size_t out=0;
+	for(size_t i=0; i<seq.size(); ) {
+		if(first[seq[i]] && i+1<seq.size() && seq[i+1]!=0) {
+			uint64_t key = ((uint64_t)seq[i] << 32) | seq[i+1];
+			std::vector<std::pair<uint64_t, uint32_t> >::iterator it = std::lower_bound(chosen.begin(), chosen.end(), std::make_pair(key, (uint32_t)0));
+			if(it!=chosen.end() && it->first==key) {
+				seq[out++] = it->second;
+				i+=2;
+				continue;
+			}
+		}
+		seq[out++] = seq[i++];
+	}
+	seq.resize(out);
+	return true;
+}
+
+CSD_RePairDAC::CSD_RePairDAC(hdt::IteratorUCharString *it, uint32_t blocksize, hdt::ProgressListener *listener) :
+		bytes(0), maxlength(0), height(0), numterminals(0), rules(NULL), blocksize(blocksize), nblocks(0), blocks(NULL), symbols(NULL)
+{
+	this->type = REPAIRDAC;
+	this->numstrings = 0;
+
+	std::vector<uint32_t> seq;
+	while(it->hasNext()) {
+		unsigned char *currentStr = it->next();
+		size_t currentLength = strlen((char *)currentStr);
+		for(size_t i=0; i<currentLength; i++) {
+			seq.push_back(currentStr[i]);
+		}
+		seq.push_back(0);
+
+		bytes += currentLength;
+		if(currentLength>maxlength) {
+			maxlength = currentLength;
+		}
+		numstrings++;
+
+		NOTIFYCOND(listener, "Converting dictionary to RePairDAC", numstrings, it->getNumberOfElements());
+
+		it->freeStr(currentStr);
+	}
+
+	// Grammar: left and right symbol of each rule.
+	std::vector<uint32_t> pairs;
+	for(uint32_t round=0; round<MAX_ROUNDS; round++) {
+		NOTIFY(listener, "Building RePairDAC grammar", round, MAX_ROUNDS);
+		if(!replacePairs(seq, pairs)) {
+			break;
+		}
+	}
+	uint32_t numrules = pairs.size()/2;
+
+	// Frequency of the final symbols, and the rules used by them. The
+	// children of a rule are older, so visiting backwards reaches all.
+	std::vector<uint64_t> frequency(FIRST_RULE+numrules, 0);
+	std::vector<bool> used(FIRST_RULE+numrules, false);
+	for(size_t i=0; i<seq.size(); i++) {
+		frequency[seq[i]]++;
+		used[seq[i]] = true;
+	}
+	for(uint32_t r=numrules; r>0; r--) {
+		if(used[FIRST_RULE+r-1]) {
+			used[pairs[2*(r-1)]] = true;
+			used[pairs[2*(r-1)+1]] = true;
+		}
+	}
+
+	// The end of string keeps 0, then the characters and the rules, each by decreasing frequency.
+	std::vector<std::pair<uint64_t, uint32_t> > order;
+	order.push_back(std::make_pair(0, 0));
+	for(uint32_t c=1; c<FIRST_RULE; c++) {
+		if(used[c]) {
+			order.push_back(std::make_pair(~frequency[c], c));
+		}
+	}
+	std::sort(order.begin()+1, order.end());
+	numterminals = order.size()-1;
+	for(uint32_t r=0; r<numrules; r++) {
+		if(used[FIRST_RULE+r]) {
+			order.push_back(std::make_pair(~frequency[FIRST_RULE+r], FIRST_RULE+r));
+		}
+	}
+	std::sort(order.begin()+1+numterminals, order.end());
+
+	std::vector<uint32_t> code(FIRST_RULE+numrules, 0);
+	for(uint32_t i=1; i<order.size(); i++) {
+		code[order[i].second] = i;
+		if(i<=numterminals) {
+			terminals[i] = order[i].second;
+		}
+	}
+
+	// Rules in their new order, and the longest expansion.
+	std::vector<uint32_t> heights(FIRST_RULE+numrules, 1);
+	height = numterminals>0 ? 1 : 0;
+	for(uint32_t r=0; r<numrules; r++) {
+		uint32_t left = heights[pairs[2*r]], right = heights[pairs[2*r+1]];
+		heights[FIRST_RULE+r] = 1+(left>right ? left : right);
+		if(used[FIRST_RULE+r] && heights[FIRST_RULE+r]>height) {
+			height = heights[FIRST_RULE+r];
+		}
+	}
+	rules = new hdt::LogSequence2(hdt::bits(order.size()), 2*(order.size()-1-numterminals));
+	for(uint32_t i=1+numterminals; i<order.size(); i++) {
+		uint32_t r = order[i].second-FIRST_RULE;
+		rules->push_back(code[pairs[2*r]]);
+		rules->push_back(code[pairs[2*r+1]]);
+	}
+	std::vector<uint32_t>().swap(pairs);
+
+	// Symbols of the strings, and where each block starts.
+	nblocks = (numstrings+blocksize-1)/blocksize;
+	blocks = new hdt::LogSequence2(hdt::bits(seq.size()>0 ? seq.size() : 1), nblocks+1);
+	std::vector<unsigned int> values(seq.size());
+	uint32_t id = 0;
+	for(size_t i=0; i<seq.size(); i++) {
+		if(i==0 || seq[i-1]==0) {
+			if(id%blocksize==0) {
+				blocks->push_back(i);
+			}
+			id++;
+		}
+		values[i] = code[seq[i]];
+	}
+	blocks->push_back(seq.size());
+	std::vector<uint32_t>().swap(seq);
+
+	symbols = new hdt::DACSequence();
+	hdt::VectorUIntIterator itValues(values);
+	symbols->add(itValues);
+}
+
+CSD_RePairDAC::~CSD_RePairDAC()
+{
+	clear();
+}
+
+void CSD_RePairDAC::clear()
+{
+	delete rules;
+	delete blocks;
+	delete symbols;
+	rules = NULL;
+	blocks = NULL;
+	symbols = NULL;
+}
+
+int CSD_RePairDAC::compare(RePairDACReader &reader, const unsigned char *s, uint32_t len)
+{
+	for(uint32_t i=0; i<len; i++) {
+		int c = reader.next();
+		if(c!=s[i]) {
+			// The end of the string (-1) is smaller than any character.
+			return c<s[i] ? -1 : 1;
+		}
+	}
+	return reader.next()<0 ? 0 : 1;
+}
+
+uint32_t CSD_RePairDAC::locate(const unsigned char *s, uint32_t len)
+{
+	if(!symbols || numstrings==0) {
+		return 0;
+	}
+
+	// Last block whose first string is not bigger than s.
+	uint32_t left = 0, right = nblocks-1;
+	while(left<right) {
+		uint32_t center = left+(right-left+1)/2;
+		RePairDACReader reader(this, center*blocksize+1);
+		int cmp = compare(reader, s, len);
+		if(cmp==0) {
+			return center*blocksize+1;
+		} else if(cmp<0) {
+			left = center;
+		} else {
+			right = center-1;
+		}
+	}
+
+	// Scan the block, the strings are sorted.
+	uint32_t id = left*blocksize+1;
+	RePairDACReader reader(this, id);
+	for(uint32_t i=0; i<blocksize && id<=numstrings; i++, id++) {
+		int cmp = compare(reader, s, len);
+		if(cmp==0) {
+			return id;
+		} else if(cmp>0) {
+			return 0;
+		}
+		reader.nextString();
+	}
+	return 0;
+}
+
+unsigned char *CSD_RePairDAC::extract(uint32_t id)
+{
+	if(!symbols || id==0 || id>numstrings) {
+		return NULL;
+	}
+
+	unsigned char *str = new unsigned char[maxlength+1];
+	extract(id, str, maxlength+1);
+	return str;
+}
+
+void CSD_RePairDAC::freeString(const unsigned char *str)
+{
+	delete [] str;
+}
+
+size_t CSD_RePairDAC::extract(uint32_t id, unsigned char *buffer, size_t capacity)
+{
+	if(!symbols || id==0 || id>numstrings) {
+		return 0;
+	}
+
+	// Keep counting after the buffer is full, so that the length is exact.
+	RePairDACReader reader(this, id);
+	size_t len = 0;
+	int c;
+	while((c=reader.next())>=0) {
+		if(len<capacity) {
+			buffer[len] = c;
+		}
+		len++;
+	}
+	if(len<capacity) {
+		buffer[len] = '\0';
+	}
+	return len;
+}
+
+uint32_t CSD_RePairDAC::getBlockSize()
+{
+	return blocksize;
+}
+
+void CSD_RePairDAC::extractBlock(uint32_t block, std::string &data, std::vector<uint32_t> &offsets)
+{
+	data.clear();
+	offsets.clear();
+	if(!symbols || (uint64_t)block*blocksize>=numstrings) {
+		offsets.push_back(0);
+		return;
+	}
+
+	uint32_t first = block*blocksize+1;
+	RePairDACReader reader(this, first);
+	for(uint32_t id=first; id<first+blocksize && id<=numstrings; id++) {
+		offsets.push_back(data.size());
+		int c;
+		while((c=reader.next())>=0) {
+			data.push_back(c);
+		}
+		data.push_back('\0');
+		reader.nextString();
+	}
+	offsets.push_back(data.size());
+}
+
+uint64_t CSD_RePairDAC::getSize()
+{
+	if(!symbols) {
+		return 0;
+	}
+	return rules->size()+blocks->size()+symbols->size()+sizeof(CSD_RePairDAC);
+}
+
+uint32_t CSD_RePairDAC::getNumberOfRules()
+{
+	return rules ? rules->getNumberOfElements()/2 : 0;
+}
+
+void CSD_RePairDAC::save(ostream &out)
+{
+	if(!symbols) {
+		throw "Trying to save an empty CSD_RePairDAC";
+	}
+
+	CRC8 crch;
+	unsigned char buf[54]; // 9 bytes per VByte (max) * 6 values.
+
+	// Save type
+	crch.writeData(out, (unsigned char *)&type, sizeof(type));
+
+	// Save sizes
+	uint8_t pos = 0;
+	pos += VByte::encode(&buf[pos], numstrings);
+	pos += VByte::encode(&buf[pos], bytes);
+	pos += VByte::encode(&buf[pos], blocksize);
+	pos += VByte::encode(&buf[pos], maxlength);
+	pos += VByte::encode(&buf[pos], height);
+	pos += VByte::encode(&buf[pos], numterminals);
+	crch.writeData(out, buf, pos);
+
+	// Save the character of each terminal
+	crch.writeData(out, &terminals[1], numterminals);
+	crch.writeCRC(out);
+
+	rules->save(out);
+	blocks->save(out);
+	symbols->save(out);
+}
+
+CSD* CSD_RePairDAC::load(istream & fp)
+{
+	CRC8 crch;
+	unsigned char buf[54]; // 9 bytes per VByte (max) * 6 values.
+	CSD_RePairDAC *dicc = new CSD_RePairDAC();
+
+	try {
+		// Load variables
+		dicc->numstrings = (uint32_t) VByte::decode(fp);
+		dicc->bytes = VByte::decode(fp);
+		dicc->blocksize = (uint32_t) VByte::decode(fp);
+		dicc->maxlength = (uint32_t) VByte::decode(fp);
+		dicc->height = (uint32_t) VByte::decode(fp);
+		dicc->numterminals = (uint32_t) VByte::decode(fp);
+		if(dicc->numterminals>255 || dicc->height>MAX_ROUNDS+1 || dicc->blocksize==0) {
+			throw "Wrong RePairDAC header.";
+		}
+		fp.read((char *)&dicc->terminals[1], dicc->numterminals);
+
+		// Calculate variables CRC, the type was already read by CSD
+		crch.update(&dicc->type, sizeof(dicc->type));
+
+		uint8_t pos = 0;
+		pos += VByte::encode(&buf[pos], dicc->numstrings);
+		pos += VByte::encode(&buf[pos], dicc->bytes);
+		pos += VByte::encode(&buf[pos], dicc->blocksize);
+		pos += VByte::encode(&buf[pos], dicc->maxlength);
+		pos += VByte::encode(&buf[pos], dicc->height);
+		pos += VByte::encode(&buf[pos], dicc->numterminals);
+		crch.update(buf, pos);
+		crch.update(&dicc->terminals[1], dicc->numterminals);
+
+		crc8_t filecrc = crc8_read(fp);
+		if(crch.getValue()!=filecrc) {
+			throw "Checksum error while reading RePairDAC Header.";
+		}
+
+		dicc->rules = new hdt::LogSequence2();
+		dicc->rules->load(fp);
+		dicc->blocks = new hdt::LogSequence2();
+		dicc->blocks->load(fp);
+		dicc->nblocks = dicc->blocks->getNumberOfElements()-1;
+		dicc->symbols = new hdt::DACSequence();
+		dicc->symbols->load(fp);
+	} catch (const char *e) {
+		delete dicc;
+		throw e;
+	}
+
+	return dicc;
+}
+
+size_t CSD_RePairDAC::load(unsigned char *ptr, unsigned char *ptrMax)
+{
+	clear();
+	size_t count=0;
+
+	// Type
+	if(ptr[count++] != REPAIRDAC)
+		throw "Trying to read a CSD_RePairDAC but type does not match";
+
+	count += VByte::decode(&ptr[count], ptrMax, &numstrings);
+	count += VByte::decode(&ptr[count], ptrMax, &bytes);
+	count += VByte::decode(&ptr[count], ptrMax, &blocksize);
+	count += VByte::decode(&ptr[count], ptrMax, &maxlength);
+	count += VByte::decode(&ptr[count], ptrMax, &height);
+	count += VByte::decode(&ptr[count], ptrMax, &numterminals);
+	if(numterminals>255 || height>MAX_ROUNDS+1 || blocksize==0 || &ptr[count+numterminals]>=ptrMax) {
+		throw "Wrong CSD_RePairDAC Header.";
+	}
+	memcpy(&terminals[1], &ptr[count], numterminals);
+	count += numterminals;
+
+	// CRC
+	CRC8 crch;
+	crch.update(&ptr[0], count);
+	if(crch.getValue()!=ptr[count++])
+		throw "CRC Error while reading CSD_RePairDAC Header.";
+
+	rules = new hdt::LogSequence2();
+	count += rules->load(&ptr[count], ptrMax);
+	blocks = new hdt::LogSequence2();
+	count += blocks->load(&ptr[count], ptrMax);
+	nblocks = blocks->getNumberOfElements()-1;
+	symbols = new hdt::DACSequence();
+	count += symbols->load(&ptr[count], ptrMax);
+
+	return count;
+}
+
+void CSD_RePairDAC::fillSuggestions(const char *base, vector<string> &out, int maxResults)
+{
+	uint32_t begin, end;
+	prefixRange((const unsigned char *)base, strlen(base), &begin, &end);
+
+	string str;
+	for(uint32_t id=begin; id<end && out.size()<(size_t)maxResults; id++) {
+		extractString(id, str);
+		out.push_back(str);
+	}
+}
+
+hdt::IteratorUCharString *CSD_RePairDAC::listAll()
+{
+	if(!symbols) {
+		return new hdt::IteratorUCharString();
+	}
+	return new RePairDACIterator(this);
+}
+
+}
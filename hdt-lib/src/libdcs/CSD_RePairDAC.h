@@ -0,0 +1,243 @@
+/* CSD_RePairDAC.h
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Compressed String Dictionary that compresses the strings with a Re-Pair
+ * grammar and stores the symbols of each string with Directly Addressable
+ * Codes, following the RPDAC technique of:
+ *
+ *   ==========================================================================
+ *     "Practical Compressed String Dictionaries"
+ *     Miguel A. Martinez-Prieto, Nieves Brisaboa, Rodrigo Canovas,
+ *     Francisco Claude and Gonzalo Navarro.
+ *     Information Systems 56, p.73-108, 2016.
+ *   ==========================================================================
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ */
+
+#ifndef _CSDREPAIRDAC_H
+#define _CSDREPAIRDAC_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Iterator.hpp>
+#include <HDTListener.hpp>
+
+#include "CSD.h"
+#include "../sequence/LogSequence2.hpp"
+#include "../sequence/DACSequence.hpp"
+
+namespace csd
+{
+
+class RePairDACReader;
+
+/**
+ * The strings are rewritten with a grammar where each rule replaces a pair
+ * of adjacent symbols that is frequent in the strings, without crossing from
+ * one string to the next. The remaining symbols of each string, followed by
+ * the symbol 0 that ends it, are numbered by frequency and stored one after
+ * another in a DACSequence, so the frequent ones take few bits. As in PFC,
+ * the position of the first string of each block is kept, and a string is
+ * expanded after skipping the previous ones of its block. locate() is a
+ * binary search on the first strings of the blocks and a scan of one block,
+ * comparing while expanding and stopping at the first difference.
+ *
+ * The grammar is built in rounds: each one counts all the pairs and replaces
+ * the most frequent ones at once, instead of one pair at a time, so the build
+ * is fast but the grammar is a bit bigger than with the original Re-Pair.
+ */
+class CSD_RePairDAC : public CSD
+{
+  public:
+    /** Rounds of pair replacement, it bounds the height of the grammar. */
+    const static uint32_t MAX_ROUNDS = 64;
+
+    /** Pairs that appear less times than this are not replaced. */
+    const static uint32_t MIN_FREQUENCY = 4;
+
+    /** Most frequent pairs replaced in each round. */
+    const static uint32_t MAX_RULES_PER_ROUND = 65536;
+
+    /** General constructor **/
+    CSD_RePairDAC();
+
+    CSD_RePairDAC(hdt::IteratorUCharString *it, uint32_t blocksize, hdt::ProgressListener *listener=NULL);
+
+    /** General destructor. */
+    ~CSD_RePairDAC();
+
+    /** Returns the ID that identify s[1..length]. If it does not exist,
+	returns 0.
+	@s: the string to be located.
+	@len: the length (in characters) of the string s.
+    */
+    uint32_t locate(const unsigned char *s, uint32_t len);
+
+    /** Returns the string identified by id.
+	@id: the identifier to be extracted.
+    */
+    unsigned char * extract(uint32_t id);
+
+    void freeString(const unsigned char *str);
+
+    size_t extract(uint32_t id, unsigned char *buffer, size_t capacity);
+
+    uint32_t getBlockSize();
+
+    void extractBlock(uint32_t block, std::string &data, std::vector<uint32_t> &offsets);
+
+    /** Returns the size of the structure in bytes. */
+    uint64_t getSize();
+
+    /** Number of rules of the grammar. */
+    uint32_t getNumberOfRules();
+
+    /** Stores a CSD_RePairDAC structure given a file pointer.
+	@fp: pointer to the file saving a CSD_RePairDAC structure.
+    */
+    void save(ostream & fp);
+
+    size_t load(unsigned char *ptr, unsigned char *ptrMax);
+
+    /** Loads a CSD_RePairDAC structure from a file pointer.
+	@fp: pointer to the file storing a CSD_RePairDAC structure. */
+    static CSD * load(istream & fp);
+
+    void fillSuggestions(const char *base, vector<string> &out, int maxResults);
+
+    hdt::IteratorUCharString *listAll();
+
+  protected:
+    uint64_t bytes;	//! Length of all the strings.
+    uint32_t maxlength;	//! Length of the longest string.
+    uint32_t height;	//! Longest path from a symbol to a character, at most MAX_ROUNDS+1.
+
+    uint32_t numterminals;	//! Symbols 1 to numterminals are characters.
+    unsigned char terminals[256];	//! Character of each terminal symbol, from 1.
+    hdt::LogSequence2 *rules;	//! Left and right symbol of each rule, the symbol numterminals+1+r is the rule r.
+
+    uint32_t blocksize;	//! Number of strings stored in each block.
+    uint32_t nblocks;	//! Number of total blocks in the dictionary.
+    hdt::LogSequence2 *blocks;	//! Position in symbols of the first string of each block, and the end.
+    hdt::DACSequence *symbols;	//! Symbols of all the strings, each one ended by 0.
+
+    /** Compares the next string of the reader with s, expanding it only up to the first difference.
+	@return: negative, zero or positive if the string is smaller, equal or bigger than s.
+    */
+    static int compare(RePairDACReader &reader, const unsigned char *s, uint32_t len);
+
+    void clear();
+
+    friend class RePairDACReader;
+};
+
+/**
+ * Expands the strings of a CSD_RePairDAC, one character at a time.
+ */
+class RePairDACReader {
+private:
+	CSD_RePairDAC *dict;
+	size_t pos;	//! Next symbol to expand.
+	size_t top;
+	size_t stack[CSD_RePairDAC::MAX_ROUNDS+2];	//! Pending symbols, the next one on top.
+public:
+	/** Starts at the string id, skipping the previous ones of its block. */
+	RePairDACReader(CSD_RePairDAC *dict, uint32_t id) : dict(dict), top(0) {
+		pos = dict->blocks->get((id-1)/dict->blocksize);
+		for(uint32_t skip=(id-1)%dict->blocksize; skip>0; ) {
+			if(dict->symbols->get(pos++)==0) {
+				skip--;
+			}
+		}
+	}
+
+	/** Returns the next character, or -1 at the end of the string. */
+	inline int next() {
+		while(true) {
+			if(top==0) {
+				size_t symbol = dict->symbols->get(pos);
+				if(symbol==0) {
+					return -1;
+				}
+				stack[top++] = symbol;
+				pos++;
+			}
+			size_t symbol = stack[--top];
+			if(symbol<=dict->numterminals) {
+				return dict->terminals[symbol];
+			}
+			size_t rule = 2*(symbol-dict->numterminals-1);
+			stack[top++] = dict->rules->get(rule+1);
+			stack[top++] = dict->rules->get(rule);
+		}
+	}
+
+	/** Moves to the start of the next string, skipping the rest of this one. */
+	inline void nextString() {
+		top = 0;
+		while(dict->symbols->get(pos++)!=0) { }
+	}
+};
+
+class RePairDACIterator : public hdt::IteratorUCharString {
+private:
+	RePairDACReader reader;
+	std::string current;
+	uint32_t count;
+	uint32_t max;
+public:
+	RePairDACIterator(CSD_RePairDAC *dict) : reader(dict, 1), count(0) {
+		max = dict->getLength();
+	}
+
+	virtual ~RePairDACIterator() { }
+
+	bool hasNext() {
+		return count<max;
+	}
+
+	unsigned char *next() {
+		current.clear();
+		int c;
+		while((c=reader.next())>=0) {
+			current.push_back(c);
+		}
+		reader.nextString();
+		count++;
+		return (unsigned char *)current.c_str();
+	}
+
+	unsigned int getNumberOfElements() {
+		return max;
+	}
+
+	virtual void freeStr(unsigned char *ptr) {
+		// The string belongs to the iterator.
+	}
+};
+
+}
+
+#endif
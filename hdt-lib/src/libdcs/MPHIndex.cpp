@@ -0,0 +1,360 @@
+/* MPHIndex.cpp
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Side index of a Compressed String Dictionary that locates a string in
+ * constant time, using a minimal perfect hash function built with the
+ * "hash and displace" technique of:
+ *
+ *   ==========================================================================
+ *     "PTHash: Revisiting FCH Minimal Perfect Hashing"
+ *     Giulio Ermanno Pibiri and Roberto Trani.
+ *     SIGIR'2021, p.1339-1348, 2021.
+ *   ==========================================================================
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ */
+
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+#include "../util/crc8.h"
+#include "MPHIndex.h"
+#include "MurmurHash.h"
+#include "VByte.h"
+
+namespace csd
+{
+
+static const uint64_t BUCKET_SIZE = 4;	// Average strings per bucket.
+static const uint32_t FINGERPRINT_BITS = 16;
+static const uint32_t MAX_SEEDS = 16;
+
+static inline uint64_t mix(uint64_t x)
+{
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return x;
+}
+
+static inline size_t fingerprint(uint64_t hash)
+{
+	return (hash * 0x9e3779b97f4a7c15ULL) >> (64-FINGERPRINT_BITS);
+}
+
+struct MPHEntry {
+	uint64_t bucket;
+	uint64_t hash;
+	uint32_t id;
+
+	bool operator<(const MPHEntry &other) const {
+		return bucket<other.bucket || (bucket==other.bucket && hash<other.hash);
+	}
+};
+
+MPHIndex::MPHIndex() : numstrings(0), numpositions(0), numbuckets(0), seed(0)
+{
+	pilots = new hdt::LogSequence2();
+	remap = new hdt::LogSequence2();
+	ids = new hdt::LogSequence2();
+	fingerprints = new hdt::LogSequence2(FINGERPRINT_BITS);
+}
+
+MPHIndex::~MPHIndex()
+{
+	delete pilots;
+	delete remap;
+	delete ids;
+	delete fingerprints;
+}
+
+void MPHIndex::clear()
+{
+	delete pilots;
+	delete remap;
+	delete ids;
+	delete fingerprints;
+	pilots = new hdt::LogSequence2();
+	remap = new hdt::LogSequence2();
+	ids = new hdt::LogSequence2();
+	fingerprints = new hdt::LogSequence2(FINGERPRINT_BITS);
+	numstrings = 0;
+	numpositions = 0;
+	numbuckets = 0;
+	seed = 0;
+}
+
+inline uint64_t MPHIndex::position(uint64_t hash, uint64_t pilot)
+{
+	return mix(hash ^ mix(pilot+seed)) % numpositions;
+}
+
+inline uint64_t MPHIndex::slot(uint64_t hash)
+{
+	uint64_t pos = position(hash, pilots->get((hash >> 32) % numbuckets));
+	return pos<numstrings ? pos : remap->get(pos-numstrings);
+}
+
+void MPHIndex::build(CSD *csd, hdt::ProgressListener *listener)
+{
+	clear();
+	if(csd->getLength()==0) {
+		return;
+	}
+
+	for(seed=0; seed<MAX_SEEDS; seed++) {
+		numstrings = csd->getLength();
+		numpositions = numstrings + numstrings/64 + 1;
+		numbuckets = numstrings/BUCKET_SIZE + 1;
+
+		// Hash all the strings and group them by bucket.
+		std::vector<MPHEntry> entries;
+		entries.reserve(numstrings);
+		hdt::IteratorUCharString *it = csd->listAll();
+		uint32_t id = 1;
+		while(it->hasNext()) {
+			unsigned char *str = it->next();
+			MPHEntry entry;
+			entry.hash = murmurHash64A(str, strlen((char *)str), seed);
+			entry.bucket = (entry.hash >> 32) % numbuckets;
+			entry.id = id++;
+			entries.push_back(entry);
+			it->freeStr(str);
+			NOTIFYCOND(listener, "Hashing strings", id, numstrings);
+		}
+		delete it;
+		if(entries.size()!=numstrings) {
+			throw "The CSD returned a different number of strings than its length";
+		}
+		std::sort(entries.begin(), entries.end());
+
+		// Two strings with the same hash cannot be separated, try another seed.
+		bool collision = false;
+		for(size_t i=1;i<entries.size() && !collision;i++) {
+			collision = entries[i].bucket==entries[i-1].bucket && entries[i].hash==entries[i-1].hash;
+		}
+		if(collision) {
+			continue;
+		}
+
+		// Start of each bucket, and buckets ordered from the biggest.
+		std::vector<size_t> start(numbuckets+1, 0);
+		for(size_t i=0;i<entries.size();i++) {
+			start[entries[i].bucket+1]++;
+		}
+		size_t maxBucket = 0;
+		for(size_t b=0;b<numbuckets;b++) {
+			maxBucket = std::max(maxBucket, start[b+1]);
+			start[b+1] += start[b];
+		}
+		std::vector<uint64_t> order;
+		order.reserve(numbuckets);
+		for(size_t len=maxBucket; len>0; len--) {
+			for(size_t b=0;b<numbuckets;b++) {
+				if(start[b+1]-start[b]==len) {
+					order.push_back(b);
+				}
+			}
+		}
+
+		// Find for each bucket the first pilot that puts all its strings in free positions.
+		std::vector<bool> taken(numpositions, false);
+		std::vector<uint64_t> pilotOf(numbuckets, 0);
+		std::vector<uint32_t> idAt(numpositions, 0);
+		std::vector<uint16_t> fingerprintAt(numpositions, 0);
+		std::vector<uint64_t> positions(maxBucket);
+		uint64_t maxPilot = 0;
+		for(size_t i=0;i<order.size();i++) {
+			uint64_t b = order[i];
+			size_t first = start[b], len = start[b+1]-start[b];
+			for(uint64_t pilot=0; ; pilot++) {
+				size_t j;
+				for(j=0;j<len;j++) {
+					uint64_t pos = position(entries[first+j].hash, pilot);
+					if(taken[pos] || std::find(&positions[0], &positions[0]+j, pos)!=&positions[0]+j) {
+						break;
+					}
+					positions[j] = pos;
+				}
+				if(j==len) {
+					for(j=0;j<len;j++) {
+						taken[positions[j]] = true;
+						idAt[positions[j]] = entries[first+j].id;
+						fingerprintAt[positions[j]] = fingerprint(entries[first+j].hash);
+					}
+					pilotOf[b] = pilot;
+					maxPilot = std::max(maxPilot, pilot);
+					break;
+				}
+			}
+			NOTIFYCOND(listener, "Building minimal perfect hash", i, order.size());
+		}
+
+		// The positions after numstrings are remapped to the free slots before it.
+		delete pilots;
+		pilots = new hdt::LogSequence2(std::max(hdt::bits(maxPilot), 1u), numbuckets);
+		for(size_t b=0;b<numbuckets;b++) {
+			pilots->push_back(pilotOf[b]);
+		}
+
+		delete remap;
+		remap = new hdt::LogSequence2(hdt::bits(numstrings), numpositions-numstrings);
+		size_t freeSlot = 0;
+		for(uint64_t pos=numstrings; pos<numpositions; pos++) {
+			if(taken[pos]) {
+				while(taken[freeSlot]) {
+					freeSlot++;
+				}
+				taken[freeSlot] = true;
+				idAt[freeSlot] = idAt[pos];
+				fingerprintAt[freeSlot] = fingerprintAt[pos];
+				remap->push_back(freeSlot);
+			} else {
+				remap->push_back(0);
+			}
+		}
+
+		delete ids;
+		delete fingerprints;
+		ids = new hdt::LogSequence2(hdt::bits(numstrings), numstrings);
+		fingerprints = new hdt::LogSequence2(FINGERPRINT_BITS, numstrings);
+		for(size_t s=0;s<numstrings;s++) {
+			ids->push_back(idAt[s]);
+			fingerprints->push_back(fingerprintAt[s]);
+		}
+		return;
+	}
+
+	clear();
+	throw "Could not build the minimal perfect hash, the strings have too many hash collisions";
+}
+
+uint32_t MPHIndex::locate(CSD *csd, const unsigned char *s, uint32_t len)
+{
+	if(numstrings==0) {
+		return 0;
+	}
+
+	uint64_t hash = murmurHash64A(s, len, seed);
+	uint64_t pos = slot(hash);
+	if(fingerprints->get(pos)!=fingerprint(hash)) {
+		return 0;
+	}
+
+	// Verify the candidate, most strings fit in the stack.
+	uint32_t id = ids->get(pos);
+	unsigned char buffer[256];
+	if(len<sizeof(buffer)) {
+		size_t found = csd->extract(id, buffer, len+1);
+		return found==len && memcmp(buffer, s, len)==0 ? id : 0;
+	}
+	std::string str;
+	csd->extractString(id, str);
+	return str.length()==len && memcmp(str.c_str(), s, len)==0 ? id : 0;
+}
+
+uint32_t MPHIndex::getLength()
+{
+	return numstrings;
+}
+
+size_t MPHIndex::size()
+{
+	return pilots->size()+remap->size()+ids->size()+fingerprints->size();
+}
+
+void MPHIndex::save(std::ostream &out)
+{
+	CRC8 crch;
+	unsigned char buf[36]; // 9 bytes per VByte (max) * 4 values.
+
+	uint8_t pos = 0;
+	pos += VByte::encode(&buf[pos], numstrings);
+	pos += VByte::encode(&buf[pos], numpositions);
+	pos += VByte::encode(&buf[pos], numbuckets);
+	pos += VByte::encode(&buf[pos], seed);
+
+	crch.writeData(out, buf, pos);
+	crch.writeCRC(out);
+
+	pilots->save(out);
+	remap->save(out);
+	ids->save(out);
+	fingerprints->save(out);
+}
+
+void MPHIndex::load(std::istream &in)
+{
+	CRC8 crch;
+	unsigned char buf[36]; // 9 bytes per VByte (max) * 4 values.
+
+	clear();
+	numstrings = (uint32_t) VByte::decode(in);
+	numpositions = VByte::decode(in);
+	numbuckets = VByte::decode(in);
+	seed = VByte::decode(in);
+
+	uint8_t pos = 0;
+	pos += VByte::encode(&buf[pos], numstrings);
+	pos += VByte::encode(&buf[pos], numpositions);
+	pos += VByte::encode(&buf[pos], numbuckets);
+	pos += VByte::encode(&buf[pos], seed);
+	crch.update(buf, pos);
+
+	crc8_t filecrc = crc8_read(in);
+	if(crch.getValue()!=filecrc) {
+		throw "Checksum error while reading the minimal perfect hash header.";
+	}
+
+	pilots->load(in);
+	remap->load(in);
+	ids->load(in);
+	fingerprints->load(in);
+}
+
+size_t MPHIndex::load(unsigned char *ptr, unsigned char *ptrMax)
+{
+	size_t count=0;
+
+	clear();
+	count += VByte::decode(&ptr[count], ptrMax, &numstrings);
+	count += VByte::decode(&ptr[count], ptrMax, &numpositions);
+	count += VByte::decode(&ptr[count], ptrMax, &numbuckets);
+	count += VByte::decode(&ptr[count], ptrMax, &seed);
+
+	CRC8 crch;
+	crch.update(&ptr[0], count);
+	if(crch.getValue()!=ptr[count++])
+		throw "CRC Error while reading the minimal perfect hash header.";
+
+	count += pilots->load(&ptr[count], ptrMax);
+	count += remap->load(&ptr[count], ptrMax);
+	count += ids->load(&ptr[count], ptrMax);
+	count += fingerprints->load(&ptr[count], ptrMax);
+
+	return count;
+}
+
+}
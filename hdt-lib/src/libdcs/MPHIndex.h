@@ -0,0 +1,98 @@
+/* MPHIndex.h
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Side index of a Compressed String Dictionary that locates a string in
+ * constant time, using a minimal perfect hash function built with the
+ * "hash and displace" technique of:
+ *
+ *   ==========================================================================
+ *     "PTHash: Revisiting FCH Minimal Perfect Hashing"
+ *     Giulio Ermanno Pibiri and Roberto Trani.
+ *     SIGIR'2021, p.1339-1348, 2021.
+ *   ==========================================================================
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ */
+
+#ifndef _MPHINDEX_H
+#define _MPHINDEX_H
+
+#include <iostream>
+
+#include <HDTListener.hpp>
+
+#include "CSD.h"
+#include "../sequence/LogSequence2.hpp"
+
+namespace csd
+{
+
+/**
+ * Maps each string of a CSD to a slot with a minimal perfect hash, and keeps
+ * in the slot a fingerprint of the string and its ID. A lookup is one hash,
+ * one fingerprint check and one extract() to verify the candidate, so strings
+ * that are not in the CSD are also rejected.
+ */
+class MPHIndex
+{
+  public:
+    MPHIndex();
+    ~MPHIndex();
+
+    /** Builds the index with all the strings of the CSD. */
+    void build(CSD *csd, hdt::ProgressListener *listener=NULL);
+
+    /**
+     * Locates a string of the CSD that was used to build the index.
+     * @return its ID, or 0 if it is not in the CSD.
+     */
+    uint32_t locate(CSD *csd, const unsigned char *s, uint32_t len);
+
+    /** Number of strings */
+    uint32_t getLength();
+
+    /** Size of the index in bytes */
+    size_t size();
+
+    void save(std::ostream &out);
+    void load(std::istream &in);
+    size_t load(unsigned char *ptr, unsigned char *ptrMax);
+
+  protected:
+    uint32_t numstrings;	//! Number of strings, and of slots of the function.
+    uint64_t numpositions;	//! Positions of the hash, a bit more than the slots.
+    uint64_t numbuckets;	//! Buckets of strings that share a pilot.
+    uint64_t seed;	//! Seed of the hash of the strings.
+
+    hdt::LogSequence2 *pilots;	//! Displacement of each bucket.
+    hdt::LogSequence2 *remap;	//! Free slot for each position after numstrings.
+    hdt::LogSequence2 *ids;	//! ID of the string of each slot.
+    hdt::LogSequence2 *fingerprints;	//! Fingerprint of the string of each slot.
+
+    void clear();
+    uint64_t position(uint64_t hash, uint64_t pilot);
+    uint64_t slot(uint64_t hash);
+};
+
+}
+
+#endif  /* _MPHINDEX_H */
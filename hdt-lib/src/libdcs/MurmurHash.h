@@ -0,0 +1,81 @@
+/* MurmurHash.h
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ */
+
+#ifndef _MURMURHASH_H
+#define _MURMURHASH_H
+
+#include <stdint.h>
+#include <string.h>
+
+namespace csd
+{
+
+/** MurmurHash64A of Austin Appleby, used by the hash side indexes of the CSDs. */
+inline uint64_t murmurHash64A(const unsigned char *s, size_t len, uint64_t seed)
+{
+	const uint64_t m = 0xc6a4a7935bd1e995ULL;
+	const int r = 47;
+	uint64_t h = seed ^ (len * m);
+
+	const unsigned char *end = s + (len & ~(size_t)7);
+	while(s!=end) {
+		uint64_t k;
+		memcpy(&k, s, 8);
+		s += 8;
+
+		k *= m;
+		k ^= k >> r;
+		k *= m;
+
+		h ^= k;
+		h *= m;
+	}
+
+	switch(len & 7) {
+	case 7: h ^= uint64_t(s[6]) << 48;
+		// fall through
+	case 6: h ^= uint64_t(s[5]) << 40;
+		// fall through
+	case 5: h ^= uint64_t(s[4]) << 32;
+		// fall through
+	case 4: h ^= uint64_t(s[3]) << 24;
+		// fall through
+	case 3: h ^= uint64_t(s[2]) << 16;
+		// fall through
+	case 2: h ^= uint64_t(s[1]) << 8;
+		// fall through
+	case 1: h ^= uint64_t(s[0]);
+		h *= m;
+	}
+
+	h ^= h >> r;
+	h *= m;
+	h ^= h >> r;
+	return h;
+}
+
+}
+
+#endif  /* _MURMURHASH_H */
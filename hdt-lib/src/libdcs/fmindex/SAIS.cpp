@@ -0,0 +1,203 @@
+/* SAIS.cpp
+ * Copyright (C) 2011, Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Suffix array construction by induced sorting, following:
+ *
+ *   ==========================================================================
+ *    "Two Efficient Algorithms for Linear Time Suffix Array Construction"
+ *     Ge Nong, Sen Zhang and Wai Hong Chan.
+ *     IEEE Transactions on Computers 60(10), p.1471-1484, 2011.
+ *   ==========================================================================
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ * Rodrigo Canovas:  rcanovas@dcc.uchile.cl
+ * Miguel A. Martinez-Prieto:  migumar2@infor.uva.es
+ */
+
+#include <string.h>
+
+#include "SAIS.h"
+
+namespace csd{
+
+	/* The characters of the text shifted by one, followed by the
+		 end-of-string 0, so that the text can contain any byte.*/
+	class ByteText{
+		public:
+			const unsigned char *text;
+			uint32_t length;
+			ByteText(const unsigned char *text, uint32_t length) : text(text), length(length) { }
+			inline uint32_t operator[](uint32_t i) const {
+				return i==length ? 0 : text[i]+1;
+			}
+	};
+
+	/* Reduced text of the recursion, already ended by a unique 0.*/
+	class IntText{
+		public:
+			const uint32_t *text;
+			IntText(const uint32_t *text) : text(text) { }
+			inline uint32_t operator[](uint32_t i) const {
+				return text[i];
+			}
+	};
+
+	/* The type of each suffix, one bit each: 1 for S (smaller than the next
+		 suffix), 0 for L (larger).*/
+	static inline bool isS(const unsigned char *t, uint32_t i){
+		return (t[i>>3]>>(i&7))&1;
+	}
+
+	static inline void setS(unsigned char *t, uint32_t i){
+		t[i>>3] |= 1<<(i&7);
+	}
+
+	/* Leftmost S suffix: an S suffix that follows an L one.*/
+	static inline bool isLMS(const unsigned char *t, uint32_t i){
+		return i>0 && i!=SAIS::EMPTY && isS(t, i) && !isS(t, i-1);
+	}
+
+	/* Sets bkt[c] to the start, or the end, of the bucket of the symbol c.*/
+	template<class Text>
+	static void getBuckets(const Text &s, uint32_t *bkt, uint32_t n, uint32_t k, bool end){
+		uint32_t sum=0;
+		memset(bkt, 0, (k+1)*sizeof(uint32_t));
+		for(uint32_t i=0; i<n; i++)
+			bkt[s[i]]++;
+		for(uint32_t c=0; c<=k; c++){
+			sum += bkt[c];
+			bkt[c] = end ? sum : sum-bkt[c];
+		}
+	}
+
+	/* Places each L suffix at the start of its bucket, from left to right,
+		 after the suffix that follows it.*/
+	template<class Text>
+	static void induceL(const unsigned char *t, uint32_t *sa, const Text &s, uint32_t *bkt, uint32_t n, uint32_t k){
+		getBuckets(s, bkt, n, k, false);
+		for(uint32_t i=0; i<n; i++){
+			uint32_t j=sa[i];
+			if(j!=SAIS::EMPTY && j>0 && !isS(t, j-1))
+				sa[bkt[s[j-1]]++]=j-1;
+		}
+	}
+
+	/* Places each S suffix at the end of its bucket, from right to left.*/
+	template<class Text>
+	static void induceS(const unsigned char *t, uint32_t *sa, const Text &s, uint32_t *bkt, uint32_t n, uint32_t k){
+		getBuckets(s, bkt, n, k, true);
+		for(uint32_t i=n; i-->0; ){
+			uint32_t j=sa[i];
+			if(j!=SAIS::EMPTY && j>0 && isS(t, j-1))
+				sa[--bkt[s[j-1]]]=j-1;
+		}
+	}
+
+	/* Sorts the suffixes of s[0..n-1], whose symbols are in 0..k and whose
+		 last symbol is a unique 0. n is at least 2.*/
+	template<class Text>
+	static void sais(const Text &s, uint32_t *sa, uint32_t n, uint32_t k){
+		unsigned char *t = new unsigned char[n/8+1];
+		memset(t, 0, n/8+1);
+		setS(t, n-1);
+		for(uint32_t i=n-1; i-->0; )
+			if(s[i]<s[i+1] || (s[i]==s[i+1] && isS(t, i+1)))
+				setS(t, i);
+
+		// Sort the LMS substrings: place the LMS suffixes at the end of their
+		// buckets in any order and induce the rest.
+		uint32_t *bkt = new uint32_t[k+1];
+		getBuckets(s, bkt, n, k, true);
+		for(uint32_t i=0; i<n; i++)
+			sa[i]=SAIS::EMPTY;
+		for(uint32_t i=1; i<n; i++)
+			if(isLMS(t, i))
+				sa[--bkt[s[i]]]=i;
+		induceL(t, sa, s, bkt, n, k);
+		induceS(t, sa, s, bkt, n, k);
+		delete [] bkt;
+
+		// Move the sorted LMS substrings to the start, and name them.
+		uint32_t n1=0;
+		for(uint32_t i=0; i<n; i++)
+			if(isLMS(t, sa[i]))
+				sa[n1++]=sa[i];
+		for(uint32_t i=n1; i<n; i++)
+			sa[i]=SAIS::EMPTY;
+		uint32_t name=0, prev=SAIS::EMPTY;
+		for(uint32_t i=0; i<n1; i++){
+			uint32_t pos=sa[i];
+			bool diff=false;
+			for(uint32_t d=0; d<n; d++){
+				if(prev==SAIS::EMPTY || s[pos+d]!=s[prev+d] || isS(t, pos+d)!=isS(t, prev+d)){
+					diff=true;
+					break;
+				} else if(d>0 && (isLMS(t, pos+d) || isLMS(t, prev+d))){
+					break;
+				}
+			}
+			if(diff){
+				name++;
+				prev=pos;
+			}
+			// LMS positions are at least two apart, so pos/2 does not collide.
+			sa[n1+pos/2]=name-1;
+		}
+		for(uint32_t i=n, j=n; i-->n1; )
+			if(sa[i]!=SAIS::EMPTY)
+				sa[--j]=sa[i];
+
+		// Sort the reduced text, made of the names in text order, recursively
+		// unless all of them are different.
+		uint32_t *sa1=sa, *s1=sa+n-n1;
+		if(name<n1)
+			sais(IntText(s1), sa1, n1, name-1);
+		else
+			for(uint32_t i=0; i<n1; i++)
+				sa1[s1[i]]=i;
+
+		// Place the LMS suffixes in their order and induce the rest.
+		bkt = new uint32_t[k+1];
+		getBuckets(s, bkt, n, k, true);
+		for(uint32_t i=1, j=0; i<n; i++)
+			if(isLMS(t, i))
+				s1[j++]=i;
+		for(uint32_t i=0; i<n1; i++)
+			sa1[i]=s1[sa1[i]];
+		for(uint32_t i=n1; i<n; i++)
+			sa[i]=SAIS::EMPTY;
+		for(uint32_t i=n1; i-->0; ){
+			uint32_t j=sa[i];
+			sa[i]=SAIS::EMPTY;
+			sa[--bkt[s[j]]]=j;
+		}
+		induceL(t, sa, s, bkt, n, k);
+		induceS(t, sa, s, bkt, n, k);
+		delete [] bkt;
+		delete [] t;
+	}
+
+	void SAIS::sort(const unsigned char *text, uint32_t length, uint32_t *sa){
+		if(length==0){
+			sa[0]=0;
+			return;
+		}
+		sais(ByteText(text, length), sa, length+1, 256);
+	}
+};
@@ -0,0 +1,60 @@
+/* SAIS.h
+ * Copyright (C) 2011, Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Suffix array construction by induced sorting, following:
+ *
+ *   ==========================================================================
+ *    "Two Efficient Algorithms for Linear Time Suffix Array Construction"
+ *     Ge Nong, Sen Zhang and Wai Hong Chan.
+ *     IEEE Transactions on Computers 60(10), p.1471-1484, 2011.
+ *   ==========================================================================
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ * Rodrigo Canovas:  rcanovas@dcc.uchile.cl
+ * Miguel A. Martinez-Prieto:  migumar2@infor.uva.es
+ */
+
+#ifndef SAIS_H_
+#define SAIS_H_
+
+#include <stdint.h>
+
+namespace csd{
+
+	/**
+	 * Builds suffix arrays in linear time. The only memory needed besides
+	 * the 32-bit suffix array is one bit per position for the types, the
+	 * bucket counters, and during the recursion, the reduced text that is
+	 * kept in the unused half of the suffix array. So it needs about 4
+	 * bytes per character, where SuffixArray needs two arrays of longs.
+	 */
+	class SAIS{
+		public:
+			/** Value of the empty entries of the suffix array during the construction. */
+			static const uint32_t EMPTY = 0xFFFFFFFF;
+
+			/** Sorts the suffixes of text[0..length-1] followed by an
+				end-of-string smaller than all the characters, as
+				SuffixArray::sort(). sa must have room for length+1 entries,
+				sa[0] is always length. The length must be smaller than EMPTY.
+			*/
+			static void sort(const unsigned char *text, uint32_t length, uint32_t *sa);
+	};
+};
+#endif /*SAIS_H_*/
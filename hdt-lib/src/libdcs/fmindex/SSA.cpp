@@ -266,21 +266,17 @@ namespace csd{
 		bitset(sampled_vector,n+1);
 		sampled = _sbb->build(sampled_vector,n+1);
 		delete [] sampled_vector;
-		//delete [] _sa;
-		free (_sa);
+		delete [] _sa;
 		_sa = NULL;
 	}
 
 
 	void SSA::build_sa() {
-		long *sa_i;
 		assert(_seq!=NULL);
 		if(_sa!=NULL)
 			delete [] _sa;
-		SuffixArray *suffix = new SuffixArray();
-		sa_i = suffix->sort(_seq, n);
-		_sa = (unsigned long*)sa_i;
-		delete suffix;
+		_sa = new uint[n+1];
+		SAIS::sort(_seq, n, _sa);
 		assert(_sa[0]==n);
 		for(unsigned long i=0;i<n;i++)
 			assert(cmp((uint)_sa[i],(uint)_sa[i+1])<=0);
@@ -306,45 +302,70 @@ namespace csd{
 			return 0;
 	}
 
-	uint SSA::locate(uchar * pattern, uint m, uint32_t **occs){
-		if(!use_sampling){
-			*occs = NULL;
-			return 0;
-		}
+	bool SSA::backward_search(uchar * pattern, uint m, uint *sp, uint *ep){
+		if(m==0)
+			return false;
 		unsigned long i=m-1;
 		uint c = pattern[i];
-		uint sp = occ[c];
-		uint ep = occ[c+1]-1;
-		while (sp<=ep && i>=1) {
+		if(!alphabet[c])
+			return false;
+		*sp = occ[c];
+		*ep = occ[c+1]-1;
+		while (*sp<=*ep && i>=1) {
 			c = pattern[--i];
 			if(!alphabet[c]){
-				return 0;
+				return false;
 			}
-			sp = occ[c]+bwt->rank(c,sp-1);
-			ep = occ[c]+bwt->rank(c,ep)-1;
+			*sp = occ[c]+bwt->rank(c,*sp-1);
+			*ep = occ[c]+bwt->rank(c,*ep)-1;
 		}
-		if (sp<=ep) {
-			uint matches = ep-sp+1;
-			*occs = new uint[matches];
-			uint i = sp;
-			uint j,dist;
-			size_t rank_tmp;
-			while(i<=ep) {
-				j = i;
-				dist = 0;
-				while(!sampled->access(j)) {
-					c = bwt->access(j,rank_tmp);
-					rank_tmp--;
-					j = occ[c]+rank_tmp;
-					dist++;
-				}
-				(*occs)[i-sp] = suff_sample[sampled->rank1(j)-1]+dist;
-				i++;
-			}
-			return ep-sp+1;
+		return *sp<=*ep;
+	}
+
+	uint SSA::count(uchar * pattern, uint m){
+		uint sp, ep;
+		if(!backward_search(pattern, m, &sp, &ep))
+			return 0;
+		return ep-sp+1;
+	}
+
+	uint SSA::locate_row(uint row){
+		uint j = row;
+		uint dist = 0;
+		size_t rank_tmp;
+		while(!sampled->access(j)) {
+			uint c = bwt->access(j,rank_tmp);
+			j = occ[c]+rank_tmp-1;
+			dist++;
 		}
-		*occs=NULL;
-		return 0;
+		return suff_sample[sampled->rank1(j)-1]+dist;
+	}
+
+	uint SSA::row_of_previous(uint row, uint c){
+		size_t rank_tmp;
+		uint b = bwt->access(row, rank_tmp);
+		while(b!=c) {
+			row = occ[b]+rank_tmp-1;
+			b = bwt->access(row, rank_tmp);
+		}
+		return occ[c]+rank_tmp-1;
+	}
+
+	bool SSA::has_sampling(){
+		return use_sampling;
+	}
+
+	uint SSA::locate(uchar * pattern, uint m, uint32_t **occs){
+		uint sp, ep;
+		if(!use_sampling || !backward_search(pattern, m, &sp, &ep)){
+			*occs = NULL;
+			return 0;
+		}
+		uint matches = ep-sp+1;
+		*occs = new uint[matches];
+		for(uint i=sp; i<=ep; i++)
+			(*occs)[i-sp] = locate_row(i);
+		return matches;
 	}
 
 
@@ -357,6 +378,11 @@ namespace csd{
 
 	uchar * SSA::extract_id(uint id, uint max_len){	
 		uchar *res = new uchar[max_len+2];
+		extract_id(id, max_len, res);
+		return res;
+	}
+
+	uint SSA::extract_id(uint id, uint max_len, uchar *res){
 		uint i = id;
 		uint pos = max_len+1;
 		res[pos] = '\0';
@@ -379,7 +405,7 @@ namespace csd{
 			res[j] = res[pos+j];
 		res[cont] = '\0';
 
-		return res;
+		return cont;
 	}
 
 	int SSA::cmp(uint i, uint j) {
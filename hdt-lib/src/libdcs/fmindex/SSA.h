@@ -42,7 +42,7 @@
 #include <Mapper.h>
 #include <algorithm>
 
-#include "SuffixArray.h"
+#include "SAIS.h"
 
 using namespace std;
 using namespace cds_static;
@@ -68,7 +68,21 @@ namespace csd{
 			uint locate_id(uchar * pattern, uint m);
 			uint locate(uchar * pattern, uint m, uint32_t **occs);
 
+			/** Finds the rows [sp, ep] of the suffixes that start with the
+				pattern. Returns false if there are none. */
+			bool backward_search(uchar * pattern, uint m, uint *sp, uint *ep);
+			/** Number of occurrences of the pattern, without locating them. */
+			uint count(uchar * pattern, uint m);
+			/** Position in the text of the suffix at the row. Needs the samples. */
+			uint locate_row(uint row);
+			/** Goes back from the row to the previous occurrence of the
+				character c, and returns the row of the suffix that starts there. */
+			uint row_of_previous(uint row, uint c);
+			bool has_sampling();
+
 			uchar * extract_id(uint id, uint max_len);
+			/** Extracts into res, that has room for max_len+2 bytes. Returns the length. */
+			uint extract_id(uint id, uint max_len, uchar *res);
             static SSA * load(istream &fp);
             void save(ostream & fp);
 
@@ -90,7 +104,7 @@ namespace csd{
 			/*use only for construction*/
 			uchar * _seq;
 			uint * _bwt;   
-			unsigned long * _sa;   
+			uint * _sa;
 			SequenceBuilder * _ssb;
 			BitSequenceBuilder * _sbb;
 			/*******************************/
@@ -33,6 +33,8 @@
 
 namespace hdt {
 
+const size_t AdjacencyList::NOT_FOUND;
+
 AdjacencyList::AdjacencyList(IntSequence *el, BitSeq *bit) :
 		elements(el),
 		bitmap(bit) {
@@ -69,12 +71,16 @@ size_t AdjacencyList::findNext(size_t pos)
  * Find element y, in the list x
  * @param x
  * @param y
- * @return
+ * @return The position, or NOT_FOUND if y is not in the list.
  */
 size_t AdjacencyList::find(size_t x, size_t y) {
 	size_t begin = find(x);
-	size_t end = last(x);
-	return binSearch(y, begin, end);
+	size_t end = last(x)+1;
+	size_t pos = elements->nextGEQ(begin, end, y);
+	if(pos==end || elements->get(pos)!=y) {
+		return NOT_FOUND;
+	}
+	return pos;
 }
 
 /**
@@ -129,32 +135,44 @@ size_t AdjacencyList::countItemsY(size_t x) {
 	return last(x)-find(x)+1;
 }
 
+/**
+ * Search the element in the sorted range [begin, end).
+ * @return The position, or NOT_FOUND.
+ */
 size_t AdjacencyList::search(unsigned int element, size_t begin, size_t end) {
-	if(end-begin>10) {
-		return binSearch(element,begin,end);
-	} else {
-		return linSearch(element,begin,end);
+	size_t pos = elements->nextGEQ(begin, end, element);
+	if(pos==end || elements->get(pos)!=element) {
+		return NOT_FOUND;
 	}
+	return pos;
 }
 
+/**
+ * Binary search of the element in the sorted range [begin, end).
+ * @return The position, or NOT_FOUND.
+ */
 size_t AdjacencyList::binSearch(unsigned int element, size_t begin, size_t end) {
-	while (begin <= end) {
-		int mid = (begin + end) / 2;
+	while (begin < end) {
+		size_t mid = begin + (end - begin) / 2;
 
 		unsigned int read = elements->get(mid);
 
 		if (element > read)
 			begin = mid + 1;
 		else if (element < read)
-			end = mid - 1;
+			end = mid;
 		else
 			return mid;
 	}
-	throw "Not found";
+	return NOT_FOUND;
 }
 
+/**
+ * Linear search of the element in the range [begin, end).
+ * @return The position, or NOT_FOUND.
+ */
 size_t AdjacencyList::linSearch(unsigned int element, size_t begin, size_t end) {
-	while (begin <= end) {
+	while (begin < end) {
 		unsigned int read = elements->get(begin);
 		//cout << "\t\tPos: " << begin << " Compare " << element << " with " << read << endl;
 
@@ -163,9 +181,18 @@ size_t AdjacencyList::linSearch(unsigned int element, size_t begin, size_t end)
 
 		begin++;
 	}
-	return end;
+	return NOT_FOUND;
 }
 
+/**
+ * Search the first position in [begin, end) whose element is greater or equal
+ * than the given one. The range must be sorted. Delegates to the sequence,
+ * which gallops by default, or uses its own index (e.g. Elias-Fano).
+ * @return The position, or end if all elements are lower.
+ */
+size_t AdjacencyList::gallopSearch(unsigned int element, size_t begin, size_t end) {
+	return elements->nextGEQ(begin, end, element);
+}
 
 unsigned int AdjacencyList::get(size_t pos) {
 	return elements->get(pos);
@@ -38,12 +38,19 @@
 
 namespace hdt {
 
+/**
+ * Lists of sorted elements stored consecutively in a sequence, with a bitmap that
+ * marks the last element of each list. The searches return NOT_FOUND instead of
+ * throwing when the element is missing.
+ */
 class AdjacencyList {
 private:
 	IntSequence *elements;
 	BitSeq *bitmap;
 
 public:
+	static const size_t NOT_FOUND = (size_t)-1;
+
 	AdjacencyList(IntSequence *el, BitSeq *bit);
 	virtual ~AdjacencyList();
 
@@ -62,6 +69,7 @@ public:
 	size_t search(unsigned int element, size_t ini, size_t fin);
 	size_t binSearch(unsigned int element, size_t ini, size_t fin);
 	size_t linSearch(unsigned int element, size_t ini, size_t fin);
+	size_t gallopSearch(unsigned int element, size_t ini, size_t fin);
 
 	unsigned int get(size_t pos);
 
@@ -0,0 +1,329 @@
+/*
+ * File: DACSequence.cpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+#include <iostream>
+#include <string.h>
+#include <HDTVocabulary.hpp>
+#include "DACSequence.hpp"
+#include "../libdcs/VByte.h"
+#include "../util/crc8.h"
+#include "../util/crc32.h"
+
+using namespace std;
+
+namespace hdt {
+
+DACSequence::DACSequence() : numentries(0) {
+}
+
+DACSequence::DACSequence(IntSequence *sequence) : numentries(0) {
+	StreamIterator it(sequence);
+	add(it);
+}
+
+DACSequence::~DACSequence() {
+	clear();
+}
+
+void DACSequence::clear() {
+	for(size_t i=0; i<levels.size(); i++) {
+		delete levels[i];
+	}
+	for(size_t i=0; i<more.size(); i++) {
+		delete more[i];
+	}
+	levels.clear();
+	more.clear();
+	widths.clear();
+	numentries = 0;
+}
+
+void DACSequence::chooseWidths(const size_t *lengths, unsigned int maxLength) {
+	// remaining[s]: values longer than s bits, which reach a level starting at bit s.
+	uint64_t remaining[MAX_LEVELS+1];
+	remaining[maxLength] = 0;
+	for(int s=maxLength-1; s>=0; s--) {
+		remaining[s] = remaining[s+1] + lengths[s+1];
+	}
+
+	// best[s]: bits of the levels from bit s onwards, including the bitmaps
+	// and their rank directory, with the width of the first of them in width[s].
+	uint64_t best[MAX_LEVELS+1];
+	unsigned int width[MAX_LEVELS+1];
+	best[maxLength] = 0;
+	for(int s=maxLength-1; s>=0; s--) {
+		best[s] = (uint64_t)-1;
+		for(unsigned int w=1; s+w<=maxLength; w++) {
+			uint64_t cost = remaining[s]*w;
+			if(s+w<maxLength) {
+				cost += remaining[s] + remaining[s]*3/8 + best[s+w];
+			}
+			if(cost<best[s]) {
+				best[s] = cost;
+				width[s] = w;
+			}
+		}
+	}
+
+	widths.clear();
+	for(unsigned int s=0; s<maxLength; s+=width[s]) {
+		widths.push_back(width[s]);
+	}
+}
+
+void DACSequence::add(IteratorUInt &elements) {
+	clear();
+
+	// First pass: count the values of each length, zero takes one bit.
+	size_t lengths[MAX_LEVELS+1];
+	memset(lengths, 0, sizeof(lengths));
+	unsigned int maxLength = 1;
+	while(elements.hasNext()) {
+		unsigned int len = bits(elements.next());
+		if(len==0) {
+			len = 1;
+		}
+		if(len>maxLength) {
+			maxLength = len;
+		}
+		lengths[len]++;
+		numentries++;
+	}
+
+	chooseWidths(lengths, maxLength);
+
+	size_t count = numentries;
+	unsigned int start = 0;
+	for(size_t l=0; l<widths.size(); l++) {
+		levels.push_back(new LogSequence2(widths[l], count));
+		start += widths[l];
+		for(unsigned int len=start-widths[l]+1; len<=start && len<=maxLength; len++) {
+			count -= lengths[len];
+		}
+		if(l+1<widths.size()) {
+			more.push_back(new BitSequence375());
+		}
+	}
+
+	// Second pass: split each value in chunks, from the lowest.
+	elements.goToStart();
+	for(size_t i=0; i<numentries; i++) {
+		size_t value = elements.next();
+		for(size_t l=0; l<widths.size(); l++) {
+			levels[l]->push_back(value & maxVal(widths[l]));
+			value >>= widths[l];
+			if(l+1==widths.size()) {
+				break;
+			}
+			more[l]->append(value!=0);
+			if(value==0) {
+				break;
+			}
+		}
+	}
+
+	// Build the rank directories now, instead of on the first query. Select is never used.
+	for(size_t l=0; l<more.size(); l++) {
+		more[l]->trimToSize();
+		more[l]->setSelectSampling(0);
+		more[l]->rank1(0);
+	}
+}
+
+size_t DACSequence::get(size_t position) {
+	if(position>=numentries) {
+		throw "Trying to get an element bigger than the array.";
+	}
+	size_t value = 0;
+	unsigned int shift = 0;
+	for(size_t l=0; ; l++) {
+		value |= levels[l]->get(position) << shift;
+		if(l+1==levels.size() || !more[l]->access(position)) {
+			return value;
+		}
+		shift += widths[l];
+		position = more[l]->rank1(position)-1;
+	}
+}
+
+size_t DACSequence::getNumberOfElements() {
+	return numentries;
+}
+
+size_t DACSequence::getNumberOfLevels() {
+	return levels.size();
+}
+
+size_t DACSequence::size() {
+	size_t total = sizeof(DACSequence);
+	for(size_t l=0; l<levels.size(); l++) {
+		total += levels[l]->size();
+	}
+	for(size_t l=0; l<more.size(); l++) {
+		total += more[l]->getSizeBytes();
+	}
+	return total;
+}
+
+void DACSequence::save(std::ostream &output) {
+	CRC8 crch;
+	unsigned char data[10];
+	unsigned int len;
+
+	// Write type
+	uint8_t type = TYPE_SEQ_DAC;
+	crch.writeData(output, &type, sizeof(type));
+
+	// Write numentries
+	len = csd::VByte::encode(data, numentries);
+	crch.writeData(output, data, len);
+
+	// Write the width of each level
+	uint8_t numlevels = widths.size();
+	crch.writeData(output, &numlevels, sizeof(numlevels));
+	if(numlevels>0) {
+		crch.writeData(output, &widths[0], numlevels);
+	}
+
+	// Write Header CRC
+	crch.writeCRC(output);
+
+	for(size_t l=0; l<levels.size(); l++) {
+		levels[l]->save(output);
+		if(l<more.size()) {
+			more[l]->save(output);
+		}
+	}
+}
+
+void DACSequence::load(std::istream &input) {
+	clear();
+
+	CRC8 crch;
+	unsigned char buf[10];
+	unsigned int pos;
+
+	// Read type
+	uint8_t type;
+	crch.readData(input, (unsigned char*)&type, sizeof(type));
+	if(type!=TYPE_SEQ_DAC) {
+		throw "Trying to read a DACSequence but the type does not match";
+	}
+
+	// Read numentries
+	uint64_t numentries64 = csd::VByte::decode(input);
+	pos = csd::VByte::encode(buf, numentries64);
+	crch.update(buf, pos);
+
+	// Read the width of each level
+	uint8_t numlevels;
+	crch.readData(input, &numlevels, sizeof(numlevels));
+	if(numlevels>MAX_LEVELS) {
+		throw "Too many levels in DACSequence header.";
+	}
+	widths.resize(numlevels);
+	if(numlevels>0) {
+		crch.readData(input, &widths[0], numlevels);
+	}
+
+	// Validate Checksum Header
+	crc8_t filecrch = crc8_read(input);
+	if(crch.getValue()!=filecrch) {
+		throw "Checksum error while reading DACSequence header.";
+	}
+
+	numentries = (size_t) numentries64;
+
+	for(size_t l=0; l<numlevels; l++) {
+		levels.push_back(new LogSequence2());
+		levels[l]->load(input);
+		if(l+1<numlevels) {
+			more.push_back(BitSequence375::load(input));
+			more[l]->setSelectSampling(0);
+		}
+	}
+}
+
+#define CHECKPTR(base, max, size) if(((base)+(size))>(max)) throw "Could not read completely the HDT from the file.";
+
+size_t DACSequence::load(const unsigned char *ptr, const unsigned char *ptrMax, ProgressListener *listener) {
+	clear();
+	size_t count = 0;
+
+	// Read type
+	CHECKPTR(&ptr[count], ptrMax, 1);
+	if(ptr[count]!=TYPE_SEQ_DAC) {
+		throw "Trying to read a DACSequence but the type does not match";
+	}
+	count++;
+
+	// Read numentries
+	uint64_t numentries64;
+	count += csd::VByte::decode(&ptr[count], ptrMax, &numentries64);
+
+	// Read the width of each level
+	CHECKPTR(&ptr[count], ptrMax, 1);
+	uint8_t numlevels = ptr[count++];
+	if(numlevels>MAX_LEVELS) {
+		throw "Too many levels in DACSequence header.";
+	}
+	CHECKPTR(&ptr[count], ptrMax, numlevels);
+	widths.assign(&ptr[count], &ptr[count]+numlevels);
+	count += numlevels;
+
+	// Validate Checksum Header
+	CRC8 crch;
+	crch.update(&ptr[0], count);
+	CHECKPTR(&ptr[count], ptrMax, 1);
+	if(crch.getValue()!=ptr[count++]) {
+		throw "Checksum error while reading DACSequence header.";
+	}
+
+	numentries = (size_t) numentries64;
+
+	for(size_t l=0; l<numlevels; l++) {
+		levels.push_back(new LogSequence2());
+		count += levels[l]->load(&ptr[count], ptrMax, listener);
+		if(l+1<numlevels) {
+			more.push_back(new BitSequence375());
+			count += more[l]->load(&ptr[count], ptrMax, listener);
+			more[l]->setSelectSampling(0);
+		}
+	}
+
+	return count;
+}
+
+std::string DACSequence::getType() {
+	return HDTVocabulary::SEQ_TYPE_DAC;
+}
+
+}
@@ -0,0 +1,118 @@
+/*
+ * File: DACSequence.hpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * Directly Addressable Codes, as described in:
+ *
+ *   ==========================================================================
+ *     "Directly Addressable Variable-Length Codes"
+ *     Nieves R. Brisaboa, Susana Ladra and Gonzalo Navarro.
+ *     SPIRE'2009, LNCS 5721, p.122-130, 2009.
+ *   ==========================================================================
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+#ifndef DACSEQUENCE_HPP_
+#define DACSEQUENCE_HPP_
+
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+
+#include "IntSequence.hpp"
+#include "LogSequence2.hpp"
+#include "../bitsequence/BitSequence375.h"
+
+namespace hdt {
+
+/**
+ * Sequence of integers where each one uses space proportional to its own
+ * length in bits, but still supports direct access. The value is split in
+ * chunks: the first level keeps the lowest chunk of all the elements, and a
+ * bitmap tells which ones continue in the next level, where rank1() finds
+ * their position. The width of each level is chosen to minimize the total
+ * size for the distribution of lengths of the values.
+ *
+ * It suits sequences where most values are small and a few are big, such as
+ * the symbols of a grammar where the frequent ones get the lower numbers.
+ */
+class DACSequence : public IntSequence {
+
+private:
+	size_t numentries;
+	std::vector<unsigned char> widths;	// Bits of the chunk of each level
+	std::vector<LogSequence2 *> levels;	// Chunks of each level
+	std::vector<BitSequence375 *> more;	// Whether each element of a level continues in the next one, all levels but the last
+
+	static const uint8_t TYPE_SEQ_DAC = 8;
+
+	/** Upper bound of the number of levels, as the values have up to 32 bits. */
+	static const size_t MAX_LEVELS = 32;
+
+	/** Chooses the widths of the levels given the number of values of each length in bits */
+	void chooseWidths(const size_t *lengths, unsigned int maxLength);
+
+	void clear();
+
+public:
+	DACSequence();
+
+	/**
+	 * Create the DAC representation of the given sequence.
+	 */
+	DACSequence(IntSequence *sequence);
+
+	virtual ~DACSequence();
+
+	/**
+	 * Adds the elements to the sequence, replacing the previous contents.
+	 * The iterator is traversed twice.
+	 */
+	void add(IteratorUInt &elements);
+
+	size_t get(size_t position);
+
+	size_t getNumberOfElements();
+
+	/** Number of levels, that is, of chunks of the longest value. */
+	size_t getNumberOfLevels();
+
+	size_t size();
+
+	void save(std::ostream &output);
+
+	void load(std::istream &input);
+
+	size_t load(const unsigned char *ptr, const unsigned char *ptrMax, ProgressListener *listener=NULL);
+
+	std::string getType();
+};
+
+}
+
+#endif /* DACSEQUENCE_HPP_ */
@@ -0,0 +1,451 @@
+/*
+ * File: EliasFanoSequence.cpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+#include <iostream>
+#include <string.h>
+#include <HDTVocabulary.hpp>
+#include "EliasFanoSequence.hpp"
+#include "../libdcs/VByte.h"
+#include "../util/crc8.h"
+#include "../util/crc32.h"
+
+using namespace std;
+
+namespace hdt {
+
+EliasFanoSequence::EliasFanoSequence() : numentries(0), valueBits(0), lowBits(1), valueMask(0), high(NULL), highBits(0), isMapped(false), low(NULL) {
+}
+
+EliasFanoSequence::EliasFanoSequence(IntSequence *sequence) : numentries(0), valueBits(0), lowBits(1), valueMask(0), high(NULL), highBits(0), isMapped(false), low(NULL) {
+	StreamIterator it(sequence);
+	add(it);
+}
+
+EliasFanoSequence::~EliasFanoSequence() {
+	clear();
+}
+
+void EliasFanoSequence::clear() {
+	if(low!=NULL) {
+		delete low;
+		low = NULL;
+	}
+	highData.clear();
+	selectSamples1.clear();
+	selectSamples0.clear();
+	high = NULL;
+	highBits = 0;
+	isMapped = false;
+	numentries = 0;
+}
+
+static inline size_t numWords(size_t bits) {
+	return (bits+63)/64;
+}
+
+static const uint64_t ONES_STEP_8 = 0x0101010101010101ULL;
+static const uint64_t MSBS_STEP_8 = 0x8080808080808080ULL;
+
+/** Ones of each byte of the word, in the same byte (broadword) */
+static inline uint64_t byteCounts(uint64_t word) {
+	word = word - ((word >> 1) & 0x5555555555555555ULL);
+	word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+	return (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+}
+
+static inline unsigned int popcount(uint64_t word) {
+	return (unsigned int)((byteCounts(word) * ONES_STEP_8) >> 56);
+}
+
+/** Position of the rank-th (starting at 0) one of the word, which must have more than rank ones */
+static inline unsigned int wordSelect(uint64_t word, size_t rank) {
+	// Prefix sums of the ones of each byte, find the byte with broadword comparisons.
+	uint64_t byteSums = byteCounts(word) * ONES_STEP_8;
+	uint64_t smaller = ((rank * ONES_STEP_8 | MSBS_STEP_8) - byteSums) & MSBS_STEP_8;
+	unsigned int shift = (unsigned int)(((smaller >> 7) * ONES_STEP_8) >> 56) * 8;
+	rank -= ((byteSums << 8) >> shift) & 0xFF;
+
+	// Select inside the byte
+	unsigned int byte = (unsigned int)(word >> shift) & 0xFF;
+	while(rank>0) {
+		byte &= byte-1;
+		rank--;
+	}
+	return shift + __builtin_ctz(byte);
+}
+
+void EliasFanoSequence::buildSelectSamples() {
+	selectSamples1.clear();
+	selectSamples0.clear();
+	size_t ones = 0, zeros = 0;
+	for(size_t i=0; i<numWords(highBits); i++) {
+		uint64_t word = high[i];
+		unsigned int valid = i+1<numWords(highBits) || highBits%64==0 ? 64 : highBits%64;
+		for(unsigned int j=0; j<valid; j++) {
+			if((word>>j) & 1) {
+				if(ones%SELECT_SAMPLING==0) {
+					selectSamples1.push_back(i*64+j);
+				}
+				ones++;
+			} else {
+				if(zeros%SELECT_SAMPLING==0) {
+					selectSamples0.push_back(i*64+j);
+				}
+				zeros++;
+			}
+		}
+	}
+}
+
+size_t EliasFanoSequence::select(size_t x, bool one) const {
+	// Start at the sample and skip the remaining ones/zeros word by word.
+	const std::vector<size_t> &samples = one ? selectSamples1 : selectSamples0;
+	size_t sample = (x-1)/SELECT_SAMPLING;
+	size_t pos = samples[sample];
+	size_t rank = (x-1)-sample*SELECT_SAMPLING;
+
+	size_t wordIndex = pos>>6;
+	uint64_t word = (one ? high[wordIndex] : ~high[wordIndex]) & (~((uint64_t)0) << (pos&63));
+	size_t count;
+	while((count=popcount(word))<=rank) {
+		rank -= count;
+		wordIndex++;
+		word = one ? high[wordIndex] : ~high[wordIndex];
+	}
+	return (wordIndex<<6) + wordSelect(word, rank);
+}
+
+void EliasFanoSequence::add(IteratorUInt &elements) {
+	clear();
+
+	// First pass: count elements and runs, find the biggest value.
+	size_t numRuns = 0, maxValue = 0;
+	unsigned int previous = 0;
+	while(elements.hasNext()) {
+		unsigned int value = elements.next();
+		if(numentries==0 || value<previous) {
+			numRuns++;
+		}
+		if(value>maxValue) {
+			maxValue = value;
+		}
+		previous = value;
+		numentries++;
+	}
+
+	valueBits = bits(maxValue);
+	valueMask = maxVal(valueBits);
+
+	// The global values are below universe. Use floor(log2(universe/n)) low bits (at least one).
+	uint64_t universe = numRuns==0 ? 1 : ((uint64_t)(numRuns-1) << valueBits) + maxValue + 1;
+	lowBits = 1;
+	if(numentries>0 && universe/numentries>1) {
+		lowBits = bits((size_t)(universe/numentries))-1;
+	}
+	size_t lowMask = maxVal(lowBits);
+
+	// Second pass: split global values in low and high parts.
+	low = new LogSequence2(lowBits, numentries);
+	highData.resize(numWords(numentries + (universe>>lowBits) + 1), 0);
+	high = &highData[0];
+
+	elements.goToStart();
+	uint64_t run = 0;
+	for(size_t i=0; i<numentries; i++) {
+		unsigned int value = elements.next();
+		if(i>0 && value<previous) {
+			run++;
+		}
+		previous = value;
+
+		uint64_t global = (run << valueBits) | value;
+		low->push_back(global & lowMask);
+
+		size_t highPos = (global >> lowBits) + i;
+		high[highPos>>6] |= (uint64_t)1 << (highPos&63);
+		highBits = highPos+1;
+	}
+	highData.resize(numWords(highBits));
+	high = highData.size()>0 ? &highData[0] : NULL;
+
+	buildSelectSamples();
+}
+
+size_t EliasFanoSequence::get(size_t position) {
+	if(position>=numentries) {
+		throw "Trying to get an element bigger than the array.";
+	}
+	return getGlobal(position, select(position+1, true)) & valueMask;
+}
+
+size_t EliasFanoSequence::decode(size_t start, size_t count, unsigned int *out) {
+	if(start>=numentries) {
+		return 0;
+	}
+	if(count>numentries-start) {
+		count = numentries-start;
+	}
+
+	// Low parts in bulk, then add the high part of each element.
+	low->decode(start, count, out);
+
+	size_t highPos = select(start+1, true);
+	for(size_t i=0; i<count; i++) {
+		if(i>0) {
+			highPos = nextOne(highPos+1);
+		}
+		uint64_t global = ((uint64_t)(highPos-start-i) << lowBits) | out[i];
+		out[i] = (unsigned int)(global & valueMask);
+	}
+	return count;
+}
+
+size_t EliasFanoSequence::nextGEQ(size_t begin, size_t end, size_t value) {
+	if(begin>=end) {
+		return begin;
+	}
+	if(value>valueMask) {
+		return end;
+	}
+
+	// The range is inside one run, so the target is in the run of the first element.
+	size_t highPos = select(begin+1, true);
+	uint64_t global = getGlobal(begin, highPos);
+	uint64_t target = (global & ~valueMask) | value;
+	if(global>=target) {
+		return begin;
+	}
+
+	size_t pos = begin;
+	uint64_t targetHigh = target >> lowBits;
+	if(end-begin > LINEAR_THRESHOLD) {
+		// The elements whose high part is targetHigh are contiguous, between
+		// the targetHigh-th and the (targetHigh+1)-th zeros of the high bitmap.
+		size_t zeros = highBits-numentries;
+		if(targetHigh > (global >> lowBits)) {
+			if(targetHigh > zeros) {
+				return end;
+			}
+			pos = select(targetHigh, false)+1-targetHigh;
+			if(pos>=end) {
+				return end;
+			}
+		}
+		size_t last = targetHigh+1 > zeros ? numentries : select(targetHigh+1, false)-targetHigh;
+		if(last>end) {
+			last = end;
+		}
+
+		// Binary search the low part inside the bucket. Next buckets are all greater.
+		size_t targetLow = target & maxVal(lowBits);
+		while(pos<last) {
+			size_t mid = pos+(last-pos)/2;
+			if(low->get(mid)<targetLow) {
+				pos = mid+1;
+			} else {
+				last = mid;
+			}
+		}
+		return pos;
+	}
+
+	// Short range, scan forward
+	while(getGlobal(pos, highPos)<target) {
+		if(++pos>=end) {
+			return end;
+		}
+		highPos = nextOne(highPos+1);
+	}
+	return pos;
+}
+
+size_t EliasFanoSequence::getNumberOfElements() {
+	return numentries;
+}
+
+size_t EliasFanoSequence::size() {
+	size_t total = sizeof(EliasFanoSequence)
+			+ numWords(highBits)*sizeof(uint64_t)
+			+ (selectSamples1.size()+selectSamples0.size())*sizeof(size_t);
+	if(low!=NULL) {
+		total += low->size();
+	}
+	return total;
+}
+
+void EliasFanoSequence::save(std::ostream &output) {
+	if(low==NULL) {
+		throw "Trying to save an empty EliasFanoSequence";
+	}
+	CRC8 crch;
+	CRC32 crcd;
+	unsigned char data[10];
+	unsigned int len;
+
+	// Write type
+	uint8_t type = TYPE_SEQ_ELIAS_FANO;
+	crch.writeData(output, &type, sizeof(type));
+
+	// Write numentries
+	len = csd::VByte::encode(data, numentries);
+	crch.writeData(output, data, len);
+
+	// Write bits
+	crch.writeData(output, &valueBits, sizeof(valueBits));
+	crch.writeData(output, &lowBits, sizeof(lowBits));
+
+	// Write size of the high bitmap
+	len = csd::VByte::encode(data, highBits);
+	crch.writeData(output, data, len);
+
+	// Write Header CRC
+	crch.writeCRC(output);
+
+	// Write high bitmap and its CRC
+	crcd.writeData(output, (unsigned char *)high, numWords(highBits)*sizeof(uint64_t));
+	crcd.writeCRC(output);
+
+	low->save(output);
+}
+
+void EliasFanoSequence::load(std::istream &input) {
+	clear();
+
+	CRC8 crch;
+	CRC32 crcd;
+	unsigned char buf[10];
+	unsigned int pos;
+
+	// Read type
+	uint8_t type;
+	crch.readData(input, (unsigned char*)&type, sizeof(type));
+	if(type!=TYPE_SEQ_ELIAS_FANO) {
+		throw "Trying to read an EliasFanoSequence but the type does not match";
+	}
+
+	// Read numentries
+	uint64_t numentries64 = csd::VByte::decode(input);
+	pos = csd::VByte::encode(buf, numentries64);
+	crch.update(buf, pos);
+
+	// Read bits
+	crch.readData(input, &valueBits, sizeof(valueBits));
+	crch.readData(input, &lowBits, sizeof(lowBits));
+
+	// Read size of the high bitmap
+	uint64_t highBits64 = csd::VByte::decode(input);
+	pos = csd::VByte::encode(buf, highBits64);
+	crch.update(buf, pos);
+
+	// Validate Checksum Header
+	crc8_t filecrch = crc8_read(input);
+	if(crch.getValue()!=filecrch) {
+		throw "Checksum error while reading EliasFanoSequence header.";
+	}
+
+	numentries = (size_t) numentries64;
+	highBits = (size_t) highBits64;
+	valueMask = maxVal(valueBits);
+
+	// Read high bitmap
+	highData.resize(numWords(highBits));
+	high = highData.size()>0 ? &highData[0] : NULL;
+	crcd.readData(input, (unsigned char *)high, numWords(highBits)*sizeof(uint64_t));
+	crc32_t filecrcd = crc32_read(input);
+	if(crcd.getValue()!=filecrcd) {
+		throw "Checksum error while reading EliasFanoSequence Data";
+	}
+
+	low = new LogSequence2();
+	low->load(input);
+
+	buildSelectSamples();
+}
+
+#define CHECKPTR(base, max, size) if(((base)+(size))>(max)) throw "Could not read completely the HDT from the file.";
+
+size_t EliasFanoSequence::load(const unsigned char *ptr, const unsigned char *ptrMax, ProgressListener *listener) {
+	clear();
+	size_t count = 0;
+
+	// Read type
+	CHECKPTR(&ptr[count], ptrMax, 1);
+	if(ptr[count]!=TYPE_SEQ_ELIAS_FANO) {
+		throw "Trying to read an EliasFanoSequence but the type does not match";
+	}
+	count++;
+
+	// Read numentries
+	uint64_t numentries64;
+	count += csd::VByte::decode(&ptr[count], ptrMax, &numentries64);
+
+	// Read bits
+	CHECKPTR(&ptr[count], ptrMax, 2);
+	valueBits = ptr[count++];
+	lowBits = ptr[count++];
+
+	// Read size of the high bitmap
+	uint64_t highBits64;
+	count += csd::VByte::decode(&ptr[count], ptrMax, &highBits64);
+
+	// Validate Checksum Header
+	CRC8 crch;
+	crch.update(&ptr[0], count);
+	CHECKPTR(&ptr[count], ptrMax, 1);
+	if(crch.getValue()!=ptr[count++]) {
+		throw "Checksum error while reading EliasFanoSequence header.";
+	}
+
+	numentries = (size_t) numentries64;
+	highBits = (size_t) highBits64;
+	valueMask = maxVal(valueBits);
+
+	// Map high bitmap
+	size_t highBytes = numWords(highBits)*sizeof(uint64_t);
+	CHECKPTR(&ptr[count], ptrMax, highBytes+4);
+	high = (uint64_t *) &ptr[count];
+	count += highBytes;
+	count += 4; // CRC of data
+	isMapped = true;
+
+	low = new LogSequence2();
+	count += low->load(&ptr[count], ptrMax, listener);
+
+	buildSelectSamples();
+
+	return count;
+}
+
+std::string EliasFanoSequence::getType() {
+	return HDTVocabulary::SEQ_TYPE_ELIAS_FANO;
+}
+
+}
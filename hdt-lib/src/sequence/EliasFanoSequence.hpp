@@ -0,0 +1,148 @@
+/*
+ * File: EliasFanoSequence.hpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+#ifndef ELIASFANOSEQUENCE_HPP_
+#define ELIASFANOSEQUENCE_HPP_
+
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+
+#include "IntSequence.hpp"
+#include "LogSequence2.hpp"
+
+namespace hdt {
+
+/**
+ * Elias-Fano encoding of a sequence made of sorted runs, such as the object
+ * lists of BitmapTriples. The sequence is split in maximal non-decreasing runs,
+ * and the element i of run r is mapped to the global value (r << valueBits) | v,
+ * which is non-decreasing along the whole sequence. The global values are
+ * stored as Elias-Fano: the lowBits least significant bits of each one in a
+ * LogSequence2, and the rest in unary in the high bitmap, where the element i
+ * sets the bit (global >> lowBits) + i.
+ *
+ * Any sorted range lies inside a single run, so nextGEQ() jumps to the
+ * candidate with one select0() on the high bits instead of searching.
+ */
+class EliasFanoSequence : public IntSequence {
+
+private:
+	size_t numentries;
+	unsigned char valueBits;	// Bits of the biggest value
+	unsigned char lowBits;		// Bits of each global value stored explicitly
+	uint64_t valueMask;
+
+	std::vector<uint64_t> highData;
+	uint64_t *high;			// High bitmap, in highData or mapped
+	size_t highBits;		// Bits of the high bitmap, the last one is set
+	bool isMapped;
+
+	std::vector<size_t> selectSamples1;	// Position of the (k*SELECT_SAMPLING+1)-th one
+	std::vector<size_t> selectSamples0;	// Position of the (k*SELECT_SAMPLING+1)-th zero
+
+	LogSequence2 *low;
+
+	static const uint8_t TYPE_SEQ_ELIAS_FANO = 7;
+
+	/** The high bitmap has about half ones, a sample every 256 scans at most 8 words */
+	static const size_t SELECT_SAMPLING = 256;
+
+	/** Up to this number of elements, nextGEQ() scans instead of using select0() */
+	static const size_t LINEAR_THRESHOLD = 64;
+
+	/** Position of the first one of the high bitmap at or after from. There must be one. */
+	inline size_t nextOne(size_t from) const {
+		size_t wordIndex = from>>6;
+		uint64_t word = high[wordIndex] & (~((uint64_t)0) << (from&63));
+		while(word==0) {
+			word = high[++wordIndex];
+		}
+		return (wordIndex<<6) + __builtin_ctzll(word);
+	}
+
+	/** Global value of the element at position i, having its bit at highPos in the high bitmap */
+	inline uint64_t getGlobal(size_t i, size_t highPos) {
+		return ((uint64_t)(highPos-i) << lowBits) | low->get(i);
+	}
+
+	/** Position of the x-th (starting at 1) one or zero of the high bitmap */
+	size_t select(size_t x, bool one) const;
+
+	void buildSelectSamples();
+	void clear();
+
+public:
+	EliasFanoSequence();
+
+	/**
+	 * Create the Elias-Fano representation of the given sequence.
+	 */
+	EliasFanoSequence(IntSequence *sequence);
+
+	virtual ~EliasFanoSequence();
+
+	/**
+	 * Adds the elements to the sequence, replacing the previous contents.
+	 * The iterator is traversed twice.
+	 */
+	void add(IteratorUInt &elements);
+
+	size_t get(size_t position);
+
+	/**
+	 * Decodes count elements starting at start, walking the high bitmap
+	 * sequentially instead of one select per element.
+	 */
+	size_t decode(size_t start, size_t count, unsigned int *out);
+
+	/**
+	 * Finds the first position in [begin, end) whose element is greater or equal
+	 * than value, using select0() on the high bits. The range must be sorted.
+	 */
+	size_t nextGEQ(size_t begin, size_t end, size_t value);
+
+	size_t getNumberOfElements();
+
+	size_t size();
+
+	void save(std::ostream &output);
+
+	void load(std::istream &input);
+
+	size_t load(const unsigned char *ptr, const unsigned char *ptrMax, ProgressListener *listener=NULL);
+
+	std::string getType();
+};
+
+}
+
+#endif /* ELIASFANOSEQUENCE_HPP_ */
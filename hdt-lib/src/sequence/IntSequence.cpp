@@ -34,6 +34,8 @@
 #include "ArraySequence.hpp"
 #include "HuffmanSequence.hpp"
 #include "WaveletSequence.hpp"
+#include "EliasFanoSequence.hpp"
+#include "DACSequence.hpp"
 
 #include <HDTVocabulary.hpp>
 
@@ -49,6 +51,10 @@ IntSequence *IntSequence::getArray(std::string type)
 		return new HuffmanSequence();
 	} else if(type==HDTVocabulary::SEQ_TYPE_WAVELET) {
 		return new WaveletSequence();
+	} else if(type==HDTVocabulary::SEQ_TYPE_ELIAS_FANO) {
+		return new EliasFanoSequence();
+	} else if(type==HDTVocabulary::SEQ_TYPE_DAC) {
+		return new DACSequence();
 	}
 	return new LogSequence2();
 }
@@ -63,11 +69,57 @@ IntSequence *IntSequence::getArray(unsigned char type)
 		return new HuffmanSequence();
 	} else if(type==SEQ_TYPE_WAVELET) {
 		return new WaveletSequence();
+	} else if(type==SEQ_TYPE_ELIAS_FANO) {
+		return new EliasFanoSequence();
+	} else if(type==SEQ_TYPE_DAC) {
+		return new DACSequence();
 	}
 	return new LogSequence2();
 }
 
 
+size_t IntSequence::decode(size_t start, size_t count, unsigned int *out)
+{
+	size_t numElements = getNumberOfElements();
+	if(start>=numElements) {
+		return 0;
+	}
+	if(count>numElements-start) {
+		count = numElements-start;
+	}
+	for(size_t i=0;i<count;i++) {
+		out[i] = (unsigned int)get(start+i);
+	}
+	return count;
+}
+
+size_t IntSequence::nextGEQ(size_t begin, size_t end, size_t value)
+{
+	if(begin>=end || get(begin)>=value) {
+		return begin;
+	}
+
+	// Invariant: element at low < value
+	size_t low = begin;
+	size_t step = 1;
+	while(low+step<end && get(low+step)<value) {
+		low += step;
+		step <<= 1;
+	}
+	size_t high = low+step<end ? low+step : end;
+
+	// Binary search in (low, high]
+	while(high-low>1) {
+		size_t mid = low+(high-low)/2;
+		if(get(mid)<value) {
+			low = mid;
+		} else {
+			high = mid;
+		}
+	}
+	return high;
+}
+
 IntSequence *IntSequence::getArray(std::istream &input)
 {
 	return getArray((unsigned char)input.peek());
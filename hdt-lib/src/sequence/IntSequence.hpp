@@ -46,6 +46,8 @@ enum SequenceType {
 	SEQ_TYPE_HUFFMAN,
 	SEQ_TYPE_WAVELET,
 	SEQ_TYPE_LOG2,
+	SEQ_TYPE_ELIAS_FANO,
+	SEQ_TYPE_DAC,
 };
 
 class IteratorUInt {
@@ -87,6 +89,23 @@ public:
 	 */
 	virtual size_t get(size_t position)=0;
 
+	/**
+	 * Decodes count consecutive elements, starting at position start, into out.
+	 * Sequences override it to avoid one virtual get() call per element on scans.
+	 *
+	 * @return Number of elements decoded, smaller than count at the end of the stream.
+	 */
+	virtual size_t decode(size_t start, size_t count, unsigned int *out);
+
+	/**
+	 * Finds the first position in [begin, end) whose element is greater or equal
+	 * than value. The range must be sorted in increasing order.
+	 * The default implementation is an exponential (galloping) search using get().
+	 *
+	 * @return The position, or end if all elements are lower.
+	 */
+	virtual size_t nextGEQ(size_t begin, size_t end, size_t value);
+
 	/**
 	 * Gets the total number of elements in the stream
 	 *
@@ -151,6 +170,54 @@ public:
 };
 
 
+// Random access to a sequence decoding blocks of elements, so that sequential scans
+// (forwards or backwards) do not pay one virtual call per element. The blocks start
+// small and double while the accesses are sequential, so that short ranges, like
+// the results of a bound pattern, do not decode a whole block.
+class SequenceBuffer {
+private:
+	static const size_t BLOCK = 128;
+	static const size_t FIRST_BLOCK = 8;
+
+	IntSequence *stream;
+	size_t numElements;
+	size_t first, count, blockSize;
+	unsigned int buffer[BLOCK];
+
+	void fill(size_t pos) {
+		if(count>0 && (pos==first+count || pos+1==first)) {
+			blockSize = blockSize*2<BLOCK ? blockSize*2 : BLOCK;
+		} else {
+			blockSize = FIRST_BLOCK;
+		}
+		if(pos<first) {
+			// Scanning backwards, keep pos at the end of the block.
+			first = pos+1>=blockSize ? pos+1-blockSize : 0;
+		} else {
+			first = pos;
+		}
+		count = stream->decode(first, blockSize, buffer);
+	}
+
+public:
+	SequenceBuffer(IntSequence *elements) : stream(elements), numElements(elements->getNumberOfElements()), first(0), count(0), blockSize(FIRST_BLOCK) {
+	}
+
+	inline unsigned int get(size_t pos) {
+		if(pos-first>=count) {
+			if(pos>=numElements) {
+				throw "Trying to get an element bigger than the array.";
+			}
+			fill(pos);
+		}
+		return buffer[pos-first];
+	}
+
+	size_t getNumberOfElements() {
+		return numElements;
+	}
+};
+
 // Iterator using C++ vector<unsigned int>
 class VectorUIntIterator : public IteratorUInt {
 private:
@@ -31,6 +31,7 @@
 
 #include <iostream>
 #include <limits>
+#include <string.h>
 #include <HDTVocabulary.hpp>
 #include "LogSequence2.hpp"
 #include "../libdcs/VByte.h"
@@ -70,13 +71,125 @@ LogSequence2::~LogSequence2() {
 
 }
 
-size_t LogSequence2::get(size_t position)
+/**
+ * Unpack count fields of BITS bits starting at bit bitPos of data, which has
+ * numBytes bytes. The field width is a template parameter, so the shifts and
+ * masks are constants and the compiler can unroll each instance.
+ */
+template<unsigned int BITS>
+static void unpackFields(const size_t *data, size_t numBytes, uint64_t bitPos, size_t count, unsigned int *out) {
+	static const unsigned int W = sizeof(size_t)*8;
+	const size_t mask = BITS==W ? ~((size_t)0) : ~(~((size_t)0) << BITS);
+	size_t k=0;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__==__ORDER_LITTLE_ENDIAN__
+	// A field of up to 32 bits fits in the 8 bytes from the one where it starts, so
+	// each one is a single unaligned load and shift, without branches, as long as
+	// those bytes are inside the data.
+	if(BITS<=32 && numBytes>=8 && bitPos<=(uint64_t)(numBytes-8)*8) {
+		const unsigned char *bytes = (const unsigned char *)data;
+		uint64_t fast = ((uint64_t)(numBytes-8)*8+7-bitPos)/BITS+1;
+		if(fast>count) {
+			fast = count;
+		}
+		for(; k<fast; k++) {
+			uint64_t word;
+			memcpy(&word, bytes+(bitPos>>3), sizeof(word));
+			out[k] = (unsigned int)((word >> (bitPos&7)) & mask);
+			bitPos += BITS;
+		}
+	}
+#endif
+
+	size_t i = bitPos/W;
+	unsigned int j = bitPos%W;
+	for(; k<count; k++) {
+		size_t value = data[i] >> j;
+		if(j+BITS>W) {
+			value |= data[i+1] << (W-j);
+		}
+		out[k] = (unsigned int)(value & mask);
+
+		j+=BITS;
+		if(j>=W) {
+			j-=W;
+			i++;
+		}
+	}
+}
+
+size_t LogSequence2::decode(size_t start, size_t count, unsigned int *out)
+{
+	if(start>=numentries) {
+		return 0;
+	}
+	if(count>numentries-start) {
+		count = numentries-start;
+	}
+
+	uint64_t bitPos = (uint64_t)start*numbits;
+	size_t numBytes = numBytesFor(numbits, numentries);
+
+#define UNPACK_CASE(n) case n: unpackFields<n>(array, numBytes, bitPos, count, out); break;
+	switch(numbits) {
+	case 0:
+		for(size_t k=0;k<count;k++) {
+			out[k] = 0;
+		}
+		break;
+	UNPACK_CASE(1) UNPACK_CASE(2) UNPACK_CASE(3) UNPACK_CASE(4)
+	UNPACK_CASE(5) UNPACK_CASE(6) UNPACK_CASE(7) UNPACK_CASE(8)
+	UNPACK_CASE(9) UNPACK_CASE(10) UNPACK_CASE(11) UNPACK_CASE(12)
+	UNPACK_CASE(13) UNPACK_CASE(14) UNPACK_CASE(15) UNPACK_CASE(16)
+	UNPACK_CASE(17) UNPACK_CASE(18) UNPACK_CASE(19) UNPACK_CASE(20)
+	UNPACK_CASE(21) UNPACK_CASE(22) UNPACK_CASE(23) UNPACK_CASE(24)
+	UNPACK_CASE(25) UNPACK_CASE(26) UNPACK_CASE(27) UNPACK_CASE(28)
+	UNPACK_CASE(29) UNPACK_CASE(30) UNPACK_CASE(31) UNPACK_CASE(32)
+	default:
+		for(size_t k=0;k<count;k++) {
+			out[k] = (unsigned int)get_field(array, numbits, start+k);
+		}
+	}
+#undef UNPACK_CASE
+
+	return count;
+}
+
+size_t LogSequence2::nextGEQ(size_t begin, size_t end, size_t value)
 {
-	if(position>=numentries) {
-		throw "Trying to get an element bigger than the array.";
+	if(end>numentries) {
+		end = numentries;
+	}
+	if(begin>=end || get_field(array, numbits, begin)>=value) {
+		return begin;
 	}
 
-	return get_field(&array[0], numbits, position);
+	// Invariant: element at low < value, the result is in (low, high]
+	size_t low = begin;
+	size_t step = 1;
+	while(low+step<end && get_field(array, numbits, low+step)<value) {
+		low += step;
+		step <<= 1;
+	}
+	size_t high = low+step<end ? low+step : end;
+
+	while(high-low>LINEAR_THRESHOLD) {
+		size_t mid = low+(high-low)/2;
+		if(get_field(array, numbits, mid)<value) {
+			low = mid;
+		} else {
+			high = mid;
+		}
+	}
+
+	// The range is sorted, the result is low+1 plus the number of candidates below value.
+	unsigned int buffer[LINEAR_THRESHOLD];
+	size_t count = LogSequence2::decode(low+1, high-low-1, buffer);
+	size_t smaller = 0;
+	for(size_t i=0;i<count;i++) {
+		smaller += buffer[i]<value;
+	}
+	return low+1+smaller;
 }
 
 void LogSequence2::add(IteratorUInt &elements)
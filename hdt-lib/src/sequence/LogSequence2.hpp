@@ -55,6 +55,9 @@ private:
 	static const uint8_t TYPE_SEQLOG = 1;
 	static const unsigned int W = sizeof(size_t)*8;
 
+	/** Candidates left when nextGEQ() switches from binary to linear search */
+	static const size_t LINEAR_THRESHOLD = 32;
+
 	/** size_t's required to represent n integers of e bits each */
 	inline size_t numElementsFor(const size_t bitsField, const size_t numEntries) {
 		return (((uint64_t)bitsField*numEntries+W-1)/W);
@@ -136,7 +139,37 @@ public:
 	 *            The position of the element to be returned
 	 * @return int
 	 */
-	size_t get(size_t position);
+	inline size_t get(size_t position) {
+		if(position>=numentries) {
+			throw "Trying to get an element bigger than the array.";
+		}
+		return get_field(array, numbits, position);
+	}
+
+	/**
+	 * Prefetch the word holding the element at position, to overlap its cache
+	 * miss with other work before calling get().
+	 */
+	inline void prefetch(size_t position) const {
+#ifdef __GNUC__
+		if(position<numentries) {
+			__builtin_prefetch(&array[((uint64_t)position*numbits)/W]);
+		}
+#endif
+	}
+
+	/**
+	 * Decodes count elements starting at start into out, reading the packed
+	 * words sequentially with a kernel specialized for the number of bits.
+	 */
+	size_t decode(size_t start, size_t count, unsigned int *out);
+
+	/**
+	 * Finds the first position in [begin, end) whose element is greater or equal
+	 * than value. Gallops and bisects with get_field() until few candidates are
+	 * left, then decodes them in a block and counts the smaller ones without branches.
+	 */
+	size_t nextGEQ(size_t begin, size_t end, size_t value);
 
 	/**
 	 * Sets the element in a specific position
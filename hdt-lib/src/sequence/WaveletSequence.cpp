@@ -33,6 +33,8 @@
 
 #include "WaveletSequence.hpp"
 
+#include <WaveletMatrix.h>
+
 #include "LogSequence.hpp"
 
 namespace hdt {
@@ -53,6 +55,16 @@ WaveletSequence::WaveletSequence(IntSequence *otherStream) : sequence(NULL) {
 	}
 }
 
+WaveletSequence::WaveletSequence(IntSequence *otherStream, std::string structure) : sequence(NULL) {
+	std::vector<unsigned int> vector;
+	vector.reserve(otherStream->getNumberOfElements());
+	for(size_t i=0;i<otherStream->getNumberOfElements();i++) {
+		vector.push_back(otherStream->get(i));
+	}
+
+	sequence = build(&vector[0], vector.size(), structure);
+}
+
 WaveletSequence::~WaveletSequence() {
 	if(sequence!=NULL)
 		delete sequence;
@@ -90,10 +102,20 @@ void WaveletSequence::add(IteratorUInt &elements)
 		sequence=NULL;
 	}
 
+	sequence = build(&vector[0], vector.size(), HDTVocabulary::SEQ_TYPE_WAVELET);
+}
+
+cds_static::Sequence *WaveletSequence::build(unsigned int *symbols, size_t len, std::string structure)
+{
 	cds_static::BitSequenceBuilder *builder = new cds_static::BitSequenceBuilderRG(20);
 	cds_static::Mapper *mapper = new cds_static::MapperNone();
 
-	sequence = new cds_static::WaveletTreeNoptrs(&vector[0], vector.size(), builder, mapper);
+	if(structure==HDTVocabulary::SEQ_TYPE_WAVELET_MATRIX) {
+		// One bitmap per bit of the alphabet, so rank/select/access cost
+		// O(log sigma) bitmap operations without following tree nodes.
+		return new cds_static::WaveletMatrix(symbols, len, builder, mapper);
+	}
+	return new cds_static::WaveletTreeNoptrs(symbols, len, builder, mapper);
 }
 
 void WaveletSequence::load(std::istream & input)
@@ -144,6 +166,14 @@ std::string WaveletSequence::getType()
 	return HDTVocabulary::SEQ_TYPE_WAVELET;
 }
 
+std::string WaveletSequence::getStructure()
+{
+	if(dynamic_cast<cds_static::WaveletMatrix *>(sequence)!=NULL) {
+		return HDTVocabulary::SEQ_TYPE_WAVELET_MATRIX;
+	}
+	return HDTVocabulary::SEQ_TYPE_WAVELET;
+}
+
 
 size_t WaveletSequence::rank(size_t symbol, size_t pos) {
 	if(sequence!=NULL) {
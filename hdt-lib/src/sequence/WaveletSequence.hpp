@@ -43,9 +43,17 @@ class WaveletSequence : public IntSequence {
 private:
 	cds_static::Sequence *sequence;
 
+	cds_static::Sequence *build(unsigned int *symbols, size_t len, std::string structure);
+
 public:
 	WaveletSequence();
 	WaveletSequence(IntSequence *otherStream);
+
+	/**
+	 * Build the wavelet from other stream, using the specified structure:
+	 * HDTVocabulary::SEQ_TYPE_WAVELET (Wavelet Tree) or HDTVocabulary::SEQ_TYPE_WAVELET_MATRIX.
+	 */
+	WaveletSequence(IntSequence *otherStream, std::string structure);
 	virtual ~WaveletSequence();
 
 	/**
@@ -94,6 +102,11 @@ public:
 
 	std::string getType();
 
+	/**
+	 * Get the underlying structure of the wavelet (Tree or Matrix).
+	 */
+	std::string getStructure();
+
 	size_t rank(size_t symbol, size_t pos);
 	size_t select(size_t symbol, size_t pos);
 };
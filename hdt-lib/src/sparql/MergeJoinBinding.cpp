@@ -66,25 +66,27 @@ bool MergeJoinBinding::findNext() {
 	return false;
     }
 
-    // Check which one is lower and find it in the other.
+    // Skip ahead on the lower one until both reach the same value.
     //cout << "Comparing s and r:    s=" << s << " r=" << r << endl;
-    if(s<r) {
-	if(left->findNext(bindingVarPosLeft, r)) {
-	    //cout << "Forward left" << endl;
-	    s = left->getVarValue(bindingVarPosLeft);
-	} else {
-	    //cout << "No more results left" << endl;
-	    hasMoreOperands = false;
-	    return false;
-	}
-    } else if(s>r) {
-	if(right->findNext(bindingVarPosLeft, s)) {
-	    //cout << "Forward right" << endl;
-	    r = right->getVarValue(bindingVarPosLeft);
+    while(s!=r) {
+	if(s<r) {
+	    if(left->findNextGreaterOrEqual(bindingVarPosLeft, r)) {
+		//cout << "Forward left" << endl;
+		s = left->getVarValue(bindingVarPosLeft);
+	    } else {
+		//cout << "No more results left" << endl;
+		hasMoreOperands = false;
+		return false;
+	    }
 	} else {
-	    //cout << "No more results right" << endl;
-	    hasMoreOperands = false;
-	    return false;
+	    if(right->findNextGreaterOrEqual(bindingVarPosRight, s)) {
+		//cout << "Forward right" << endl;
+		r = right->getVarValue(bindingVarPosRight);
+	    } else {
+		//cout << "No more results right" << endl;
+		hasMoreOperands = false;
+		return false;
+	    }
 	}
     }
 
@@ -8,6 +8,7 @@
 #include <list>
 
 #include "QueryProcessor.hpp"
+#include "../hdt/BasicHDT.hpp"
 
 namespace hdt {
 
@@ -45,6 +46,16 @@ set<string> getCommonVars(VarBindingInterface& a, VarBindingInterface& b) {
 
 
 VarBindingString* QueryProcessor::searchJoin(vector<TripleString>& patterns, set<string>& vars) {
+	vector<LiteralRangeFilter> filters;
+	return searchJoin(patterns, vars, filters);
+}
+
+VarBindingString* QueryProcessor::searchJoin(vector<TripleString>& patterns, set<string>& vars, vector<LiteralRangeFilter> &filters) {
+	vector<LiteralTagFilter> tagFilters;
+	return searchJoin(patterns, vars, filters, tagFilters);
+}
+
+VarBindingString* QueryProcessor::searchJoin(vector<TripleString>& patterns, set<string>& vars, vector<LiteralRangeFilter> &filters, vector<LiteralTagFilter> &tagFilters) {
 	try {
 		if (patterns.size() == 0) {
 			return new EmptyVarBingingString();
@@ -162,6 +173,27 @@ VarBindingString* QueryProcessor::searchJoin(vector<TripleString>& patterns, set
 			// IF no match found??
 		}
 
+		// Fetched for each query, the HDT replaces its indexes when they are regenerated.
+		BasicHDT *basic = dynamic_cast<BasicHDT *>(hdt);
+		LiteralRangeIndex *literalIndex = basic!=NULL ? basic->getLiteralRangeIndex() : NULL;
+		LiteralTagIndex *tagIndex = basic!=NULL ? basic->getLiteralTagIndex() : NULL;
+
+		for (unsigned int i = 0; i < filters.size(); i++) {
+			map<string, TripleComponentRole>::iterator role = varRole.find(filters[i].var);
+			if (role == varRole.end() || role->second != OBJECT) {
+				throw "Range filters only apply to variables in the object of the patterns";
+			}
+			root = new VarRangeFilterBinding(root, filters[i], literalIndex, hdt->getDictionary());
+		}
+
+		for (unsigned int i = 0; i < tagFilters.size(); i++) {
+			map<string, TripleComponentRole>::iterator role = varRole.find(tagFilters[i].var);
+			if (role == varRole.end() || role->second != OBJECT) {
+				throw "Literal filters only apply to variables in the object of the patterns";
+			}
+			root = new VarTagFilterBinding(root, tagFilters[i], tagIndex, hdt->getDictionary());
+		}
+
 		return new BasicVarBindingString(varRole, new VarFilterBinding(root, vars), hdt->getDictionary());
 	} catch (char *e) {
 		cout << "Exception: " << e << endl;
@@ -21,6 +21,18 @@ public:
 	virtual ~QueryProcessor();
 
 	VarBindingString *searchJoin(vector<TripleString> &patterns, set<string> &vars);
+
+	/**
+	 * Join the patterns, keeping only the results whose object variables satisfy
+	 * the range filters. The literal range index of the HDT is used when available.
+	 */
+	VarBindingString *searchJoin(vector<TripleString> &patterns, set<string> &vars, vector<LiteralRangeFilter> &filters);
+
+	/**
+	 * Same, also with language and datatype filters. The literal tag index of
+	 * the HDT is used when available.
+	 */
+	VarBindingString *searchJoin(vector<TripleString> &patterns, set<string> &vars, vector<LiteralRangeFilter> &filters, vector<LiteralTagFilter> &tagFilters);
 };
 
 
@@ -63,7 +75,9 @@ public:
 		unsigned int id = varID->getVarValue(numvar);
 		string varName(getVarName(numvar));
 
-		return dict->idToString(id, varRole.find(varName)->second);
+		string value;
+		dict->extractString(id, varRole.find(varName)->second, value);
+		return value;
 	}
 	virtual const char *getVarName(unsigned int numvar) {
 		return varID->getVarName(numvar);
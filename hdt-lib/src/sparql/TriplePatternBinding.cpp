@@ -62,23 +62,18 @@ bool TriplePatternBinding::findNext() {
 	return false;
 }
 
-#if 0
 // Use TriplePattern to jump to next occurence.
-bool TriplePatternBinding::findNext(const char *varName, unsigned int value=0) {
-	unsigned int varIdx = getVarIndex(varName);
+bool TriplePatternBinding::findNextGreaterOrEqual(unsigned int varIndex, unsigned int value) {
+	if(!iterator->canFindNextOccurrence(vars[varIndex])) {
+		return VarBindingInterface::findNextGreaterOrEqual(varIndex, value);
+	}
 
-	if(iterator->findNextOccurrence(value, vars[varIdx])) {
+	if(iterator->findNextOccurrence(value, vars[varIndex]) && iterator->hasNext()) {
 		currentTriple = iterator->next();
-
-		if(getVar(varName)!=value) {
-			throw "Found value is not what we were searching!";
-		}
 		return true;
 	}
-
 	return false;
 }
-#endif
 
 void TriplePatternBinding::goToStart() {
 	iterator->goToStart();
@@ -37,10 +37,8 @@ public:
 	ResultEstimationType estimationAccuracy();
 	bool findNext();
 
-#if 0
 	// Use TriplePattern to jump to next occurence.
-	bool findNext(const char *varName, unsigned int value=0);
-#endif
+	bool findNextGreaterOrEqual(unsigned int varIndex, unsigned int value);
 
 	void goToStart();
 	unsigned int getNumVars();
@@ -41,6 +41,18 @@ public:
 		}
 		return false;
 	}
+	/**
+	 * Move forward to the next result whose variable is greater or equal than value.
+	 * Bindings over a sorted variable can override it to skip ahead instead of scanning.
+	 */
+	virtual bool findNextGreaterOrEqual(unsigned int varIndex, unsigned int value) {
+		while(findNext()) {
+			if(getVarValue(varIndex)>=value) {
+				return true;
+			}
+		}
+		return false;
+	}
 	virtual unsigned int getNumVars()=0;
 	virtual unsigned int getVarValue(const char *varName)=0;
 	virtual unsigned int getVarValue(unsigned int numvar)=0;
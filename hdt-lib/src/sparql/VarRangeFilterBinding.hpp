@@ -0,0 +1,119 @@
+#ifndef VARRANGEFILTERBINDING_HPP
+#define VARRANGEFILTERBINDING_HPP
+
+#include <Dictionary.hpp>
+
+#include "VarBindingInterface.hpp"
+#include "../dictionary/LiteralRangeIndex.hpp"
+
+namespace hdt {
+
+/**
+ * Restriction of an object variable to the typed literals whose value is in
+ * an interval, like FILTER(?v > 10 && ?v < 100) on xsd:integer values.
+ */
+struct LiteralRangeFilter {
+    string var;
+    LiteralValueType type;
+    double low, high;
+    bool lowInclusive, highInclusive;
+};
+
+/**
+ * Binding that only returns the results of its child whose variable satisfies
+ * a LiteralRangeFilter. With a LiteralRangeIndex the accepted IDs are marked in
+ * a bitmap once, otherwise each value is converted to string and parsed.
+ */
+class VarRangeFilterBinding : public VarBindingInterface
+{
+
+private:
+    VarBindingInterface *child;
+    LiteralRangeFilter filter;
+    unsigned int varIndex;
+    BitSequence375 *bitmap;
+    Dictionary *dictionary;
+    std::string literal;
+
+    bool accept(unsigned int id) {
+	if(bitmap!=NULL) {
+	    return id<bitmap->getNumBits() && bitmap->access(id);
+	}
+	LiteralValueType type;
+	double value;
+	dictionary->extractString(id, OBJECT, literal);
+	if(!LiteralRangeIndex::parseValue(literal, &type, &value) || type!=filter.type) {
+	    return false;
+	}
+	return (filter.lowInclusive ? value>=filter.low : value>filter.low)
+		&& (filter.highInclusive ? value<=filter.high : value<filter.high);
+    }
+public:
+    /**
+     * @param index Literal range index of the HDT, or NULL to parse the literals.
+     */
+    VarRangeFilterBinding(VarBindingInterface *child, LiteralRangeFilter &filter, LiteralRangeIndex *index, Dictionary *dictionary) :
+	child(child), filter(filter), bitmap(NULL), dictionary(dictionary) {
+	varIndex = child->getVarIndex(filter.var.c_str());
+	if(index!=NULL) {
+	    bitmap = index->getBitmap(filter.type, filter.low, filter.lowInclusive, filter.high, filter.highInclusive);
+	}
+    }
+
+    ~VarRangeFilterBinding() {
+	delete child;
+	if(bitmap!=NULL) {
+	    delete bitmap;
+	}
+    }
+
+    unsigned int isOrdered(unsigned int numvar) {
+	return child->isOrdered(numvar);
+    }
+
+    unsigned int estimatedNumResults() {
+	return child->estimatedNumResults();
+    }
+
+    ResultEstimationType estimationAccuracy() {
+	ResultEstimationType accuracy = child->estimationAccuracy();
+	return accuracy==EXACT ? UP_TO : accuracy;
+    }
+
+    bool findNext() {
+	while(child->findNext()) {
+	    if(accept(child->getVarValue(varIndex))) {
+		return true;
+	    }
+	}
+	return false;
+    }
+
+    unsigned int getNumVars() {
+	return child->getNumVars();
+    }
+
+    unsigned int getVarValue(const char *varName) {
+	return child->getVarValue(varName);
+    }
+
+    unsigned int getVarValue(unsigned int numvar) {
+	return child->getVarValue(numvar);
+    }
+
+    const char *getVarName(unsigned int numvar) {
+	return child->getVarName(numvar);
+    }
+
+    void searchVar(unsigned int numvar, unsigned int value) {
+	child->searchVar(numvar, value);
+    }
+
+    void goToStart() {
+	child->goToStart();
+    }
+};
+
+}
+
+#endif // VARRANGEFILTERBINDING_HPP
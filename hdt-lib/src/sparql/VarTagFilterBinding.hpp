@@ -0,0 +1,142 @@
+#ifndef VARTAGFILTERBINDING_HPP
+#define VARTAGFILTERBINDING_HPP
+
+#include <Dictionary.hpp>
+
+#include "VarBindingInterface.hpp"
+#include "../dictionary/LiteralTagIndex.hpp"
+
+namespace hdt {
+
+enum LiteralTagFilterType {
+    TAG_IS_LITERAL,	// FILTER(isLiteral(?v))
+    TAG_LANGUAGE,	// FILTER(lang(?v)="value")
+    TAG_DATATYPE	// FILTER(datatype(?v)=<value>)
+};
+
+/**
+ * Restriction of an object variable to the literals, to those with a
+ * language, or to those with a datatype written between '<' and '>'.
+ */
+struct LiteralTagFilter {
+    string var;
+    LiteralTagFilterType type;
+    string value;
+};
+
+/**
+ * Binding that only returns the results of its child whose variable satisfies
+ * a LiteralTagFilter. With a LiteralTagIndex the accepted IDs are marked in a
+ * bitmap once, otherwise each value is converted to string and parsed.
+ */
+class VarTagFilterBinding : public VarBindingInterface
+{
+
+private:
+    VarBindingInterface *child;
+    LiteralTagFilter filter;
+    unsigned int varIndex;
+    BitSequence375 *bitmap;
+    LiteralTagIndex *index;
+    Dictionary *dictionary;
+    std::string literal, tag;
+
+    bool accept(unsigned int id) {
+	if(bitmap!=NULL) {
+	    return id<bitmap->getNumBits() && bitmap->access(id);
+	}
+	if(index!=NULL) {
+	    return index->isLiteral(id);
+	}
+	dictionary->extractString(id, OBJECT, literal);
+	if(!LiteralTagIndex::parseTag(literal, tag)) {
+	    return false;
+	}
+	switch(filter.type) {
+	case TAG_LANGUAGE:
+	    return tag.size()==filter.value.size()+1 && tag[0]=='@' && tag.compare(1, string::npos, filter.value)==0;
+	case TAG_DATATYPE:
+	    return LiteralTagIndex::getDatatypeOfTag(tag)==filter.value;
+	default:
+	    return true;
+	}
+    }
+public:
+    /**
+     * @param index Literal tag index of the HDT, or NULL to parse the literals.
+     */
+    VarTagFilterBinding(VarBindingInterface *child, LiteralTagFilter &filter, LiteralTagIndex *index, Dictionary *dictionary) :
+	child(child), filter(filter), bitmap(NULL), index(index), dictionary(dictionary) {
+	varIndex = child->getVarIndex(filter.var.c_str());
+	if(index!=NULL && filter.type!=TAG_IS_LITERAL) {
+	    std::vector<unsigned int> ids;
+	    if(filter.type==TAG_LANGUAGE) {
+		index->getObjectIDsByLanguage(filter.value, ids);
+	    } else {
+		index->getObjectIDsByDatatype(filter.value, ids);
+	    }
+	    bitmap = new BitSequence375(dictionary->getMaxObjectID()+1);
+	    bitmap->set(dictionary->getMaxObjectID(), false);
+	    for(size_t i=0; i<ids.size(); i++) {
+		bitmap->set(ids[i], true);
+	    }
+	}
+    }
+
+    ~VarTagFilterBinding() {
+	delete child;
+	if(bitmap!=NULL) {
+	    delete bitmap;
+	}
+    }
+
+    unsigned int isOrdered(unsigned int numvar) {
+	return child->isOrdered(numvar);
+    }
+
+    unsigned int estimatedNumResults() {
+	return child->estimatedNumResults();
+    }
+
+    ResultEstimationType estimationAccuracy() {
+	ResultEstimationType accuracy = child->estimationAccuracy();
+	return accuracy==EXACT ? UP_TO : accuracy;
+    }
+
+    bool findNext() {
+	while(child->findNext()) {
+	    if(accept(child->getVarValue(varIndex))) {
+		return true;
+	    }
+	}
+	return false;
+    }
+
+    unsigned int getNumVars() {
+	return child->getNumVars();
+    }
+
+    unsigned int getVarValue(const char *varName) {
+	return child->getVarValue(varName);
+    }
+
+    unsigned int getVarValue(unsigned int numvar) {
+	return child->getVarValue(numvar);
+    }
+
+    const char *getVarName(unsigned int numvar) {
+	return child->getVarName(numvar);
+    }
+
+    void searchVar(unsigned int numvar, unsigned int value) {
+	child->searchVar(numvar, value);
+    }
+
+    void goToStart() {
+	child->goToStart();
+    }
+};
+
+}
+
+#endif // VARTAGFILTERBINDING_HPP
@@ -14,5 +14,7 @@
 #include "IndexJoinBinding.hpp"
 #include "MergeJoinBinding.hpp"
 #include "VarFilterBinding.hpp"
+#include "VarRangeFilterBinding.hpp"
+#include "VarTagFilterBinding.hpp"
 
 #endif /* JOINS_HPP_ */
@@ -32,6 +32,8 @@
 #include "BitmapTriples.hpp"
 
 #include "TripleIterators.hpp"
+#include "BitmapTriplesScanIterator.hpp"
+#include "../sequence/EliasFanoSequence.hpp"
 
 #include <HDTVocabulary.hpp>
 
@@ -52,6 +54,8 @@ BitmapTriples::BitmapTriples() : order(SPO) {
 	bitmapIndex = NULL;
 	waveletY = NULL;
 	predicateCount = NULL;
+	predicateOccurrences = NULL;
+	occurrenceOffsets = NULL;
 }
 
 BitmapTriples::BitmapTriples(HDTSpecification &specification) : spec(specification) {
@@ -67,6 +71,8 @@ BitmapTriples::BitmapTriples(HDTSpecification &specification) : spec(specificati
 	bitmapIndex = NULL;
 	waveletY = NULL;
 	predicateCount = NULL;
+	predicateOccurrences = NULL;
+	occurrenceOffsets = NULL;
 }
 
 BitmapTriples::~BitmapTriples() {
@@ -88,6 +94,12 @@ BitmapTriples::~BitmapTriples() {
 	if(predicateCount!=NULL) {
 		delete predicateCount;
 	}
+	if(predicateOccurrences!=NULL) {
+		delete predicateOccurrences;
+	}
+	if(occurrenceOffsets!=NULL) {
+		delete occurrenceOffsets;
+	}
 	delete arrayY;
 	delete arrayZ;
 }
@@ -104,8 +116,8 @@ void BitmapTriples::load(ModifiableTriples &triples, ProgressListener *listener)
 
 	IteratorTripleID *it = triples.searchAll();
 
-	bitmapY = new BitSequence375(triples.getNumberOfElements()/2);
-	bitmapZ = new BitSequence375(triples.getNumberOfElements());
+	bitmapY = BitSeq::getBitmap(spec.get("bitmap.y"));
+	bitmapZ = BitSeq::getBitmap(spec.get("bitmap.z"));
 
 	LogSequence2 *vectorY = new LogSequence2(bits(triples.getNumberOfElements()));
 	LogSequence2 *vectorZ = new LogSequence2(bits(triples.getNumberOfElements()),triples.getNumberOfElements());
@@ -176,7 +188,13 @@ void BitmapTriples::load(ModifiableTriples &triples, ProgressListener *listener)
 	arrayY = vectorY;
 
 	delete arrayZ;
-	arrayZ = vectorZ;
+	if(spec.get("stream.z")==HDTVocabulary::SEQ_TYPE_ELIAS_FANO) {
+		// Object lists are increasing, encode them as Elias-Fano.
+		arrayZ = new EliasFanoSequence(vectorZ);
+		delete vectorZ;
+	} else {
+		arrayZ = vectorZ;
+	}
 
 #if 0
 	AdjacencyList adjY(arrayY, bitmapY);
@@ -227,7 +245,7 @@ void BitmapTriples::generateWavelet(ProgressListener *listener) {
 	if(arrayY->getType()==HDTVocabulary::SEQ_TYPE_WAVELET) {
 		waveletY = reinterpret_cast<WaveletSequence *>(arrayY);
 	} else {
-		waveletY = new WaveletSequence(arrayY);
+		waveletY = new WaveletSequence(arrayY, spec.get("stream.wavelet"));
 #if 0
         // FIXME: Substitute existing or leave both?
         delete arrayY;
@@ -236,6 +254,62 @@ void BitmapTriples::generateWavelet(ProgressListener *listener) {
 	}
 }
 
+/**
+ * Builds the offsets used by MiddleWaveletIterator::goTo(). The occurrences of each
+ * predicate in Y are grouped together, and each one stores the number of triples of
+ * that predicate in its previous occurrences, so the one holding any result of ?P?
+ * is found with a binary search instead of walking the previous lists.
+ * Built with the rest of the index and saved after it, so iterators only read them.
+ */
+void BitmapTriples::generatePredicateOffsets() {
+	AdjacencyList adjZ(arrayZ, bitmapZ);
+	SequenceBuffer bufY(arrayY);
+	unsigned int numY = arrayY->getNumberOfElements();
+
+	// Count the occurrences of each predicate
+	vector<unsigned int> occurrences;
+	for(unsigned int i=0;i<numY;i++) {
+		unsigned int pred = bufY.get(i);
+		if(occurrences.size()<pred) {
+			occurrences.resize(pred, 0);
+		}
+		occurrences[pred-1]++;
+	}
+
+	LogSequence2 *first = new LogSequence2(bits(numY), occurrences.size()+1);
+	vector<unsigned int> next(occurrences.size());
+	unsigned int total = 0;
+	for(unsigned int i=0;i<occurrences.size();i++) {
+		first->push_back(total);
+		next[i] = total;
+		total += occurrences[i];
+	}
+	first->push_back(total);
+
+	LogSequence2 *offsets = new LogSequence2(bits(arrayZ->getNumberOfElements()), numY);
+	for(unsigned int i=0;i<numY;i++) {
+		offsets->push_back(0);
+	}
+	vector<size_t> triplesBefore(occurrences.size(), 0);
+	unsigned int posZ = 0;
+	for(unsigned int i=0;i<numY;i++) {
+		unsigned int pred = bufY.get(i);
+		unsigned int nextPosZ = adjZ.last(i)+1;
+		offsets->set(next[pred-1]++, triplesBefore[pred-1]);
+		triplesBefore[pred-1] += nextPosZ-posZ;
+		posZ = nextPosZ;
+	}
+
+	if(predicateOccurrences!=NULL) {
+		delete predicateOccurrences;
+	}
+	if(occurrenceOffsets!=NULL) {
+		delete occurrenceOffsets;
+	}
+	predicateOccurrences = first;
+	occurrenceOffsets = offsets;
+}
+
 void BitmapTriples::generateIndex(ProgressListener *listener) {
 	generateIndexMemory(listener);
 	//generateIndexMemoryFast(listener);
@@ -248,10 +322,11 @@ void BitmapTriples::generateIndexMemory(ProgressListener *listener) {
 	iListener.setRange(0,20);
 
 	// Count the number of appearances of each object
+	SequenceBuffer bufZ(arrayZ);
 	LogSequence2 *objectCount = new LogSequence2(bits(arrayZ->getNumberOfElements()));
 	unsigned int maxCount = 0;
 	for(unsigned int i=0;i<arrayZ->getNumberOfElements(); i++) {
-		unsigned int val = arrayZ->get(i);
+		unsigned int val = bufZ.get(i);
 		if(val==0) {
 			cerr << "ERROR: There is a zero value in the Z level." << endl;
 			continue;
@@ -276,7 +351,7 @@ void BitmapTriples::generateIndexMemory(ProgressListener *listener) {
 
 	iListener.setRange(20, 25);
 	// Calculate bitmap that separates each object sublist.
-	bitmapIndex = new BitSequence375(arrayZ->getNumberOfElements());
+	bitmapIndex = BitSeq::getBitmap(spec.get("bitmap.index"));
 	unsigned int tmpCount=0;
 	for(unsigned int i=0;i<objectCount->getNumberOfElements();i++) {
 		tmpCount += objectCount->get(i);
@@ -317,9 +392,13 @@ void BitmapTriples::generateIndexMemory(ProgressListener *listener) {
 	LogSequence2 *objectArray = new LogSequence2(bits(arrayY->getNumberOfElements()), arrayZ->getNumberOfElements());
 	objectArray->resize(arrayZ->getNumberOfElements());
 
+	unsigned int posY = 0;
 	for(unsigned int i=0;i<arrayZ->getNumberOfElements(); i++) {
-			unsigned int objectValue = arrayZ->get(i);
-			unsigned int posY = i>0 ?  bitmapZ->rank1(i-1) : 0;
+			unsigned int objectValue = bufZ.get(i);
+			if(i>0 && bitmapZ->access(i-1)) {
+				// Previous element closed its list.
+				posY++;
+			}
 
 			unsigned int insertBase = objectValue==1 ? 0 : bitmapIndex->select1(objectValue-1)+1;
 			unsigned int insertOffset = objectInsertedCount->get(objectValue-1);
@@ -413,10 +492,11 @@ void BitmapTriples::generateIndexMemory(ProgressListener *listener) {
 	// Count predicates
 
 	iListener.setRange(90,100);
+	SequenceBuffer bufY(arrayY);
 	LogSequence2 *predCount = new LogSequence2(bits(arrayY->getNumberOfElements()));
 	for(unsigned int i=0;i<arrayY->getNumberOfElements(); i++) {
 		// Read value
-		unsigned int val = arrayY->get(i);
+		unsigned int val = bufY.get(i);
 
 		// Grow if necessary
 		if(predCount->getNumberOfElements()<val) {
@@ -463,6 +543,8 @@ void BitmapTriples::generateIndexMemory(ProgressListener *listener) {
 	st.reset();
 	generateWavelet();
 	cout << "Wavelet generated in " << st << endl;
+
+	generatePredicateOffsets();
 }
 
 void BitmapTriples::generateIndexFast(ProgressListener *listener) {
@@ -477,8 +559,13 @@ void BitmapTriples::generateIndexFast(ProgressListener *listener) {
 	// For each object, a list of (zpos, predicate)
 	vector<vector<pair<unsigned int, unsigned int> > > index;
 	int maxpred = 0;
+	SequenceBuffer bufZ(arrayZ);
+	unsigned int adjZlist = 0;
 	for(unsigned int i=0;i<arrayZ->getNumberOfElements(); i++) {
-		unsigned int val = arrayZ->get(i);
+		unsigned int val = bufZ.get(i);
+		if(i>0 && bitmapZ->access(i-1)) {
+			adjZlist++;
+		}
         if(val==0) {
             cerr << "ERROR: There is a zero value in the Z level." << endl;
             continue;
@@ -486,7 +573,6 @@ void BitmapTriples::generateIndexFast(ProgressListener *listener) {
 		if(index.size()<val) {
 			index.resize(val);
 		}
-		unsigned int adjZlist = i>0 ?  bitmapZ->rank1(i-1) : 0;
 
 		//cout << "Item " << i << " in adjlist " << adjZlist << endl;
 		unsigned int pred = arrayY->get(adjZlist);
@@ -508,7 +594,7 @@ void BitmapTriples::generateIndexFast(ProgressListener *listener) {
 	if(bitmapIndex!=NULL) {
 		delete bitmapIndex;
 	}
-	bitmapIndex = new BitSequence375(arrayZ->getNumberOfElements());
+	bitmapIndex = BitSeq::getBitmap(spec.get("bitmap.index"));
 
     cout << " Serialize object lists..." << endl;
 	iListener.setRange(40, 80);
@@ -569,6 +655,8 @@ void BitmapTriples::generateIndexFast(ProgressListener *listener) {
 	generateWavelet();
 	cout << "Wavelet generated in " << st << endl;
 
+	generatePredicateOffsets();
+
 	cout << "Num triples: " << getNumberOfElements() << endl;
 	cout << "Order: " << getOrderStr(order) << endl;
 	cout << "Original triples size: " << size() << endl;
@@ -608,15 +696,28 @@ TripleComponentOrder BitmapTriples::getOrder()
     return order;
 }
 
+template<TripleComponentOrder ORDER>
+static IteratorTripleID *newScanIterator(BitmapTriples *triples, TripleID &pattern, bool boundX, bool boundY, BitSequence375 *bitmapY, BitSequence375 *bitmapZ) {
+	if(boundY) {
+		return new BitmapTriplesScanIterator<ORDER, true, true>(triples, pattern, bitmapY, bitmapZ);
+	} else if(boundX) {
+		return new BitmapTriplesScanIterator<ORDER, true, false>(triples, pattern, bitmapY, bitmapZ);
+	}
+	return new BitmapTriplesScanIterator<ORDER, false, false>(triples, pattern, bitmapY, bitmapZ);
+}
+
 IteratorTripleID *BitmapTriples::search(TripleID & pattern)
 {
 	CHECK_BITMAPTRIPLES_INITIALIZED
 
 	TripleID reorderedPat = pattern;
 	swapComponentOrder(&reorderedPat, SPO, this->order);
-	std::string patternString = reorderedPat.getPatternString();
+	bool boundX = reorderedPat.getSubject()!=0;
+	bool boundY = reorderedPat.getPredicate()!=0;
+	bool boundZ = reorderedPat.getObject()!=0;
 
-	if(patternString=="S?O") {
+	if(boundX && !boundY && boundZ) {
+		// S?O
 	    if(this->order == SPO) {
 		return new SequentialSearchIteratorTripleID(pattern, new BitmapTriplesSearchIterator(this, pattern));
 	    } else if( (this->order == OPS) && (arrayIndex!=NULL)) {
@@ -624,17 +725,193 @@ IteratorTripleID *BitmapTriples::search(TripleID & pattern)
 	    }
 	}
 
-	if((arrayIndex!=NULL) && (patternString=="??O" || patternString=="?PO" )) {
+	if((arrayIndex!=NULL) && !boundX && boundZ) {
+		// ??O, ?PO
 		return new ObjectIndexIterator(this, pattern);
-	} else if( waveletY != NULL && patternString=="?P?") {
+	} else if( waveletY != NULL && !boundX && boundY && !boundZ) {
+		// ?P?
 		return new MiddleWaveletIterator(this, pattern);
-	} else {
-		if(patternString=="???" || patternString=="S??" || patternString=="SP?"|| patternString=="SPO" ) {
-			return new BitmapTriplesSearchIterator(this, pattern);
-		} else {
-			return new SequentialSearchIteratorTripleID(pattern, new BitmapTriplesSearchIterator(this, pattern));
+	} else if((boundX || !boundY) && (boundY || !boundZ)) {
+		// ???, S??, SP?, SPO
+		BitSequence375 *bitY = dynamic_cast<BitSequence375 *>(bitmapY);
+		BitSequence375 *bitZ = dynamic_cast<BitSequence375 *>(bitmapZ);
+		if(bitY!=NULL && bitZ!=NULL) {
+			switch(order) {
+			case SPO:
+				return newScanIterator<SPO>(this, pattern, boundX, boundY, bitY, bitZ);
+			case SOP:
+				return newScanIterator<SOP>(this, pattern, boundX, boundY, bitY, bitZ);
+			case PSO:
+				return newScanIterator<PSO>(this, pattern, boundX, boundY, bitY, bitZ);
+			case POS:
+				return newScanIterator<POS>(this, pattern, boundX, boundY, bitY, bitZ);
+			case OSP:
+				return newScanIterator<OSP>(this, pattern, boundX, boundY, bitY, bitZ);
+			case OPS:
+				return newScanIterator<OPS>(this, pattern, boundX, boundY, bitY, bitZ);
+			default:
+				break;
+			}
+		}
+		return new BitmapTriplesSearchIterator(this, pattern);
+	}
+	return new SequentialSearchIteratorTripleID(pattern, new BitmapTriplesSearchIterator(this, pattern));
+}
+
+/** State of one lookup of BitmapTriples::searchBatch(), in the order of the triples */
+struct BatchLookup {
+	unsigned int x, y, z;
+	size_t minY, maxY, minZ, maxZ;
+	bool fallback;
+};
+
+/** Lookups interleaved by searchBatch(), enough to keep several misses in flight */
+static const size_t BATCH_GROUP = 16;
+
+static inline void prefetchElement(LogSequence2 *seq, size_t pos) {
+	if(seq!=NULL) {
+		seq->prefetch(pos);
+	}
+}
+
+void BitmapTriples::searchBatch(std::vector<TripleID> &patterns, std::vector<TripleID> &results, std::vector<size_t> &offsets)
+{
+	CHECK_BITMAPTRIPLES_INITIALIZED
+
+	results.clear();
+	offsets.clear();
+
+	BitSequence375 *bitY = dynamic_cast<BitSequence375 *>(bitmapY);
+	BitSequence375 *bitZ = dynamic_cast<BitSequence375 *>(bitmapZ);
+	LogSequence2 *seqY = dynamic_cast<LogSequence2 *>(arrayY);
+	LogSequence2 *seqZ = dynamic_cast<LogSequence2 *>(arrayZ);
+	size_t numY = arrayY->getNumberOfElements();
+	bitmapY->countOnes();	// Builds the indexes, the prefetches do not.
+	bitmapZ->countOnes();
+
+	BatchLookup lookups[BATCH_GROUP];
+	unsigned int buffer[64];
+
+	for(size_t group=0; group<patterns.size(); group+=BATCH_GROUP) {
+		size_t n = std::min(BATCH_GROUP, patterns.size()-group);
+
+		// Convert to local order, prefetch the counters to find the list of x in Y.
+		for(size_t i=0;i<n;i++) {
+			BatchLookup &l = lookups[i];
+			TripleID pattern = patterns[group+i];
+			swapComponentOrder(&pattern, SPO, order);
+			l.x = pattern.getSubject();
+			l.y = pattern.getPredicate();
+			l.z = pattern.getObject();
+			l.minZ = l.maxZ = 0;
+			l.fallback = l.x==0 || bitY==NULL || bitZ==NULL;
+			if(!l.fallback) {
+				bitY->prefetchSelect1(l.x-1);
+				bitY->prefetchSelect1(l.x);
+			}
+		}
+		for(size_t i=0;i<n;i++) {
+			BatchLookup &l = lookups[i];
+			if(!l.fallback && l.x!=0) {
+				bitY->prefetchSelect1Block(l.x-1);
+				bitY->prefetchSelect1Block(l.x);
+			}
+		}
+
+		// Range of the list of x in Y, prefetch its elements or the counters of its lists in Z.
+		for(size_t i=0;i<n;i++) {
+			BatchLookup &l = lookups[i];
+			if(l.fallback || l.x==0) {
+				continue;
+			}
+			l.minY = l.x==1 ? 0 : bitY->BitSequence375::select1(l.x-1)+1;
+			l.maxY = bitY->BitSequence375::select1(l.x)+1;
+			if(l.maxY>numY) {
+				// x is beyond the last list, no results
+				l.x = 0;
+			} else if(l.y!=0) {
+				prefetchElement(seqY, l.minY);
+			} else {
+				bitZ->prefetchSelect1(l.minY);
+				bitZ->prefetchSelect1(l.maxY);
+			}
+		}
+
+		// Find y in the list, prefetch the counters of its list in Z.
+		for(size_t i=0;i<n;i++) {
+			BatchLookup &l = lookups[i];
+			if(l.fallback || l.x==0 || l.y==0) {
+				continue;
+			}
+			size_t posY = arrayY->nextGEQ(l.minY, l.maxY, l.y);
+			if(posY==l.maxY || arrayY->get(posY)!=l.y) {
+				// No results
+				l.x = 0;
+				continue;
+			}
+			l.minY = posY;
+			l.maxY = posY+1;
+			bitZ->prefetchSelect1(l.minY);
+			bitZ->prefetchSelect1(l.maxY);
+		}
+		for(size_t i=0;i<n;i++) {
+			BatchLookup &l = lookups[i];
+			if(!l.fallback && l.x!=0) {
+				bitZ->prefetchSelect1Block(l.minY);
+				bitZ->prefetchSelect1Block(l.maxY);
+			}
+		}
+
+		// Range in Z, prefetch its first elements.
+		for(size_t i=0;i<n;i++) {
+			BatchLookup &l = lookups[i];
+			if(l.fallback || l.x==0) {
+				continue;
+			}
+			l.minZ = l.minY==0 ? 0 : bitZ->BitSequence375::select1(l.minY)+1;
+			l.maxZ = bitZ->BitSequence375::select1(l.maxY)+1;
+			prefetchElement(seqZ, l.minZ);
+			if(l.y==0) {
+				prefetchElement(seqY, l.minY);
+			}
+		}
+
+		// Read the results.
+		for(size_t i=0;i<n;i++) {
+			BatchLookup &l = lookups[i];
+			offsets.push_back(results.size());
+
+			if(l.fallback) {
+				IteratorTripleID *it = search(patterns[group+i]);
+				while(it->hasNext()) {
+					results.push_back(*it->next());
+				}
+				delete it;
+				continue;
+			}
+
+			size_t posY = l.minY;
+			unsigned int y = l.minZ<l.maxZ ? arrayY->get(posY) : 0;
+			for(size_t posZ=l.minZ; posZ<l.maxZ; ) {
+				size_t count = arrayZ->decode(posZ, std::min((size_t)64, l.maxZ-posZ), buffer);
+				if(count==0) {
+					break;
+				}
+				for(size_t j=0;j<count;j++, posZ++) {
+					if(l.z==0 || buffer[j]==l.z) {
+						TripleID triple(l.x, y, buffer[j]);
+						swapComponentOrder(&triple, order, SPO);
+						results.push_back(triple);
+					}
+					// Next list of Z, only when Y is not bound.
+					if(bitZ->BitSequence375::access(posZ) && posZ+1<l.maxZ) {
+						y = arrayY->get(++posY);
+					}
+				}
+			}
 		}
 	}
+	offsets.push_back(results.size());
 }
 
 void BitmapTriples::save(std::ostream & output, ControlInformation &controlInformation, ProgressListener *listener)
@@ -676,14 +953,14 @@ void BitmapTriples::load(std::istream &input, ControlInformation &controlInforma
 
 	iListener.setRange(0,5);
 	iListener.notifyProgress(0, "BitmapTriples loading Bitmap Y");
-	bitmapY = BitSequence375::load(input);
+	bitmapY = BitSeq::load(input);
 	if(bitmapY==NULL){
 		throw "Could not read bitmapY.";
 	}
 
 	iListener.setRange(5,10);
 	iListener.notifyProgress(0, "BitmapTriples loading Bitmap Z");
-	bitmapZ = BitSequence375::load(input);
+	bitmapZ = BitSeq::load(input);
 	if(bitmapZ==NULL){
 		throw "Could not read bitmapZ.";
 	}
@@ -719,17 +996,16 @@ size_t BitmapTriples::load(unsigned char *ptr, unsigned char *ptrMax, ProgressLi
 
     order = (TripleComponentOrder) controlInformation.getUint("order");
 
-    BitSequence375 *bitY = new BitSequence375();
-    BitSequence375 *bitZ = new BitSequence375();
-
     IntermediateListener iListener(listener);
 
     iListener.setRange(0,5);
     iListener.notifyProgress(0, "BitmapTriples loading Bitmap Y");
+    BitSeq *bitY = BitSeq::getBitmap(ptr[count]);
     count += bitY->load(&ptr[count], ptrMax, listener);
 
     iListener.setRange(5,10);
     iListener.notifyProgress(0, "BitmapTriples loading Bitmap Z");
+    BitSeq *bitZ = BitSeq::getBitmap(ptr[count]);
     count += bitZ->load(&ptr[count], ptrMax, listener);
 
     iListener.setRange(10,20);
@@ -768,6 +1044,15 @@ void BitmapTriples::saveIndex(std::ostream &output, ControlInformation &controlI
 	controlInformation.setUint("numTriples", getNumberOfElements());
 	controlInformation.setUint("order", getOrder());
 	controlInformation.setFormat(HDTVocabulary::INDEX_TYPE_FOQ);
+	if(waveletY!=NULL) {
+		controlInformation.set("stream.wavelet", waveletY->getStructure());
+	}
+#ifndef WIN32
+	// The predicate offsets go after the wavelet, so older readers ignore them.
+	if(waveletY!=NULL && occurrenceOffsets!=NULL) {
+		controlInformation.setUint("predicateOffsets", 1);
+	}
+#endif
 	controlInformation.save(output);
 
     iListener.setRange(50,60);
@@ -785,6 +1070,11 @@ void BitmapTriples::saveIndex(std::ostream &output, ControlInformation &controlI
 #ifndef WIN32
     if(waveletY!=NULL) {
         waveletY->save(output);
+        if(occurrenceOffsets!=NULL) {
+            iListener.notifyProgress(100, "BitmapTriples saving predicate offsets");
+            predicateOccurrences->save(output);
+            occurrenceOffsets->save(output);
+        }
     }
 #endif
 }
@@ -809,6 +1099,11 @@ void BitmapTriples::loadIndex(std::istream &input, ControlInformation &controlIn
 		throw "The order of the triples is different than the index.";
 	}
 
+	// Regenerate the wavelet with the same structure that was used to build the index.
+	if(controlInformation.get("stream.wavelet")!="") {
+		spec.set("stream.wavelet", controlInformation.get("stream.wavelet"));
+	}
+
 	IntermediateListener iListener(listener);
 
 	// Load predicate count
@@ -826,7 +1121,7 @@ void BitmapTriples::loadIndex(std::istream &input, ControlInformation &controlIn
 	}
 	iListener.setRange(10,20);
 	iListener.notifyProgress(0, "BitmapTriples loading Bitmap Index");
-	bitmapIndex = BitSequence375::load(input);
+	bitmapIndex = BitSeq::load(input);
 
 	// LOAD SEQ
 	if(arrayIndex!=NULL) {
@@ -846,9 +1141,25 @@ void BitmapTriples::loadIndex(std::istream &input, ControlInformation &controlIn
 #endif
         waveletY = new WaveletSequence();
         waveletY->load(input);
+        if(controlInformation.getUint("predicateOffsets")) {
+            iListener.notifyProgress(100, "BitmapTriples loading predicate offsets");
+            LogSequence2 *first = new LogSequence2();
+            LogSequence2 *offsets = new LogSequence2();
+            first->load(input);
+            offsets->load(input);
+            delete predicateOccurrences;
+            delete occurrenceOffsets;
+            predicateOccurrences = first;
+            occurrenceOffsets = offsets;
+            return;
+        }
     } else {
         generateWavelet(&iListener);
     }
+
+    // Index saved without them.
+    iListener.notifyProgress(100, "BitmapTriples generating predicate offsets");
+    generatePredicateOffsets();
 }
 
 size_t BitmapTriples::loadIndex(unsigned char *ptr, unsigned char *ptrMax, ProgressListener *listener)
@@ -871,6 +1182,10 @@ size_t BitmapTriples::loadIndex(unsigned char *ptr, unsigned char *ptrMax, Progr
         throw "The supplied index does not have the same number of triples as the dataset";
     }
 
+    if(controlInformation.get("stream.wavelet")!="") {
+        spec.set("stream.wavelet", controlInformation.get("stream.wavelet"));
+    }
+
     // LOAD PREDICATES
     iListener.setRange(0,10);
     iListener.notifyProgress(0, "BitmapTriples loading Predicate Count");
@@ -888,7 +1203,7 @@ size_t BitmapTriples::loadIndex(unsigned char *ptr, unsigned char *ptrMax, Progr
     if(bitmapIndex!=NULL) {
         delete bitmapIndex;
     }
-    BitSequence375 *bitIndex = new BitSequence375();
+    BitSeq *bitIndex = BitSeq::getBitmap(ptr[count]);
     count += bitIndex->load(&ptr[count], ptrMax, &iListener);
     bitmapIndex = bitIndex;
 
@@ -911,11 +1226,28 @@ size_t BitmapTriples::loadIndex(unsigned char *ptr, unsigned char *ptrMax, Progr
 
         waveletY = new WaveletSequence();
         count += waveletY->load(&ptr[count], ptrMax, &iListener);
+
+        if(controlInformation.getUint("predicateOffsets")) {
+            iListener.notifyProgress(100, "BitmapTriples loading predicate offsets");
+            LogSequence2 *first = new LogSequence2();
+            count += first->load(&ptr[count], ptrMax);
+            LogSequence2 *offsets = new LogSequence2();
+            count += offsets->load(&ptr[count], ptrMax);
+            delete predicateOccurrences;
+            delete occurrenceOffsets;
+            predicateOccurrences = first;
+            occurrenceOffsets = offsets;
+            return count;
+        }
 #endif
     } else {
         iListener.notifyProgress(0, "BitmapTriples generating Wavelet");
-        waveletY = new WaveletSequence(arrayY);
+        waveletY = new WaveletSequence(arrayY, spec.get("stream.wavelet"));
     }
+
+    // Index saved without them, or with a wavelet as Y that is not read again.
+    iListener.notifyProgress(100, "BitmapTriples generating predicate offsets");
+    generatePredicateOffsets();
     return count;
 }
 
@@ -35,7 +35,7 @@
 #include <Triples.hpp>
 #include <HDTSpecification.hpp>
 
-#include "../bitsequence/BitSequence375.h"
+#include "../bitsequence/BitSeq.h"
 #include "../sequence/WaveletSequence.hpp"
 #include "../sequence/LogSequence2.hpp"
 #include "../sequence/AdjacencyList.hpp"
@@ -51,13 +51,19 @@ private:
 	ControlInformation controlInformation;
 	HDTSpecification spec;
 	IntSequence *arrayY, *arrayZ, *arrayIndex;
-	BitSequence375 *bitmapY, *bitmapZ, *bitmapIndex;
+	BitSeq *bitmapY, *bitmapZ, *bitmapIndex;
 	IntSequence *predicateCount;
 	WaveletSequence *waveletY;
 
+	// For each predicate, position of its first occurrence in occurrenceOffsets.
+	LogSequence2 *predicateOccurrences;
+	// Number of triples of the predicate before each of its occurrences in Y, grouped by predicate.
+	LogSequence2 *occurrenceOffsets;
+
 	TripleComponentOrder order;
 
 	void generateWavelet(ProgressListener *listener = NULL);
+	void generatePredicateOffsets();
 
 public:
 	BitmapTriples();
@@ -72,6 +78,21 @@ public:
 	 */
 	IteratorTripleID *search(TripleID &triple);
 
+	/**
+	 * Searches many patterns at once, for instance the lookups of an index join.
+	 * The lookups of the patterns with the first component of the order bound
+	 * (S??, SP? and SPO in SPO order) are interleaved in groups: each stage
+	 * prefetches what the next one reads for all the group, so the cache misses
+	 * of the selects in the bitmaps and the reads of the arrays overlap.
+	 * Other patterns are resolved one by one with search().
+	 *
+	 * @param patterns Patterns in SPO.
+	 * @param results Receives the triples matching each pattern, one pattern after another.
+	 * @param offsets Receives patterns.size()+1 positions, the results of the
+	 * pattern i are in [offsets[i], offsets[i+1]).
+	 */
+	void searchBatch(std::vector<TripleID> &patterns, std::vector<TripleID> &results, std::vector<size_t> &offsets);
+
 	/**
 	 * Calculates the cost to retrieve a specific pattern
 	 *
@@ -128,24 +149,30 @@ public:
 };
 
 class BitmapTriplesSearchIterator : public IteratorTripleID {
-private:
+protected:
 	BitmapTriples *triples;
 	TripleID pattern, returnTriple;
 	unsigned int patX, patY, patZ;
 
 	AdjacencyList adjY, adjZ;
+	SequenceBuffer bufY, bufZ;
 	unsigned int posY, posZ;
 	unsigned int minY, maxY, minZ, maxZ;
         unsigned int nextY, nextZ, prevY, prevZ;
 	unsigned int x, y, z;
 
 	void findRange();
+	void goToPosZ(unsigned int pos);
 	void getNextTriple();
 	void getPreviousTriple();
 
 	void updateOutput();
 public:
-	BitmapTriplesSearchIterator(BitmapTriples *triples, TripleID &pat);
+	/**
+	 * @param initialize Find the range of the pattern and position the iterator on
+	 * the first result. Subclasses that override them pass false and call their own.
+	 */
+	BitmapTriplesSearchIterator(BitmapTriples *triples, TripleID &pat, bool initialize=true);
 
 	bool hasNext();
 	TripleID *next();
@@ -157,6 +184,7 @@ public:
 	TripleComponentOrder getOrder();
 	bool canGoTo();
 	void goTo(unsigned int pos);
+	bool canFindNextOccurrence(unsigned char component);
 	bool findNextOccurrence(unsigned int value, unsigned char component);
 	bool isSorted(TripleComponentRole role);
 };
@@ -167,6 +195,7 @@ private:
 	TripleID pattern, returnTriple;
 
 	AdjacencyList adjY, adjZ;
+	SequenceBuffer bufZ;
 	WaveletSequence *wavelet;
 	unsigned int patX, patY, patZ;
 	unsigned int posY, posZ;
@@ -187,6 +216,9 @@ public:
 	unsigned int estimatedNumResults();
 	ResultEstimationType numResultEstimation();
 	TripleComponentOrder getOrder();
+	bool canGoTo();
+	void goTo(unsigned int pos);
+	bool canFindNextOccurrence(unsigned char component);
 	bool findNextOccurrence(unsigned int value, unsigned char component);
 	bool isSorted(TripleComponentRole role);
 };
@@ -197,6 +229,7 @@ private:
 	TripleID pattern, returnTriple;
 
 	AdjacencyList adjY, adjZ, adjIndex;
+	SequenceBuffer bufIndex;
 	unsigned int patX, patY, patZ;
 	unsigned int posIndex;
 	unsigned int predicateOcurrence, numOcurrences;
@@ -207,6 +240,7 @@ private:
 	void calculateRange();
 	unsigned int getPosZ(unsigned int index);
 	unsigned int getY(unsigned int index);
+	long long gallopPredicate(unsigned int value);
 public:
 	ObjectIndexIterator(BitmapTriples *triples, TripleID &pat);
 
@@ -220,6 +254,7 @@ public:
 	TripleComponentOrder getOrder();
 	bool canGoTo();
 	void goTo(unsigned int pos);
+	bool canFindNextOccurrence(unsigned char component);
 	bool findNextOccurrence(unsigned int value, unsigned char component);
 	bool isSorted(TripleComponentRole role);
 };
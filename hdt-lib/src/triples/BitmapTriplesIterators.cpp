@@ -39,12 +39,29 @@ namespace hdt {
 
 #define SAVE_ADJ_LIST
 
+/**
+ * Position (0 for x, 1 for y, 2 for z) of a component (1 Subject, 2 Predicate, 3 Object)
+ * when the triples are stored in the given order.
+ */
+static unsigned int localComponent(unsigned char component, TripleComponentOrder order) {
+    TripleID roles(1,2,3);
+    swapComponentOrder(&roles, SPO, order);
+    if(roles.getSubject()==component) {
+	return 0;
+    } else if(roles.getPredicate()==component) {
+	return 1;
+    }
+    return 2;
+}
+
 /// ITERATOR
-BitmapTriplesSearchIterator::BitmapTriplesSearchIterator(BitmapTriples *trip, TripleID &pat) :
+BitmapTriplesSearchIterator::BitmapTriplesSearchIterator(BitmapTriples *trip, TripleID &pat, bool initialize) :
     triples(trip),
     pattern(pat),
     adjY(trip->arrayY, trip->bitmapY),
-    adjZ(trip->arrayZ, trip->bitmapZ)
+    adjZ(trip->arrayZ, trip->bitmapZ),
+    bufY(trip->arrayY),
+    bufZ(trip->arrayZ)
 {
     // Convert pattern to local order.
     swapComponentOrder(&pattern, SPO, triples->order);
@@ -75,9 +92,10 @@ BitmapTriplesSearchIterator::BitmapTriplesSearchIterator(BitmapTriples *trip, Tr
     }
 #endif
 
-    findRange();
-
-    goToStart();
+    if(initialize) {
+        findRange();
+        goToStart();
+    }
 }
 
 void BitmapTriplesSearchIterator::updateOutput() {
@@ -93,22 +111,24 @@ void BitmapTriplesSearchIterator::findRange()
         // S X X
         if(patY!=0) {
             // S P X
-            try {
-                minY = adjY.find(patX-1, patY);
-                maxY = minY+1;
-                if(patZ!=0) {
-                    // S P O
-                    minZ = adjZ.find(minY,patZ);
-                    maxZ = minZ+1;
-                } else {
-                    // S P ?
-                    minZ = adjZ.find(minY);
-                    maxZ = adjZ.last(minY)+1;
-                    //maxZ = adjZ.findNext(minZ);
-                }
-            } catch (const char *ex) {
+            size_t foundY = adjY.find(patX-1, patY);
+            size_t foundZ = foundY==AdjacencyList::NOT_FOUND || patZ==0 ? 0 : adjZ.find(foundY, patZ);
+            if(foundY==AdjacencyList::NOT_FOUND || foundZ==AdjacencyList::NOT_FOUND) {
                 // Item not found in list, no results.
                 minY = minZ = maxY = maxZ = 0;
+            } else if(patZ!=0) {
+                // S P O
+                minY = foundY;
+                maxY = minY+1;
+                minZ = foundZ;
+                maxZ = minZ+1;
+            } else {
+                // S P ?
+                minY = foundY;
+                maxY = minY+1;
+                minZ = adjZ.find(minY);
+                maxZ = adjZ.last(minY)+1;
+                //maxZ = adjZ.findNext(minZ);
             }
         } else {
             // S ? X
@@ -143,11 +163,11 @@ TripleID *BitmapTriplesSearchIterator::next()
     cout << "\tTriple: " << x << ", " << y << ", " << z << endl;
 #endif
 
-    z = adjZ.get(posZ);
+    z = bufZ.get(posZ);
 
     if(posZ==nextZ) {
         posY++;
-	y = adjY.get(posY);
+	y = bufY.get(posY);
 	nextZ = adjZ.find(posY+1);
 	//nextZ = adjZ.findNext(nextZ)+1;
 
@@ -177,10 +197,10 @@ TripleID *BitmapTriplesSearchIterator::previous()
 
 #if 0
     // TODO: Keep prevZ updated to save bitmap accesses.
-    z = adjZ.get(posZ);
+    z = bufZ.get(posZ);
     if(posZ==prevZ) {
         posY--;
-        y = adjY.get(posY);
+        y = bufY.get(posY);
         prevZ = adjZ.find(posY);
 
         if(posY==prevY) {
@@ -191,8 +211,8 @@ TripleID *BitmapTriplesSearchIterator::previous()
 #else
     posY = adjZ.findListIndex(posZ);
 
-    z = adjZ.get(posZ);
-    y = adjY.get(posY);
+    z = bufZ.get(posZ);
+    y = bufY.get(posY);
     x = adjY.findListIndex(posY)+1;
 
     nextY = adjY.last(x-1)+1;
@@ -216,8 +236,8 @@ void BitmapTriplesSearchIterator::goToStart()
     if(posZ<maxZ) {
     	posY = adjZ.findListIndex(posZ);
 
-    	z = adjZ.get(posZ);
-    	y = adjY.get(posY);
+    	z = bufZ.get(posZ);
+    	y = bufY.get(posY);
     	x = adjY.findListIndex(posY)+1;
 
     	nextY = adjY.last(x-1)+1;
@@ -239,23 +259,28 @@ ResultEstimationType BitmapTriplesSearchIterator::numResultEstimation()
 }
 
 bool BitmapTriplesSearchIterator::canGoTo() {
-    return pattern.isEmpty();
+    // The results are the consecutive range [minZ, maxZ) unless some component is filtered.
+    return (patY==0 || patX!=0) && (patZ==0 || patY!=0);
 }
 
 void BitmapTriplesSearchIterator::goTo(unsigned int pos) {
-    if(!pattern.isEmpty()) {
+    if(!canGoTo()) {
         throw "Cannot goTo on this pattern.";
     }
 
-    if(pos>=adjZ.getSize()) {
+    if(pos>=maxZ-minZ) {
         throw "Cannot goTo beyond last triple";
     }
 
+    goToPosZ(minZ+pos);
+}
+
+void BitmapTriplesSearchIterator::goToPosZ(unsigned int pos) {
     posZ = pos;
     posY = adjZ.findListIndex(posZ);
 
-    z = adjZ.get(posZ);
-    y = adjY.get(posY);
+    z = bufZ.get(posZ);
+    y = bufY.get(posY);
     x = adjY.findListIndex(posY)+1;
 
     nextY = adjY.last(x-1)+1;
@@ -266,26 +291,65 @@ TripleComponentOrder BitmapTriplesSearchIterator::getOrder() {
     return triples->order;
 }
 
+bool BitmapTriplesSearchIterator::canFindNextOccurrence(unsigned char component) {
+    switch(localComponent(component, triples->order)) {
+    case 0:
+	return true;
+    case 1:
+	return patX!=0;
+    default:
+	return patX!=0 && patY!=0;
+    }
+}
+
 bool BitmapTriplesSearchIterator::findNextOccurrence(unsigned int value, unsigned char component) {
-    if(triples->order==SPO) {
-	if(component==3 && patY!=0) {
+    if(!hasNext()) {
+	return false;
+    }
 
+    unsigned int newPosZ;
+    switch(localComponent(component, triples->order)) {
+    case 0:
+	// Jump directly to the list of X using the bitmaps.
+	if(value<=1) {
+	    return true;
 	}
-
-	if(component==2 && patX!=0) {
-
+	if(value-1>=adjY.countListsX()) {
+	    newPosZ = maxZ;
+	} else {
+	    newPosZ = adjZ.find(adjY.find(value-1));
 	}
-    } else if(triples->order==OPS) {
-	if(component==1 && patY!=0) {
-
+	break;
+    case 1: {
+	// Y is sorted within the list of X, gallop over the remaining Y.
+	if(patX==0) {
+	    throw "Cannot search component";
 	}
-
-	if(component==2 && patX!=0) {
-
+	unsigned int currentPosY = adjZ.findListIndex(posZ);
+	unsigned int newPosY = adjY.gallopSearch(value, currentPosY, maxY);
+	if(newPosY==currentPosY) {
+	    return true;
+	}
+	newPosZ = newPosY<maxY ? adjZ.find(newPosY) : maxZ;
+	break;
+    }
+    default:
+	// Z is sorted within the list of Y, gallop over the remaining Z.
+	if(patX==0 || patY==0) {
+	    throw "Cannot search component";
 	}
+	newPosZ = adjZ.gallopSearch(value, posZ, maxZ);
+    }
 
+    if(newPosZ<=posZ) {
+	return true;
+    }
+    if(newPosZ>=maxZ) {
+	posZ = maxZ;
+	return false;
     }
-    return false;
+    goToPosZ(newPosZ);
+    return true;
 }
 
 bool BitmapTriplesSearchIterator::isSorted(TripleComponentRole role) {
@@ -320,6 +384,7 @@ MiddleWaveletIterator::MiddleWaveletIterator(BitmapTriples *trip, TripleID &pat)
     pattern(pat),
     adjY(trip->arrayY, trip->bitmapY),
     adjZ(trip->arrayZ, trip->bitmapZ),
+    bufZ(trip->arrayZ),
     predicateOcurrence(1),
     wavelet(trip->waveletY)
 {
@@ -377,10 +442,10 @@ TripleID *MiddleWaveletIterator::next()
 
         x = adjY.findListIndex(posY)+1;
         y = adjY.get(posY);
-        z = adjZ.get(posZ);
+        z = bufZ.get(posZ);
         posZ++;
     } else {
-        z = adjZ.get(posZ);
+        z = bufZ.get(posZ);
         posZ++;
     }
     updateOutput();
@@ -407,10 +472,10 @@ TripleID *MiddleWaveletIterator::previous()
 
         x = adjY.findListIndex(posY)+1;
         y = adjY.get(posY);
-        z = adjZ.get(posZ);
+        z = bufZ.get(posZ);
     } else {
         posZ--;
-        z = adjZ.get(posZ);
+        z = bufZ.get(posZ);
 
     }
     updateOutput();
@@ -429,7 +494,7 @@ void MiddleWaveletIterator::goToStart()
 
     x = adjY.findListIndex(posY)+1;
     y = adjY.get(posY);
-    z = adjZ.get(posZ);
+    z = bufZ.get(posZ);
 }
 
 unsigned int MiddleWaveletIterator::estimatedNumResults()
@@ -452,47 +517,101 @@ TripleComponentOrder MiddleWaveletIterator::getOrder() {
     return triples->order;
 }
 
-bool MiddleWaveletIterator::findNextOccurrence(unsigned int value, unsigned char component) {
-    if(component==1) {
-        // Search subject, check each predicate ocurrence.
-        while(x!=value) {
-            predicateOcurrence++;
-            if(predicateOcurrence>numOcurrences) {  // FIXME CHECK COMP
-                return false;
-            }
-            posY = wavelet->select(patY, predicateOcurrence);
-            x = adjY.findListIndex(posY)+1;
+bool MiddleWaveletIterator::canGoTo() {
+    return triples->occurrenceOffsets!=NULL;
+}
+
+void MiddleWaveletIterator::goTo(unsigned int pos) {
+    if(!canGoTo()) {
+        throw "Cannot goTo on this pattern";
+    }
+    if(patY>=triples->predicateOccurrences->getNumberOfElements()) {
+        throw "Cannot goTo beyond last triple";
+    }
+    size_t first = triples->predicateOccurrences->get(patY-1);
+    size_t end = triples->predicateOccurrences->get(patY);
+    if(first==end) {
+        throw "Cannot goTo beyond last triple";
+    }
+
+    // Last occurrence of the predicate whose previous occurrences hold at most pos triples.
+    size_t low = first;
+    size_t high = end-1;
+    while(low<high) {
+        size_t mid = low+(high-low+1)/2;
+        if(triples->occurrenceOffsets->get(mid)<=pos) {
+            low = mid;
+        } else {
+            high = mid-1;
         }
+    }
 
-        prevZ = adjZ.find(posY);
-        nextZ = adjZ.last(posY);
+    unsigned int occurrence = low-first+1;
+    unsigned int newPosY = wavelet->select(patY, occurrence);
+    unsigned int newPosZ = adjZ.find(newPosY)+pos-triples->occurrenceOffsets->get(low);
+    if(newPosZ>adjZ.last(newPosY)) {
+        throw "Cannot goTo beyond last triple";
+    }
 
-        y = adjY.get(posY);
-        z = adjZ.get(posZ);
-    } else if(component==3) {
-        // Search Object
-        while(z!=value) {
-            predicateOcurrence++;
-            if(predicateOcurrence>numOcurrences) {  // FIXME CHECK COMP
-                return false;
-            }
-            posY = wavelet->select(patY, predicateOcurrence);
-            try {
-                posZ = adjZ.find(posY, value);
+    predicateOcurrence = occurrence;
+    posY = newPosY;
+    prevZ = adjZ.find(posY);
+    nextZ = adjZ.last(posY);
+    posZ = newPosZ;
+
+    x = adjY.findListIndex(posY)+1;
+    y = adjY.get(posY);
+}
 
-                // If found:
-                posY = adjZ.findListIndex(posZ);
+bool MiddleWaveletIterator::canFindNextOccurrence(unsigned char component) {
+    return localComponent(component, triples->order)!=2;
+}
 
-                prevZ = adjZ.find(posY);
-                nextZ = adjZ.last(posY);
+bool MiddleWaveletIterator::findNextOccurrence(unsigned int value, unsigned char component) {
+    if(!hasNext()) {
+	return false;
+    }
 
-                y = adjY.get(posY);
-                x = adjY.findListIndex(posY)+1;
-                return true;
-            } catch (const char *ex) {
-                // Not found
-            }
-        }
+    switch(localComponent(component, triples->order)) {
+    case 0: {
+	if(value<=1) {
+	    return true;
+	}
+	if(value-1>=adjY.countListsX()) {
+	    posZ = maxZ;
+	    return false;
+	}
+
+	// Count the occurrences of the predicate before the list of X.
+	unsigned int firstPosY = adjY.find(value-1);
+	unsigned int target = (firstPosY==0 ? 0 : wavelet->rank(patY, firstPosY-1)) + 1;
+
+	unsigned int current = posZ<=nextZ ? predicateOcurrence : predicateOcurrence+1;
+	if(target<=current) {
+	    return true;
+	}
+	if(target>numOcurrences) {
+	    posZ = maxZ;
+	    return false;
+	}
+
+	predicateOcurrence = target;
+	posY = wavelet->select(patY, predicateOcurrence);
+	prevZ = adjZ.find(posY);
+	nextZ = adjZ.last(posY);
+	posZ = prevZ;
+
+	x = adjY.findListIndex(posY)+1;
+	y = adjY.get(posY);
+	z = bufZ.get(posZ);
+	return true;
+    }
+    case 1:
+	if(value<=patY) {
+	    return true;
+	}
+	posZ = maxZ;
+	return false;
     }
     throw "Cannot search component";
 }
@@ -529,7 +648,8 @@ ObjectIndexIterator::ObjectIndexIterator(BitmapTriples *trip, TripleID &pat) :
     pattern(pat),
     adjY(trip->arrayY, trip->bitmapY),
     adjZ(trip->arrayZ, trip->bitmapZ),
-    adjIndex(trip->arrayIndex, trip->bitmapIndex)
+    adjIndex(trip->arrayIndex, trip->bitmapIndex),
+    bufIndex(trip->arrayIndex)
 {
     // Convert pattern to local order.
     swapComponentOrder(&pattern, SPO, triples->order);
@@ -560,10 +680,11 @@ unsigned int ObjectIndexIterator::getPosZ(unsigned int indexObjectPos) {
     unsigned int posZ=0;
     unsigned int posAdjList = adjIndex.get(indexObjectPos);
 
-    try {
-        posZ = adjZ.find(posAdjList, patZ);
+    size_t found = adjZ.find(posAdjList, patZ);
+    if(found!=AdjacencyList::NOT_FOUND) {
+        posZ = found;
 //        z = adjZ.get(posZ);
-    } catch (const char *ex) {
+    } else {
 	cerr << "posZ not found in Index!!!!" << endl;
         posZ = adjZ.find(posAdjList);
     }
@@ -607,7 +728,7 @@ bool ObjectIndexIterator::hasNext()
 
 TripleID *ObjectIndexIterator::next()
 {
-    unsigned int posY = adjIndex.get(posIndex);
+    unsigned int posY = bufIndex.get(posIndex);
 
     z = patZ;
     y = patY!=0 ? patY : adjY.get(posY);
@@ -628,7 +749,7 @@ TripleID *ObjectIndexIterator::previous()
 {
     posIndex--;
 
-    unsigned int posY = adjIndex.get(posIndex);
+    unsigned int posY = bufIndex.get(posIndex);
 
     z = patZ;
     y = patY!=0 ? patY : adjY.get(posY);
@@ -768,35 +889,86 @@ void ObjectIndexIterator::goTo(unsigned int pos)
     posIndex = minIndex+pos;
 }
 
+bool ObjectIndexIterator::canFindNextOccurrence(unsigned char component) {
+    switch(localComponent(component, triples->order)) {
+    case 0:
+	return patY!=0;
+    default:
+	return true;
+    }
+}
+
 bool ObjectIndexIterator::findNextOccurrence(unsigned int value, unsigned char component) {
-    if(component==1) {
-        if(patY!=0) {
-            unsigned int posZ, posY;
-            while(x!=value) {
-                posZ = getPosZ(posIndex);
-                posY = adjZ.findListIndex(posZ);
-                x = adjY.findListIndex(posY)+1;
+    if(!hasNext()) {
+	return false;
+    }
 
-                posIndex++;
-            }
-            z = adjZ.get(posZ);
-            y = adjY.get(posY);
-        } else {
+    switch(localComponent(component, triples->order)) {
+    case 0:
+	// Within the same predicate, the index is sorted by position in Y, hence by X.
+	if(patY==0) {
+	    throw "Cannot search component";
+	}
+	if(value<=1) {
+	    return true;
+	}
+	if(value-1>=adjY.countListsX()) {
+	    posIndex = maxIndex+1;
+	    return false;
+	}
+	posIndex = adjIndex.gallopSearch(adjY.find(value-1), posIndex, maxIndex+1);
+	break;
+    case 1:
+	if(patY!=0) {
+	    if(value>patY) {
+		posIndex = maxIndex+1;
+	    }
+	    break;
+	}
+	posIndex = gallopPredicate(value);
+	break;
+    default:
+	if(value>patZ) {
+	    posIndex = maxIndex+1;
+	}
+    }
+    return hasNext();
+}
 
-        }
-    } else if(component==2) {
-        // Binary search the predicate within the object list.
+/**
+ * Galloping search of the first index position from posIndex whose predicate
+ * is greater or equal than value. The index of each object is sorted by predicate.
+ */
+long long ObjectIndexIterator::gallopPredicate(unsigned int value) {
+    if(getY(posIndex)>=value) {
+	return posIndex;
+    }
 
+    // Invariant: getY(low) < value
+    long long low = posIndex;
+    long long step = 1;
+    while(low+step<=maxIndex && getY(low+step)<value) {
+	low += step;
+	step <<= 1;
     }
-    return true;
+    long long high = low+step<=maxIndex ? low+step : maxIndex+1;
+
+    while(high-low>1) {
+	long long mid = low+(high-low)/2;
+	if(getY(mid)<value) {
+	    low = mid;
+	} else {
+	    high = mid;
+	}
+    }
+    return high;
 }
 
-
 bool ObjectIndexIterator::isSorted(TripleComponentRole role) {
     if(triples->order==SPO) {
 	switch(role) {
 	case SUBJECT:
-	    return false;
+	    return patY!=0;
 	case PREDICATE:
 	    return true;
 	case OBJECT:
@@ -805,7 +977,7 @@ bool ObjectIndexIterator::isSorted(TripleComponentRole role) {
     } else if(triples->order==OPS) {
 	switch(role) {
 	case OBJECT:
-	    return false;
+	    return patY!=0;
 	case PREDICATE:
 	    return true;
 	case SUBJECT:
@@ -0,0 +1,134 @@
+/*
+ * File: BitmapTriplesScanIterator.hpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+
+#ifndef BITMAPTRIPLESSCANITERATOR_HPP_
+#define BITMAPTRIPLESSCANITERATOR_HPP_
+
+#include "BitmapTriples.hpp"
+#include "../bitsequence/BitSequence375.h"
+
+namespace hdt {
+
+/**
+ * Sets the triple to the SPO form of the components x, y, z stored in the given order.
+ * The order is known at compile time, so the switch is resolved by the compiler.
+ */
+template<TripleComponentOrder ORDER>
+inline void setLocalTriple(TripleID &triple, unsigned int x, unsigned int y, unsigned int z) {
+	switch(ORDER) {
+	case SPO:
+		triple.setAll(x, y, z);
+		break;
+	case SOP:
+		triple.setAll(x, z, y);
+		break;
+	case PSO:
+		triple.setAll(y, x, z);
+		break;
+	case POS:
+		triple.setAll(z, x, y);
+		break;
+	case OSP:
+		triple.setAll(y, z, x);
+		break;
+	case OPS:
+		triple.setAll(z, y, x);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * BitmapTriplesSearchIterator for the patterns whose results are a range of Z
+ * (???, S??, SP? and SPO), with next() instantiated for each triple order and
+ * pattern shape. When BOUND_Y all the results share x and y, and when BOUND_X
+ * they share x, so next() only checks the bitmaps of the levels that can change.
+ *
+ * Instead of finding where each list ends with select1(), next() reads the bit of
+ * the current position on BitSequence375 bitmaps with non-virtual calls, and
+ * goToStart() skips the selects that only the generic next() needs. The rest of
+ * the operations are inherited, and they rely on the same posY, posZ, x, y.
+ */
+template<TripleComponentOrder ORDER, bool BOUND_X, bool BOUND_Y>
+class BitmapTriplesScanIterator : public BitmapTriplesSearchIterator {
+private:
+	BitSequence375 *bitmapY, *bitmapZ;
+
+public:
+	BitmapTriplesScanIterator(BitmapTriples *triples, TripleID &pattern, BitSequence375 *bitmapY, BitSequence375 *bitmapZ) :
+		BitmapTriplesSearchIterator(triples, pattern, false), bitmapY(bitmapY), bitmapZ(bitmapZ) {
+		findRange();
+		goToStart();
+	}
+
+	void goToStart() {
+		posZ = minZ;
+		if(posZ>=maxZ) {
+			return;
+		}
+		// findRange() already knows the first list of bound patterns.
+		if(BOUND_X) {
+			posY = minY;
+			x = patX;
+		} else {
+			posY = adjZ.findListIndex(posZ);
+			x = adjY.findListIndex(posY)+1;
+		}
+		y = BOUND_Y ? patY : bufY.get(posY);
+	}
+
+	bool hasNext() {
+		return posZ<maxZ;
+	}
+
+	TripleID *next() {
+		z = bufZ.get(posZ);
+		setLocalTriple<ORDER>(returnTriple, x, y, z);
+
+		// Move to the next list of Z, and the next list of Y if this was the last of x.
+		if(!BOUND_Y && bitmapZ->BitSequence375::access(posZ) && posZ+1<maxZ) {
+			if(!BOUND_X && bitmapY->BitSequence375::access(posY)) {
+				x++;
+			}
+			posY++;
+			y = bufY.get(posY);
+		}
+		posZ++;
+
+		return &returnTriple;
+	}
+};
+
+}
+
+#endif /* BITMAPTRIPLESSCANITERATOR_HPP_ */
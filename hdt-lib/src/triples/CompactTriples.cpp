@@ -258,7 +258,9 @@ TripleComponentOrder CompactTriples::getOrder()
 /// ITERATOR
 CompactTriplesIterator::CompactTriplesIterator(CompactTriples *trip, TripleID &pat) :
 		triples(trip),
-		pattern(pat)
+		pattern(pat),
+		bufY(trip->streamY),
+		bufZ(trip->streamZ)
 {
 	// Convert pattern to local order.
 	swapComponentOrder(&pattern, SPO, triples->order);
@@ -288,14 +290,14 @@ TripleID *CompactTriplesIterator::next()
 		posY++;
 		goingUp=true;
 	}
-	z = triples->streamZ->get(posZ++);
+	z = bufZ.get(posZ++);
 
 	if(z==0) {
-		z = triples->streamZ->get(posZ++);
+		z = bufZ.get(posZ++);
 
-		y = triples->streamY->get(posY++);
+		y = bufY.get(posY++);
 		if(y==0) {
-			y = triples->streamY->get(posY++);
+			y = bufY.get(posY++);
 			x++;
 		}
 	}
@@ -313,7 +315,7 @@ bool CompactTriplesIterator::hasPrevious()
 TripleID *CompactTriplesIterator::previous()
 {
 	//cout << "\t\tposZ=" << posZ << "("<< triples->streamZ->get(posZ)<<") posY="<< posY << "("<< triples->streamY->get(posY) << ")" << endl;
-	z = triples->streamZ->get(--posZ);
+	z = bufZ.get(--posZ);
 
 	if(goingUp) {
 		posY--;
@@ -321,11 +323,11 @@ TripleID *CompactTriplesIterator::previous()
 	}
 
 	if(z==0) {
-		z = triples->streamZ->get(--posZ);
+		z = bufZ.get(--posZ);
 
-		y = triples->streamY->get(--posY);
+		y = bufY.get(--posY);
 		if(y==0) {
-			y = triples->streamY->get(--posY);
+			y = bufY.get(--posY);
 			x--;
 		}
 	}
@@ -339,7 +341,7 @@ void CompactTriplesIterator::goToStart()
 {
 	posY = posZ = 0;
 	x = 1;
-	y = triples->streamY->get(posY++);
+	y = bufY.get(posY++);
 	goingUp = true;
 }
 
@@ -121,6 +121,7 @@ class CompactTriplesIterator : public IteratorTripleID {
 private:
 	CompactTriples *triples;
 	TripleID pattern, returnTriple;
+	SequenceBuffer bufY, bufZ;
 
 	unsigned int patX, patY, patZ;
 
@@ -211,13 +211,14 @@ TripleComponentOrder PlainTriples::getOrder()
 }
 
 PlainTriplesIterator::PlainTriplesIterator(PlainTriples *triples, TripleID & pattern, TripleComponentOrder order) :
-		pattern(pattern), order(order), triples(triples), pos(0)
+		pattern(pattern), order(order), triples(triples),
+		bufX(triples->streamX), bufY(triples->streamY), bufZ(triples->streamZ), pos(0)
 {
 }
 
 void PlainTriplesIterator::updateOutput()
 {
-	returnTriple.setAll(triples->streamX->get(pos), triples->streamY->get(pos), triples->streamZ->get(pos));
+	returnTriple.setAll(bufX.get(pos), bufY.get(pos), bufZ.get(pos));
 }
 
 bool PlainTriplesIterator::hasNext()
@@ -122,6 +122,7 @@ private:
 	TripleID pattern, returnTriple;
 	TripleComponentOrder order;
 	PlainTriples *triples;
+	SequenceBuffer bufX, bufY, bufZ;
 	int64_t pos;
 
 	void updateOutput();
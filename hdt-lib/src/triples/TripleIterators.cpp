@@ -29,6 +29,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "TripleIterators.hpp"
 
 namespace hdt {
@@ -181,11 +183,135 @@ void SequentialSearchIteratorTripleID::goToStart()
 	doFetchNext();
 }
 
+bool SequentialSearchIteratorTripleID::canFindNextOccurrence(unsigned char component)
+{
+	return iterator->canFindNextOccurrence(component);
+}
+
+bool SequentialSearchIteratorTripleID::findNextOccurrence(unsigned int value, unsigned char component)
+{
+	if(!goingUp) {
+		goingUp = true;
+		if(hasPreviousTriples){
+			doFetchNext();
+		}
+		doFetchNext();
+	}
+	if(!hasMoreTriples) {
+		return false;
+	}
+
+	// The prefetched triple may already satisfy the condition.
+	unsigned int current = component==1 ? nextTriple.getSubject() : component==2 ? nextTriple.getPredicate() : nextTriple.getObject();
+	if(current>=value) {
+		return true;
+	}
+
+	iterator->findNextOccurrence(value, component);
+	doFetchNext();
+	return hasMoreTriples;
+}
 
 
+
+RangeFilterIteratorTripleID::RangeFilterIteratorTripleID(IteratorTripleID *other, TripleComponentRole role, const std::vector<std::pair<unsigned int, unsigned int> > &ranges)
+	: iterator(other), ranges(ranges)
+{
+	std::sort(this->ranges.begin(), this->ranges.end());
+	component = role==SUBJECT ? 1 : role==PREDICATE ? 2 : 3;
+	canSkip = iterator->canFindNextOccurrence(component);
+	doFetchNext();
+}
+
+RangeFilterIteratorTripleID::~RangeFilterIteratorTripleID()
+{
+	delete iterator;
+}
+
+void RangeFilterIteratorTripleID::doFetchNext()
+{
+	hasMoreTriples = false;
+
+	while(iterator->hasNext()) {
+		TripleID *next = iterator->next();
+		unsigned int value = component==1 ? next->getSubject() : component==2 ? next->getPredicate() : next->getObject();
+
+		// First range that ends after the value.
+		size_t left = 0, right = ranges.size();
+		while(left<right) {
+			size_t center = (left+right)/2;
+			if(ranges[center].second<=value) {
+				left = center+1;
+			} else {
+				right = center;
+			}
+		}
+
+		if(left<ranges.size() && ranges[left].first<=value) {
+			hasMoreTriples = true;
+			nextTriple = *next;
+			return;
+		}
+
+		if(canSkip) {
+			// The values only grow, jump to the start of the next range.
+			if(left==ranges.size() || !iterator->findNextOccurrence(ranges[left].first, component)) {
+				return;
+			}
+		}
+	}
+}
+
+bool RangeFilterIteratorTripleID::hasNext()
+{
+	return hasMoreTriples;
+}
+
+TripleID *RangeFilterIteratorTripleID::next()
+{
+	returnTriple = nextTriple;
+	doFetchNext();
+	return &returnTriple;
+}
+
+void RangeFilterIteratorTripleID::goToStart()
+{
+	iterator->goToStart();
+	doFetchNext();
+}
+
+unsigned int RangeFilterIteratorTripleID::estimatedNumResults()
+{
+	return iterator->estimatedNumResults();
+}
+
+ResultEstimationType RangeFilterIteratorTripleID::numResultEstimation()
+{
+	ResultEstimationType accuracy = iterator->numResultEstimation();
+	return accuracy==EXACT ? UP_TO : accuracy;
+}
+
+TripleComponentOrder RangeFilterIteratorTripleID::getOrder()
+{
+	return iterator->getOrder();
+}
+
+bool RangeFilterIteratorTripleID::isSorted(TripleComponentRole role)
+{
+	return iterator->isSorted(role);
+}
+
 TripleID *RandomAccessIterator::get(unsigned int idx)
 {
 //	cout << "RandomAccessIterator: " << currentIdx << "/" << idx << " PREV/NEXT: "<< it->hasPrevious() << ", " << it->hasNext() << endl;
+	if(idx!=currentIdx && idx<numElements && it->canGoTo()) {
+		it->goTo(idx);
+		current = it->next();
+		currentIdx = idx;
+		goingUp = true;
+		return current;
+	}
+
 	while(currentIdx > idx && it->hasPrevious()) {
 		if(goingUp) {
 			goingUp = false;
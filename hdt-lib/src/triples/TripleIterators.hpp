@@ -32,6 +32,8 @@
 #ifndef TRIPLEITERATORS_HPP_
 #define TRIPLEITERATORS_HPP_
 
+#include <vector>
+
 #include <Iterator.hpp>
 #include "TripleOrderConvert.hpp"
 
@@ -75,8 +77,39 @@ public:
 	bool hasPrevious();
 	TripleID *previous();
 	void goToStart();
+	bool canFindNextOccurrence(unsigned char component);
+	bool findNextOccurrence(unsigned int value, unsigned char component);
 };
 
+/**
+ * Returns the triples of another iterator whose component of the role is in
+ * any of several disjoint ranges of IDs [begin, end), such as the ones of
+ * Dictionary::prefixRange(), so that prefix filters need no strings. When the
+ * component is sorted in the iterator it jumps over the gaps between ranges
+ * with findNextOccurrence() instead of reading them.
+ */
+class RangeFilterIteratorTripleID : public IteratorTripleID {
+protected:
+	IteratorTripleID *iterator;
+	std::vector<std::pair<unsigned int, unsigned int> > ranges;
+	unsigned char component;
+	bool canSkip;
+	TripleID nextTriple, returnTriple;
+	bool hasMoreTriples;
+
+	void doFetchNext();
+public:
+	RangeFilterIteratorTripleID(IteratorTripleID *other, TripleComponentRole role, const std::vector<std::pair<unsigned int, unsigned int> > &ranges);
+	~RangeFilterIteratorTripleID();
+
+	bool hasNext();
+	TripleID *next();
+	void goToStart();
+	unsigned int estimatedNumResults();
+	ResultEstimationType numResultEstimation();
+	TripleComponentOrder getOrder();
+	bool isSorted(TripleComponentRole role);
+};
 
 class RandomAccessIterator {
 	IteratorTripleID *it;
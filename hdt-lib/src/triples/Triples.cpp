@@ -0,0 +1,103 @@
+/*
+ * File: Triples.cpp
+ * Last modified: $Date$
+ * Revision: $Revision$
+ * Last modified by: $Author$
+ *
+ * Copyright (C) 2012, Mario Arias, Javier D. Fernandez, Miguel A. Martinez-Prieto
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Mario Arias:               mario.arias@gmail.com
+ *   Javier D. Fernandez:       jfergar@infor.uva.es
+ *   Miguel A. Martinez-Prieto: migumar2@infor.uva.es
+ *
+ */
+
+
+#include <Triples.hpp>
+#include <Iterator.hpp>
+
+#include <stdint.h>
+#include <set>
+
+using namespace std;
+
+namespace hdt {
+
+/**
+ * SplitMix64 generator, so samples only depend on the seed and not on the platform rand().
+ */
+static uint64_t nextRandom(uint64_t &state) {
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+vector<TripleID> Triples::sample(TripleID &pattern, unsigned int k, unsigned int seed) {
+	vector<TripleID> samples;
+	uint64_t state = seed;
+
+	IteratorTripleID *it = search(pattern);
+	if(k==0) {
+		delete it;
+		return samples;
+	}
+
+	if(it->canGoTo() && it->numResultEstimation()==EXACT) {
+		unsigned int numResults = it->estimatedNumResults();
+		if(k>=numResults) {
+			while(it->hasNext()) {
+				samples.push_back(*it->next());
+			}
+		} else {
+			// Floyd's algorithm: k distinct positions in [0, numResults)
+			set<unsigned int> positions;
+			for(unsigned int j=numResults-k; j<numResults; j++) {
+				unsigned int pos = nextRandom(state) % (j+1);
+				if(!positions.insert(pos).second) {
+					positions.insert(j);
+				}
+			}
+			for(set<unsigned int>::iterator pos=positions.begin(); pos!=positions.end(); ++pos) {
+				it->goTo(*pos);
+				samples.push_back(*it->next());
+			}
+		}
+	} else {
+		// Reservoir sampling
+		unsigned long long count = 0;
+		while(it->hasNext()) {
+			TripleID *triple = it->next();
+			if(count<k) {
+				samples.push_back(*triple);
+			} else {
+				unsigned long long pos = nextRandom(state) % (count+1);
+				if(pos<k) {
+					samples[pos] = *triple;
+				}
+			}
+			count++;
+		}
+	}
+	delete it;
+	return samples;
+}
+
+}
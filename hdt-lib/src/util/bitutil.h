@@ -11,6 +11,10 @@
 #include <stdint.h>
 #include <iostream>
 
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
 namespace hdt {
 
 extern const unsigned char popcount_tab[256];
@@ -29,18 +33,43 @@ inline uint32_t bits(uint64_t n) {
 	return b;
 }
 
+/**
+ * Position (starting at 1) of the rank-th one of value. If there are not
+ * enough ones, returns the position of the highest one.
+ */
 inline uint32_t wordSelect1(uint32_t value, uint32_t rank) {
+#ifdef __BMI2__
+	if(rank==0 || value==0) {
+		return 0;
+	}
+	if(rank>(uint32_t)__builtin_popcount(value)) {
+		return 32-__builtin_clz(value);
+	}
+	return __builtin_ctz(_pdep_u32(1u<<(rank-1), value))+1;
+#else
 	uint32_t bitpos=0;
+	// Skip whole bytes
+	while(rank>popcount_tab[value & 0xff] && (value>>8)) {
+		rank -= popcount_tab[value & 0xff];
+		bitpos+=8;
+		value>>=8;
+	}
 	while(rank && value) {
 		rank -= value & 1;
 		bitpos++;
 		value>>=1;
 	}
 	return bitpos;
+#endif
 }
 
 inline uint32_t wordSelect1(uint64_t value, uint64_t rank) {
 	uint32_t bitpos=0;
+	while(rank>popcount_tab[value & 0xff] && (value>>8)) {
+		rank -= popcount_tab[value & 0xff];
+		bitpos+=8;
+		value>>=8;
+	}
 	while(rank && value) {
 		rank -= value & 1;
 		bitpos++;
@@ -84,10 +113,11 @@ inline uint32_t popcount64(const uint64_t x) {
 #ifdef __SSE4_2__
 	return __builtin_popcountll(x);
 #else
-	return popcount_tab[(x) & 0xff]  + popcount_tab[(x >>  8) & 0xff]
-	     + popcount_tab[(x >> 16) & 0xff]  + popcount_tab[(x >> 24) & 0xff]
-         + popcount_tab[(x >> 32) & 0xff]  + popcount_tab[(x >> 40) & 0xff]
-         + popcount_tab[(x >> 48) & 0xff]  + popcount_tab[(x >> 56) & 0xff];
+	// Broadword count, cheaper than eight table lookups
+	uint64_t v = x - ((x >> 1) & 0x5555555555555555ULL);
+	v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+	v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (uint32_t)((v * 0x0101010101010101ULL) >> 56);
 #endif
 }
 
@@ -0,0 +1,139 @@
+/*
+ * batchsearch.cpp
+ *
+ * Check BitmapTriples::searchBatch() against search() for S??, SP?, SPO and
+ * other patterns, and compare the time of resolving many random lookups in
+ * one batch or one by one.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "../src/triples/BitmapTriples.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+int check(BitmapTriples *triples, vector<TripleID> &patterns, vector<TripleID> &results, vector<size_t> &offsets) {
+	if(offsets.size()!=patterns.size()+1) {
+		cerr << "Error: " << offsets.size() << " offsets for " << patterns.size() << " patterns" << endl;
+		return 1;
+	}
+	int errors=0;
+	for(size_t i=0;i<patterns.size() && errors<10;i++) {
+		size_t pos = offsets[i];
+		IteratorTripleID *it = triples->search(patterns[i]);
+		while(it->hasNext()) {
+			TripleID *triple = it->next();
+			if(pos>=offsets[i+1] || !(results[pos]==*triple)) {
+				cerr << "Error: pattern " << patterns[i] << " expected " << *triple << endl;
+				errors++;
+				break;
+			}
+			pos++;
+		}
+		delete it;
+		if(errors==0 && pos!=offsets[i+1]) {
+			cerr << "Error: pattern " << patterns[i] << " has more results" << endl;
+			errors++;
+		}
+	}
+	return errors;
+}
+
+void benchmark(BitmapTriples *triples, const char *name, vector<TripleID> &patterns) {
+	vector<TripleID> results;
+	vector<size_t> offsets;
+
+	StopWatch st;
+	for(size_t i=0;i<patterns.size();i++) {
+		IteratorTripleID *it = triples->search(patterns[i]);
+		while(it->hasNext()) {
+			results.push_back(*it->next());
+		}
+		delete it;
+	}
+	unsigned long long timeSearch = st.stopReal();
+	size_t numResults = results.size();
+
+	st.reset();
+	triples->searchBatch(patterns, results, offsets);
+	unsigned long long timeBatch = st.stopReal();
+
+	cout << name << "\t" << patterns.size() << " lookups, " << numResults << " triples\tsearch(): " << timeSearch << " us\tsearchBatch(): " << timeBatch << " us" << endl;
+}
+
+int main(int argc, char **argv) {
+	if(argc<2) {
+		cout << "$ batchsearch <hdtfile>" << endl;
+		return 1;
+	}
+
+	HDT *hdt = HDTManager::mapIndexedHDT(argv[1]);
+	BitmapTriples *triples = dynamic_cast<BitmapTriples *>(hdt->getTriples());
+	if(triples==NULL) {
+		cerr << "The triples are not BitmapTriples" << endl;
+		delete hdt;
+		return 1;
+	}
+
+	vector<TripleID> all;
+	IteratorTripleID *it = triples->searchAll();
+	while(it->hasNext()) {
+		all.push_back(*it->next());
+	}
+	delete it;
+	if(all.size()==0) {
+		delete hdt;
+		return 0;
+	}
+
+	// Patterns from existing triples, and mixing two triples for some empty results.
+	vector<TripleID> mixed, subjects, subjectPredicates;
+	for(int i=0;i<200000;i++) {
+		TripleID &triple = all[((size_t)rand()*7919)%all.size()];
+		TripleID &other = all[((size_t)rand()*7919)%all.size()];
+		subjects.push_back(TripleID(triple.getSubject(), 0, 0));
+		subjectPredicates.push_back(TripleID(triple.getSubject(), triple.getPredicate(), 0));
+		if(i<2000) {
+			int mask = 1+rand()%7;
+			mixed.push_back(TripleID(mask&1 ? triple.getSubject() : 0, mask&2 ? other.getPredicate() : 0, mask&4 ? triple.getObject() : 0));
+			mixed.push_back(TripleID(triple.getSubject(), triple.getPredicate(), triple.getObject()));
+		}
+	}
+
+	vector<TripleID> results;
+	vector<size_t> offsets;
+	int errors=0;
+	triples->searchBatch(mixed, results, offsets);
+	errors += check(triples, mixed, results, offsets);
+	vector<TripleID> firstSubjects(subjects.begin(), subjects.begin()+1000);
+	triples->searchBatch(firstSubjects, results, offsets);
+	errors += check(triples, firstSubjects, results, offsets);
+	vector<TripleID> empty;
+	triples->searchBatch(empty, results, offsets);
+	if(offsets.size()!=1 || results.size()!=0) {
+		cerr << "Error: empty batch" << endl;
+		errors++;
+	}
+	// Subject after the last one, search() throws but the batch has no results.
+	vector<TripleID> beyond(1, TripleID(all.back().getSubject()+1, 0, 0));
+	triples->searchBatch(beyond, results, offsets);
+	if(offsets.size()!=2 || results.size()!=0) {
+		cerr << "Error: subject beyond the last one" << endl;
+		errors++;
+	}
+
+	benchmark(triples, "S??", subjects);
+	benchmark(triples, "SP?", subjectPredicates);
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+
+	delete hdt;
+	return errors;
+}
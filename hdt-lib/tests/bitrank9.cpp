@@ -0,0 +1,200 @@
+/*
+ * bitrank9.cpp
+ *
+ * Check BitSequenceRank9 against BitSequence375, including save/load at
+ * several stream positions and the alignment of the saved blocks, and
+ * compare rank1/select1 speed of both on random positions.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "../src/bitsequence/BitSequence375.h"
+#include "../src/bitsequence/BitSequenceRank9.h"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+int compare(BitSeq &a, BitSeq &b) {
+	int errors=0;
+	if(a.getNumBits()!=b.getNumBits() || a.countOnes()!=b.countOnes()) {
+		cerr << "Error: different size" << endl;
+		return 1;
+	}
+	for(size_t i=0;i<a.getNumBits() && errors<10;i++) {
+		if(a.access(i)!=b.access(i) || a.rank1(i)!=b.rank1(i) || a.rank0(i)!=b.rank0(i)) {
+			cerr << "Error access/rank at " << i << endl;
+			errors++;
+		}
+	}
+	for(size_t i=1;i<=a.countOnes() && errors<10;i++) {
+		if(a.select1(i)!=b.select1(i)) {
+			cerr << "Error select1(" << i << ")" << endl;
+			errors++;
+		}
+	}
+	for(size_t i=1;i<=a.countZeros() && errors<10;i++) {
+		if(a.select0(i)!=b.select0(i)) {
+			cerr << "Error select0(" << i << ")" << endl;
+			errors++;
+		}
+	}
+	// selectNext1 against a linear scan
+	size_t next = a.getNumBits();
+	for(size_t i=a.getNumBits();i>0 && errors<10;i--) {
+		if(b.access(i-1)) next=i-1;
+		if(b.selectNext1(i-1)!=next) {
+			cerr << "Error selectNext1(" << i-1 << ")" << endl;
+			errors++;
+		}
+	}
+	// selectPrev1 against a linear scan
+	size_t prev = (size_t)-1;
+	for(size_t i=0;i<a.getNumBits() && errors<10;i++) {
+		if(b.access(i)) prev=i;
+		if(b.selectPrev1(i)!=prev) {
+			cerr << "Error selectPrev1(" << i << ")" << endl;
+			errors++;
+		}
+	}
+	return errors;
+}
+
+/** Copies data to a buffer aligned to 64 bytes plus shift. */
+unsigned char *copyAligned(const string &data, size_t shift, vector<uint64_t> &memory) {
+	memory.assign(data.size()/8+16, 0);
+	unsigned char *base = (unsigned char *)&memory[0];
+	base += (64 - ((uintptr_t)base)%64) % 64;
+	memcpy(base+shift, data.data(), data.size());
+	return base+shift;
+}
+
+/** Saves after prefix bytes and loads from the stream and from memory. */
+int checkSaveLoad(BitSeq &plain, BitSequenceRank9 &rank9, size_t prefix) {
+	int errors=0;
+	stringstream stream;
+	stream << string(prefix, 'x');
+	rank9.save(stream);
+
+	stream.seekg(prefix);
+	BitSeq *loaded = BitSeq::load(stream);
+	errors += compare(plain, *loaded);
+	delete loaded;
+
+	// The blocks, followed by the superblock counters and the CRC32, start
+	// at a multiple of 64 bytes.
+	string data = stream.str();
+	size_t numblocks = (rank9.getNumBits()+447)/448;
+	size_t blocksStart = data.size() - 4 - (numblocks+15)/16*8 - numblocks*64;
+	if(blocksStart%64!=0) {
+		cerr << "Error: blocks saved after " << prefix << " bytes start at " << blocksStart << endl;
+		errors++;
+	}
+
+	// Memory load, mapped in place when aligned and copied when not.
+	vector<uint64_t> memory;
+	for(size_t shift=0; shift<2; shift++) {
+		unsigned char *ptr = copyAligned(data, shift, memory) + prefix;
+		BitSeq *mapped = BitSeq::getBitmap(ptr[0]);
+		size_t count = mapped->load(ptr, ptr+data.size()-prefix);
+		if(count!=data.size()-prefix) {
+			cerr << "Error: loaded " << count << " bytes of " << data.size()-prefix << endl;
+			errors++;
+		}
+		errors += compare(plain, *mapped);
+		delete mapped;
+	}
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+
+	// Correctness on several sizes and densities
+	size_t sizes[] = { 1, 63, 64, 447, 448, 449, 100000 };
+	int densities[] = { 0, 1, 50, 99, 100 };
+	for(size_t s=0;s<sizeof(sizes)/sizeof(size_t);s++) {
+		for(size_t d=0;d<sizeof(densities)/sizeof(int);d++) {
+			BitSequence375 plain(sizes[s]);
+			BitSequenceRank9 rank9(sizes[s]);
+			for(size_t i=0;i<sizes[s];i++) {
+				bool val = (rand()%100)<densities[d];
+				plain.append(val);
+				rank9.append(val);
+			}
+			errors += compare(plain, rank9);
+
+			rank9.setSelectSampling(0);
+			errors += compare(plain, rank9);
+
+			size_t prefixes[] = { 0, 1, 13, 63 };
+			for(size_t p=0;p<4;p++) {
+				errors += checkSaveLoad(plain, rank9, prefixes[p]);
+			}
+		}
+	}
+
+	// Speed on a big bitmap, use a size bigger than the CPU cache to see the effect of cache misses
+	size_t numbits = argc>1 ? strtoull(argv[1], NULL, 10) : 200000000;
+	size_t numqueries = 5000000;
+	BitSequence375 plain(numbits);
+	BitSequenceRank9 rank9(numbits);
+	for(size_t i=0;i<numbits;i++) {
+		bool val = rand()%4==0;
+		plain.append(val);
+		rank9.append(val);
+	}
+	plain.countOnes();
+	rank9.countOnes();
+
+	vector<size_t> positions, ranks;
+	for(size_t i=0;i<numqueries;i++) {
+		positions.push_back(((size_t)rand()*7919)%numbits);
+		ranks.push_back(1+((size_t)rand()*7919)%plain.countOnes());
+	}
+
+	// Also mapped from memory aligned as a mapped file.
+	stringstream stream;
+	rank9.save(stream);
+	vector<uint64_t> memory;
+	unsigned char *ptr = copyAligned(stream.str(), 0, memory);
+	BitSequenceRank9 mapped;
+	mapped.load(ptr, ptr+stream.str().size());
+
+	// The queries miss the cache, so the times are noisy: take the best of
+	// several rounds, alternating the bitmaps.
+	BitSeq *bitmaps[] = { &plain, &rank9, &mapped };
+	const char *names[] = { "BitSequence375", "BitSequenceRank9", "BitSequenceRank9 mapped" };
+	unsigned long long bestRank[3], bestSelect[3];
+	size_t sum=0;
+	for(int round=0;round<3;round++) {
+		for(int b=0;b<3;b++) {
+			StopWatch st;
+			for(size_t i=0;i<numqueries;i++) {
+				sum += bitmaps[b]->rank1(positions[i]);
+			}
+			unsigned long long timeRank = st.stopReal();
+
+			st.reset();
+			for(size_t i=0;i<numqueries;i++) {
+				sum += bitmaps[b]->select1(ranks[i]);
+			}
+			unsigned long long timeSelect = st.stopReal();
+
+			if(round==0 || timeRank<bestRank[b]) bestRank[b] = timeRank;
+			if(round==0 || timeSelect<bestSelect[b]) bestSelect[b] = timeSelect;
+		}
+	}
+	for(int b=0;b<3;b++) {
+		cout << names[b] << "\trank1: " << bestRank[b] << " us\tselect1: " << bestSelect[b] << " us\tsize: " << bitmaps[b]->getSizeBytes() << " bytes" << endl;
+	}
+	cout << "(" << sum%10 << ")" << endl;
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
@@ -0,0 +1,213 @@
+/*
+ * blockcache.cpp
+ *
+ * Check extractBlock() of PFC, HTFC and RePairDAC against extract(), and
+ * CSD_BlockCache against its child with budgets that keep all the blocks or
+ * force evictions, from several threads. Then map an HDT file with and
+ * without the cache of the sections and compare idToString() of random IDs
+ * and its time, if given, also of the predicates from several threads.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+#include <HDTSpecification.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_PFC.h"
+#include "../src/libdcs/CSD_HTFC.h"
+#include "../src/libdcs/CSD_RePairDAC.h"
+#include "../src/libdcs/CSD_BlockCache.h"
+#include "../src/hdt/BasicHDT.hpp"
+#include "../src/dictionary/FourSectionDictionary.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+CSD *create(int codec, vector<string> &strings) {
+	VectorIteratorUCharString it(strings);
+	if(codec==0) {
+		return new CSD_PFC(&it, 16);
+	} else if(codec==1) {
+		return new CSD_HTFC(&it, 16);
+	}
+	return new CSD_RePairDAC(&it, 16);
+}
+
+int checkBlocks(const char *name, CSD *csd, vector<string> &strings) {
+	int errors=0;
+	string data;
+	vector<uint32_t> offsets;
+	uint32_t blocksize = csd->getBlockSize();
+	for(size_t first=0; first<strings.size() && errors<10; first+=blocksize) {
+		csd->extractBlock(first/blocksize, data, offsets);
+		size_t count = min((size_t)blocksize, strings.size()-first);
+		if(offsets.size()!=count+1 || offsets.back()!=data.size()) {
+			cerr << "Error " << name << " extractBlock(" << first/blocksize << ") has " << offsets.size()-1 << " strings" << endl;
+			errors++;
+			continue;
+		}
+		for(size_t i=0; i<count; i++) {
+			if(strings[first+i]!=&data[offsets[i]]) {
+				cerr << "Error " << name << " extractBlock(" << first/blocksize << ") string " << i << endl;
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+int checkCache(const char *name, CSD_BlockCache *cache, vector<string> &strings) {
+	int errors=0;
+	if(cache->getLength()!=strings.size() || cache->extract(0)!=NULL || cache->extract(strings.size()+1)!=NULL) {
+		cerr << "Error " << name << " length or out of range" << endl;
+		return 1;
+	}
+
+	// Sequential, with a small buffer that most strings do not fit.
+	string str;
+	unsigned char small[24];
+	for(size_t i=0; i<strings.size() && errors<10; i++) {
+		cache->extractString(i+1, str);
+		size_t len = cache->extract(i+1, small, sizeof(small));
+		if(str!=strings[i] || len!=strings[i].length() || (len<sizeof(small) && strings[i]!=(char *)small)) {
+			cerr << "Error " << name << " extract(" << i+1 << ")=" << str << " expected " << strings[i] << endl;
+			errors++;
+		}
+	}
+
+	// Random IDs from several threads.
+	vector<uint32_t> ids;
+	for(size_t i=0; i<200000; i++) {
+		ids.push_back(1+rand()%strings.size());
+	}
+	int threadErrors=0;
+	#pragma omp parallel for schedule(dynamic, 1000) reduction(+:threadErrors)
+	for(long i=0; i<(long)ids.size(); i++) {
+		string out;
+		cache->extractString(ids[i], out);
+		if(out!=strings[ids[i]-1]) {
+			threadErrors++;
+		}
+	}
+	if(threadErrors>0) {
+		cerr << "Error " << name << " " << threadErrors << " wrong strings from several threads" << endl;
+		errors += threadErrors;
+	}
+	cout << "  " << name << "\t" << cache->getNumberOfSlots() << " slots of " << cache->getSlotBytes() << " bytes\thits: "
+			<< cache->getHits() << "\tmisses: " << cache->getMisses() << endl;
+	return errors;
+}
+
+int checkStrings(vector<string> &strings) {
+	int errors=0;
+	const char *names[] = { "PFC", "HTFC", "RePairDAC" };
+	for(int c=0; c<3; c++) {
+		CSD *csd = create(c, strings);
+		errors += checkBlocks(names[c], csd, strings);
+		delete csd;
+
+		// Budgets for one set, a few sets, and all the blocks.
+		uint64_t budgets[] = { 1, 64*1024, 64*1024*1024 };
+		for(int b=0; b<3; b++) {
+			CSD_BlockCache cache(create(c, strings), budgets[b], b==0 ? 1 : CSD_BlockCache::DEFAULT_SHARDS);
+			errors += checkCache(names[c], &cache, strings);
+		}
+	}
+	return errors;
+}
+
+unsigned long long readIds(Dictionary *dict, vector<unsigned int> &ids, vector<string> &out, TripleComponentRole role=OBJECT) {
+	StopWatch st;
+	out.resize(ids.size());
+	#pragma omp parallel for schedule(dynamic, 1000)
+	for(long i=0; i<(long)ids.size(); i++) {
+		out[i] = dict->idToString(ids[i], role);
+	}
+	return st.stopReal();
+}
+
+int checkHDT(const char *file) {
+	HDT *plain = HDTManager::mapHDT(file);
+
+	HDTSpecification spec;
+	spec.set("dictionary.cachesize", "16777216");
+	BasicHDT *cached = new BasicHDT(spec);
+	cached->mapHDT(file);
+
+	// Skewed IDs, most of them from a few blocks.
+	Dictionary *dict = plain->getDictionary();
+	vector<unsigned int> ids;
+	unsigned int hot = dict->getMaxObjectID()/100+1;
+	for(size_t i=0; i<500000; i++) {
+		ids.push_back(1+(rand()%10<9 ? rand()%hot : rand()%dict->getMaxObjectID()));
+	}
+
+	vector<string> expected, found;
+	unsigned long long timePlain = readIds(dict, ids, expected);
+	unsigned long long timeCached = readIds(cached->getDictionary(), ids, found);
+
+	int errors=0;
+	for(size_t i=0; i<ids.size() && errors<10; i++) {
+		if(expected[i]!=found[i]) {
+			cerr << "Error idToString(" << ids[i] << ")=" << found[i] << " expected " << expected[i] << endl;
+			errors++;
+		}
+	}
+
+	// The predicates keep all their strings, read from several threads.
+	vector<unsigned int> predIds;
+	for(size_t i=0; i<200000; i++) {
+		predIds.push_back(1+rand()%dict->getMaxPredicateID());
+	}
+	readIds(dict, predIds, expected, PREDICATE);
+	readIds(cached->getDictionary(), predIds, found, PREDICATE);
+	for(size_t i=0; i<predIds.size() && errors<10; i++) {
+		if(expected[i]!=found[i] || found[i]=="") {
+			cerr << "Error predicate idToString(" << predIds[i] << ")=" << found[i] << " expected " << expected[i] << endl;
+			errors++;
+		}
+	}
+
+	uint64_t hits, misses;
+	FourSectionDictionary *four = dynamic_cast<FourSectionDictionary *>(cached->getDictionary());
+	if(four) {
+		four->getCacheCounters(&hits, &misses);
+		cout << "HDT\t" << ids.size() << " objects\tplain: " << timePlain/1000 << " ms\tcached: " << timeCached/1000
+				<< " ms\thits: " << hits << "\tmisses: " << misses << endl;
+	}
+	delete plain;
+	delete cached;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	vector<string> strings;
+	for(int i=0; i<30000; i++) {
+		string str = "http://example.org/";
+		int len = 1+rand()%(i%100==0 ? 300 : 20);
+		for(int j=0; j<len; j++) {
+			str += (char)('a'+rand()%(j<2 ? 2 : 26));
+		}
+		strings.push_back(str);
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+	int errors=0;
+	vector<string> one(strings.begin(), strings.begin()+1);
+	errors += checkStrings(one);
+	errors += checkStrings(strings);
+
+	if(argc>1) {
+		errors += checkHDT(argv[1]);
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
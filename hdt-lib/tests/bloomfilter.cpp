@@ -0,0 +1,235 @@
+/*
+ * bloomfilter.cpp
+ *
+ * Check BloomFilter: no false negatives, the measured false positive rate
+ * against the estimate, and save/load from a stream and from memory. Then
+ * generate the filter of an HDT file, if given, and compare stringToId() and
+ * stringToIds() with and without it, also loaded and mapped, and the time of
+ * the lookups of absent strings.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+#include <HDTSpecification.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_PFC.h"
+#include "../src/libdcs/BloomFilter.h"
+#include "../src/hdt/BasicHDT.hpp"
+#include "../src/dictionary/FourSectionDictionary.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+string randomString(const string &base) {
+	string str = base;
+	int len = 1+rand()%20;
+	for(int j=0; j<len; j++) {
+		str += (char)('a'+rand()%26);
+	}
+	return str;
+}
+
+int checkFilter(const char *name, BloomFilter &filter, vector<string> &strings, vector<string> &absent) {
+	int errors=0;
+	for(size_t i=0; i<strings.size() && errors<10; i++) {
+		if(!filter.mayContain((const unsigned char *)strings[i].c_str(), strings[i].length())) {
+			cerr << "Error " << name << " false negative " << strings[i] << endl;
+			errors++;
+		}
+	}
+
+	size_t positives=0;
+	for(size_t i=0; i<absent.size(); i++) {
+		if(filter.mayContain((const unsigned char *)absent[i].c_str(), absent[i].length())) {
+			positives++;
+		}
+	}
+	double measured = (double)positives/absent.size();
+	double estimated = filter.getFalsePositiveRate();
+	cout << "  " << name << "\t" << filter.getLength() << " strings\t" << filter.getNumberOfProbes() << " probes\t"
+			<< filter.size() << " bytes\tmeasured: " << measured << "\testimated: " << estimated << endl;
+	if(measured>2*estimated+0.002) {
+		cerr << "Error " << name << " false positive rate " << measured << " estimated " << estimated << endl;
+		errors++;
+	}
+	return errors;
+}
+
+int checkStrings() {
+	vector<string> strings, absent;
+	for(int i=0; i<50000; i++) {
+		strings.push_back(randomString("http://example.org/"));
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+	for(int i=0; i<200000; i++) {
+		absent.push_back(randomString("http://example.com/"));
+	}
+
+	VectorIteratorUCharString it(strings);
+	CSD_PFC csd(&it, 16);
+
+	int errors=0;
+	uint32_t bits[] = { 4, 10, 16 };
+	for(int b=0; b<3; b++) {
+		BloomFilter filter;
+		filter.build(&csd, bits[b]);
+		errors += checkFilter("built", filter, strings, absent);
+
+		stringstream stream;
+		filter.save(stream);
+		BloomFilter loaded;
+		loaded.load(stream);
+		errors += checkFilter("loaded", loaded, strings, absent);
+
+		string data = stream.str();
+		vector<unsigned char> buffer(data.begin(), data.end());
+		BloomFilter mapped;
+		if(mapped.load(&buffer[0], &buffer[0]+buffer.size())!=buffer.size()) {
+			cerr << "Error mapped filter did not read all the data" << endl;
+			errors++;
+		}
+		errors += checkFilter("mapped", mapped, strings, absent);
+
+		try {
+			BloomFilter truncated;
+			truncated.load(&buffer[0], &buffer[0]+buffer.size()-5);
+			cerr << "Error truncated filter loaded" << endl;
+			errors++;
+		} catch (const char *e) {
+		}
+	}
+
+	// Empty section
+	vector<string> none;
+	VectorIteratorUCharString emptyIt(none);
+	CSD_PFC empty(&emptyIt, 16);
+	BloomFilter filter;
+	filter.build(&empty);
+	if(filter.mayContain((const unsigned char *)"a", 1)) {
+		cerr << "Error empty filter contains a string" << endl;
+		errors++;
+	}
+	return errors;
+}
+
+/** Lookups of all the strings of a role, plus absent ones, in one dictionary against the other. */
+int compare(const char *name, Dictionary *expected, Dictionary *found, vector<string> &absent) {
+	int errors=0;
+	TripleComponentRole roles[] = { SUBJECT, PREDICATE, OBJECT };
+	unsigned int maxIds[] = { expected->getMaxSubjectID(), expected->getMaxPredicateID(), expected->getMaxObjectID() };
+	for(int r=0; r<3; r++) {
+		vector<string> strs;
+		for(unsigned int id=1; id<=maxIds[r]; id++) {
+			strs.push_back(expected->idToString(id, roles[r]));
+		}
+		strs.insert(strs.end(), absent.begin(), absent.end());
+
+		vector<unsigned int> ids;
+		found->stringToIds(strs, roles[r], ids);
+		for(size_t i=0; i<strs.size() && errors<10; i++) {
+			unsigned int id = i<maxIds[r] ? i+1 : 0;
+			if(found->stringToId(strs[i], roles[r])!=id || ids[i]!=id) {
+				cerr << "Error " << name << " stringToId(" << strs[i] << ")=" << ids[i] << " expected " << id << endl;
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+unsigned long long lookupAbsent(Dictionary *dict, vector<string> &absent) {
+	StopWatch st;
+	unsigned int found=0;
+	for(size_t i=0; i<absent.size(); i++) {
+		found += dict->stringToId(absent[i], OBJECT);
+	}
+	if(found!=0) {
+		cerr << "Error: absent strings found" << endl;
+	}
+	return st.stopReal();
+}
+
+int checkHDT(const char *file) {
+	string copy = "bloomfilter.hdt";
+	{
+		ifstream in(file, ios::binary);
+		ofstream out(copy.c_str(), ios::binary);
+		out << in.rdbuf();
+	}
+
+	vector<string> absent;
+	for(int i=0; i<200000; i++) {
+		absent.push_back(i%2 ? randomString("http://example.com/") : "\""+randomString("")+"\"");
+	}
+
+	int errors=0;
+	HDT *plain = HDTManager::mapHDT(copy.c_str());
+
+	HDTSpecification spec;
+	spec.set("dictionary.bloomfilter", "true");
+	BasicHDT *filtered = new BasicHDT(spec);
+	filtered->mapHDT(copy.c_str());
+	filtered->loadOrCreateIndex();
+	FourSectionDictionary *four = dynamic_cast<FourSectionDictionary *>(filtered->getDictionary());
+	if(four==NULL || !four->hasBloomFilter()) {
+		cerr << "Error: the HDT does not have a Bloom filter" << endl;
+		return 1;
+	}
+	errors += compare("generated", plain->getDictionary(), filtered->getDictionary(), absent);
+
+	unsigned long long timePlain = lookupAbsent(plain->getDictionary(), absent);
+	unsigned long long timeFiltered = lookupAbsent(filtered->getDictionary(), absent);
+	cout << "HDT\t" << absent.size() << " absent objects\tplain: " << timePlain/1000 << " ms\tfiltered: "
+			<< timeFiltered/1000 << " ms\tfalse positive rate of objects: "
+			<< four->getBloomFilter(NOT_SHARED_OBJECT)->getFalsePositiveRate() << endl;
+	delete filtered;
+
+	// Mapped with the other indexes, and read from the stream.
+	HDT *mapped = HDTManager::mapIndexedHDT(copy.c_str());
+	four = dynamic_cast<FourSectionDictionary *>(mapped->getDictionary());
+	if(!four->hasBloomFilter()) {
+		cerr << "Error: the mapped HDT did not load the Bloom filter" << endl;
+		errors++;
+	}
+	errors += compare("mapped", plain->getDictionary(), mapped->getDictionary(), absent);
+	delete mapped;
+
+	HDT *loaded = HDTManager::loadIndexedHDT(copy.c_str());
+	four = dynamic_cast<FourSectionDictionary *>(loaded->getDictionary());
+	if(!four->hasBloomFilter()) {
+		cerr << "Error: the loaded HDT did not load the Bloom filter" << endl;
+		errors++;
+	}
+	errors += compare("loaded", plain->getDictionary(), loaded->getDictionary(), absent);
+	delete loaded;
+	delete plain;
+
+	remove(copy.c_str());
+	remove((copy+".index").c_str());
+	remove((copy+".bloom").c_str());
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+	errors += checkStrings();
+
+	if(argc>1) {
+		errors += checkHDT(argv[1]);
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
@@ -0,0 +1,178 @@
+/*
+ * eliasfano.cpp
+ *
+ * Check EliasFanoSequence against LogSequence2, including save/load and nextGEQ(),
+ * and compare size, scan and seek speed of both. With an HDT file as argument,
+ * use its object lists; otherwise generate random sorted lists.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "../src/sequence/LogSequence2.hpp"
+#include "../src/sequence/EliasFanoSequence.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+int compare(IntSequence &a, IntSequence &b, vector<size_t> &listStart) {
+	int errors=0;
+	if(a.getNumberOfElements()!=b.getNumberOfElements()) {
+		cerr << "Error: different size" << endl;
+		return 1;
+	}
+	for(size_t i=0;i<a.getNumberOfElements() && errors<10;i++) {
+		if(a.get(i)!=b.get(i)) {
+			cerr << "Error get(" << i << ")=" << b.get(i) << " expected " << a.get(i) << endl;
+			errors++;
+		}
+	}
+
+	unsigned int bufA[100], bufB[100];
+	for(size_t i=0;i<a.getNumberOfElements() && errors<10;i+=37) {
+		size_t countA = a.decode(i, 100, bufA);
+		size_t countB = b.decode(i, 100, bufB);
+		if(countA!=countB) {
+			cerr << "Error decode(" << i << ") count" << endl;
+			errors++;
+		}
+		for(size_t j=0;j<countA && j<countB;j++) {
+			if(bufA[j]!=bufB[j]) {
+				cerr << "Error decode(" << i << ") at " << j << endl;
+				errors++;
+				break;
+			}
+		}
+	}
+
+	// nextGEQ inside each list, against the default galloping search.
+	for(size_t l=0;l+1<listStart.size() && errors<10;l++) {
+		size_t begin = listStart[l], end = listStart[l+1];
+		size_t last = a.get(end-1);
+		for(int t=0;t<5;t++) {
+			size_t from = begin + rand()%(end-begin);
+			size_t value = rand()%(last+2);
+			if(a.nextGEQ(from, end, value)!=b.nextGEQ(from, end, value)) {
+				cerr << "Error nextGEQ(" << from << "," << end << "," << value << ")=" << b.nextGEQ(from, end, value) << " expected " << a.nextGEQ(from, end, value) << endl;
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+void benchmark(const char *name, IntSequence &seq, vector<size_t> &listStart, vector<size_t> &lastValue) {
+	unsigned int buf[128];
+	StopWatch st;
+	size_t sum=0;
+	for(size_t i=0;i<seq.getNumberOfElements();i+=128) {
+		size_t count = seq.decode(i, 128, buf);
+		for(size_t j=0;j<count;j++) {
+			sum += buf[j];
+		}
+	}
+	unsigned long long timeScan = st.stopReal();
+
+	// Seek to random values inside random lists.
+	srand(1);
+	size_t numSeeks = 1000000;
+	vector<size_t> seekList, seekValue;
+	for(size_t i=0;i<numSeeks;i++) {
+		size_t l = ((size_t)rand()*7919)%(listStart.size()-1);
+		seekList.push_back(l);
+		seekValue.push_back(rand()%(lastValue[l]+1));
+	}
+	st.reset();
+	for(size_t i=0;i<numSeeks;i++) {
+		sum += seq.nextGEQ(listStart[seekList[i]], listStart[seekList[i]+1], seekValue[i]);
+	}
+	unsigned long long timeSeek = st.stopReal();
+
+	cout << name << "\tsize: " << seq.size() << " bytes\tscan: " << timeScan << " us\tseek: " << timeSeek << " us (" << sum%10 << ")" << endl;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+	LogSequence2 plain(32);
+	vector<size_t> listStart;
+
+	if(argc>1) {
+		// Object lists of the HDT in SPO order.
+		HDT *hdt = HDTManager::mapHDT(argv[1]);
+		TripleID any(0,0,0);
+		IteratorTripleID *it = hdt->getTriples()->search(any);
+		TripleID last(0,0,0);
+		while(it->hasNext()) {
+			TripleID *triple = it->next();
+			if(triple->getSubject()!=last.getSubject() || triple->getPredicate()!=last.getPredicate()) {
+				listStart.push_back(plain.getNumberOfElements());
+			}
+			plain.push_back(triple->getObject());
+			last = *triple;
+		}
+		delete it;
+		delete hdt;
+	} else {
+		// Random lists of different lengths and densities.
+		for(size_t l=0;l<200000;l++) {
+			listStart.push_back(plain.getNumberOfElements());
+			size_t len = 1+(rand()%10==0 ? rand()%1000 : rand()%3);
+			unsigned int value = 1+rand()%1000;
+			for(size_t j=0;j<len;j++) {
+				plain.push_back(value);
+				value += 1+rand()%(l%2 ? 3 : 5000);
+			}
+		}
+	}
+	listStart.push_back(plain.getNumberOfElements());
+	plain.reduceBits();
+
+	EliasFanoSequence ef(&plain);
+	errors += compare(plain, ef, listStart);
+
+	// Stream save/load
+	stringstream stream;
+	ef.save(stream);
+	IntSequence *loaded = IntSequence::getArray(stream);
+	loaded->load(stream);
+	errors += compare(plain, *loaded, listStart);
+	delete loaded;
+
+	// Memory load
+	string buf = stream.str();
+	IntSequence *mapped = IntSequence::getArray((unsigned char)buf[0]);
+	mapped->load((const unsigned char *)buf.c_str(), (const unsigned char *)buf.c_str()+buf.size());
+	errors += compare(plain, *mapped, listStart);
+	delete mapped;
+
+	// Corner cases
+	LogSequence2 small(8);
+	vector<size_t> smallStart;
+	smallStart.push_back(0);
+	small.push_back(0);
+	small.push_back(0);
+	small.push_back(5);
+	smallStart.push_back(3);
+	small.push_back(1);
+	smallStart.push_back(4);
+	EliasFanoSequence efSmall(&small);
+	errors += compare(small, efSmall, smallStart);
+
+	vector<size_t> lastValue;
+	for(size_t l=0;l+1<listStart.size();l++) {
+		lastValue.push_back(plain.get(listStart[l+1]-1));
+	}
+
+	cout << plain.getNumberOfElements() << " elements in " << listStart.size()-1 << " lists" << endl;
+	benchmark("LogSequence2", plain, listStart, lastValue);
+	benchmark("EliasFano", ef, listStart, lastValue);
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
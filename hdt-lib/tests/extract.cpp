@@ -0,0 +1,235 @@
+/*
+ * extract.cpp
+ *
+ * Check CSD::extract(id, buffer, capacity) of PFC, HTFC, FMIndex and the
+ * cache against extract(id) with buffers too small, exact and big, and
+ * extractMany(), PFCCursor and the PFC iterator. With an HDT file, also check
+ * Dictionary::tripleIDtoTripleString() and extractMany() against idToString()
+ * and compare their times.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_PFC.h"
+#include "../src/libdcs/CSD_HTFC.h"
+#include "../src/libdcs/CSD_FMIndex.h"
+#include "../src/libdcs/CSD_Cache2.h"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+int check(const char *name, CSD *csd, vector<string> &strings) {
+	int errors=0;
+	vector<unsigned char> buffer(100000);
+	string reused;
+	for(uint32_t id=1; id<=strings.size() && errors<10; id++) {
+		unsigned char *ptr = csd->extract(id);
+		string expected((char *)ptr);
+		csd->freeString(ptr);
+		if(expected!=strings[id-1]) {
+			cerr << "Error " << name << " extract(" << id << ")=" << expected << endl;
+			errors++;
+			continue;
+		}
+
+		size_t capacities[] = { 1, expected.length(), expected.length()+1, buffer.size() };
+		for(int i=0;i<4;i++) {
+			memset(&buffer[0], 'x', capacities[i]);
+			size_t len = csd->extract(id, &buffer[0], capacities[i]);
+			// Either the string is written, or the result is enough to hold it.
+			bool written = len<capacities[i];
+			if((written && (len!=expected.length() || strcmp((char *)&buffer[0], expected.c_str())!=0))
+					|| (!written && len<expected.length())) {
+				cerr << "Error " << name << " extract(" << id << ", buffer, " << capacities[i] << ")=" << len << " expected " << expected.length() << endl;
+				errors++;
+			}
+		}
+
+		if(csd->extractString(id, reused)!=expected.length() || reused!=expected) {
+			cerr << "Error " << name << " extractString(" << id << ")=" << reused << endl;
+			errors++;
+		}
+	}
+	if(csd->extract(0, &buffer[0], buffer.size())!=0 || csd->extract(strings.size()+1, &buffer[0], buffer.size())!=0) {
+		cerr << "Error " << name << " extract of a wrong id" << endl;
+		errors++;
+	}
+
+	// Sorted runs, repeated and unsorted ids.
+	vector<uint32_t> ids;
+	for(uint32_t id=1; id<=strings.size(); id++) {
+		if(rand()%3==0) {
+			ids.push_back(id);
+		}
+	}
+	ids.push_back(ids.back());
+	ids.push_back(1);
+	ids.push_back(strings.size());
+	vector<string> out;
+	csd->extractMany(ids, out);
+	for(size_t i=0;i<ids.size() && errors<10;i++) {
+		if(out.size()!=ids.size() || out[i]!=strings[ids[i]-1]) {
+			cerr << "Error " << name << " extractMany id " << ids[i] << endl;
+			errors++;
+		}
+	}
+	return errors;
+}
+
+int checkCursor(CSD_PFC *pfc, vector<string> &strings) {
+	int errors=0;
+	PFCCursor cursor(pfc);
+	uint32_t ids[] = { 1, 2, 3, 3, 9, 16, 15, 17, 40, 0, 41, (uint32_t)strings.size(), (uint32_t)strings.size()+1, 5 };
+	for(size_t i=0;i<sizeof(ids)/sizeof(ids[0]);i++) {
+		string expected = ids[i]>0 && ids[i]<=strings.size() ? strings[ids[i]-1] : "";
+		if(cursor.extract(ids[i])!=expected) {
+			cerr << "Error PFCCursor extract(" << ids[i] << ")" << endl;
+			errors++;
+		}
+	}
+
+	IteratorUCharString *it = pfc->listAll();
+	size_t count=0;
+	while(it->hasNext()) {
+		unsigned char *str = it->next();
+		if(count>=strings.size() || strings[count]!=(char *)str) {
+			cerr << "Error PFC iterator string " << count << endl;
+			errors++;
+			break;
+		}
+		it->freeStr(str);
+		count++;
+	}
+	delete it;
+	if(count!=strings.size()) {
+		cerr << "Error PFC iterator returned " << count << " strings" << endl;
+		errors++;
+	}
+	return errors;
+}
+
+int checkHDT(const char *file) {
+	HDT *hdt = HDTManager::mapHDT(file);
+	Dictionary *dict = hdt->getDictionary();
+
+	vector<TripleID> all;
+	IteratorTripleID *it = hdt->getTriples()->searchAll();
+	while(it->hasNext()) {
+		all.push_back(*it->next());
+	}
+	delete it;
+
+	int errors=0;
+	TripleString ts;
+	for(size_t i=0;i<all.size() && errors<10;i++) {
+		dict->tripleIDtoTripleString(all[i], ts);
+		if(ts.getSubject()!=dict->idToString(all[i].getSubject(), SUBJECT)
+				|| ts.getPredicate()!=dict->idToString(all[i].getPredicate(), PREDICATE)
+				|| ts.getObject()!=dict->idToString(all[i].getObject(), OBJECT)) {
+			cerr << "Error tripleIDtoTripleString " << all[i] << endl;
+			errors++;
+		}
+	}
+
+	size_t total=0;
+	StopWatch st;
+	for(size_t i=0;i<all.size();i++) {
+		string s = dict->idToString(all[i].getSubject(), SUBJECT);
+		string p = dict->idToString(all[i].getPredicate(), PREDICATE);
+		string o = dict->idToString(all[i].getObject(), OBJECT);
+		total += s.length()+p.length()+o.length();
+	}
+	unsigned long long timeCopy = st.stopReal();
+
+	st.reset();
+	for(size_t i=0;i<all.size();i++) {
+		dict->tripleIDtoTripleString(all[i], ts);
+		total -= ts.getSubject().length()+ts.getPredicate().length()+ts.getObject().length();
+	}
+	unsigned long long timeInPlace = st.stopReal();
+	if(total!=0) {
+		cerr << "Error: different total length" << endl;
+		errors++;
+	}
+	cout << all.size() << " triples\tidToString(): " << timeCopy << " us\ttripleIDtoTripleString(): " << timeInPlace << " us" << endl;
+
+	// Consecutive objects, as when listing a range of the dictionary.
+	vector<unsigned int> objects;
+	vector<string> out;
+	string str;
+	unsigned long long timeMany=0, timeOne=0;
+	unsigned int maxObject = dict->getMaxObjectID();
+	for(unsigned int first=1;first<=maxObject;first+=1024) {
+		objects.clear();
+		for(unsigned int id=first;id<first+1024 && id<=maxObject;id++) {
+			objects.push_back(id);
+		}
+
+		st.reset();
+		dict->extractMany(objects, OBJECT, out);
+		timeMany += st.stopReal();
+
+		st.reset();
+		for(size_t i=0;i<objects.size();i++) {
+			dict->extractString(objects[i], OBJECT, str);
+			if(errors<10 && str!=out[i]) {
+				cerr << "Error extractMany object " << objects[i] << endl;
+				errors++;
+			}
+		}
+		timeOne += st.stopReal();
+	}
+	cout << "Object runs\textractString(): " << timeOne << " us\textractMany(): " << timeMany << " us" << endl;
+
+	delete hdt;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+
+	// Sorted strings with shared prefixes and a few long ones.
+	vector<string> strings;
+	for(int i=0;i<5000;i++) {
+		// Literals, as the FM-Index only keeps those.
+		string str = "\"http://example.org/";
+		int len = rand()%10==0 ? 200+rand()%2000 : 1+rand()%30;
+		for(int j=0;j<len;j++) {
+			str += (char)('a'+rand()%(j<3 ? 3 : 26));
+		}
+		strings.push_back(str);
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+	VectorIteratorUCharString itPFC(strings);
+	CSD_PFC *pfc = new CSD_PFC(&itPFC, 8);
+	errors += check("PFC", pfc, strings);
+	errors += checkCursor(pfc, strings);
+	CSD_Cache2 cache(pfc);
+	errors += check("Cache2", &cache, strings);
+
+	VectorIteratorUCharString itHTFC(strings);
+	CSD_HTFC htfc(&itHTFC, 8);
+	errors += check("HTFC", &htfc, strings);
+
+	VectorIteratorUCharString itFM(strings);
+	CSD_FMIndex fm(&itFM);
+	errors += check("FMIndex", &fm, strings);
+
+	if(argc>1) {
+		errors += checkHDT(argv[1]);
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
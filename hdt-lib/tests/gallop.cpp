@@ -0,0 +1,133 @@
+/*
+ * gallop.cpp
+ *
+ * Check findNextOccurrence() of the triple iterators against a linear scan
+ * for all kinds of patterns, and compare the time of both to skip ahead.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+unsigned int getComponent(TripleID &triple, unsigned char component) {
+	switch(component) {
+	case 1:
+		return triple.getSubject();
+	case 2:
+		return triple.getPredicate();
+	default:
+		return triple.getObject();
+	}
+}
+
+/**
+ * Start at random positions of the results of the pattern, skip to random
+ * values of each sortable component and compare with the expected triple.
+ */
+int checkPattern(Triples *triples, TripleID &pattern, unsigned long long *timeSeek, unsigned long long *timeScan) {
+	int errors=0;
+
+	vector<TripleID> results;
+	IteratorTripleID *it = triples->search(pattern);
+	while(it->hasNext()) {
+		results.push_back(*it->next());
+	}
+
+	for(unsigned char component=1; component<=3; component++) {
+		if(!it->canFindNextOccurrence(component) || results.size()==0) {
+			continue;
+		}
+
+		for(int test=0; test<20; test++) {
+			size_t start = rand()%results.size();
+			unsigned int first = getComponent(results[start], component);
+			unsigned int last = getComponent(results[results.size()-1], component);
+			unsigned int value = first + rand()%(last-first+2);
+
+			size_t expected = start;
+			while(expected<results.size() && getComponent(results[expected], component)<value) {
+				expected++;
+			}
+
+			// Linear scan with the iterator
+			it->goToStart();
+			for(size_t i=0;i<start;i++) {
+				it->next();
+			}
+			StopWatch st;
+			while(it->hasNext() && getComponent(*it->next(), component)<value) { }
+			*timeScan += st.stopReal();
+
+			// Skip ahead
+			it->goToStart();
+			for(size_t i=0;i<start;i++) {
+				it->next();
+			}
+			st.reset();
+			bool found = it->findNextOccurrence(value, component);
+			*timeSeek += st.stopReal();
+
+			if(found!=(expected<results.size()) || found!=it->hasNext()) {
+				cerr << "Error: pattern " << pattern << " component " << (int)component << " value " << value << " found " << found << endl;
+				errors++;
+				continue;
+			}
+			if(found) {
+				TripleID *triple = it->next();
+				if(!(*triple==results[expected])) {
+					cerr << "Error: pattern " << pattern << " component " << (int)component << " value " << value << " got " << *triple << " expected " << results[expected] << endl;
+					errors++;
+				}
+			}
+		}
+	}
+	delete it;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	if(argc<2) {
+		cout << "$ gallop <hdtfile>" << endl;
+		return 1;
+	}
+
+	HDT *hdt = HDTManager::mapIndexedHDT(argv[1]);
+	Triples *triples = hdt->getTriples();
+
+	vector<TripleID> all;
+	TripleID any(0,0,0);
+	IteratorTripleID *it = triples->search(any);
+	while(it->hasNext()) {
+		all.push_back(*it->next());
+	}
+	delete it;
+
+	int errors=0;
+	unsigned long long timeSeek=0, timeScan=0;
+
+	TripleID empty(0,0,0);
+	errors += checkPattern(triples, empty, &timeSeek, &timeScan);
+
+	// Every combination of bound components taken from existing triples.
+	for(int i=0;i<200 && all.size()>0;i++) {
+		TripleID &triple = all[((size_t)rand()*7919)%all.size()];
+		for(int mask=1; mask<7; mask++) {
+			TripleID pattern(mask&1 ? triple.getSubject() : 0, mask&2 ? triple.getPredicate() : 0, mask&4 ? triple.getObject() : 0);
+			errors += checkPattern(triples, pattern, &timeSeek, &timeScan);
+		}
+	}
+
+	cout << "Seek: " << timeSeek << " us\tScan: " << timeScan << " us" << endl;
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+
+	delete hdt;
+	return errors;
+}
@@ -0,0 +1,204 @@
+/*
+ * goto.cpp
+ *
+ * Check goTo() of the triple iterators against a linear scan for all kinds
+ * of patterns, and HDT::search() with offset and limit, with the index
+ * generated, then mapped and loaded from the file it was saved to.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+int checkPattern(Triples *triples, TripleID &pattern, unsigned long long *timeGoTo, unsigned long long *timeScan) {
+	int errors=0;
+
+	vector<TripleID> results;
+	IteratorTripleID *it = triples->search(pattern);
+	while(it->hasNext()) {
+		results.push_back(*it->next());
+	}
+
+	if(!it->canGoTo()) {
+		delete it;
+		return 0;
+	}
+
+	for(int test=0; test<20 && results.size()>0; test++) {
+		size_t pos = test==0 ? results.size()-1 : rand()%results.size();
+
+		StopWatch st;
+		it->goToStart();
+		for(size_t i=0;i<pos;i++) {
+			it->next();
+		}
+		*timeScan += st.stopReal();
+
+		st.reset();
+		it->goTo(pos);
+		*timeGoTo += st.stopReal();
+
+		if(!it->hasNext()) {
+			cerr << "Error: pattern " << pattern << " goTo " << pos << " has no next" << endl;
+			errors++;
+			continue;
+		}
+		// Compare the rest of the results, up to a few
+		for(size_t i=pos; i<results.size() && i<pos+3; i++) {
+			TripleID *triple = it->next();
+			if(!(*triple==results[i])) {
+				cerr << "Error: pattern " << pattern << " goTo " << pos << " got " << *triple << " expected " << results[i] << endl;
+				errors++;
+				break;
+			}
+		}
+	}
+
+	bool thrown = false;
+	try {
+		it->goTo(results.size());
+	} catch (const char *e) {
+		thrown = true;
+	}
+	if(!thrown) {
+		cerr << "Error: pattern " << pattern << " goTo beyond the end" << endl;
+		errors++;
+	}
+
+	delete it;
+	return errors;
+}
+
+string tripleToString(TripleString *triple) {
+	return triple->getSubject()+" "+triple->getPredicate()+" "+triple->getObject();
+}
+
+int checkLimit(HDT *hdt, const char *subject, const char *predicate, const char *object) {
+	vector<string> results;
+	IteratorTripleString *it = hdt->search(subject, predicate, object);
+	while(it->hasNext()) {
+		results.push_back(tripleToString(it->next()));
+	}
+	delete it;
+
+	int errors=0;
+	unsigned int offsets[] = { 0, 1, results.size()/2, results.size(), results.size()+5 };
+	unsigned int limits[] = { 0, 1, 10 };
+	for(int i=0;i<5;i++) {
+		for(int j=0;j<3;j++) {
+			it = hdt->search(subject, predicate, object, offsets[i], limits[j]);
+			size_t pos = offsets[i];
+			while(it->hasNext()) {
+				string triple = tripleToString(it->next());
+				if(pos>=results.size() || triple!=results[pos]) {
+					cerr << "Error: search offset " << offsets[i] << " limit " << limits[j] << " got " << triple << endl;
+					errors++;
+					break;
+				}
+				pos++;
+			}
+			size_t expected = offsets[i]>=results.size() ? 0 : results.size()-offsets[i];
+			if(limits[j]!=0 && expected>limits[j]) {
+				expected = limits[j];
+			}
+			if(errors==0 && pos-offsets[i]!=expected) {
+				cerr << "Error: search offset " << offsets[i] << " limit " << limits[j] << " returned " << pos-offsets[i] << " expected " << expected << endl;
+				errors++;
+			}
+			delete it;
+		}
+	}
+	return errors;
+}
+
+int checkHDT(const char *name, HDT *hdt) {
+	Triples *triples = hdt->getTriples();
+
+	vector<TripleID> all;
+	TripleID any(0,0,0);
+	IteratorTripleID *it = triples->search(any);
+	while(it->hasNext()) {
+		all.push_back(*it->next());
+	}
+	delete it;
+
+	int errors=0;
+	unsigned long long timeGoTo=0, timeScan=0;
+
+	TripleID empty(0,0,0);
+	errors += checkPattern(triples, empty, &timeGoTo, &timeScan);
+
+	// Every combination of bound components taken from existing triples.
+	for(int i=0;i<200 && all.size()>0;i++) {
+		TripleID &triple = all[((size_t)rand()*7919)%all.size()];
+		for(int mask=1; mask<7; mask++) {
+			TripleID pattern(mask&1 ? triple.getSubject() : 0, mask&2 ? triple.getPredicate() : 0, mask&4 ? triple.getObject() : 0);
+			errors += checkPattern(triples, pattern, &timeGoTo, &timeScan);
+		}
+	}
+
+	// The index has the predicate offsets, so ?P? seeks without modifying the triples.
+	if(all.size()>0) {
+		TripleID pattern(0, all[0].getPredicate(), 0);
+		IteratorTripleID *predIt = triples->search(pattern);
+		if(!predIt->canGoTo()) {
+			cerr << "Error: ?P? cannot goTo on an indexed HDT " << name << endl;
+			errors++;
+		}
+		delete predIt;
+	}
+
+	// Offset and limit on strings
+	Dictionary *dict = hdt->getDictionary();
+	for(int i=0;i<20 && all.size()>0;i++) {
+		TripleID &triple = all[((size_t)rand()*7919)%all.size()];
+		string subject = dict->idToString(triple.getSubject(), SUBJECT);
+		string predicate = dict->idToString(triple.getPredicate(), PREDICATE);
+		string object = dict->idToString(triple.getObject(), OBJECT);
+		errors += checkLimit(hdt, "", predicate.c_str(), "");
+		errors += checkLimit(hdt, "", "", object.c_str());
+		errors += checkLimit(hdt, subject.c_str(), "", object.c_str());
+		errors += checkLimit(hdt, subject.c_str(), "", "");
+	}
+	errors += checkLimit(hdt, "", "", "");
+
+	cout << name << "\tGoTo: " << timeGoTo << " us\tScan: " << timeScan << " us" << endl;
+	delete hdt;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	if(argc<2) {
+		cout << "$ goto <hdtfile>" << endl;
+		return 1;
+	}
+
+	// A copy without index, so that it is generated and saved with the predicate offsets.
+	string copy = "goto.hdt";
+	{
+		ifstream in(argv[1], ios::binary);
+		ofstream out(copy.c_str(), ios::binary);
+		out << in.rdbuf();
+	}
+	remove((copy+".index").c_str());
+
+	int errors=0;
+	errors += checkHDT("generated", HDTManager::mapIndexedHDT(copy.c_str()));
+	errors += checkHDT("mapped", HDTManager::mapIndexedHDT(copy.c_str()));
+	errors += checkHDT("loaded", HDTManager::loadIndexedHDT(copy.c_str()));
+
+	remove(copy.c_str());
+	remove((copy+".index").c_str());
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
@@ -0,0 +1,188 @@
+/*
+ * hashindex.cpp
+ *
+ * Check MPHIndex::locate() against the IDs of the strings of a PFC, for
+ * strings that are not there, and after saving and loading it from a stream
+ * and from memory. With an HDT file, also check stringToId() with the hash
+ * index of the FourSectionDictionary against the one without it for all the
+ * roles, also with stringToIds(), and compare their times.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_PFC.h"
+#include "../src/libdcs/MPHIndex.h"
+#include "../src/dictionary/FourSectionDictionary.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+int checkIndex(const char *name, MPHIndex &index, CSD *pfc, vector<string> &strings) {
+	int errors=0;
+	for(size_t i=0;i<strings.size() && errors<10;i++) {
+		uint32_t id = index.locate(pfc, (const unsigned char *)strings[i].c_str(), strings[i].length());
+		if(id!=i+1) {
+			cerr << "Error " << name << " locate(" << strings[i] << ")=" << id << " expected " << i+1 << endl;
+			errors++;
+		}
+		string other = strings[i]+"a";
+		if(!binary_search(strings.begin(), strings.end(), other) && index.locate(pfc, (const unsigned char *)other.c_str(), other.length())!=0) {
+			cerr << "Error " << name << " found " << other << endl;
+			errors++;
+		}
+	}
+	if(index.locate(pfc, (const unsigned char *)"", 0)!=0) {
+		cerr << "Error " << name << " found the empty string" << endl;
+		errors++;
+	}
+	return errors;
+}
+
+int checkPFC(vector<string> &strings) {
+	VectorIteratorUCharString it(strings);
+	CSD_PFC pfc(&it, 16);
+
+	MPHIndex index;
+	index.build(&pfc);
+	int errors = checkIndex("built", index, &pfc, strings);
+	if(index.getLength()!=strings.size()) {
+		cerr << "Error length " << index.getLength() << endl;
+		errors++;
+	}
+
+	stringstream stream;
+	index.save(stream);
+	string data = stream.str();
+
+	MPHIndex loaded;
+	loaded.load(stream);
+	errors += checkIndex("loaded", loaded, &pfc, strings);
+
+	MPHIndex mapped;
+	size_t count = mapped.load((unsigned char *)&data[0], (unsigned char *)&data[0]+data.size());
+	if(count!=data.size()) {
+		cerr << "Error mapped " << count << " bytes of " << data.size() << endl;
+		errors++;
+	}
+	errors += checkIndex("mapped", mapped, &pfc, strings);
+
+	cout << strings.size() << " strings\t" << index.size() << " bytes" << endl;
+	return errors;
+}
+
+int checkRole(FourSectionDictionary *dict, TripleComponentRole role, unsigned int maxId, vector<unsigned int> &expected, vector<string> &strs, bool build) {
+	if(build) {
+		for(unsigned int id=1; id<=maxId; id++) {
+			if(rand()%4==0) {
+				strs.push_back(dict->idToString(id, role));
+				if(rand()%10==0) {
+					strs.push_back(strs.back()+"x");
+				}
+			}
+		}
+		random_shuffle(strs.begin(), strs.end());
+		expected.resize(strs.size());
+	}
+
+	StopWatch st;
+	int errors=0;
+	for(size_t i=0;i<strs.size();i++) {
+		unsigned int id = dict->stringToId(strs[i], role);
+		if(build) {
+			expected[i] = id;
+		} else if(id!=expected[i] && errors<10) {
+			cerr << "Error stringToId(" << strs[i] << ", " << role << ")=" << id << " expected " << expected[i] << endl;
+			errors++;
+		}
+	}
+	unsigned long long timeSingle = st.stopReal();
+
+	// The batch lookup uses the hash index too.
+	st.reset();
+	vector<unsigned int> ids;
+	dict->stringToIds(strs, role, ids);
+	unsigned long long timeBatch = st.stopReal();
+	for(size_t i=0;i<strs.size() && errors<10;i++) {
+		if(ids[i]!=expected[i]) {
+			cerr << "Error stringToIds(" << strs[i] << ", " << role << ")=" << ids[i] << " expected " << expected[i] << endl;
+			errors++;
+		}
+	}
+	cout << "Role " << role << "\t" << strs.size() << " strings\t" << (dict->hasHashIndex() ? "hash: " : "search: ") << timeSingle
+			<< " us\tstringToIds(): " << timeBatch << " us" << endl;
+	return errors;
+}
+
+int checkHDT(const char *file) {
+	HDT *hdt = HDTManager::mapHDT(file);
+	FourSectionDictionary *dict = dynamic_cast<FourSectionDictionary *>(hdt->getDictionary());
+	if(dict==NULL) {
+		delete hdt;
+		return 0;
+	}
+
+	TripleComponentRole roles[] = { SUBJECT, PREDICATE, OBJECT };
+	unsigned int maxIds[] = { dict->getMaxSubjectID(), dict->getMaxPredicateID(), dict->getMaxObjectID() };
+	vector<unsigned int> expected[3];
+	vector<string> strs[3];
+
+	int errors=0;
+	for(int r=0;r<3;r++) {
+		errors += checkRole(dict, roles[r], maxIds[r], expected[r], strs[r], true);
+	}
+
+	dict->generateHashIndex();
+	for(int r=0;r<3;r++) {
+		errors += checkRole(dict, roles[r], maxIds[r], expected[r], strs[r], false);
+	}
+
+	stringstream stream;
+	ControlInformation ci;
+	dict->saveHashIndex(stream, ci);
+	ci.load(stream);
+	dict->loadHashIndex(stream, ci);
+	for(int r=0;r<3;r++) {
+		errors += checkRole(dict, roles[r], maxIds[r], expected[r], strs[r], false);
+	}
+
+	delete hdt;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+
+	vector<string> strings;
+	for(int i=0;i<50000;i++) {
+		string str = "http://example.org/";
+		int len = 1+rand()%(i%100==0 ? 400 : 20);
+		for(int j=0;j<len;j++) {
+			str += (char)('a'+rand()%(j<2 ? 2 : 26));
+		}
+		strings.push_back(str);
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+	size_t sizes[] = { 1, 2, 3, 100, strings.size() };
+	for(int i=0;i<5;i++) {
+		vector<string> some(strings.begin(), strings.begin()+sizes[i]);
+		errors += checkPFC(some);
+	}
+
+	if(argc>1) {
+		errors += checkHDT(argv[1]);
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
@@ -0,0 +1,227 @@
+/*
+ * literalrange.cpp
+ *
+ * Check LiteralRangeIndex: parsing of typed literals, ranges against a scan of
+ * the dictionary, save/load with the HDT, and range filters in QueryProcessor
+ * with and without the index. A stale index of another HDT is removed on save
+ * and rejected on load.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include "../src/hdt/BasicHDT.hpp"
+#include "../src/sparql/QueryProcessor.hpp"
+
+using namespace hdt;
+using namespace std;
+
+static const string XSD = "http://www.w3.org/2001/XMLSchema#";
+
+int checkParse(const string &literal, bool valid, LiteralValueType expectedType, double expected) {
+	LiteralValueType type;
+	double value;
+	bool parsed = LiteralRangeIndex::parseValue(literal, &type, &value);
+	if(parsed!=valid || (valid && (type!=expectedType || value!=expected))) {
+		cerr << "Error parsing " << literal << endl;
+		return 1;
+	}
+	return 0;
+}
+
+/** Object IDs of the literals of the type in the interval, scanning the dictionary */
+void scan(Dictionary *dict, LiteralValueType type, double low, double high, vector<unsigned int> &out) {
+	out.clear();
+	for(unsigned int id=dict->getNshared()+1; id<=dict->getMaxObjectID(); id++) {
+		LiteralValueType t;
+		double value;
+		if(LiteralRangeIndex::parseValue(dict->idToString(id, OBJECT), &t, &value) && t==type && value>=low && value<high) {
+			out.push_back(id);
+		}
+	}
+}
+
+int checkIndex(HDT *hdt, LiteralRangeIndex *index) {
+	if(index==NULL) {
+		cerr << "Error: no literal range index" << endl;
+		return 1;
+	}
+	int errors=0;
+	double numericBounds[][2] = { {10, 100}, {-5, 5}, {0.5, 2.5}, {1000, 1e9}, {50, 50} };
+	double dateBounds[][2] = { {0, 86400*365.0}, {-1e10, 0}, {946684800, 1e10} };
+	vector<unsigned int> expected, ids;
+	for(int i=0;i<5;i++) {
+		scan(hdt->getDictionary(), LITERAL_NUMERIC, numericBounds[i][0], numericBounds[i][1], expected);
+		index->getObjectIDs(LITERAL_NUMERIC, numericBounds[i][0], true, numericBounds[i][1], false, ids);
+		if(ids!=expected) {
+			cerr << "Error: numeric range [" << numericBounds[i][0] << "," << numericBounds[i][1] << ") has " << ids.size() << " expected " << expected.size() << endl;
+			errors++;
+		}
+	}
+	for(int i=0;i<3;i++) {
+		scan(hdt->getDictionary(), LITERAL_DATETIME, dateBounds[i][0], dateBounds[i][1], expected);
+		index->getObjectIDs(LITERAL_DATETIME, dateBounds[i][0], true, dateBounds[i][1], false, ids);
+		if(ids!=expected) {
+			cerr << "Error: date range has " << ids.size() << " expected " << expected.size() << endl;
+			errors++;
+		}
+	}
+	return errors;
+}
+
+int countQuery(QueryProcessor &processor, LiteralRangeFilter &filter) {
+	vector<TripleString> patterns;
+	patterns.push_back(TripleString("?s", "http://example.org/value", "?v"));
+	set<string> vars;
+	vector<LiteralRangeFilter> filters(1, filter);
+	VarBindingString *binding = processor.searchJoin(patterns, vars, filters);
+	int count=0;
+	while(binding->findNext()) {
+		count++;
+	}
+	delete binding;
+	return count;
+}
+
+int countQuery(HDT *hdt, LiteralRangeFilter &filter) {
+	QueryProcessor processor(hdt);
+	return countQuery(processor, filter);
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+
+	errors += checkParse("\"42\"^^<"+XSD+"integer>", true, LITERAL_NUMERIC, 42);
+	errors += checkParse("\"-1.5e2\"^^<"+XSD+"double>", true, LITERAL_NUMERIC, -150);
+	errors += checkParse("\"3.25\"^^<"+XSD+"decimal>", true, LITERAL_NUMERIC, 3.25);
+	errors += checkParse("\"12abc\"^^<"+XSD+"integer>", false, LITERAL_NUMERIC, 0);
+	errors += checkParse("\"NaN\"^^<"+XSD+"double>", false, LITERAL_NUMERIC, 0);
+	errors += checkParse("\"42\"", false, LITERAL_NUMERIC, 0);
+	errors += checkParse("\"42\"@en", false, LITERAL_NUMERIC, 0);
+	errors += checkParse("\"42\"^^<http://example.org/type>", false, LITERAL_NUMERIC, 0);
+	errors += checkParse("\"1970-01-02T00:00:00Z\"^^<"+XSD+"dateTime>", true, LITERAL_DATETIME, 86400);
+	errors += checkParse("\"1970-01-01T02:00:00+02:00\"^^<"+XSD+"dateTime>", true, LITERAL_DATETIME, 0);
+	errors += checkParse("\"2000-03-01T00:00:00.5\"^^<"+XSD+"dateTime>", true, LITERAL_DATETIME, 951868800.5);
+	errors += checkParse("\"1969-12-31\"^^<"+XSD+"date>", true, LITERAL_DATETIME, -86400);
+	errors += checkParse("\"2000-13-01\"^^<"+XSD+"date>", false, LITERAL_DATETIME, 0);
+
+	// Dataset with integers, decimals, dates and other literals.
+	const char *rdfFile = "literalrange.nt";
+	const char *hdtFile = "literalrange.hdt";
+	ofstream out(rdfFile);
+	for(int i=0;i<3000;i++) {
+		out << "<http://example.org/s" << i << "> <http://example.org/value> ";
+		switch(i%5) {
+		case 0:
+			out << "\"" << (rand()%2000)-500 << "\"^^<" << XSD << "integer> .\n";
+			break;
+		case 1:
+			out << "\"" << (rand()%10000)/100.0 << "\"^^<" << XSD << "decimal> .\n";
+			break;
+		case 2:
+			out << "\"" << 1950+rand()%80 << "-0" << 1+rand()%9 << "-1" << rand()%10 << "T1" << rand()%10 << ":00:00Z\"^^<" << XSD << "dateTime> .\n";
+			break;
+		case 3:
+			out << "\"" << rand()%100 << "\" .\n";
+			break;
+		default:
+			out << "<http://example.org/o" << rand()%100 << "> .\n";
+		}
+	}
+	out.close();
+
+	HDTSpecification spec;
+	spec.setOptions("literals.rangeindex:true");
+	BasicHDT *hdt = dynamic_cast<BasicHDT *>(HDTManager::generateHDT(rdfFile, "http://example.org", NTRIPLES, spec));
+	errors += checkIndex(hdt, hdt->getLiteralRangeIndex());
+	hdt->saveToHDT(hdtFile);
+
+	LiteralRangeFilter filter;
+	filter.var = "?v";
+	filter.type = LITERAL_NUMERIC;
+	filter.low = 10;
+	filter.lowInclusive = false;
+	filter.high = 100;
+	filter.highInclusive = false;
+	int withIndex = countQuery(hdt, filter);
+	delete hdt;
+
+	// Loaded with the other indexes
+	BasicHDT *loaded = dynamic_cast<BasicHDT *>(HDTManager::mapIndexedHDT(hdtFile));
+	errors += checkIndex(loaded, loaded->getLiteralRangeIndex());
+
+	// A processor created before the index is regenerated uses the new one.
+	QueryProcessor processor(loaded);
+	loaded->generateLiteralRangeIndex();
+	int regenerated = countQuery(processor, filter);
+	if(regenerated!=withIndex) {
+		cerr << "Error: filter returned " << regenerated << " after regenerating the index, expected " << withIndex << endl;
+		errors++;
+	}
+	delete loaded;
+
+	// Without index the filter parses the literals.
+	HDT *plain = HDTManager::mapHDT(hdtFile);
+	int withoutIndex = countQuery(plain, filter);
+	int expected = 0;
+	IteratorTripleString *it = plain->search("", "http://example.org/value", "");
+	while(it->hasNext()) {
+		LiteralValueType type;
+		double value;
+		if(LiteralRangeIndex::parseValue(it->next()->getObject(), &type, &value) && type==LITERAL_NUMERIC && value>10 && value<100) {
+			expected++;
+		}
+	}
+	delete it;
+	delete plain;
+	if(withIndex!=withoutIndex || withIndex==0 || withIndex!=expected) {
+		cerr << "Error: filter returned " << withIndex << " with index, " << withoutIndex << " without, expected " << expected << endl;
+		errors++;
+	}
+
+	// Another HDT saved with the same name removes the index, and rejects a stale one.
+	string literalsFile = string(hdtFile)+".literals";
+	string stale;
+	{
+		ifstream in(literalsFile.c_str(), ios::binary);
+		stale.assign((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+	}
+	ofstream small(rdfFile);
+	small << "<http://example.org/s> <http://example.org/value> \"1\"^^<" << XSD << "integer> .\n";
+	small.close();
+	HDTSpecification noIndex;
+	HDT *other = HDTManager::generateHDT(rdfFile, "http://example.org", NTRIPLES, noIndex);
+	other->saveToHDT(hdtFile);
+	delete other;
+	if(ifstream(literalsFile.c_str()).good()) {
+		cerr << "Error: the index of the previous HDT was not removed" << endl;
+		errors++;
+	}
+	{
+		ofstream restore(literalsFile.c_str(), ios::binary);
+		restore << stale;
+	}
+	try {
+		HDT *mismatch = HDTManager::mapIndexedHDT(hdtFile);
+		cerr << "Error: loaded the literal range index of another HDT" << endl;
+		errors++;
+		delete mismatch;
+	} catch (const char *e) {
+	}
+
+	remove(rdfFile);
+	remove(hdtFile);
+	remove((string(hdtFile)+".index").c_str());
+	remove(literalsFile.c_str());
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
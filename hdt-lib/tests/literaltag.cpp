@@ -0,0 +1,241 @@
+/*
+ * literaltag.cpp
+ *
+ * Check LiteralTagIndex: parsing of the tags, the objects of each language
+ * and datatype against a scan of the dictionary, save/load with the HDT, and
+ * language and datatype filters in QueryProcessor with and without the index.
+ * A stale index of another HDT is removed on save and rejected on load.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <iterator>
+
+#include "../src/hdt/BasicHDT.hpp"
+#include "../src/sparql/QueryProcessor.hpp"
+
+using namespace hdt;
+using namespace std;
+
+static const string XSD = "http://www.w3.org/2001/XMLSchema#";
+
+int checkParse(const string &literal, bool valid, const string &expected) {
+	string tag;
+	bool parsed = LiteralTagIndex::parseTag(literal, tag);
+	if(parsed!=valid || (valid && tag!=expected)) {
+		cerr << "Error parsing " << literal << endl;
+		return 1;
+	}
+	return 0;
+}
+
+/** Object IDs whose tag gives the datatype or language, scanning the dictionary */
+void scan(Dictionary *dict, bool language, const string &value, vector<unsigned int> &out) {
+	out.clear();
+	string tag;
+	for(unsigned int id=1; id<=dict->getMaxObjectID(); id++) {
+		if(!LiteralTagIndex::parseTag(dict->idToString(id, OBJECT), tag)) {
+			continue;
+		}
+		if(language ? tag=="@"+value : LiteralTagIndex::getDatatypeOfTag(tag)==value) {
+			out.push_back(id);
+		}
+	}
+}
+
+int checkIndex(HDT *hdt, LiteralTagIndex *index) {
+	if(index==NULL) {
+		cerr << "Error: no literal tag index" << endl;
+		return 1;
+	}
+	int errors=0;
+	Dictionary *dict = hdt->getDictionary();
+
+	// Each object against its string.
+	string tag;
+	for(unsigned int id=1; id<=dict->getMaxObjectID(); id++) {
+		string str = dict->idToString(id, OBJECT);
+		bool literal = LiteralTagIndex::parseTag(str, tag);
+		if(index->isLiteral(id)!=literal || (literal && index->getDatatype(id)!=LiteralTagIndex::getDatatypeOfTag(tag))
+				|| index->getLanguage(id)!=(literal && tag[0]=='@' ? tag.substr(1) : "")) {
+			cerr << "Error: tag of " << str << endl;
+			errors++;
+		}
+	}
+
+	const char *languages[] = { "en", "es", "en-GB", "fr", NULL };
+	const string datatypes[] = { "<"+XSD+"integer>", "<"+XSD+"string>", "<http://example.org/type>",
+			"<http://www.w3.org/1999/02/22-rdf-syntax-ns#langString>", "<"+XSD+"date>", "" };
+	vector<unsigned int> expected, ids;
+	for(int i=0; languages[i]; i++) {
+		scan(dict, true, languages[i], expected);
+		index->getObjectIDsByLanguage(languages[i], ids);
+		if(ids!=expected) {
+			cerr << "Error: language " << languages[i] << " has " << ids.size() << " expected " << expected.size() << endl;
+			errors++;
+		}
+	}
+	for(int i=0; datatypes[i]!=""; i++) {
+		scan(dict, false, datatypes[i], expected);
+		index->getObjectIDsByDatatype(datatypes[i], ids);
+		if(ids!=expected) {
+			cerr << "Error: datatype " << datatypes[i] << " has " << ids.size() << " expected " << expected.size() << endl;
+			errors++;
+		}
+	}
+
+	// select() and count() of each code.
+	for(unsigned int code=0; code<index->getNumberOfCodes(); code++) {
+		index->getObjectIDs(code, ids);
+		size_t count = 0;
+		for(unsigned int id=dict->getNshared()+1; id<=dict->getMaxObjectID(); id++) {
+			if(index->getCode(id)==code) {
+				if(count>=ids.size() || ids[count]!=id) {
+					break;
+				}
+				count++;
+			}
+		}
+		if(count!=ids.size() || count!=index->count(code) || (count>0 && index->select(code, count)!=ids.back())) {
+			cerr << "Error: code " << code << " (" << index->getTag(code) << ") has " << ids.size() << " objects" << endl;
+			errors++;
+		}
+	}
+	return errors;
+}
+
+int countQuery(HDT *hdt, LiteralTagFilter &filter) {
+	QueryProcessor processor(hdt);
+	vector<TripleString> patterns;
+	patterns.push_back(TripleString("?s", "http://example.org/label", "?v"));
+	set<string> vars;
+	vector<LiteralRangeFilter> filters;
+	vector<LiteralTagFilter> tagFilters(1, filter);
+	VarBindingString *binding = processor.searchJoin(patterns, vars, filters, tagFilters);
+	int count=0;
+	while(binding->findNext()) {
+		count++;
+	}
+	delete binding;
+	return count;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+
+	errors += checkParse("\"foo\"", true, "");
+	errors += checkParse("\"foo\"@en", true, "@en");
+	errors += checkParse("\"say \"hi\"\"@en-GB", true, "@en-GB");
+	errors += checkParse("\"12\"^^<"+XSD+"int>", true, "<"+XSD+"int>");
+	errors += checkParse("\"\"", true, "");
+	errors += checkParse("<http://example.org/a>", false, "");
+	errors += checkParse("_:b1", false, "");
+	errors += checkParse("\"", false, "");
+
+	// Dataset with languages, datatypes, simple literals and IRIs.
+	const char *rdfFile = "literaltag.nt";
+	const char *hdtFile = "literaltag.hdt";
+	const char *languages[] = { "en", "es", "en-GB", "de" };
+	ofstream out(rdfFile);
+	for(int i=0;i<3000;i++) {
+		out << "<http://example.org/s" << i << "> <http://example.org/label> ";
+		switch(i%6) {
+		case 0:
+		case 1:
+			out << "\"label " << rand()%1000 << "\"@" << languages[rand()%4] << " .\n";
+			break;
+		case 2:
+			out << "\"" << rand()%1000 << "\"^^<" << XSD << "integer> .\n";
+			break;
+		case 3:
+			out << "\"" << rand()%1000 << "\"" << (rand()%2 ? "^^<"+XSD+"string>" : "") << " .\n";
+			break;
+		case 4:
+			out << "\"v" << rand()%100 << "\"^^<http://example.org/type> .\n";
+			break;
+		default:
+			out << "<http://example.org/s" << rand()%100 << "> .\n";
+		}
+	}
+	out.close();
+
+	HDTSpecification spec;
+	spec.setOptions("literals.tagindex:true");
+	BasicHDT *hdt = dynamic_cast<BasicHDT *>(HDTManager::generateHDT(rdfFile, "http://example.org", NTRIPLES, spec));
+	errors += checkIndex(hdt, hdt->getLiteralTagIndex());
+	hdt->saveToHDT(hdtFile);
+
+	LiteralTagFilter filters[3];
+	filters[0].var = filters[1].var = filters[2].var = "?v";
+	filters[0].type = TAG_LANGUAGE;
+	filters[0].value = "en";
+	filters[1].type = TAG_DATATYPE;
+	filters[1].value = "<"+XSD+"string>";
+	filters[2].type = TAG_IS_LITERAL;
+	int withIndex[3];
+	for(int i=0;i<3;i++) {
+		withIndex[i] = countQuery(hdt, filters[i]);
+	}
+	cout << "Index\t" << hdt->getLiteralTagIndex()->getNumberOfCodes() << " codes\t" << hdt->getLiteralTagIndex()->size() << " bytes" << endl;
+	delete hdt;
+
+	// Loaded with the other indexes
+	BasicHDT *loaded = dynamic_cast<BasicHDT *>(HDTManager::mapIndexedHDT(hdtFile));
+	errors += checkIndex(loaded, loaded->getLiteralTagIndex());
+	delete loaded;
+
+	// Without index the filters parse the literals.
+	HDT *plain = HDTManager::mapHDT(hdtFile);
+	for(int i=0;i<3;i++) {
+		int withoutIndex = countQuery(plain, filters[i]);
+		if(withIndex[i]!=withoutIndex || withIndex[i]==0) {
+			cerr << "Error: filter " << i << " returned " << withIndex[i] << " with index, " << withoutIndex << " without" << endl;
+			errors++;
+		}
+	}
+	delete plain;
+
+	// Another HDT saved with the same name removes the index, and rejects a stale one.
+	string tagsFile = string(hdtFile)+".tags";
+	string stale;
+	{
+		ifstream in(tagsFile.c_str(), ios::binary);
+		stale.assign((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+	}
+	ofstream small(rdfFile);
+	small << "<http://example.org/s> <http://example.org/label> \"label\"@en .\n";
+	small.close();
+	HDTSpecification noIndex;
+	HDT *other = HDTManager::generateHDT(rdfFile, "http://example.org", NTRIPLES, noIndex);
+	other->saveToHDT(hdtFile);
+	delete other;
+	if(ifstream(tagsFile.c_str()).good()) {
+		cerr << "Error: the index of the previous HDT was not removed" << endl;
+		errors++;
+	}
+	{
+		ofstream restore(tagsFile.c_str(), ios::binary);
+		restore << stale;
+	}
+	try {
+		HDT *mismatch = HDTManager::mapIndexedHDT(hdtFile);
+		cerr << "Error: loaded the literal tag index of another HDT" << endl;
+		errors++;
+		delete mismatch;
+	} catch (const char *e) {
+	}
+
+	remove(rdfFile);
+	remove(hdtFile);
+	remove((string(hdtFile)+".index").c_str());
+	remove(tagsFile.c_str());
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
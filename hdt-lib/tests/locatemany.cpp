@@ -0,0 +1,151 @@
+/*
+ * locatemany.cpp
+ *
+ * Check CSD_PFC::locateMany() against locate() with existing, missing,
+ * repeated and empty strings in random and sorted order, and skipping the
+ * entries that already have an ID. With an HDT file, also check
+ * Dictionary::stringToIds() against stringToId() for all the roles, with the
+ * strings in ID order and shuffled, and compare their times.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_PFC.h"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+int checkPFC(vector<string> &strings, uint32_t blocksize) {
+	VectorIteratorUCharString it(strings);
+	CSD_PFC pfc(&it, blocksize);
+
+	// Existing strings, and strings around them that do not exist.
+	vector<string> queries;
+	for(size_t i=0;i<strings.size();i++) {
+		if(rand()%3==0) {
+			queries.push_back(strings[i]);
+		}
+		if(rand()%5==0) {
+			queries.push_back(strings[i]+"a");
+			queries.push_back(strings[i].substr(0, strings[i].length()-1));
+		}
+	}
+	queries.push_back("");
+	queries.push_back("!");
+	queries.push_back("~~~~");
+	queries.push_back(strings[0]);
+	queries.push_back(strings[0]);
+	queries.push_back(strings.back());
+	random_shuffle(queries.begin(), queries.end());
+
+	// Shuffled, and then sorted with every other string skipped.
+	int errors=0;
+	for(int round=0; round<2; round++) {
+		vector<uint32_t> ids;
+		if(round==1) {
+			sort(queries.begin(), queries.end());
+			ids.assign(queries.size(), 0);
+			for(size_t i=0;i<ids.size();i+=2) {
+				ids[i] = 12345;
+			}
+		}
+		pfc.locateMany(queries, ids);
+		for(size_t i=0;i<queries.size() && errors<10;i++) {
+			uint32_t expected = round==1 && i%2==0 ? 12345 : pfc.locate((const unsigned char *)queries[i].c_str(), queries[i].length());
+			if(ids.size()!=queries.size() || ids[i]!=expected) {
+				cerr << "Error blocksize " << blocksize << " locateMany(" << queries[i] << ")=" << ids[i] << " expected " << expected << endl;
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+int checkRole(Dictionary *dict, TripleComponentRole role, unsigned int maxId) {
+	// Strings of the role, some of them twice and some that do not exist.
+	vector<string> strs;
+	for(unsigned int id=1; id<=maxId; id++) {
+		if(rand()%4==0) {
+			strs.push_back(dict->idToString(id, role));
+			if(rand()%10==0) {
+				strs.push_back(strs.back()+"x");
+				strs.push_back(strs[rand()%strs.size()]);
+			}
+		}
+	}
+
+	// In ID order, as when merging dictionaries, and shuffled.
+	int errors=0;
+	for(int round=0; round<2; round++) {
+		if(round==1) {
+			random_shuffle(strs.begin(), strs.end());
+		}
+
+		// Best of three
+		unsigned long long timeOne=0, timeMany=0;
+		vector<unsigned int> expected(strs.size()), ids;
+		for(int rep=0; rep<3; rep++) {
+			StopWatch st;
+			for(size_t i=0;i<strs.size();i++) {
+				expected[i] = dict->stringToId(strs[i], role);
+			}
+			unsigned long long time = st.stopReal();
+			timeOne = rep==0 || time<timeOne ? time : timeOne;
+
+			st.reset();
+			dict->stringToIds(strs, role, ids);
+			time = st.stopReal();
+			timeMany = rep==0 || time<timeMany ? time : timeMany;
+		}
+
+		cout << "Role " << role << (round==0 ? " in order" : " shuffled") << "\t" << strs.size() << " strings\tstringToId(): "
+				<< timeOne << " us\tstringToIds(): " << timeMany << " us" << endl;
+
+		if(ids!=expected) {
+			cerr << "Error stringToIds() of role " << role << endl;
+			errors++;
+		}
+	}
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+
+	vector<string> strings;
+	for(int i=0;i<20000;i++) {
+		string str = "http://example.org/";
+		int len = 1+rand()%20;
+		for(int j=0;j<len;j++) {
+			str += (char)('a'+rand()%(j<2 ? 2 : 26));
+		}
+		strings.push_back(str);
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+	uint32_t blocksizes[] = { 1, 2, 16, 128 };
+	for(int i=0;i<4;i++) {
+		errors += checkPFC(strings, blocksizes[i]);
+	}
+
+	if(argc>1) {
+		HDT *hdt = HDTManager::mapHDT(argv[1]);
+		Dictionary *dict = hdt->getDictionary();
+		errors += checkRole(dict, SUBJECT, dict->getMaxSubjectID());
+		errors += checkRole(dict, PREDICATE, dict->getMaxPredicateID());
+		errors += checkRole(dict, OBJECT, dict->getMaxObjectID());
+		delete hdt;
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
@@ -0,0 +1,84 @@
+/*
+ * logdecode.cpp
+ *
+ * Check LogSequence2::decode() against get() for every bit width, and
+ * compare the scan speed of get() through IntSequence, as the triple
+ * iterators used to read, with SequenceBuffer and with decode().
+ */
+
+#include <stdlib.h>
+#include <iostream>
+
+#include "../src/sequence/LogSequence2.hpp"
+#include "../src/sequence/IntSequence.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+int main(int argc, char **argv) {
+	size_t num = 1000000;
+	unsigned int *out = new unsigned int[num];
+	int errors = 0;
+
+	for(unsigned int numbits=1; numbits<=32; numbits++) {
+		LogSequence2 arr(numbits, num);
+		size_t max = maxVal(numbits);
+		for(size_t i=0;i<num;i++) {
+			arr.push_back(((size_t)rand()*7919+i) & max);
+		}
+
+		// Unaligned starts and partial reads at the end.
+		size_t starts[] = { 0, 1, 63, 64, 1001, num-5 };
+		for(size_t s=0; s<sizeof(starts)/sizeof(size_t); s++) {
+			size_t count = arr.decode(starts[s], 1000, out);
+			for(size_t i=0;i<count;i++) {
+				if(out[i]!=arr.get(starts[s]+i)) {
+					cerr << "Error: bits=" << numbits << " pos=" << starts[s]+i << endl;
+					errors++;
+					break;
+				}
+			}
+		}
+
+		// Touch the output first, so that decode() is not timed with the page faults.
+		arr.decode(0, num, out);
+
+		// Through a volatile pointer, so that get() stays a virtual call as in the iterators.
+		IntSequence * volatile sequence = &arr;
+		IntSequence *seq = sequence;
+		StopWatch st;
+		size_t sum1=0;
+		for(size_t i=0;i<num;i++) {
+			sum1 += seq->get(i);
+		}
+		unsigned long long timeGet = st.stopReal();
+
+		st.reset();
+		size_t sum2=0;
+		SequenceBuffer buffer(seq);
+		for(size_t i=0;i<num;i++) {
+			sum2 += buffer.get(i);
+		}
+		unsigned long long timeBuffer = st.stopReal();
+
+		st.reset();
+		size_t sum3=0;
+		arr.decode(0, num, out);
+		for(size_t i=0;i<num;i++) {
+			sum3 += out[i];
+		}
+		unsigned long long timeDecode = st.stopReal();
+
+		if(sum1!=sum2 || sum1!=sum3) {
+			cerr << "Error: bits=" << numbits << " checksum differs" << endl;
+			errors++;
+		}
+		cout << "Bits: " << numbits << "\tget(): " << timeGet << " us\tSequenceBuffer: " << timeBuffer << " us\tdecode(): " << timeDecode << " us" << endl;
+	}
+
+	delete [] out;
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
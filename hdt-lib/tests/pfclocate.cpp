@@ -0,0 +1,147 @@
+/*
+ * pfclocate.cpp
+ *
+ * Check CSD_PFC::locate() with several block sizes and head samplings,
+ * including none, for existing strings and strings around them that do not
+ * exist, and compare the time with and without the upper index of heads,
+ * which is only built on request.
+ * With an HDT file, also compare and time stringToId() for the objects
+ * with and without the option dictionary.headsampling.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+#include <HDTSpecification.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_PFC.h"
+#include "../src/hdt/BasicHDT.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+int checkPFC(vector<string> &strings, uint32_t blocksize) {
+	VectorIteratorUCharString it(strings);
+	CSD_PFC pfc(&it, blocksize);
+
+	// Existing strings, and strings around them that do not exist.
+	vector<string> queries;
+	vector<uint32_t> expected;
+	for(size_t i=0;i<strings.size();i++) {
+		queries.push_back(strings[i]);
+		expected.push_back(i+1);
+		if(rand()%5==0) {
+			string bigger = strings[i]+"a";
+			string smaller = strings[i].substr(0, strings[i].length()-1);
+			queries.push_back(bigger);
+			expected.push_back(binary_search(strings.begin(), strings.end(), bigger) ? lower_bound(strings.begin(), strings.end(), bigger)-strings.begin()+1 : 0);
+			queries.push_back(smaller);
+			expected.push_back(binary_search(strings.begin(), strings.end(), smaller) ? lower_bound(strings.begin(), strings.end(), smaller)-strings.begin()+1 : 0);
+		}
+	}
+	const char *others[] = { "", "!", "http://", "~~~~" };
+	for(int i=0;i<4;i++) {
+		queries.push_back(others[i]);
+		expected.push_back(0);
+	}
+
+	int errors=0;
+	if(pfc.getHeadSampling()!=0) {
+		cerr << "Error blocksize " << blocksize << " upper index built without request" << endl;
+		errors++;
+	}
+	uint32_t samplings[] = { 0, 1, 2, CSD_PFC::SUGGESTED_HEAD_SAMPLING, 64 };
+	unsigned long long times[5];
+	for(int s=0;s<5;s++) {
+		pfc.setHeadSampling(samplings[s]);
+		StopWatch st;
+		for(size_t i=0;i<queries.size();i++) {
+			uint32_t id = pfc.locate((const unsigned char *)queries[i].c_str(), queries[i].length());
+			if(id!=expected[i] && errors<10) {
+				cerr << "Error blocksize " << blocksize << " sampling " << samplings[s] << " locate(" << queries[i] << ")=" << id << " expected " << expected[i] << endl;
+				errors++;
+			}
+		}
+		times[s] = st.stopReal();
+	}
+	cout << "Blocksize " << blocksize << "\t" << queries.size() << " locate()\tno index: " << times[0] << " us\tsampling " << CSD_PFC::SUGGESTED_HEAD_SAMPLING << ": " << times[3] << " us" << endl;
+	return errors;
+}
+
+unsigned long long lookup(Dictionary *dict, vector<string> &strs, vector<unsigned int> &ids) {
+	ids.resize(strs.size());
+	StopWatch st;
+	for(size_t i=0;i<strs.size();i++) {
+		ids[i] = dict->stringToId(strs[i], OBJECT);
+	}
+	return st.stopReal();
+}
+
+int checkHDT(const char *file) {
+	HDT *hdt = HDTManager::mapHDT(file);
+	Dictionary *dict = hdt->getDictionary();
+
+	// The same HDT with the upper index requested for every section.
+	HDTSpecification spec;
+	spec.set("dictionary.headsampling", "8");
+	BasicHDT *sampled = new BasicHDT(spec);
+	sampled->mapHDT(file);
+
+	vector<string> strs;
+	for(unsigned int id=1; id<=dict->getMaxObjectID(); id++) {
+		if(rand()%4==0) {
+			strs.push_back(dict->idToString(id, OBJECT));
+		}
+	}
+	random_shuffle(strs.begin(), strs.end());
+
+	int errors=0;
+	vector<unsigned int> ids, sampledIds;
+	unsigned long long timePlain = lookup(dict, strs, ids);
+	unsigned long long timeSampled = lookup(sampled->getDictionary(), strs, sampledIds);
+	for(size_t i=0;i<strs.size() && errors<10;i++) {
+		if(ids[i]==0 || sampledIds[i]!=ids[i]) {
+			cerr << "Error stringToId(" << strs[i] << ")=" << ids[i] << " with head sampling " << sampledIds[i] << endl;
+			errors++;
+		}
+	}
+	cout << strs.size() << " objects\tstringToId(): " << timePlain << " us\twith dictionary.headsampling 8: " << timeSampled << " us" << endl;
+
+	delete sampled;
+	delete hdt;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+
+	vector<string> strings;
+	for(int i=0;i<50000;i++) {
+		string str = "http://example.org/";
+		int len = 1+rand()%20;
+		for(int j=0;j<len;j++) {
+			str += (char)('a'+rand()%(j<2 ? 2 : 26));
+		}
+		strings.push_back(str);
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+	uint32_t blocksizes[] = { 1, 2, 16, 128 };
+	for(int i=0;i<4;i++) {
+		errors += checkPFC(strings, blocksizes[i]);
+	}
+
+	if(argc>1) {
+		errors += checkHDT(argv[1]);
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
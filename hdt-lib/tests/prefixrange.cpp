@@ -0,0 +1,191 @@
+/*
+ * prefixrange.cpp
+ *
+ * Check CSD::prefixRange() of PFC and HTFC against the strings that start
+ * with each prefix. With an HDT file, also check Dictionary::prefixRange()
+ * for all the roles, and count the triples whose subject or object start
+ * with a prefix with RangeFilterIteratorTripleID and by decoding the strings,
+ * comparing their times.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_PFC.h"
+#include "../src/libdcs/CSD_HTFC.h"
+#include "../src/triples/TripleIterators.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+bool startsWith(const string &str, const string &prefix) {
+	return str.compare(0, prefix.length(), prefix)==0;
+}
+
+int checkCSD(const char *name, CSD *csd, vector<string> &strings, vector<string> &prefixes) {
+	int errors=0;
+	for(size_t i=0;i<prefixes.size() && errors<10;i++) {
+		uint32_t begin, end;
+		csd->prefixRange((const unsigned char *)prefixes[i].c_str(), prefixes[i].length(), &begin, &end);
+
+		uint32_t expectedBegin = lower_bound(strings.begin(), strings.end(), prefixes[i])-strings.begin()+1;
+		uint32_t expectedEnd = expectedBegin;
+		while(expectedEnd<=strings.size() && startsWith(strings[expectedEnd-1], prefixes[i])) {
+			expectedEnd++;
+		}
+		if(begin!=expectedBegin || end!=expectedEnd) {
+			cerr << "Error " << name << " prefixRange(" << prefixes[i] << ")=[" << begin << ", " << end << ") expected [" << expectedBegin << ", " << expectedEnd << ")" << endl;
+			errors++;
+		}
+	}
+	return errors;
+}
+
+int checkRole(Dictionary *dict, TripleComponentRole role, unsigned int maxId, vector<string> &prefixes) {
+	int errors=0;
+	vector<pair<unsigned int, unsigned int> > ranges;
+	for(size_t i=0;i<prefixes.size() && errors<10;i++) {
+		dict->prefixRange(prefixes[i], role, ranges);
+
+		size_t r=0;
+		for(unsigned int id=1; id<=maxId; id++) {
+			while(r<ranges.size() && ranges[r].second<=id) {
+				r++;
+			}
+			bool inRange = r<ranges.size() && ranges[r].first<=id;
+			if(inRange!=startsWith(dict->idToString(id, role), prefixes[i])) {
+				cerr << "Error prefixRange(" << prefixes[i] << ", " << role << ") at ID " << id << endl;
+				errors++;
+				break;
+			}
+		}
+		for(r=0;r<ranges.size();r++) {
+			if(ranges[r].first>=ranges[r].second || (r>0 && ranges[r-1].second>ranges[r].first)) {
+				cerr << "Error prefixRange(" << prefixes[i] << ", " << role << ") ranges not sorted" << endl;
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+int countTriples(HDT *hdt, TripleComponentRole role, const string &prefix) {
+	Dictionary *dict = hdt->getDictionary();
+
+	StopWatch st;
+	size_t expected=0;
+	string str;
+	IteratorTripleID *it = hdt->getTriples()->searchAll();
+	while(it->hasNext()) {
+		TripleID *triple = it->next();
+		dict->extractString(role==SUBJECT ? triple->getSubject() : triple->getObject(), role, str);
+		if(startsWith(str, prefix)) {
+			expected++;
+		}
+	}
+	delete it;
+	unsigned long long timeDecode = st.stopReal();
+
+	st.reset();
+	vector<pair<unsigned int, unsigned int> > ranges;
+	dict->prefixRange(prefix, role, ranges);
+	size_t count=0;
+	it = new RangeFilterIteratorTripleID(hdt->getTriples()->searchAll(), role, ranges);
+	while(it->hasNext()) {
+		it->next();
+		count++;
+	}
+	delete it;
+	unsigned long long timeRanges = st.stopReal();
+
+	cout << "Role " << role << "\t" << prefix << "\t" << count << " triples\tdecoding: " << timeDecode << " us\tranges: " << timeRanges << " us" << endl;
+	if(count!=expected) {
+		cerr << "Error counting triples with prefix " << prefix << ": " << count << " expected " << expected << endl;
+		return 1;
+	}
+	return 0;
+}
+
+int checkHDT(const char *file) {
+	HDT *hdt = HDTManager::mapHDT(file);
+	Dictionary *dict = hdt->getDictionary();
+
+	// Prefixes of some terms of each role, and others that do not appear.
+	TripleComponentRole roles[] = { SUBJECT, PREDICATE, OBJECT };
+	unsigned int maxIds[] = { dict->getMaxSubjectID(), dict->getMaxPredicateID(), dict->getMaxObjectID() };
+	int errors=0;
+	for(int r=0;r<3;r++) {
+		vector<string> prefixes;
+		prefixes.push_back("");
+		prefixes.push_back("\"");
+		prefixes.push_back("http://");
+		prefixes.push_back("~");
+		for(int i=0;i<10;i++) {
+			string str = dict->idToString(1+rand()%maxIds[r], roles[r]);
+			prefixes.push_back(str.substr(0, rand()%(str.length()+1)));
+			prefixes.push_back(str.substr(0, rand()%(str.length()+1))+"~");
+		}
+		errors += checkRole(dict, roles[r], maxIds[r], prefixes);
+	}
+
+	string subject = dict->idToString(1+rand()%dict->getMaxSubjectID(), SUBJECT);
+	errors += countTriples(hdt, SUBJECT, subject.substr(0, subject.length()/2));
+	errors += countTriples(hdt, SUBJECT, subject.substr(0, subject.length()-1));
+	errors += countTriples(hdt, SUBJECT, "http://");
+	errors += countTriples(hdt, OBJECT, "\"");
+
+	delete hdt;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+
+	vector<string> strings;
+	for(int i=0;i<20000;i++) {
+		string str = "http://example.org/";
+		int len = rand()%20;
+		for(int j=0;j<len;j++) {
+			str += (char)('a'+rand()%(j<2 ? 2 : 26));
+		}
+		strings.push_back(str);
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+	vector<string> prefixes;
+	prefixes.push_back("");
+	prefixes.push_back("a");
+	prefixes.push_back("http://example.org/");
+	prefixes.push_back("http://example.org/~");
+	prefixes.push_back("\xff");
+	for(int i=0;i<2000;i++) {
+		string str = strings[rand()%strings.size()];
+		prefixes.push_back(str.substr(0, rand()%(str.length()+1)));
+		prefixes.push_back(str+"a");
+	}
+
+	uint32_t blocksizes[] = { 1, 2, 16, 128 };
+	for(int i=0;i<4;i++) {
+		VectorIteratorUCharString itPFC(strings);
+		CSD_PFC pfc(&itPFC, blocksizes[i]);
+		errors += checkCSD("PFC", &pfc, strings, prefixes);
+	}
+	VectorIteratorUCharString itHTFC(strings);
+	CSD_HTFC htfc(&itHTFC, 16);
+	errors += checkCSD("HTFC", &htfc, strings, prefixes);
+
+	if(argc>1) {
+		errors += checkHDT(argv[1]);
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
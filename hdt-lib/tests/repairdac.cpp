@@ -0,0 +1,229 @@
+/*
+ * repairdac.cpp
+ *
+ * Check DACSequence::get() against the values, and CSD_RePairDAC extract(),
+ * locate() and listAll() against the strings, also after saving and loading
+ * it from a stream and from memory. Then compare the size and the time of
+ * extract() and locate() with PFC and HTFC, for the sections of an HDT file
+ * if given.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_PFC.h"
+#include "../src/libdcs/CSD_HTFC.h"
+#include "../src/libdcs/CSD_RePairDAC.h"
+#include "../src/sequence/DACSequence.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+int checkDAC() {
+	vector<unsigned int> values;
+	for(int i=0;i<100000;i++) {
+		// Mostly small values, some big ones.
+		int len = rand()%100<90 ? rand()%8 : rand()%33;
+		values.push_back(len==0 ? 0 : (unsigned int)(((uint64_t)rand()<<16 ^ rand()) & (((uint64_t)1<<len)-1)));
+	}
+	values.push_back(0xFFFFFFFF);
+
+	VectorUIntIterator it(values);
+	DACSequence dac;
+	dac.add(it);
+
+	stringstream stream;
+	dac.save(stream);
+	string data = stream.str();
+	DACSequence loaded;
+	loaded.load(stream);
+	DACSequence mapped;
+	size_t count = mapped.load((const unsigned char *)&data[0], (const unsigned char *)&data[0]+data.size());
+
+	int errors=0;
+	if(count!=data.size() || dac.getNumberOfElements()!=values.size() || mapped.getNumberOfElements()!=values.size()) {
+		cerr << "Error DACSequence size" << endl;
+		errors++;
+	}
+	for(size_t i=0;i<values.size() && errors<10;i++) {
+		if(dac.get(i)!=values[i] || loaded.get(i)!=values[i] || mapped.get(i)!=values[i]) {
+			cerr << "Error DACSequence get(" << i << ")=" << dac.get(i) << " expected " << values[i] << endl;
+			errors++;
+		}
+	}
+	cout << "DACSequence\t" << values.size() << " values\t" << dac.getNumberOfLevels() << " levels\t" << dac.size() << " bytes" << endl;
+	return errors;
+}
+
+int checkStrings(const char *name, CSD *csd, vector<string> &strings) {
+	int errors=0;
+	if(csd->getLength()!=strings.size()) {
+		cerr << "Error " << name << " length " << csd->getLength() << " expected " << strings.size() << endl;
+		return 1;
+	}
+	string str;
+	unsigned char small[4];
+	for(size_t i=0;i<strings.size() && errors<10;i++) {
+		csd->extractString(i+1, str);
+		unsigned char *ptr = csd->extract(i+1);
+		size_t len = csd->extract(i+1, small, sizeof(small));
+		if(str!=strings[i] || strings[i]!=(char *)ptr || len!=strings[i].length() || (len<sizeof(small) && strings[i]!=(char *)small)) {
+			cerr << "Error " << name << " extract(" << i+1 << ")=" << str << " expected " << strings[i] << endl;
+			errors++;
+		}
+		csd->freeString(ptr);
+
+		uint32_t id = csd->locate((const unsigned char *)strings[i].c_str(), strings[i].length());
+		if(id!=i+1) {
+			cerr << "Error " << name << " locate(" << strings[i] << ")=" << id << " expected " << i+1 << endl;
+			errors++;
+		}
+		string other = strings[i]+"a";
+		if(!binary_search(strings.begin(), strings.end(), other) && csd->locate((const unsigned char *)other.c_str(), other.length())!=0) {
+			cerr << "Error " << name << " found " << other << endl;
+			errors++;
+		}
+	}
+	if(csd->locate((const unsigned char *)"", 0)!=0 || csd->extract(0)!=NULL || csd->extract(strings.size()+1)!=NULL) {
+		cerr << "Error " << name << " out of range" << endl;
+		errors++;
+	}
+
+	IteratorUCharString *it = csd->listAll();
+	for(size_t i=0; it->hasNext(); i++) {
+		unsigned char *next = it->next();
+		if(i>=strings.size() || strings[i]!=(char *)next) {
+			cerr << "Error " << name << " listAll() at " << i << endl;
+			errors++;
+			break;
+		}
+		it->freeStr(next);
+	}
+	delete it;
+	return errors;
+}
+
+int checkRePairDAC(vector<string> &strings, uint32_t blocksize) {
+	VectorIteratorUCharString it(strings);
+	CSD_RePairDAC dict(&it, blocksize);
+	int errors = checkStrings("built", &dict, strings);
+
+	stringstream stream;
+	dict.save(stream);
+	string data = stream.str();
+
+	CSD *loaded = CSD::load(stream);
+	errors += checkStrings("loaded", loaded, strings);
+	delete loaded;
+
+	CSD *mapped = CSD::create(data[0]);
+	size_t count = mapped->load((unsigned char *)&data[0], (unsigned char *)&data[0]+data.size());
+	if(count!=data.size()) {
+		cerr << "Error mapped " << count << " bytes of " << data.size() << endl;
+		errors++;
+	}
+	errors += checkStrings("mapped", mapped, strings);
+	delete mapped;
+	return errors;
+}
+
+void compare(const char *section, IteratorUCharString *it) {
+	vector<string> strings;
+	size_t bytes=0;
+	while(it->hasNext()) {
+		unsigned char *str = it->next();
+		strings.push_back((char *)str);
+		bytes += strings.back().length();
+		it->freeStr(str);
+	}
+	delete it;
+	if(strings.empty()) {
+		return;
+	}
+
+	vector<uint32_t> ids;
+	for(size_t i=0;i<10000;i++) {
+		ids.push_back(1+rand()%strings.size());
+	}
+
+	const char *names[] = { "PFC", "HTFC", "RePairDAC" };
+	cout << section << "\t" << strings.size() << " strings\t" << bytes << " bytes" << endl;
+	for(int c=0;c<3;c++) {
+		VectorIteratorUCharString itStrings(strings);
+		StopWatch st;
+		CSD *csd = c==0 ? (CSD *)new CSD_PFC(&itStrings, 16) : c==1 ? (CSD *)new CSD_HTFC(&itStrings, 16) : (CSD *)new CSD_RePairDAC(&itStrings, 16);
+		unsigned long long timeBuild = st.stopReal();
+
+		st.reset();
+		string str;
+		for(size_t i=0;i<ids.size();i++) {
+			csd->extractString(ids[i], str);
+		}
+		unsigned long long timeExtract = st.stopReal();
+
+		st.reset();
+		for(size_t i=0;i<ids.size();i++) {
+			const string &query = strings[ids[i]-1];
+			csd->locate((const unsigned char *)query.c_str(), query.length());
+		}
+		unsigned long long timeLocate = st.stopReal();
+
+		cout << "  " << names[c] << "\t" << csd->getSize() << " bytes (" << 100.0*csd->getSize()/bytes << "%)\tbuild: " << timeBuild/1000 << " ms"
+				<< "\textract: " << timeExtract*1000/ids.size() << " ns\tlocate: " << timeLocate*1000/ids.size() << " ns" << endl;
+		delete csd;
+	}
+}
+
+int main(int argc, char **argv) {
+	int errors = checkDAC();
+
+	vector<string> strings;
+	for(int i=0;i<50000;i++) {
+		string str = "http://example.org/";
+		int len = 1+rand()%(i%100==0 ? 400 : 20);
+		for(int j=0;j<len;j++) {
+			str += (char)('a'+rand()%(j<2 ? 2 : 26));
+		}
+		strings.push_back(str);
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+	// Small sets, and long repetitive strings whose grammar is the deepest.
+	size_t sizes[] = { 0, 1, 2, 100, strings.size() };
+	for(int i=0;i<5;i++) {
+		vector<string> some(strings.begin(), strings.begin()+sizes[i]);
+		errors += checkRePairDAC(some, 1);
+		errors += checkRePairDAC(some, 16);
+	}
+	vector<string> repetitive;
+	for(int i=1;i<200;i++) {
+		repetitive.push_back(string(i*50, 'a')+(char)('a'+i%26));
+	}
+	sort(repetitive.begin(), repetitive.end());
+	errors += checkRePairDAC(repetitive, 8);
+
+	if(argc>1) {
+		HDT *hdt = HDTManager::mapHDT(argv[1]);
+		Dictionary *dict = hdt->getDictionary();
+		compare("Shared", dict->getShared());
+		compare("Subjects", dict->getSubjects());
+		compare("Predicates", dict->getPredicates());
+		compare("Objects", dict->getObjects());
+		delete hdt;
+	} else {
+		compare("Generated", new VectorIteratorUCharString(strings));
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
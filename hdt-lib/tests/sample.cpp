@@ -0,0 +1,154 @@
+/*
+ * sample.cpp
+ *
+ * Check Triples::sample() for all kinds of patterns: the sample must have the
+ * right size, distinct triples matching the pattern, depend only on the seed,
+ * and be roughly uniform.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <map>
+#include <set>
+
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+struct TripleIDLess {
+	bool operator()(const TripleID &a, const TripleID &b) const {
+		TripleID &ta = const_cast<TripleID &>(a);
+		TripleID &tb = const_cast<TripleID &>(b);
+		if(ta.getSubject()!=tb.getSubject()) {
+			return ta.getSubject()<tb.getSubject();
+		}
+		if(ta.getPredicate()!=tb.getPredicate()) {
+			return ta.getPredicate()<tb.getPredicate();
+		}
+		return ta.getObject()<tb.getObject();
+	}
+};
+
+int checkPattern(Triples *triples, TripleID &pattern, unsigned int k) {
+	int errors=0;
+
+	set<TripleID, TripleIDLess> results;
+	IteratorTripleID *it = triples->search(pattern);
+	while(it->hasNext()) {
+		results.insert(*it->next());
+	}
+	delete it;
+
+	for(unsigned int seed=1; seed<4; seed++) {
+		vector<TripleID> sample = triples->sample(pattern, k, seed);
+		size_t expected = results.size()<k ? results.size() : k;
+		if(sample.size()!=expected) {
+			cerr << "Error: pattern " << pattern << " sample size " << sample.size() << " expected " << expected << endl;
+			errors++;
+			continue;
+		}
+		set<TripleID, TripleIDLess> distinct;
+		for(size_t i=0;i<sample.size();i++) {
+			if(results.find(sample[i])==results.end()) {
+				cerr << "Error: pattern " << pattern << " sampled " << sample[i] << " does not match" << endl;
+				errors++;
+			}
+			distinct.insert(sample[i]);
+		}
+		if(distinct.size()!=sample.size()) {
+			cerr << "Error: pattern " << pattern << " repeated triples in sample" << endl;
+			errors++;
+		}
+		vector<TripleID> again = triples->sample(pattern, k, seed);
+		for(size_t i=0;i<sample.size() && i<again.size();i++) {
+			if(!(sample[i]==again[i])) {
+				cerr << "Error: pattern " << pattern << " different sample with the same seed" << endl;
+				errors++;
+				break;
+			}
+		}
+	}
+	return errors;
+}
+
+/**
+ * Draw one triple with many seeds, every result should appear about the same number of times.
+ */
+int checkUniform(Triples *triples, TripleID &pattern) {
+	map<TripleID, unsigned int, TripleIDLess> histogram;
+	IteratorTripleID *it = triples->search(pattern);
+	while(it->hasNext()) {
+		histogram[*it->next()] = 0;
+	}
+	delete it;
+	if(histogram.size()==0 || histogram.size()>50) {
+		return 0;
+	}
+
+	unsigned int draws = 400*histogram.size();
+	for(unsigned int seed=0; seed<draws; seed++) {
+		vector<TripleID> sample = triples->sample(pattern, 1, seed);
+		histogram[sample[0]]++;
+	}
+	for(map<TripleID, unsigned int, TripleIDLess>::iterator i=histogram.begin(); i!=histogram.end(); ++i) {
+		if(i->second<200 || i->second>600) {
+			cerr << "Error: pattern " << pattern << " not uniform, " << i->first << " drawn " << i->second << " times of 400" << endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	if(argc<2) {
+		cout << "$ sample <hdtfile>" << endl;
+		return 1;
+	}
+
+	HDT *hdt = HDTManager::mapIndexedHDT(argv[1]);
+	Triples *triples = hdt->getTriples();
+
+	vector<TripleID> all;
+	TripleID any(0,0,0);
+	IteratorTripleID *it = triples->search(any);
+	while(it->hasNext()) {
+		all.push_back(*it->next());
+	}
+	delete it;
+
+	int errors=0;
+	errors += checkPattern(triples, any, 10);
+
+	// Every combination of bound components taken from existing triples,
+	// and from two different triples to get some empty results.
+	for(int i=0;i<100 && all.size()>0;i++) {
+		TripleID &triple = all[((size_t)rand()*7919)%all.size()];
+		TripleID &other = all[((size_t)rand()*7919)%all.size()];
+		for(int mask=1; mask<7; mask++) {
+			TripleID pattern(mask&1 ? triple.getSubject() : 0, mask&2 ? triple.getPredicate() : 0, mask&4 ? triple.getObject() : 0);
+			errors += checkPattern(triples, pattern, 5);
+			errors += checkUniform(triples, pattern);
+
+			TripleID mixed(mask&1 ? triple.getSubject() : 0, mask&2 ? other.getPredicate() : 0, mask&4 ? other.getObject() : 0);
+			errors += checkPattern(triples, mixed, 5);
+		}
+	}
+
+	// Time to sample a big pattern
+	if(all.size()>0) {
+		TripleID pattern(0, all[all.size()/2].getPredicate(), 0);
+		StopWatch st;
+		vector<TripleID> sample = triples->sample(pattern, 100, 1);
+		cout << "Sample of " << sample.size() << " from " << pattern << " in " << st << endl;
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+
+	delete hdt;
+	return errors;
+}
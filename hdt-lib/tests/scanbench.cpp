@@ -0,0 +1,113 @@
+/*
+ * scanbench.cpp
+ *
+ * Per-triple cost, including the creation of the iterator, of the ???, S??, SP?
+ * and ??O patterns, comparing the iterators returned by BitmapTriples::search()
+ * against the generic BitmapTriplesSearchIterator, and checking that both return
+ * the same triples.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "../src/triples/BitmapTriples.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+struct Result {
+	unsigned long long time;
+	unsigned long long numTriples;
+	unsigned long long checksum;
+};
+
+/**
+ * Time to create the iterator and read all its results.
+ */
+void scan(BitmapTriples *triples, TripleID &pattern, bool generic, Result &result) {
+	StopWatch st;
+	IteratorTripleID *it = generic ? new BitmapTriplesSearchIterator(triples, pattern) : triples->search(pattern);
+	while(it->hasNext()) {
+		TripleID *triple = it->next();
+		result.checksum = result.checksum*31 + triple->getSubject() + 7*triple->getPredicate() + 13*triple->getObject();
+		result.numTriples++;
+	}
+	delete it;
+	result.time += st.stopReal();
+}
+
+int benchmark(BitmapTriples *triples, const char *name, vector<TripleID> &patterns, bool generic) {
+	Result fast = { 0, 0, 0 };
+	Result slow = { 0, 0, 0 };
+	// Separate passes, so that one does not warm the cache for the other.
+	for(int round=0; round<3; round++) {
+		for(size_t i=0;i<patterns.size();i++) {
+			scan(triples, patterns[i], false, fast);
+		}
+		for(size_t i=0;i<patterns.size() && generic;i++) {
+			scan(triples, patterns[i], true, slow);
+		}
+	}
+	cout << name << "\t" << fast.numTriples/3 << " triples\tsearch(): " << (double)fast.time*1000/fast.numTriples << " ns/triple";
+	if(generic) {
+		cout << "\tgeneric: " << (double)slow.time*1000/slow.numTriples << " ns/triple";
+	}
+	cout << endl;
+
+	if(generic && (fast.numTriples!=slow.numTriples || fast.checksum!=slow.checksum)) {
+		cerr << "Error: " << name << " different results" << endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	if(argc<2) {
+		cout << "$ scanbench <hdtfile>" << endl;
+		return 1;
+	}
+
+	HDT *hdt = HDTManager::mapIndexedHDT(argv[1]);
+	BitmapTriples *triples = dynamic_cast<BitmapTriples *>(hdt->getTriples());
+	if(triples==NULL) {
+		cerr << "The triples are not BitmapTriples" << endl;
+		delete hdt;
+		return 1;
+	}
+
+	vector<TripleID> all;
+	IteratorTripleID *it = triples->searchAll();
+	while(it->hasNext()) {
+		all.push_back(*it->next());
+	}
+	delete it;
+	if(all.size()==0) {
+		delete hdt;
+		return 0;
+	}
+
+	vector<TripleID> any, subjects, subjectPredicates, objects;
+	any.push_back(TripleID(0,0,0));
+	for(int i=0;i<20000;i++) {
+		TripleID &triple = all[((size_t)rand()*7919)%all.size()];
+		subjects.push_back(TripleID(triple.getSubject(), 0, 0));
+		subjectPredicates.push_back(TripleID(triple.getSubject(), triple.getPredicate(), 0));
+		objects.push_back(TripleID(0, 0, triple.getObject()));
+	}
+
+	int errors=0;
+	errors += benchmark(triples, "???", any, true);
+	errors += benchmark(triples, "S??", subjects, true);
+	errors += benchmark(triples, "SP?", subjectPredicates, true);
+	errors += benchmark(triples, "??O", objects, false);
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+
+	delete hdt;
+	return errors;
+}
@@ -0,0 +1,261 @@
+/*
+ * sectioncodec.cpp
+ *
+ * Check CSD_HTFC extract(), locate() and listAll() against the strings,
+ * also after saving and loading it from a stream and from memory. Then
+ * import the dictionary of an HDT file, or a generated one, into
+ * FourSectionDictionary with a different codec for each section and check
+ * every ID and string, and every string of each section in order, also
+ * after saving and loading it. An unknown codec must throw.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+#include <HDTSpecification.hpp>
+#include <ControlInformation.hpp>
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_HTFC.h"
+#include "../src/dictionary/PlainDictionary.hpp"
+#include "../src/dictionary/FourSectionDictionary.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+int checkStrings(const char *name, CSD *csd, vector<string> &strings) {
+	int errors=0;
+	if(csd->getLength()!=strings.size()) {
+		cerr << "Error " << name << " length " << csd->getLength() << " expected " << strings.size() << endl;
+		return 1;
+	}
+	string str;
+	for(size_t i=0;i<strings.size() && errors<10;i++) {
+		csd->extractString(i+1, str);
+		if(str!=strings[i]) {
+			cerr << "Error " << name << " extract(" << i+1 << ")=" << str << " expected " << strings[i] << endl;
+			errors++;
+		}
+		uint32_t id = csd->locate((const unsigned char *)strings[i].c_str(), strings[i].length());
+		if(id!=i+1) {
+			cerr << "Error " << name << " locate(" << strings[i] << ")=" << id << " expected " << i+1 << endl;
+			errors++;
+		}
+	}
+
+	IteratorUCharString *it = csd->listAll();
+	size_t count=0;
+	for(; it->hasNext(); count++) {
+		unsigned char *next = it->next();
+		if(count>=strings.size() || strings[count]!=(char *)next) {
+			cerr << "Error " << name << " listAll() at " << count << endl;
+			errors++;
+			break;
+		}
+		it->freeStr(next);
+	}
+	delete it;
+	if(errors==0 && count!=strings.size()) {
+		cerr << "Error " << name << " listAll() returned " << count << " strings" << endl;
+		errors++;
+	}
+	return errors;
+}
+
+int checkHTFC(vector<string> &strings, uint32_t blocksize) {
+	VectorIteratorUCharString it(strings);
+	CSD_HTFC dict(&it, blocksize);
+	int errors = checkStrings("built", &dict, strings);
+
+	stringstream stream;
+	dict.save(stream);
+	string data = stream.str();
+
+	CSD *loaded = CSD::load(stream);
+	errors += checkStrings("loaded", loaded, strings);
+	delete loaded;
+
+	CSD *mapped = CSD::create(data[0]);
+	size_t count = mapped->load((unsigned char *)&data[0], (unsigned char *)&data[0]+data.size());
+	if(count!=data.size()) {
+		cerr << "Error mapped " << count << " bytes of " << data.size() << endl;
+		errors++;
+	}
+	errors += checkStrings("mapped", mapped, strings);
+	delete mapped;
+	return errors;
+}
+
+int checkDictionary(const char *name, Dictionary *dict, Dictionary *other) {
+	int errors=0;
+	if(dict->getNsubjects()!=other->getNsubjects() || dict->getNobjects()!=other->getNobjects()
+			|| dict->getNpredicates()!=other->getNpredicates() || dict->getNshared()!=other->getNshared()) {
+		cerr << "Error " << name << " number of entries" << endl;
+		return 1;
+	}
+	TripleComponentRole roles[] = { SUBJECT, PREDICATE, OBJECT };
+	unsigned int max[] = { dict->getNsubjects(), dict->getNpredicates(), dict->getNobjects() };
+	for(int r=0;r<3;r++) {
+		for(unsigned int id=1;id<=max[r] && errors<10;id++) {
+			string str = other->idToString(id, roles[r]);
+			if(dict->idToString(id, roles[r])!=str || dict->stringToId(str, roles[r])!=id) {
+				cerr << "Error " << name << " ID " << id << " role " << r << ": " << str << endl;
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+/** The strings of a section against the same section of the other dictionary, in order. */
+int checkSection(const char *name, const char *section, IteratorUCharString *it, IteratorUCharString *expected) {
+	int errors=0;
+	size_t count=0;
+	for(; expected->hasNext(); count++) {
+		unsigned char *str = expected->next();
+		if(!it->hasNext()) {
+			cerr << "Error " << name << " " << section << " ends at " << count << endl;
+			errors++;
+			expected->freeStr(str);
+			break;
+		}
+		unsigned char *next = it->next();
+		if(strcmp((char *)str, (char *)next)!=0) {
+			cerr << "Error " << name << " " << section << " at " << count << ": " << next << " expected " << str << endl;
+			errors++;
+		}
+		it->freeStr(next);
+		expected->freeStr(str);
+		if(errors) {
+			break;
+		}
+	}
+	if(errors==0 && it->hasNext()) {
+		cerr << "Error " << name << " " << section << " has more than " << count << " strings" << endl;
+		errors++;
+	}
+	delete it;
+	delete expected;
+	return errors;
+}
+
+int checkSections(const char *name, Dictionary *dict, Dictionary *other) {
+	int errors=0;
+	errors += checkSection(name, "subjects", dict->getSubjects(), other->getSubjects());
+	errors += checkSection(name, "predicates", dict->getPredicates(), other->getPredicates());
+	errors += checkSection(name, "objects", dict->getObjects(), other->getObjects());
+	errors += checkSection(name, "shared", dict->getShared(), other->getShared());
+	return errors;
+}
+
+int checkSpec(const char *options, Dictionary *other) {
+	HDTSpecification spec;
+	spec.setOptions(options);
+	FourSectionDictionary dict(spec);
+	dict.import(other);
+	int errors = checkDictionary(options, &dict, other);
+	errors += checkSections(options, &dict, other);
+
+	stringstream stream;
+	ControlInformation ci;
+	dict.save(stream, ci);
+	string data = stream.str();
+
+	FourSectionDictionary loaded;
+	ci.clear();
+	ci.load(stream);
+	loaded.load(stream, ci);
+	errors += checkDictionary("loaded", &loaded, other);
+	errors += checkSections("loaded", &loaded, other);
+
+	FourSectionDictionary mapped;
+	ci.clear();
+	mapped.load((unsigned char *)&data[0], (unsigned char *)&data[0]+data.size());
+	errors += checkDictionary("mapped", &mapped, other);
+	errors += checkSections("mapped", &mapped, other);
+
+	cout << options << "\t" << data.size() << " bytes" << endl;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	vector<string> strings;
+	for(int i=0;i<50000;i++) {
+		string str = "http://example.org/";
+		int len = 1+rand()%(i%100==0 ? 400 : 20);
+		for(int j=0;j<len;j++) {
+			str += (char)('a'+rand()%(j<2 ? 2 : 26));
+		}
+		strings.push_back(str);
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+	int errors=0;
+	size_t sizes[] = { 0, 1, 2, 100, strings.size() };
+	for(int i=0;i<5;i++) {
+		vector<string> some(strings.begin(), strings.begin()+sizes[i]);
+		errors += checkHTFC(some, 1);
+		errors += checkHTFC(some, 16);
+	}
+
+	HDT *hdt = NULL;
+	Dictionary *other;
+	PlainDictionary plain;
+	if(argc>1) {
+		hdt = HDTManager::mapHDT(argv[1]);
+		other = hdt->getDictionary();
+	} else {
+		// Subjects and objects share some strings, some objects are literals.
+		plain.startProcessing();
+		for(size_t i=0;i<strings.size();i++) {
+			if(i%3!=2) {
+				plain.insert(strings[i], SUBJECT);
+			}
+			if(i%3!=0) {
+				string object = i%5==0 ? "\""+strings[i]+"\"" : strings[i];
+				plain.insert(object, OBJECT);
+			}
+			if(i%1000==0) {
+				plain.insert(strings[i], PREDICATE);
+			}
+		}
+		plain.stopProcessing();
+		other = &plain;
+	}
+
+	const char *options[] = {
+		"dictionary.codec:pfc",
+		"dictionary.codec:htfc",
+		"dictionary.subjects.codec:pfc;dictionary.objects.codec:htfc;dictionary.objects.blocksize:64;dictionary.shared.codec:repairdac",
+		"dictionary.codec:auto;dictionary.goal:size",
+		"dictionary.codec:auto;dictionary.goal:speed",
+		"dictionary.codec:auto"
+	};
+	for(int i=0;i<6;i++) {
+		errors += checkSpec(options[i], other);
+	}
+
+	const char *unknown[] = { "dictionary.codec:hftc", "dictionary.objects.codec:PFC" };
+	for(int i=0;i<2;i++) {
+		HDTSpecification spec;
+		spec.setOptions(unknown[i]);
+		FourSectionDictionary dict(spec);
+		try {
+			dict.import(other);
+			cerr << "Error " << unknown[i] << " imported" << endl;
+			errors++;
+		} catch (const char *e) {
+		}
+	}
+	delete hdt;
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
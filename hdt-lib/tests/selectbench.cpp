@@ -0,0 +1,97 @@
+/*
+ * selectbench.cpp
+ *
+ * Check BitSequence375 select0/select1 against a linear scan and
+ * compare their speed for several sampling rates of the select directory.
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "../src/bitsequence/BitSequence375.h"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+int check(BitSequence375 &bitmap) {
+	int errors=0;
+	size_t ones=0, zeros=0;
+	for(size_t i=0;i<bitmap.getNumBits();i++) {
+		if(bitmap.access(i)) {
+			ones++;
+			if(bitmap.select1(ones)!=i) {
+				if(errors++<10) cerr << "Error select1(" << ones << ")=" << bitmap.select1(ones) << " expected " << i << endl;
+			}
+		} else {
+			zeros++;
+			if(bitmap.select0(zeros)!=i) {
+				if(errors++<10) cerr << "Error select0(" << zeros << ")=" << bitmap.select0(zeros) << " expected " << i << endl;
+			}
+		}
+	}
+	return errors;
+}
+
+void benchmark(BitSequence375 &bitmap, uint32_t rate, vector<size_t> &queries1, vector<size_t> &queries0) {
+	bitmap.setSelectSampling(rate);
+
+	StopWatch st;
+	size_t sum=0;
+	for(size_t i=0;i<queries1.size();i++) {
+		sum += bitmap.select1(queries1[i]);
+	}
+	unsigned long long time1 = st.stopReal();
+
+	st.reset();
+	for(size_t i=0;i<queries0.size();i++) {
+		sum += bitmap.select0(queries0[i]);
+	}
+	unsigned long long time0 = st.stopReal();
+
+	cout << "\tSampling " << rate << "\tselect1: " << time1 << " us\tselect0: " << time0 << " us\tsize: " << bitmap.getSizeBytes() << " bytes (" << sum%10 << ")" << endl;
+}
+
+int main(int argc, char **argv) {
+	size_t numbits = 50000000;
+	size_t numqueries = 2000000;
+	int errors=0;
+
+	// Dense, sparse and clustered bitmaps.
+	int densities[] = { 50, 5, 0 };
+	for(int d=0; d<3; d++) {
+		BitSequence375 bitmap(numbits);
+		for(size_t i=0;i<numbits;i++) {
+			bool val = densities[d]>0 ? (size_t)(rand()%100)<densities[d] : (i/100000)%7==0 && rand()%3==0;
+			bitmap.append(val);
+		}
+		bitmap.countOnes();
+
+		cout << "Density " << densities[d] << "%: " << bitmap.countOnes() << " ones" << endl;
+
+		// Verify on a smaller prefix with a tiny sampling rate
+		BitSequence375 small(1000000);
+		for(size_t i=0;i<1000000;i++) {
+			small.append(bitmap.access(i));
+		}
+		small.setSelectSampling(3);
+		errors+=check(small);
+		small.setSelectSampling(0);
+		errors+=check(small);
+
+		vector<size_t> queries1, queries0;
+		for(size_t i=0;i<numqueries;i++) {
+			queries1.push_back(1+((size_t)rand()*7919)%bitmap.countOnes());
+			queries0.push_back(1+((size_t)rand()*7919)%bitmap.countZeros());
+		}
+
+		benchmark(bitmap, 0, queries1, queries0);
+		benchmark(bitmap, 4096, queries1, queries0);
+		benchmark(bitmap, 1024, queries1, queries0);
+		benchmark(bitmap, 256, queries1, queries0);
+	}
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
@@ -0,0 +1,186 @@
+/*
+ * substringsearch.cpp
+ *
+ * Check the substring search of CSD_FMIndex, with and without the suffix
+ * sampling, and of LiteralDictionary against a scan of the strings: the
+ * distinct IDs of iterate_substring(), the sorted IDs of locate_substring()
+ * and the occurrences of count_substring(). Then compare the time to get the
+ * first IDs of a frequent substring with locating all of them.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+#include <HDTVocabulary.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_FMIndex.h"
+#include "../src/dictionary/LiteralDictionary.hpp"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+/** IDs from 1 of the strings that contain the pattern, and its occurrences. */
+void scan(vector<string> &strings, const string &pattern, vector<uint32_t> &ids, uint32_t *occurrences) {
+	ids.clear();
+	*occurrences = 0;
+	for(size_t i=0;i<strings.size();i++) {
+		size_t pos = strings[i].find(pattern);
+		if(pos!=string::npos) {
+			ids.push_back(i+1);
+		}
+		while(pos!=string::npos) {
+			(*occurrences)++;
+			pos = strings[i].find(pattern, pos+1);
+		}
+	}
+}
+
+int checkPattern(CSD_FMIndex *fm, bool sampling, vector<string> &strings, const string &pattern) {
+	vector<uint32_t> expected, ids;
+	uint32_t occurrences;
+	scan(strings, pattern, expected, &occurrences);
+
+	IteratorUInt *it = fm->iterate_substring((unsigned char *)pattern.c_str(), pattern.length());
+	while(it->hasNext()) {
+		ids.push_back(it->next());
+	}
+	delete it;
+	sort(ids.begin(), ids.end());
+
+	int errors=0;
+	if(ids!=expected) {
+		cerr << "Error iterate_substring(" << pattern << "): " << ids.size() << " IDs, expected " << expected.size() << endl;
+		errors++;
+	}
+	if(fm->count_substring((unsigned char *)pattern.c_str(), pattern.length())!=occurrences) {
+		cerr << "Error count_substring(" << pattern << ") expected " << occurrences << endl;
+		errors++;
+	}
+	if(sampling) {
+		uint32_t *occs;
+		uint32_t num = fm->locate_substring((unsigned char *)pattern.c_str(), pattern.length(), &occs);
+		if(num!=expected.size() || (num>0 && !equal(occs, occs+num, expected.begin()))) {
+			cerr << "Error locate_substring(" << pattern << "): " << num << " IDs, expected " << expected.size() << endl;
+			errors++;
+		}
+		delete [] occs;
+	}
+	return errors;
+}
+
+int checkLiteralDictionary() {
+	const char *rdfFile = "substringsearch.nt";
+	ofstream out(rdfFile);
+	for(int i=0;i<2000;i++) {
+		out << "<http://example.org/s" << i << "> <http://example.org/label> \"label " << rand()%500 << " of " << i%7 << "\"@en .\n";
+		out << "<http://example.org/s" << i << "> <http://example.org/link> <http://example.org/o" << rand()%100 << "> .\n";
+	}
+	out.close();
+
+	HDTSpecification spec;
+	spec.setOptions("dictionary.type:"+HDTVocabulary::DICTIONARY_TYPE_LITERAL);
+	HDT *hdt = HDTManager::generateHDT(rdfFile, "http://example.org", NTRIPLES, spec);
+	remove(rdfFile);
+	LiteralDictionary *dict = dynamic_cast<LiteralDictionary *>(hdt->getDictionary());
+
+	int errors=0;
+	const char *patterns[] = { "label 1", "of 3", "\"@en", "12", "missing" };
+	for(int p=0;p<5;p++) {
+		string pattern = patterns[p];
+		vector<unsigned int> expected, ids;
+		uint32_t occurrences=0;
+		for(unsigned int id=dict->getNshared()+1; id<=dict->getMaxObjectID(); id++) {
+			string str = dict->idToString(id, OBJECT);
+			if(str[0]=='"' && str.find(pattern)!=string::npos) {
+				expected.push_back(id);
+				for(size_t pos=str.find(pattern); pos!=string::npos; pos=str.find(pattern, pos+1)) {
+					occurrences++;
+				}
+			}
+		}
+		IteratorUInt *it = dict->substringToIds((unsigned char *)pattern.c_str(), pattern.length());
+		while(it->hasNext()) {
+			ids.push_back(it->next());
+		}
+		delete it;
+		sort(ids.begin(), ids.end());
+		if(ids!=expected || dict->substringCount((unsigned char *)pattern.c_str(), pattern.length())!=occurrences) {
+			cerr << "Error LiteralDictionary substring " << pattern << ": " << ids.size() << " IDs, expected " << expected.size() << endl;
+			errors++;
+		}
+	}
+	delete hdt;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	vector<string> strings;
+	for(int i=0;i<20000;i++) {
+		string str = "\"";
+		int len = 1+rand()%40;
+		for(int j=0;j<len;j++) {
+			str += (char)('a'+rand()%(j%4==0 ? 3 : 8));
+		}
+		strings.push_back(str+"\"");
+	}
+	sort(strings.begin(), strings.end());
+	strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+	int errors=0;
+	vector<string> patterns;
+	for(int i=0;i<200;i++) {
+		const string &str = strings[rand()%strings.size()];
+		size_t start = rand()%(str.length()-1);
+		patterns.push_back(str.substr(start, 2+rand()%5));
+	}
+	patterns.push_back("zzz");
+	patterns.push_back("\"c");
+
+	for(int sampling=0;sampling<2;sampling++) {
+		VectorIteratorUCharString it(strings);
+		CSD_FMIndex fm(&it, false, 40, 64, sampling==1);
+		for(size_t p=0;p<patterns.size() && errors<10;p++) {
+			errors += checkPattern(&fm, sampling==1, strings, patterns[p]);
+		}
+
+		// First IDs of a frequent substring against all of them.
+		unsigned char *pattern = (unsigned char *)"a";
+		StopWatch st;
+		IteratorUInt *first = fm.iterate_substring(pattern, 1);
+		for(int i=0;i<10 && first->hasNext();i++) {
+			first->next();
+		}
+		delete first;
+		unsigned long long timeFirst = st.stopReal();
+
+		st.reset();
+		size_t count=0;
+		IteratorUInt *all = fm.iterate_substring(pattern, 1);
+		while(all->hasNext()) {
+			all->next();
+			count++;
+		}
+		delete all;
+		unsigned long long timeAll = st.stopReal();
+
+		st.reset();
+		uint32_t occurrences = fm.count_substring(pattern, 1);
+		unsigned long long timeCount = st.stopReal();
+
+		cout << (sampling ? "Sampled" : "Not sampled") << "\t" << occurrences << " occurrences in " << count << " strings"
+				<< "\tfirst 10: " << timeFirst << " us\tall: " << timeAll << " us\tcount: " << timeCount << " us" << endl;
+	}
+
+	errors += checkLiteralDictionary();
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
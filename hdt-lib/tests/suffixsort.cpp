@@ -0,0 +1,145 @@
+/*
+ * suffixsort.cpp
+ *
+ * Check SAIS::sort() against SuffixArray::sort() on small and degenerate
+ * texts, then compare their time and memory on the text that CSD_FMIndex
+ * builds from the objects of an HDT file, or from generated literals, and
+ * check locate() and extract() of a CSD_FMIndex built on those strings.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "../src/libdcs/CSD_FMIndex.h"
+#include "../src/libdcs/fmindex/SAIS.h"
+#include "../src/libdcs/fmindex/SuffixArray.h"
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace csd;
+using namespace std;
+
+int check(const string &text) {
+	if(text.empty()) {
+		// SuffixArray does not finish on an empty text.
+		uint32_t sa;
+		SAIS::sort(NULL, 0, &sa);
+		return sa==0 ? 0 : 1;
+	}
+	SuffixArray suffix;
+	long *expected = suffix.sort((unsigned char *)text.data(), text.length());
+	vector<uint32_t> sa(text.length()+1);
+	SAIS::sort((const unsigned char *)text.data(), text.length(), &sa[0]);
+
+	int errors=0;
+	for(size_t i=0;i<=text.length();i++) {
+		if(sa[i]!=(uint32_t)expected[i]) {
+			cerr << "Error SAIS length " << text.length() << " at " << i << ": " << sa[i] << " expected " << expected[i] << endl;
+			errors++;
+			break;
+		}
+	}
+	free(expected);
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	int errors=0;
+
+	// Small texts of every kind, including zeros and runs.
+	const char *fixed[] = { "", "a", "aa", "ab", "ba", "banana", "mississippi", "abracadabra", "aaaaaaaaaaaaaaab", "baaaaaaaaaaaaaaa" };
+	for(int i=0;i<10;i++) {
+		errors += check(fixed[i]);
+	}
+	errors += check(string("a\0b\0a\0", 6));
+	errors += check(string(1000, 'x'));
+	for(int i=0;i<2000;i++) {
+		string text;
+		int alphabet = 1+rand()%(i%2 ? 4 : 256);
+		int len = 1+rand()%(i%10 ? 50 : 5000);
+		for(int j=0;j<len;j++) {
+			text.push_back((char)(rand()%alphabet));
+		}
+		errors += check(text);
+	}
+
+	// The strings of an objects section.
+	vector<string> strings;
+	HDT *hdt = NULL;
+	if(argc>1) {
+		hdt = HDTManager::mapHDT(argv[1]);
+		IteratorUCharString *it = hdt->getDictionary()->getObjects();
+		while(it->hasNext()) {
+			unsigned char *str = it->next();
+			strings.push_back((char *)str);
+			it->freeStr(str);
+		}
+		delete it;
+	} else {
+		for(int i=0;i<200000;i++) {
+			string str = "\"";
+			int len = 5+rand()%60;
+			for(int j=0;j<len;j++) {
+				str += (char)(j%6==5 ? ' ' : 'a'+rand()%(j<3 ? 3 : 26));
+			}
+			strings.push_back(str+"\"@en");
+		}
+		sort(strings.begin(), strings.end());
+		strings.erase(unique(strings.begin(), strings.end()), strings.end());
+	}
+
+	// Same layout as the text of CSD_FMIndex.
+	string text = "\1";
+	for(size_t i=0;i<strings.size();i++) {
+		text += strings[i];
+		text += '\1';
+	}
+	text += '\0';
+
+	StopWatch st;
+	SuffixArray suffix;
+	long *expected = suffix.sort((unsigned char *)text.data(), text.length());
+	unsigned long long timeSuffixArray = st.stopReal();
+
+	st.reset();
+	uint32_t *sa = new uint32_t[text.length()+1];
+	SAIS::sort((const unsigned char *)text.data(), text.length(), sa);
+	unsigned long long timeSAIS = st.stopReal();
+
+	for(size_t i=0;i<=text.length();i++) {
+		if(sa[i]!=(uint32_t)expected[i]) {
+			cerr << "Error SAIS at " << i << endl;
+			errors++;
+			break;
+		}
+	}
+	free(expected);
+	delete [] sa;
+
+	cout << "Text: " << text.length() << " bytes, " << strings.size() << " strings" << endl;
+	cout << "  SuffixArray\t" << timeSuffixArray/1000 << " ms\t" << 2*sizeof(long) << " bytes per character" << endl;
+	cout << "  SAIS\t\t" << timeSAIS/1000 << " ms\t" << sizeof(uint32_t) << " bytes per character" << endl;
+
+	// The FM-index built with it.
+	VectorIteratorUCharString it(strings);
+	CSD_FMIndex fm(&it);
+	string str;
+	for(size_t i=0;i<strings.size() && errors<10;i+=1+strings.size()/5000) {
+		fm.extractString(i+1, str);
+		uint32_t id = fm.locate((const unsigned char *)strings[i].c_str(), strings[i].length());
+		if(str!=strings[i] || id!=i+1) {
+			cerr << "Error FMIndex " << i+1 << ": " << str << " " << id << endl;
+			errors++;
+		}
+	}
+	delete hdt;
+
+	cout << (errors==0 ? "OK" : "ERRORS") << endl;
+	return errors;
+}
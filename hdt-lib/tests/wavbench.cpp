@@ -0,0 +1,68 @@
+/*
+ * wavbench.cpp
+ *
+ * Compare MiddleWaveletIterator (?P? patterns) throughput using
+ * a Wavelet Tree or a Wavelet Matrix as predicate sequence.
+ */
+
+#include <HDT.hpp>
+#include <HDTManager.hpp>
+#include <HDTVocabulary.hpp>
+
+#include <string>
+#include <iostream>
+
+#include "../src/util/StopWatch.hpp"
+
+using namespace hdt;
+using namespace std;
+
+void benchmark(const char *rdfFile, string structure) {
+	HDTSpecification spec;
+	spec.set("stream.wavelet", structure);
+
+	HDT *hdt = HDTManager::generateHDT(rdfFile, "<http://example.org>", NTRIPLES, spec);
+
+	StopWatch st;
+	hdt->getTriples()->generateIndex(NULL);
+	cout << structure << " index generated in " << st << endl;
+
+	unsigned int npred = hdt->getDictionary()->getNpredicates();
+	unsigned long long numTriples = 0;
+
+	st.reset();
+	for(unsigned int p=1;p<=npred;p++) {
+		TripleID pat(0,p,0);
+		IteratorTripleID *it = hdt->getTriples()->search(pat);
+		while(it->hasNext()) {
+			it->next();
+			numTriples++;
+		}
+		delete it;
+	}
+	st.stop();
+
+	unsigned long long micros = st.getReal();
+	cout << structure << ": " << numTriples << " triples of " << npred << " predicates in " << st;
+	if(micros>0) {
+		cout << " (" << (numTriples*1000000ULL/micros) << " triples/s)";
+	}
+	cout << endl;
+
+	delete hdt;
+}
+
+int main(int argc, char **argv) {
+	if(argc<2) {
+		cout << "$ wavbench <rdffile>" << endl;
+		return 1;
+	}
+
+	try {
+		benchmark(argv[1], HDTVocabulary::SEQ_TYPE_WAVELET);
+		benchmark(argv[1], HDTVocabulary::SEQ_TYPE_WAVELET_MATRIX);
+	} catch (const char *e) {
+		cerr << "ERROR: " << e << endl;
+		return 1;
+	}
+}
@@ -31,10 +31,14 @@
 
 
 #include <HDT.hpp>
+#include <HDTVocabulary.hpp>
+#include <HDTManager.hpp>
 
 #include "../src/hdt/HDTFactory.hpp"
+#include "../src/hdt/BasicHDT.hpp"
 
 #include "../src/rdf/RDFSerializerNTriples.hpp"
+#include "../src/libdcs/BloomFilter.h"
 
 #include <getopt.h>
 #include <string>
@@ -46,6 +50,37 @@
 using namespace hdt;
 using namespace std;
 
+/**
+ * Print, as N-Triples comments, the parameters and estimated false positive
+ * rate of the Bloom filter of each dictionary section saved next to the file.
+ */
+void printBloomFilter(BasicHDT *hdt) {
+	ifstream in;
+	ControlInformation ci;
+	try {
+		if(!hdt->openBloomFilter(in, ci)) {
+			return;
+		}
+	} catch (const char *e) {
+		cout << "# Bloom filter: stale, " << e << endl;
+		return;
+	}
+	if(ci.getFormat()!=HDTVocabulary::INDEX_TYPE_BLOOM) {
+		throw "The .bloom file is not a dictionary Bloom filter.";
+	}
+
+	const char *sections[] = { "shared", "subjects", "predicates", "objects" };
+	for(int i=0; i<4; i++) {
+		csd::BloomFilter filter;
+		filter.load(in);
+		cout << "# Bloom filter " << sections[i] << ": " << filter.getLength() << " strings, "
+				<< (filter.getLength()>0 ? filter.size()*8.0/filter.getLength() : 0) << " bits per string, "
+				<< filter.getNumberOfProbes() << " probes, false positive rate "
+				<< filter.getFalsePositiveRate() << endl;
+	}
+	in.close();
+}
+
 
 void help() {
 	cout << "$ hdtInfo [options] <hdtfile> " << endl;
@@ -149,6 +184,14 @@ int main(int argc, char **argv) {
 
 		delete header;
 
+		// Mapped to check the Bloom filter against the counts of its dictionary.
+		HDT *hdt = HDTManager::mapHDT(inputFile.c_str());
+		BasicHDT *basic = dynamic_cast<BasicHDT *>(hdt);
+		if(basic!=NULL) {
+			printBloomFilter(basic);
+		}
+		delete hdt;
+
 	} catch (char *e) {
 		cout << "ERROR: " << e << endl;
 	} catch (const char *e) {